@@ -121,12 +121,12 @@ class autotuneProgram(MeasurementInterface):
 
           elif (paramType == 6):
 
-            # HELIX parameter: should we fix the maximum number of sequential segments?
+            # HELIX parameter: should we fix the iteration block size?
             openTuner_param = SwitchParameter(str(param), dimension)
 
           elif (paramType == 7):
 
-            # HELIX parameter: maximum number of sequential segments
+            # HELIX parameter: iteration block factor
             openTuner_param = IntegerParameter(str(param), 0, dimension - 1)
 
           elif (paramType == 8):
@@ -167,6 +167,10 @@ class autotuneProgram(MeasurementInterface):
         if (conf[str(key)] != utils.Technique.DOALL): # DOALL was not chosen
           chunkSizeIndex = key + 2
           conf[str(chunkSizeIndex)] = 0
+        if (conf[str(key)] != utils.Technique.HELIX): # HELIX was not chosen
+          for iterationBlockIndex in [key + 3, key + 4]:
+            if (str(iterationBlockIndex) in conf):
+              conf[str(iterationBlockIndex)] = 0
 
     return conf
 
@@ -0,0 +1,109 @@
+/*
+ * Copyright 2023  Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do
+ so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#pragma once
+
+#include "noelle/core/SystemHeaders.hpp"
+
+namespace arcana::noelle {
+
+/*
+ * Dense numbering of the functions, basic blocks, and instructions of a
+ * module.
+ *
+ * IDs of each kind start from 0 and follow the order of the module, like the
+ * ones UniqueIRMarker embeds in the IR.
+ * A value keeps its ID until it is deleted.
+ * Values created after the numbering has been computed get new IDs the first
+ * time they are queried.
+ * Transformations that delete code need to invoke @invalidate: the numbering
+ * is then refreshed at the next query.
+ */
+class IRNumbering {
+public:
+  /*
+   * The module is the one of the first value queried.
+   */
+  IRNumbering();
+
+  IRNumbering(Module &m);
+
+  uint32_t getID(Function *f);
+
+  uint32_t getID(BasicBlock *bb);
+
+  uint32_t getID(Instruction *inst);
+
+  /*
+   * Return the value with ID @id.
+   * Return nullptr if the value has been deleted.
+   */
+  template <class T>
+  T *getValue(uint32_t id);
+
+  /*
+   * Return the number of IDs assigned to values of type T so far.
+   * This includes the IDs of deleted values.
+   */
+  template <class T>
+  uint32_t getNumberOfIDs(void);
+
+  /*
+   * Notify that the module has been modified.
+   */
+  void invalidate(void);
+
+private:
+  template <class T>
+  class ValueIDs {
+  public:
+    uint32_t fetchOrAssign(T *v);
+
+    void keep(T *v, ValueIDs<T> &oldIDs);
+
+    DenseMap<T *, uint32_t> ids;
+    std::vector<T *> values;
+  };
+
+  Module *m;
+  bool isValid;
+  ValueIDs<Function> functionIDs;
+  ValueIDs<BasicBlock> basicBlockIDs;
+  ValueIDs<Instruction> instructionIDs;
+
+  void refresh(Module &currentModule);
+};
+
+template <>
+Function *IRNumbering::getValue<Function>(uint32_t id);
+template <>
+BasicBlock *IRNumbering::getValue<BasicBlock>(uint32_t id);
+template <>
+Instruction *IRNumbering::getValue<Instruction>(uint32_t id);
+
+template <>
+uint32_t IRNumbering::getNumberOfIDs<Function>(void);
+template <>
+uint32_t IRNumbering::getNumberOfIDs<BasicBlock>(void);
+template <>
+uint32_t IRNumbering::getNumberOfIDs<Instruction>(void);
+
+} // namespace arcana::noelle
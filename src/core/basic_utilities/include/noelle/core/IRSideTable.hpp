@@ -0,0 +1,150 @@
+/*
+ * Copyright 2023  Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do
+ so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#pragma once
+
+#include "noelle/core/SystemHeaders.hpp"
+#include "noelle/core/IRNumbering.hpp"
+
+namespace arcana::noelle {
+
+/*
+ * Table that maps values of type KeyT (i.e., functions, basic blocks, or
+ * instructions) to data of type ValueT.
+ * Data is stored in a vector indexed by the IDs of an IRNumbering.
+ */
+template <class KeyT, class ValueT>
+class IRSideTable {
+public:
+  IRSideTable(IRNumbering &numbering, ValueT defaultValue = ValueT());
+
+  bool contains(KeyT *key) const;
+
+  /*
+   * Return the data of @key, which must exist.
+   */
+  const ValueT &at(KeyT *key) const;
+
+  /*
+   * Return the data of @key.
+   * Return the default value if @key has no data.
+   */
+  ValueT lookup(KeyT *key) const;
+
+  /*
+   * Return the data of @key, which is added if it does not exist.
+   */
+  ValueT &operator[](KeyT *key);
+
+  void erase(KeyT *key);
+
+  void clear(void);
+
+private:
+  IRNumbering &numbering;
+  std::vector<ValueT> values;
+  BitVector isSet;
+  ValueT defaultValue;
+
+  bool isIDSet(uint32_t id) const;
+};
+
+template <class KeyT, class ValueT>
+IRSideTable<KeyT, ValueT>::IRSideTable(IRNumbering &numbering,
+                                       ValueT defaultValue)
+  : numbering{ numbering },
+    defaultValue{ defaultValue } {
+  return;
+}
+
+template <class KeyT, class ValueT>
+bool IRSideTable<KeyT, ValueT>::contains(KeyT *key) const {
+  auto id = this->numbering.getID(key);
+
+  return this->isIDSet(id);
+}
+
+template <class KeyT, class ValueT>
+const ValueT &IRSideTable<KeyT, ValueT>::at(KeyT *key) const {
+  auto id = this->numbering.getID(key);
+  assert(this->isIDSet(id));
+
+  return this->values[id];
+}
+
+template <class KeyT, class ValueT>
+ValueT IRSideTable<KeyT, ValueT>::lookup(KeyT *key) const {
+  auto id = this->numbering.getID(key);
+  if (!this->isIDSet(id)) {
+    return this->defaultValue;
+  }
+
+  return this->values[id];
+}
+
+template <class KeyT, class ValueT>
+ValueT &IRSideTable<KeyT, ValueT>::operator[](KeyT *key) {
+  auto id = this->numbering.getID(key);
+
+  /*
+   * Make room for all the IDs assigned so far.
+   * This avoids growing the table one ID at a time.
+   */
+  if (id >= this->values.size()) {
+    auto newSize = std::max(id + 1, this->numbering.getNumberOfIDs<KeyT>());
+    this->values.resize(newSize, this->defaultValue);
+    this->isSet.resize(newSize);
+  }
+  this->isSet.set(id);
+
+  return this->values[id];
+}
+
+template <class KeyT, class ValueT>
+void IRSideTable<KeyT, ValueT>::erase(KeyT *key) {
+  auto id = this->numbering.getID(key);
+  if (id >= this->isSet.size()) {
+    return;
+  }
+  this->isSet.reset(id);
+  this->values[id] = this->defaultValue;
+
+  return;
+}
+
+template <class KeyT, class ValueT>
+void IRSideTable<KeyT, ValueT>::clear(void) {
+  this->values.clear();
+  this->isSet.clear();
+
+  return;
+}
+
+template <class KeyT, class ValueT>
+bool IRSideTable<KeyT, ValueT>::isIDSet(uint32_t id) const {
+  if (id >= this->isSet.size()) {
+    return false;
+  }
+
+  return this->isSet.test(id);
+}
+
+} // namespace arcana::noelle
@@ -0,0 +1,174 @@
+/*
+ * Copyright 2023  Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do
+ so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "noelle/core/IRNumbering.hpp"
+
+namespace arcana::noelle {
+
+IRNumbering::IRNumbering() : m{ nullptr }, isValid{ true } {
+  return;
+}
+
+IRNumbering::IRNumbering(Module &m) : m{ &m }, isValid{ false } {
+  return;
+}
+
+uint32_t IRNumbering::getID(Function *f) {
+  assert(f != nullptr);
+  this->refresh(*f->getParent());
+
+  return this->functionIDs.fetchOrAssign(f);
+}
+
+uint32_t IRNumbering::getID(BasicBlock *bb) {
+  assert(bb != nullptr);
+  this->refresh(*bb->getModule());
+
+  return this->basicBlockIDs.fetchOrAssign(bb);
+}
+
+uint32_t IRNumbering::getID(Instruction *inst) {
+  assert(inst != nullptr);
+  this->refresh(*inst->getModule());
+
+  return this->instructionIDs.fetchOrAssign(inst);
+}
+
+template <>
+Function *IRNumbering::getValue<Function>(uint32_t id) {
+  assert(id < this->functionIDs.values.size());
+
+  return this->functionIDs.values[id];
+}
+
+template <>
+BasicBlock *IRNumbering::getValue<BasicBlock>(uint32_t id) {
+  assert(id < this->basicBlockIDs.values.size());
+
+  return this->basicBlockIDs.values[id];
+}
+
+template <>
+Instruction *IRNumbering::getValue<Instruction>(uint32_t id) {
+  assert(id < this->instructionIDs.values.size());
+
+  return this->instructionIDs.values[id];
+}
+
+template <>
+uint32_t IRNumbering::getNumberOfIDs<Function>(void) {
+  return this->functionIDs.values.size();
+}
+
+template <>
+uint32_t IRNumbering::getNumberOfIDs<BasicBlock>(void) {
+  return this->basicBlockIDs.values.size();
+}
+
+template <>
+uint32_t IRNumbering::getNumberOfIDs<Instruction>(void) {
+  return this->instructionIDs.values.size();
+}
+
+void IRNumbering::invalidate(void) {
+  this->isValid = false;
+
+  return;
+}
+
+void IRNumbering::refresh(Module &currentModule) {
+
+  /*
+   * Bind the numbering to the module of the first value queried.
+   */
+  if (this->m == nullptr) {
+    this->m = &currentModule;
+    this->isValid = false;
+  }
+  assert(this->m == &currentModule);
+
+  /*
+   * Check if the numbering is up to date.
+   */
+  if (this->isValid) {
+    return;
+  }
+
+  /*
+   * Number the values of the module.
+   * Values that already have an ID keep it, new values get new IDs, and the
+   * IDs of deleted values are not reused.
+   */
+  ValueIDs<Function> newFunctionIDs;
+  ValueIDs<BasicBlock> newBasicBlockIDs;
+  ValueIDs<Instruction> newInstructionIDs;
+  newFunctionIDs.values.resize(this->functionIDs.values.size(), nullptr);
+  newBasicBlockIDs.values.resize(this->basicBlockIDs.values.size(), nullptr);
+  newInstructionIDs.values.resize(this->instructionIDs.values.size(), nullptr);
+  for (auto &F : *this->m) {
+    newFunctionIDs.keep(&F, this->functionIDs);
+    for (auto &bb : F) {
+      newBasicBlockIDs.keep(&bb, this->basicBlockIDs);
+      for (auto &inst : bb) {
+        newInstructionIDs.keep(&inst, this->instructionIDs);
+      }
+    }
+  }
+  this->functionIDs = std::move(newFunctionIDs);
+  this->basicBlockIDs = std::move(newBasicBlockIDs);
+  this->instructionIDs = std::move(newInstructionIDs);
+  this->isValid = true;
+
+  return;
+}
+
+template <class T>
+uint32_t IRNumbering::ValueIDs<T>::fetchOrAssign(T *v) {
+  auto it = this->ids.find(v);
+  if (it != this->ids.end()) {
+    return it->second;
+  }
+
+  /*
+   * @v has been created after the numbering.
+   */
+  uint32_t id = this->values.size();
+  this->ids[v] = id;
+  this->values.push_back(v);
+
+  return id;
+}
+
+template <class T>
+void IRNumbering::ValueIDs<T>::keep(T *v, ValueIDs<T> &oldIDs) {
+  auto it = oldIDs.ids.find(v);
+  if (it == oldIDs.ids.end()) {
+    this->fetchOrAssign(v);
+    return;
+  }
+  auto id = it->second;
+  this->ids[v] = id;
+  this->values[id] = v;
+
+  return;
+}
+
+} // namespace arcana::noelle
@@ -67,6 +67,22 @@ public:
 
   std::unordered_set<CallGraphFunctionFunctionEdge *> getEdges(void) const;
 
+  /*
+   * Iterate over the edges of @node, without collecting them first, until
+   * @funcToInvoke returns true or no other edge exists.
+   * Each edge is visited once.
+   */
+  bool iterateOverEdges(
+      CallGraphFunctionNode *node,
+      std::function<bool(CallGraphFunctionFunctionEdge *)> funcToInvoke) const;
+
+  /*
+   * Iterate over all edges of the call graph until @funcToInvoke returns true
+   * or no other edge exists.
+   */
+  bool iterateOverEdges(
+      std::function<bool(CallGraphFunctionFunctionEdge *)> funcToInvoke) const;
+
   void removeSubEdge(CallGraphFunctionFunctionEdge *e,
                      CallGraphInstructionFunctionEdge *se);
 
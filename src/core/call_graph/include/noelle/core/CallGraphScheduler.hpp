@@ -0,0 +1,123 @@
+/*
+ * Copyright 2023  Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do
+ so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#pragma once
+
+#include "noelle/core/SystemHeaders.hpp"
+#include "noelle/core/CallGraph.hpp"
+#include "noelle/core/SCCCAG.hpp"
+
+namespace arcana::noelle {
+
+/*
+ * Scheduler of per-function analyses that follows the call graph.
+ */
+class CallGraphScheduler {
+public:
+  /*
+   * When @numberOfThreads is greater than 1, independent SCCs of the call
+   * graph are analyzed in parallel.
+   * In this case, callbacks must not modify the IR nor the LLVM context (e.g.,
+   * by creating constants or metadata).
+   */
+  CallGraphScheduler(CallGraph *callGraph, uint32_t numberOfThreads = 1);
+
+  /*
+   * Invoke @funcToInvoke on every function with a body, callees first.
+   * A function is analyzed after all the functions it may invoke, except the
+   * ones that belong to its same SCC of the call graph.
+   * The functions of an SCC are analyzed one after the other by the same
+   * thread, in no particular order.
+   */
+  void runBottomUp(std::function<void(Function &f)> funcToInvoke);
+
+  /*
+   * Invoke @funcToInvoke on every SCC of the call graph, callees first.
+   * Each invocation receives all the functions of an SCC (including the ones
+   * without a body) so they can be analyzed together (e.g., to solve recursive
+   * functions).
+   */
+  void runBottomUpOnSCCs(
+      std::function<void(std::vector<Function *> const &scc)> funcToInvoke);
+
+  /*
+   * Compute a result for every function with a body, callees first.
+   * @funcToInvoke receives the results computed so far. Results of the callees
+   * that belong to different SCCs are always available. When running in
+   * parallel, results of other functions can be still in flight and must not be
+   * read.
+   */
+  template <class ResultT>
+  std::unordered_map<Function *, ResultT> computeBottomUp(
+      std::function<ResultT(Function &f,
+                            const std::unordered_map<Function *, ResultT> &)>
+          funcToInvoke);
+
+private:
+  CallGraph *cg;
+  uint32_t numberOfThreads;
+
+  std::vector<Function *> getFunctions(SCCCAGNode *n) const;
+
+  void runSequentially(
+      std::vector<std::vector<Function *>> const &sccs,
+      std::function<void(std::vector<Function *> const &scc)> funcToInvoke);
+
+  void runInParallel(
+      std::vector<std::vector<Function *>> const &sccs,
+      std::vector<std::vector<uint32_t>> const &callers,
+      std::vector<uint32_t> &pendingCallees,
+      std::function<void(std::vector<Function *> const &scc)> funcToInvoke);
+};
+
+template <class ResultT>
+std::unordered_map<Function *, ResultT> CallGraphScheduler::computeBottomUp(
+    std::function<ResultT(Function &f,
+                          const std::unordered_map<Function *, ResultT> &)>
+        funcToInvoke) {
+
+  /*
+   * Allocate the results of all functions before starting.
+   * This allows callbacks running in parallel to write their own result
+   * without changing the structure of the map.
+   */
+  std::unordered_map<Function *, ResultT> results;
+  for (auto node : this->cg->getFunctionNodes()) {
+    auto f = node->getFunction();
+    if (f->empty()) {
+      continue;
+    }
+    results[f];
+  }
+
+  /*
+   * Compute the results.
+   */
+  auto computeResult = [&results, &funcToInvoke](Function &f) {
+    auto r = funcToInvoke(f, results);
+    results.at(&f) = std::move(r);
+  };
+  this->runBottomUp(computeResult);
+
+  return results;
+}
+
+} // namespace arcana::noelle
@@ -43,6 +43,8 @@ public:
 
   bool isAnSCC(void) const override;
 
+  std::unordered_set<CallGraphNode *> const &getNodes(void) const;
+
   virtual ~SCCCAGNode_SCC();
 
 private:
@@ -71,8 +73,15 @@ public:
 
   SCCCAGNode *getNode(CallGraphNode *n) const;
 
+  /*
+   * Return the nodes of the SCCCAG in reverse topological order.
+   * Each node comes after the nodes it invokes.
+   */
+  std::vector<SCCCAGNode *> const &getNodesInBottomUpOrder(void) const;
+
 private:
   std::unordered_map<CallGraphNode *, SCCCAGNode *> nodes;
+  std::vector<SCCCAGNode *> bottomUpNodes;
 };
 
 } // namespace arcana::noelle
@@ -378,7 +378,7 @@ void CallGraph::identifyCallGraphIslandsByCallInstructions(
       /*
        * Iterate over the edges.
        */
-      for (auto edge : this->getEdges(currentNode)) {
+      auto visitEdge = [&](CallGraphFunctionFunctionEdge *edge) -> bool {
 
         /*
          * Fetch the calleer.
@@ -429,7 +429,10 @@ void CallGraph::identifyCallGraphIslandsByCallInstructions(
            */
           todos.push(callerNode);
         }
-      }
+
+        return false;
+      };
+      this->iterateOverEdges(currentNode, visitEdge);
     }
   }
 
@@ -620,6 +623,71 @@ std::unordered_set<CallGraphFunctionFunctionEdge *> CallGraph::getEdges(
   return s0;
 }
 
+std::unordered_set<CallGraphFunctionFunctionEdge *> CallGraph::getEdges(
+    void) const {
+  std::unordered_set<CallGraphFunctionFunctionEdge *> s;
+
+  auto f = [&s](CallGraphFunctionFunctionEdge *e) -> bool {
+    s.insert(e);
+    return false;
+  };
+  this->iterateOverEdges(f);
+
+  return s;
+}
+
+bool CallGraph::iterateOverEdges(
+    CallGraphFunctionNode *node,
+    std::function<bool(CallGraphFunctionFunctionEdge *)> funcToInvoke) const {
+
+  /*
+   * Iterate over the incoming edges.
+   */
+  auto incomingIt = this->incomingEdges.find(node);
+  if (incomingIt != this->incomingEdges.end()) {
+    for (auto &p : incomingIt->second) {
+      if (funcToInvoke(p.second)) {
+        return true;
+      }
+    }
+  }
+
+  /*
+   * Iterate over the outgoing edges.
+   * Self-edges have been visited already as incoming ones.
+   */
+  auto outgoingIt = this->outgoingEdges.find(node);
+  if (outgoingIt != this->outgoingEdges.end()) {
+    for (auto &p : outgoingIt->second) {
+      if (p.first == node) {
+        continue;
+      }
+      if (funcToInvoke(p.second)) {
+        return true;
+      }
+    }
+  }
+
+  return false;
+}
+
+bool CallGraph::iterateOverEdges(
+    std::function<bool(CallGraphFunctionFunctionEdge *)> funcToInvoke) const {
+
+  /*
+   * Every edge is the outgoing edge of exactly one node.
+   */
+  for (auto &nodeEdges : this->outgoingEdges) {
+    for (auto &p : nodeEdges.second) {
+      if (funcToInvoke(p.second)) {
+        return true;
+      }
+    }
+  }
+
+  return false;
+}
+
 void CallGraph::removeSubEdge(CallGraphFunctionFunctionEdge *e,
                               CallGraphInstructionFunctionEdge *se) {
 
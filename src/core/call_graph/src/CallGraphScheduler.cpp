@@ -0,0 +1,239 @@
+/*
+ * Copyright 2023  Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do
+ so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include <mutex>
+#include <condition_variable>
+
+#include "noelle/core/CallGraphScheduler.hpp"
+
+namespace arcana::noelle {
+
+CallGraphScheduler::CallGraphScheduler(CallGraph *callGraph,
+                                       uint32_t numberOfThreads)
+  : cg{ callGraph },
+    numberOfThreads{ numberOfThreads } {
+  assert(this->cg != nullptr);
+
+  return;
+}
+
+void CallGraphScheduler::runBottomUp(
+    std::function<void(Function &f)> funcToInvoke) {
+
+  /*
+   * Analyze the functions of an SCC one after the other.
+   */
+  auto invokeOnFunctions = [&funcToInvoke](std::vector<Function *> const &scc) {
+    for (auto f : scc) {
+      if (f->empty()) {
+        continue;
+      }
+      funcToInvoke(*f);
+    }
+  };
+  this->runBottomUpOnSCCs(invokeOnFunctions);
+
+  return;
+}
+
+void CallGraphScheduler::runBottomUpOnSCCs(
+    std::function<void(std::vector<Function *> const &scc)> funcToInvoke) {
+
+  /*
+   * Fetch the SCCs of the call graph in bottom-up order.
+   */
+  auto scccag = this->cg->getSCCCAG();
+  auto &nodes = scccag->getNodesInBottomUpOrder();
+  std::vector<std::vector<Function *>> sccs{};
+  for (auto node : nodes) {
+    sccs.push_back(this->getFunctions(node));
+  }
+
+  /*
+   * Check if we should run in a single thread.
+   * In this case, the bottom-up order of the SCCs is all we need.
+   */
+  if (this->numberOfThreads <= 1) {
+    this->runSequentially(sccs, funcToInvoke);
+    return;
+  }
+
+  /*
+   * Compute the dependences between SCCs.
+   * An SCC can be analyzed once all the SCCs it invokes have been analyzed.
+   */
+  std::unordered_map<SCCCAGNode *, uint32_t> nodeIndex{};
+  for (auto i = 0u; i < nodes.size(); i++) {
+    nodeIndex[nodes[i]] = i;
+  }
+  std::vector<std::vector<uint32_t>> callers(nodes.size());
+  std::vector<uint32_t> pendingCallees(nodes.size(), 0);
+  for (auto i = 0u; i < nodes.size(); i++) {
+
+    /*
+     * Collect the SCCs that invoke a function of the current one.
+     */
+    std::unordered_set<uint32_t> callerSCCs{};
+    for (auto f : sccs[i]) {
+      auto fNode = this->cg->getFunctionNode(f);
+      for (auto edge : this->cg->getIncomingEdges(fNode)) {
+        auto callerNode = scccag->getNode(edge->getCaller());
+        auto callerIndex = nodeIndex.at(callerNode);
+        if (callerIndex == i) {
+          continue;
+        }
+        callerSCCs.insert(callerIndex);
+      }
+    }
+
+    /*
+     * Add the dependences.
+     */
+    for (auto callerIndex : callerSCCs) {
+      callers[i].push_back(callerIndex);
+      pendingCallees[callerIndex]++;
+    }
+  }
+
+  /*
+   * Run the SCCs.
+   */
+  this->runInParallel(sccs, callers, pendingCallees, funcToInvoke);
+
+  return;
+}
+
+std::vector<Function *> CallGraphScheduler::getFunctions(SCCCAGNode *n) const {
+  std::vector<Function *> functions{};
+
+  /*
+   * Check if the node is a single function that is not recursive.
+   */
+  if (!n->isAnSCC()) {
+    auto functionNode = static_cast<SCCCAGNode_Function *>(n);
+    auto cgNode =
+        static_cast<CallGraphFunctionNode *>(functionNode->getNode());
+    functions.push_back(cgNode->getFunction());
+    return functions;
+  }
+
+  /*
+   * The node is an SCC of functions.
+   */
+  auto sccNode = static_cast<SCCCAGNode_SCC *>(n);
+  for (auto node : sccNode->getNodes()) {
+    auto cgNode = static_cast<CallGraphFunctionNode *>(node);
+    functions.push_back(cgNode->getFunction());
+  }
+
+  return functions;
+}
+
+void CallGraphScheduler::runSequentially(
+    std::vector<std::vector<Function *>> const &sccs,
+    std::function<void(std::vector<Function *> const &scc)> funcToInvoke) {
+  for (auto &scc : sccs) {
+    funcToInvoke(scc);
+  }
+
+  return;
+}
+
+void CallGraphScheduler::runInParallel(
+    std::vector<std::vector<Function *>> const &sccs,
+    std::vector<std::vector<uint32_t>> const &callers,
+    std::vector<uint32_t> &pendingCallees,
+    std::function<void(std::vector<Function *> const &scc)> funcToInvoke) {
+
+  /*
+   * Initialize the queue of SCCs ready to be analyzed.
+   * These are the ones that do not invoke other SCCs.
+   *
+   * The queue, the number of pending callees, and the number of SCCs left are
+   * protected by @m.
+   */
+  std::mutex m;
+  std::condition_variable cv;
+  std::deque<uint32_t> ready{};
+  for (auto i = 0u; i < sccs.size(); i++) {
+    if (pendingCallees[i] == 0) {
+      ready.push_back(i);
+    }
+  }
+  auto sccsLeft = sccs.size();
+
+  /*
+   * Define the work of a thread.
+   */
+  auto worker = [&]() {
+    while (true) {
+
+      /*
+       * Fetch the next SCC ready to be analyzed.
+       */
+      uint32_t current;
+      {
+        std::unique_lock<std::mutex> lock(m);
+        cv.wait(lock, [&]() { return !ready.empty() || (sccsLeft == 0); });
+        if (ready.empty()) {
+          return;
+        }
+        current = ready.front();
+        ready.pop_front();
+      }
+
+      /*
+       * Analyze the SCC.
+       */
+      funcToInvoke(sccs[current]);
+
+      /*
+       * Release the callers of the SCC that have no other pending callees.
+       */
+      {
+        std::lock_guard<std::mutex> lock(m);
+        for (auto callerIndex : callers[current]) {
+          pendingCallees[callerIndex]--;
+          if (pendingCallees[callerIndex] == 0) {
+            ready.push_back(callerIndex);
+          }
+        }
+        sccsLeft--;
+      }
+      cv.notify_all();
+    }
+  };
+
+  /*
+   * Run the threads.
+   */
+  std::vector<std::thread> threads{};
+  for (auto i = 0u; i < this->numberOfThreads; i++) {
+    threads.emplace_back(worker);
+  }
+  for (auto &t : threads) {
+    t.join();
+  }
+
+  return;
+}
+
+} // namespace arcana::noelle
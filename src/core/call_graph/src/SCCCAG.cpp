@@ -97,16 +97,21 @@ SCCCAG::SCCCAG(CallGraph *cg) {
       /*
        * Create the correct node and insert it into the SCCCAG.
        * Possible nodes are an SCC or a single Function.
+       *
+       * NOTE: scc_iterator returns an SCC only after all SCCs reachable from
+       * it. Hence, the order in which we create the nodes is bottom-up.
        */
       if (!thisIsAnSCC) {
         auto sccNode = new SCCCAGNode_Function(singleCGNode);
         this->nodes[singleCGNode] = sccNode;
+        this->bottomUpNodes.push_back(sccNode);
         continue;
       }
       auto sccNode = new SCCCAGNode_SCC(cgNodes);
       for (auto node : cgNodes) {
         this->nodes[node] = sccNode;
       }
+      this->bottomUpNodes.push_back(sccNode);
     }
   }
 
@@ -122,4 +127,8 @@ SCCCAGNode *SCCCAG::getNode(CallGraphNode *n) const {
   return node;
 }
 
+std::vector<SCCCAGNode *> const &SCCCAG::getNodesInBottomUpOrder(void) const {
+  return this->bottomUpNodes;
+}
+
 } // namespace arcana::noelle
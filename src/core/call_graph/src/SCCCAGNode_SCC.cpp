@@ -33,6 +33,11 @@ bool SCCCAGNode_SCC::isAnSCC(void) const {
   return true;
 }
 
+std::unordered_set<CallGraphNode *> const &SCCCAGNode_SCC::getNodes(
+    void) const {
+  return this->nodes;
+}
+
 SCCCAGNode_SCC::~SCCCAGNode_SCC() {
   return;
 }
@@ -20,6 +20,7 @@
  OR OTHER DEALINGS IN THE SOFTWARE.
  */
 #include "CodeSize.hpp"
+#include "noelle/core/CodeSizeBudget.hpp"
 
 namespace arcana::noelle {
 
@@ -29,28 +30,10 @@ bool CodeSize::runOnModule(Module &M) {
 
   /*
    * Compute the code size.
+   *
+   * This is the metric used by the code size budget of the transformations.
    */
-  uint64_t s = 0;
-  for (auto &F : M) {
-    for (auto &bb : F) {
-      for (auto &I : bb) {
-
-        /*
-         * Check the current instruction
-         */
-        if (isa<PHINode>(&I)) {
-          continue;
-        }
-        if (auto brInst = dyn_cast<BranchInst>(&I)) {
-          if (brInst->isUnconditional()) {
-            continue;
-          }
-        }
-
-        s++;
-      }
-    }
-  }
+  auto s = CodeSizeBudget::getCodeSize(M);
   outs() << s << "\n";
 
   return false;
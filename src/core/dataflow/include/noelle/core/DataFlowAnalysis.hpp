@@ -40,6 +40,9 @@ public:
       std::function<bool(Instruction *i)> filter);
 
   DataFlowResult *getFullSets(Function *f);
+
+  DataFlowResult *getFullSets(Function *f,
+                              std::function<bool(Instruction *i)> filter);
 };
 
 } // namespace arcana::noelle
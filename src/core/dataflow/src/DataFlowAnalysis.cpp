@@ -42,6 +42,36 @@ DataFlowResult *DataFlowAnalysis::getFullSets(Function *f) {
   return df;
 }
 
+DataFlowResult *DataFlowAnalysis::getFullSets(
+    Function *f,
+    std::function<bool(Instruction *i)> filter) {
+
+  /*
+   * Collect the instructions to consider.
+   */
+  std::vector<Instruction *> consideredInsts;
+  for (auto &inst : instructions(*f)) {
+    if (filter(&inst)) {
+      consideredInsts.push_back(&inst);
+    }
+  }
+
+  /*
+   * Every instruction can reach every instruction considered.
+   */
+  auto df = new DataFlowResult{};
+  for (auto &inst : instructions(*f)) {
+    auto &inSetOfInst = df->IN(&inst);
+    auto &outSetOfInst = df->OUT(&inst);
+    for (auto inst2 : consideredInsts) {
+      inSetOfInst.insert(inst2);
+      outSetOfInst.insert(inst2);
+    }
+  }
+
+  return df;
+}
+
 DataFlowResult *DataFlowAnalysis::runReachableAnalysis(
     Function *f,
     std::function<bool(Instruction *i)> filter) {
@@ -453,7 +453,7 @@ void DG<T>::removeNode(DGNode<T> *node) {
     incomingToNode.insert(edge);
   for (auto edge : node->getOutgoingEdges())
     outgoingFromNode.insert(edge);
-  for (auto edge : node->getAllEdges())
+  for (auto edge : node->allEdges())
     allToAndFromNode.insert(edge);
 
   /*
@@ -76,6 +76,15 @@ public:
     return make_range(incomingEdges.begin(), incomingEdges.end());
   }
 
+  /*
+   * Non-allocating view of the outgoing edges followed by the incoming ones.
+   * Contrary to @getAllEdges, an edge from the node to itself is visited
+   * twice.
+   */
+  auto allEdges(void) {
+    return concat<DGEdge<T, T> *const>(outgoingEdges, incomingEdges);
+  }
+
   uint64_t degree(void) const;
 
   uint64_t outDegree(void) const;
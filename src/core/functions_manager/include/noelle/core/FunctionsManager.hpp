@@ -45,6 +45,17 @@ public:
 
   std::set<Function *> getFunctions(void) const;
 
+  /*
+   * Non-allocating view of the functions that @getFunctions returns.
+   * Contrary to @getFunctions, functions follow their order in the module.
+   */
+  auto functions(void) const {
+    auto hasBody = [](Function &f) { return !f.empty() && !f.isIntrinsic(); };
+    auto toPointer = [](Function &f) { return &f; };
+
+    return map_range(make_filter_range(this->program, hasBody), toPointer);
+  }
+
   std::set<Function *> getFunctionsWithPrefix(
       const std::string &prefixName) const;
 
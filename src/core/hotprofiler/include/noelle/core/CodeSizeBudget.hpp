@@ -0,0 +1,119 @@
+/*
+ * Copyright 2023  Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do
+ so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#pragma once
+
+#include "noelle/core/SystemHeaders.hpp"
+#include "noelle/core/LoopStructure.hpp"
+#include "noelle/core/Hot.hpp"
+
+namespace arcana::noelle {
+
+/*
+ * Request of a transformation to grow the program by cloning code.
+ */
+struct CodeGrowthRequest {
+  std::string transformation;
+  std::string target;
+
+  /*
+   * Instructions added to the program.
+   */
+  uint64_t codeSize;
+
+  /*
+   * Dynamic instructions expected to be saved.
+   */
+  double benefit;
+};
+
+/*
+ * Module-wide budget of the code that transformations can clone (e.g.,
+ * parallelizations, unrolling, whilification, inlining).
+ *
+ * The program can grow up to a maximum factor of its original size. Requests
+ * are granted by their benefit per instruction added, and the rejected ones
+ * are reported.
+ */
+class CodeSizeBudget {
+public:
+  CodeSizeBudget(Hot *profiles,
+                 uint64_t originalCodeSize,
+                 uint64_t currentCodeSize,
+                 double maximumGrowth);
+
+  /*
+   * Return the code size as measured by noelle-codesize: the number of
+   * instructions excluding PHIs and unconditional branches.
+   */
+  static uint64_t getCodeSize(BasicBlock &bb);
+
+  static uint64_t getCodeSize(Function &f);
+
+  static uint64_t getCodeSize(Module &m);
+
+  static uint64_t getCodeSize(LoopStructure &loop);
+
+  uint64_t getOriginalCodeSize(void) const;
+
+  uint64_t getMaximumCodeSize(void) const;
+
+  uint64_t getRemainingCodeSize(void) const;
+
+  /*
+   * Return the dynamic instructions expected to be saved by a transformation
+   * of @loop that saves @fractionSaved of its execution time.
+   * Without profiles, every loop is considered equally beneficial.
+   */
+  double getExpectedBenefit(LoopStructure *loop, double fractionSaved) const;
+
+  /*
+   * Return true if @request is granted. In this case, its code size is
+   * charged to the budget.
+   */
+  bool requestCodeGrowth(CodeGrowthRequest const &request);
+
+  /*
+   * Grant the requests with the highest benefit per instruction added until
+   * the budget is exhausted.
+   * Return whether each request (in the order given) has been granted.
+   */
+  std::vector<bool> requestCodeGrowth(
+      std::vector<CodeGrowthRequest> const &requests);
+
+  /*
+   * Give back @codeSize instructions of the granted @request that its
+   * transformation did not add (e.g., because it failed).
+   */
+  void releaseCodeGrowth(CodeGrowthRequest const &request, uint64_t codeSize);
+
+  void printReport(raw_ostream &stream, std::string prefix) const;
+
+private:
+  Hot *profiles;
+  uint64_t originalCodeSize;
+  uint64_t maximumCodeSize;
+  uint64_t currentCodeSize;
+  std::vector<CodeGrowthRequest> granted;
+  std::vector<CodeGrowthRequest> rejected;
+};
+
+} // namespace arcana::noelle
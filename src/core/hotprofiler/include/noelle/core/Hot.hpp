@@ -24,6 +24,11 @@
 #include "noelle/core/SystemHeaders.hpp"
 #include "noelle/core/LoopStructure.hpp"
 #include "noelle/core/SCC.hpp"
+#include "noelle/core/IRNumbering.hpp"
+#include "noelle/core/IRSideTable.hpp"
+#include "noelle/core/ProfileStore.hpp"
+#include "noelle/core/LoopIterationsDistribution.hpp"
+#include "noelle/core/MemoryDependenceProfile.hpp"
 
 namespace arcana::noelle {
 
@@ -33,6 +38,13 @@ public:
 
   bool isAvailable(void) const;
 
+  /*
+   * Notify that the code has been transformed.
+   * Transformations that add or delete code must invoke it before the next
+   * query: the profiles of the deleted code are then dropped.
+   */
+  void invalidateCodeNumbering(void);
+
   /*
    * =========================== Instructions ================================
    */
@@ -122,6 +134,44 @@ public:
 
   double getAverageTotalInstructionsPerIteration(LoopStructure *loop) const;
 
+  /*
+   * Return the distribution of the iterations per invocation of @loop recorded
+   * by the loop profiler.
+   *
+   * @return nullptr if @loop has not been profiled by the loop profiler.
+   */
+  const LoopIterationsDistribution *getIterationsDistribution(
+      LoopStructure *loop) const;
+
+  /*
+   * Return the median number of iterations per invocation of @loop.
+   * If @loop has not been profiled by the loop profiler, this is the average.
+   */
+  double getMedianLoopIterationsPerInvocation(LoopStructure *loop) const;
+
+  /*
+   * Return the fraction of the iterations of @loop executed by invocations with
+   * at least @minimumIterations iterations.
+   * If @loop has not been profiled by the loop profiler, all invocations are
+   * assumed to execute the average number of iterations.
+   *
+   * @return Between 0 and 1
+   */
+  double getFractionOfIterationsInInvocationsWithAtLeast(
+      LoopStructure *loop,
+      uint64_t minimumIterations) const;
+
+  /*
+   * Return the profile of the loop-carried memory dependence of @loop from
+   * @fromInst to @toInst recorded by the dependence profiler.
+   *
+   * @return nullptr if the dependence has not been profiled.
+   */
+  const MemoryDependenceProfile *getMemoryDependenceProfile(
+      LoopStructure *loop,
+      Instruction *fromInst,
+      Instruction *toInst) const;
+
   /*
    * =========================== Functions ==================================
    */
@@ -160,20 +210,33 @@ public:
   double getBranchFrequency(BasicBlock *sourceBB, BasicBlock *targetBB) const;
 
 private:
-  std::unordered_map<BasicBlock *, std::unordered_map<BasicBlock *, double>>
+  /*
+   * Profiles are mutable because, when they come from a profile store, the
+   * ones of a function are loaded the first time they are requested.
+   */
+  mutable std::unordered_map<BasicBlock *,
+                             std::unordered_map<BasicBlock *, double>>
       branchProbability;
-  std::unordered_map<BasicBlock *, uint64_t> bbInvocations;
-  std::unordered_map<Function *, uint64_t> functionInvocations;
-  std::unordered_map<Function *, uint64_t> functionSelfInstructions;
-  std::unordered_map<Function *, uint64_t> functionTotalInstructions;
-  std::unordered_map<Instruction *, uint64_t> instructionTotalInstructions;
+  mutable IRNumbering numbering;
+  mutable IRSideTable<BasicBlock, uint64_t> bbInvocations;
+  mutable IRSideTable<Function, uint64_t> functionInvocations;
+  mutable IRSideTable<Function, uint64_t> functionSelfInstructions;
+  mutable IRSideTable<Function, uint64_t> functionTotalInstructions;
+  mutable IRSideTable<Instruction, uint64_t> instructionTotalInstructions;
   uint64_t moduleNumberOfInstructionsExecuted;
+  std::shared_ptr<ProfileStore> profileStore;
+  std::unordered_map<uint64_t, LoopIterationsDistribution>
+      loopIterationsDistributions;
+  std::unordered_map<
+      uint64_t,
+      std::map<std::pair<uint32_t, uint32_t>, MemoryDependenceProfile>>
+      memoryDependenceProfiles;
 
   void computeTotalInstructions(Module &M);
 
   void computeTotalInstructions(
-      Function &F,
-      std::unordered_map<Function *, bool> &evaluationStack);
+      std::vector<Function *> const &scc,
+      IRSideTable<Function, uint64_t> &invocationsFromOutsideSCC);
 
   void setFunctionTotalInstructions(Function *f, uint64_t totalInstructions);
 
@@ -187,7 +250,27 @@ private:
 
   void computeProgramInvocations(Module &M);
 
+  void setIterationsDistribution(uint64_t loopID,
+                                 LoopIterationsDistribution const &d);
+
+  void setMemoryDependenceProfile(uint64_t loopID,
+                                  Instruction *fromInst,
+                                  Instruction *toInst,
+                                  MemoryDependenceProfile const &p);
+
+  /*
+   * Use the profiles saved in @store.
+   */
+  void setProfileStore(std::shared_ptr<ProfileStore> store);
+
+  /*
+   * Load the profiles of @f from the profile store, if any and if they have not
+   * been loaded yet.
+   */
+  void loadProfileOf(Function *f) const;
+
   friend class HotProfiler;
+  friend class ProfileStore;
 };
 
 } // namespace arcana::noelle
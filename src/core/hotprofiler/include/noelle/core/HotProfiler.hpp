@@ -25,6 +25,7 @@
 #include "llvm/Analysis/BranchProbabilityInfo.h"
 #include "noelle/core/SystemHeaders.hpp"
 #include "noelle/core/Hot.hpp"
+#include "noelle/core/ProfileStore.hpp"
 
 namespace arcana::noelle {
 
@@ -44,8 +45,16 @@ public:
 
 private:
   Hot hot;
+  std::string profileStoreFileName;
+  std::string profileStoreOutputFileName;
+  std::string loopProfileFileName;
+  std::string dependenceProfileFileName;
 
   void analyzeProfiles(Module &M);
+
+  void loadLoopProfiles(std::string const &fileName);
+
+  void loadDependenceProfiles(Module &M, std::string const &fileName);
 };
 
 } // namespace arcana::noelle
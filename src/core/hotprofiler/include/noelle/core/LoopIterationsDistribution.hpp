@@ -0,0 +1,80 @@
+/*
+ * Copyright 2023  Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do
+ so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#pragma once
+
+#include "noelle/core/SystemHeaders.hpp"
+
+namespace arcana::noelle {
+
+/*
+ * Distribution of the iterations executed per invocation of a loop, and of the
+ * cost of its iterations, as recorded by the loop profiler.
+ *
+ * Invocations are grouped by iterations in buckets of powers of two: bucket 0
+ * includes the invocations with no iterations and bucket i > 0 includes the
+ * ones with [2^(i-1), 2^i) iterations.
+ */
+class LoopIterationsDistribution {
+public:
+  LoopIterationsDistribution(std::vector<uint64_t> const &invocationsPerBucket,
+                             std::vector<uint64_t> const &iterationsPerBucket,
+                             double iterationCostMean,
+                             double iterationCostVariance);
+
+  uint64_t getInvocations(void) const;
+
+  uint64_t getIterations(void) const;
+
+  /*
+   * Return the smallest number of iterations per invocation such that at least
+   * @percentile (between 0 and 1) of the invocations do not exceed it.
+   * The result is rounded up to the end of its bucket.
+   */
+  uint64_t getIterationsPerInvocationPercentile(double percentile) const;
+
+  /*
+   * Return the fraction (between 0 and 1) of the iterations that are executed
+   * by invocations with at least @minimumIterations iterations.
+   * Invocations are counted only if their whole bucket satisfies the bound.
+   */
+  double getFractionOfIterationsInInvocationsWithAtLeast(
+      uint64_t minimumIterations) const;
+
+  /*
+   * Return the mean and the variance of the cost (in cycles) of an iteration.
+   */
+  double getIterationCostMean(void) const;
+
+  double getIterationCostVariance(void) const;
+
+private:
+  std::vector<uint64_t> invocationsPerBucket;
+  std::vector<uint64_t> iterationsPerBucket;
+  double iterationCostMean;
+  double iterationCostVariance;
+
+  static uint64_t getFirstIterationsOfBucket(uint32_t bucket);
+
+  static uint64_t getLastIterationsOfBucket(uint32_t bucket);
+};
+
+} // namespace arcana::noelle
@@ -0,0 +1,61 @@
+/*
+ * Copyright 2023  Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do
+ so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#pragma once
+
+#include "noelle/core/SystemHeaders.hpp"
+
+namespace arcana::noelle {
+
+/*
+ * How often a loop-carried memory dependence between two instructions of a
+ * loop manifested at run time, as recorded by the dependence profiler.
+ *
+ * The dependence manifests when the destination instruction accesses a memory
+ * location that the source instruction accessed in a previous iteration of the
+ * same invocation of the loop.
+ * The iteration distance is the number of iterations between the two accesses.
+ */
+class MemoryDependenceProfile {
+public:
+  MemoryDependenceProfile(uint64_t occurrences,
+                          uint64_t minimumIterationDistance,
+                          uint64_t maximumIterationDistance);
+
+  bool hasManifested(void) const;
+
+  uint64_t getOccurrences(void) const;
+
+  /*
+   * Return the shortest and the longest iteration distance observed.
+   * They are 0 if the dependence never manifested.
+   */
+  uint64_t getMinimumIterationDistance(void) const;
+
+  uint64_t getMaximumIterationDistance(void) const;
+
+private:
+  uint64_t occurrences;
+  uint64_t minimumIterationDistance;
+  uint64_t maximumIterationDistance;
+};
+
+} // namespace arcana::noelle
@@ -0,0 +1,121 @@
+/*
+ * Copyright 2023  Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do
+ so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#pragma once
+
+#include "llvm/Support/MemoryBuffer.h"
+#include "noelle/core/SystemHeaders.hpp"
+
+namespace arcana::noelle {
+
+class Hot;
+
+/*
+ * Binary file that stores the profiles of a module.
+ *
+ * The file is memory-mapped and never parsed as a whole: the profile of a
+ * function is located (by name) only when it is requested.
+ * Basic blocks, edges, and call instructions are identified by their position
+ * within their function. Hence, a store can only be used with the bitcode it
+ * has been generated from.
+ */
+class ProfileStore {
+public:
+  struct Header {
+    char magic[8];
+    uint32_t version;
+    uint32_t numberOfFunctions;
+    uint64_t moduleInstructionsExecuted;
+    uint64_t functionsOffset;
+    uint64_t blocksOffset;
+    uint64_t edgesOffset;
+    uint64_t callsOffset;
+    uint64_t namesOffset;
+    uint64_t fileSize;
+  };
+
+  struct FunctionEntry {
+    uint64_t nameOffset;
+    uint32_t nameLength;
+    uint32_t numberOfBlocks;
+    uint32_t numberOfInstructions;
+    uint32_t numberOfEdges;
+    uint32_t numberOfCalls;
+    uint32_t padding;
+    uint64_t firstBlock;
+    uint64_t firstEdge;
+    uint64_t firstCall;
+    uint64_t invocations;
+    uint64_t selfInstructions;
+    uint64_t totalInstructions;
+  };
+
+  struct EdgeEntry {
+    uint32_t block;
+    uint32_t successor;
+    double frequency;
+  };
+
+  struct CallEntry {
+    uint32_t instruction;
+    uint32_t padding;
+    uint64_t totalInstructions;
+  };
+
+  /*
+   * Map the store saved in @fileName.
+   */
+  ProfileStore(std::string const &fileName);
+
+  bool isValid(void) const;
+
+  uint64_t getModuleInstructionsExecuted(void) const;
+
+  /*
+   * Return the profile of @f, or nullptr if the store does not have it or if
+   * it has been generated from a different body of @f.
+   */
+  const FunctionEntry *getFunctionProfile(Function &f) const;
+
+  ArrayRef<uint64_t> getBlockInvocations(const FunctionEntry &f) const;
+
+  ArrayRef<EdgeEntry> getEdges(const FunctionEntry &f) const;
+
+  ArrayRef<CallEntry> getCalls(const FunctionEntry &f) const;
+
+  /*
+   * Save the profiles of @M held by @hot to @fileName.
+   */
+  static bool write(std::string const &fileName, Module &M, Hot &hot);
+
+  static constexpr uint32_t version = 1;
+
+private:
+  std::unique_ptr<MemoryBuffer> buffer;
+  const Header *header;
+
+  template <class T>
+  const T *getArray(uint64_t offset) const;
+
+  StringRef getName(const FunctionEntry &f) const;
+};
+
+} // namespace arcana::noelle
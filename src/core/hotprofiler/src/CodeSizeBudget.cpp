@@ -0,0 +1,211 @@
+/*
+ * Copyright 2023  Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do
+ so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "noelle/core/CodeSizeBudget.hpp"
+
+namespace arcana::noelle {
+
+CodeSizeBudget::CodeSizeBudget(Hot *profiles,
+                               uint64_t originalCodeSize,
+                               uint64_t currentCodeSize,
+                               double maximumGrowth)
+  : profiles{ profiles },
+    originalCodeSize{ originalCodeSize },
+    maximumCodeSize{ (uint64_t)(originalCodeSize * maximumGrowth) },
+    currentCodeSize{ currentCodeSize } {
+  assert(profiles != nullptr);
+  assert(maximumGrowth >= 1);
+
+  return;
+}
+
+uint64_t CodeSizeBudget::getCodeSize(BasicBlock &bb) {
+  uint64_t s = 0;
+  for (auto &I : bb) {
+
+    /*
+     * Check the current instruction
+     */
+    if (isa<PHINode>(&I)) {
+      continue;
+    }
+    if (auto brInst = dyn_cast<BranchInst>(&I)) {
+      if (brInst->isUnconditional()) {
+        continue;
+      }
+    }
+
+    s++;
+  }
+
+  return s;
+}
+
+uint64_t CodeSizeBudget::getCodeSize(Function &f) {
+  uint64_t s = 0;
+  for (auto &bb : f) {
+    s += CodeSizeBudget::getCodeSize(bb);
+  }
+
+  return s;
+}
+
+uint64_t CodeSizeBudget::getCodeSize(Module &m) {
+  uint64_t s = 0;
+  for (auto &F : m) {
+    s += CodeSizeBudget::getCodeSize(F);
+  }
+
+  return s;
+}
+
+uint64_t CodeSizeBudget::getCodeSize(LoopStructure &loop) {
+  uint64_t s = 0;
+  for (auto bb : loop.blocks()) {
+    s += CodeSizeBudget::getCodeSize(*bb);
+  }
+
+  return s;
+}
+
+uint64_t CodeSizeBudget::getOriginalCodeSize(void) const {
+  return this->originalCodeSize;
+}
+
+uint64_t CodeSizeBudget::getMaximumCodeSize(void) const {
+  return this->maximumCodeSize;
+}
+
+uint64_t CodeSizeBudget::getRemainingCodeSize(void) const {
+  if (this->currentCodeSize >= this->maximumCodeSize) {
+    return 0;
+  }
+
+  return this->maximumCodeSize - this->currentCodeSize;
+}
+
+double CodeSizeBudget::getExpectedBenefit(LoopStructure *loop,
+                                          double fractionSaved) const {
+  if (!this->profiles->isAvailable()) {
+    return fractionSaved;
+  }
+
+  return this->profiles->getTotalInstructions(loop) * fractionSaved;
+}
+
+bool CodeSizeBudget::requestCodeGrowth(CodeGrowthRequest const &request) {
+  auto granted = this->requestCodeGrowth(std::vector<CodeGrowthRequest>{
+      request });
+
+  return granted[0];
+}
+
+std::vector<bool> CodeSizeBudget::requestCodeGrowth(
+    std::vector<CodeGrowthRequest> const &requests) {
+  std::vector<bool> granted(requests.size(), false);
+
+  /*
+   * Rank the requests by benefit per instruction added.
+   */
+  std::vector<uint32_t> order;
+  for (auto i = 0u; i < requests.size(); i++) {
+    order.push_back(i);
+  }
+  auto benefitPerInstruction = [&requests](uint32_t i) -> double {
+    auto &r = requests[i];
+    return r.benefit / ((double)std::max<uint64_t>(r.codeSize, 1));
+  };
+  std::stable_sort(order.begin(),
+                   order.end(),
+                   [&benefitPerInstruction](uint32_t i1, uint32_t i2) {
+                     return benefitPerInstruction(i1)
+                            > benefitPerInstruction(i2);
+                   });
+
+  /*
+   * Grant the requests that fit in the budget.
+   */
+  for (auto i : order) {
+    auto &r = requests[i];
+    if (r.codeSize > this->getRemainingCodeSize()) {
+      this->rejected.push_back(r);
+      continue;
+    }
+    this->currentCodeSize += r.codeSize;
+    this->granted.push_back(r);
+    granted[i] = true;
+  }
+
+  return granted;
+}
+
+void CodeSizeBudget::releaseCodeGrowth(CodeGrowthRequest const &request,
+                                       uint64_t codeSize) {
+  for (auto it = this->granted.begin(); it != this->granted.end(); it++) {
+    if ((it->transformation != request.transformation)
+        || (it->target != request.target)) {
+      continue;
+    }
+
+    /*
+     * Give back at most what has been charged for the request.
+     */
+    auto released = std::min(codeSize, it->codeSize);
+    it->codeSize -= released;
+    this->currentCodeSize -= released;
+    if (it->codeSize == 0) {
+      this->granted.erase(it);
+    }
+    break;
+  }
+
+  return;
+}
+
+void CodeSizeBudget::printReport(raw_ostream &stream,
+                                 std::string prefix) const {
+  stream << prefix << "Code size budget\n";
+  stream << prefix << "  Original code size: " << this->originalCodeSize
+         << "\n";
+  stream << prefix << "  Maximum code size: " << this->maximumCodeSize << "\n";
+  stream << prefix << "  Code size: " << this->currentCodeSize << "\n";
+
+  /*
+   * Print the requests.
+   */
+  auto printRequest = [&stream, &prefix](CodeGrowthRequest const &r) {
+    stream << prefix << "    " << r.transformation << " of " << r.target
+           << ": " << r.codeSize << " instructions, benefit = " << r.benefit
+           << "\n";
+  };
+  stream << prefix << "  Requests granted: " << this->granted.size() << "\n";
+  for (auto &r : this->granted) {
+    printRequest(r);
+  }
+  stream << prefix << "  Requests rejected: " << this->rejected.size() << "\n";
+  for (auto &r : this->rejected) {
+    printRequest(r);
+  }
+
+  return;
+}
+
+} // namespace arcana::noelle
@@ -21,10 +21,18 @@
  */
 #include "noelle/core/SystemHeaders.hpp"
 #include "noelle/core/Hot.hpp"
+#include "noelle/core/CallGraphScheduler.hpp"
 
 namespace arcana::noelle {
 
-Hot::Hot() : moduleNumberOfInstructionsExecuted{ 0 } {
+Hot::Hot()
+  : bbInvocations{ numbering },
+    functionInvocations{ numbering },
+    functionSelfInstructions{ numbering },
+    functionTotalInstructions{ numbering },
+    instructionTotalInstructions{ numbering },
+    moduleNumberOfInstructionsExecuted{ 0 },
+    profileStore{ nullptr } {
   return;
 }
 
@@ -32,28 +40,32 @@ bool Hot::isAvailable(void) const {
   return this->hasBeenExecuted();
 }
 
+void Hot::invalidateCodeNumbering(void) {
+  this->numbering.invalidate();
+
+  return;
+}
+
 void Hot::computeProgramInvocations(Module &M) {
 
   /*
    * Compute the total number of instructions executed.
    */
-  for (auto pairs : this->bbInvocations) {
+  for (auto &F : M) {
+    for (auto &bb : F) {
 
-    /*
-     * Fetch the current basic block
-     */
-    auto bb = pairs.first;
-
-    /*
-     * Fetch the number of invocations of the basic block and its length.
-     */
-    auto totalBBInsts = this->getInvocations(bb);
-    auto bbLength = std::distance(bb->begin(), bb->end());
+      /*
+       * Fetch the number of invocations of the basic block and its length.
+       * Basic blocks without profiles have no invocations.
+       */
+      auto totalBBInsts = this->getInvocations(&bb);
+      auto bbLength = std::distance(bb.begin(), bb.end());
 
-    /*
-     * Update the module counter
-     */
-    this->moduleNumberOfInstructionsExecuted += (totalBBInsts * bbLength);
+      /*
+       * Update the module counter
+       */
+      this->moduleNumberOfInstructionsExecuted += (totalBBInsts * bbLength);
+    }
   }
 
   /*
@@ -61,12 +73,15 @@ void Hot::computeProgramInvocations(Module &M) {
    * Each call instructions is considered one; so callee instructions are not
    * considered.
    */
-  for (auto pairs : this->functionInvocations) {
+  for (auto &F : M) {
 
     /*
      * Fetch the function.
      */
-    auto f = pairs.first;
+    auto f = &F;
+    if (!this->functionInvocations.contains(f)) {
+      continue;
+    }
 
     /*
      * Consider all basic blocks.
@@ -92,260 +107,176 @@ void Hot::computeTotalInstructions(Module &moduleToAnalyze) {
    * Analyze every function included in M and compute their total instructions
    * executed.
    *
-   * To do so, we iterate over all functions of M.
+   * To do so, we iterate over the SCCs of the call graph of M bottom-up.
+   * This way, the callees of a function have been analyzed already, except
+   * the ones that belong to its same SCC, which are solved together.
+   * Only direct calls are considered.
    */
-  for (auto &F : moduleToAnalyze) {
+  auto noIndirectCallees = [](CallInst *) -> bool { return false; };
+  auto getNoCallees = [](CallInst *) -> const std::set<const Function *> {
+    return {};
+  };
+  CallGraph directCallGraph(moduleToAnalyze, noIndirectCallees, getNoCallees);
+  CallGraphScheduler scheduler(&directCallGraph);
+  IRSideTable<Function, uint64_t> invocationsFromOutsideSCC{ this->numbering };
+  auto computeTotalInstructionsOfSCC =
+      [this, &invocationsFromOutsideSCC](std::vector<Function *> const &scc) {
+        this->computeTotalInstructions(scc, invocationsFromOutsideSCC);
+      };
+  scheduler.runBottomUpOnSCCs(computeTotalInstructionsOfSCC);
 
-    /*
-     * Fetch the next function defined within the module.
-     */
-    if (F.empty()) {
-      continue;
-    }
+  return;
+}
 
-    /*
-     * Compute the total instructions of F.
-     */
-    std::unordered_map<Function *, bool> evaluationStack;
-    this->computeTotalInstructions(F, evaluationStack);
-  }
+void Hot::computeTotalInstructions(
+    std::vector<Function *> const &scc,
+    IRSideTable<Function, uint64_t> &invocationsFromOutsideSCC) {
 
   /*
-   * Analyze every call instruction.
-   *
-   * To do so, we iterate over all functions and check all of their callers.
+   * Fetch the functions of the SCC that have been executed.
    */
-  for (auto &F : moduleToAnalyze) {
-
-    /*
-     * Fetch the next function defined within the module.
-     */
-    if (F.empty()) {
+  std::unordered_set<Function *> executedFunctions{};
+  for (auto f : scc) {
+    if (f->empty()) {
       continue;
     }
 
     /*
      * Check if the function has been executed at all.
      */
-    if (!this->hasBeenExecuted(&F)) {
+    if (!this->hasBeenExecuted(f)) {
+      this->setFunctionTotalInstructions(f, 0);
       continue;
     }
+    executedFunctions.insert(f);
+  }
+  if (executedFunctions.size() == 0) {
+    return;
+  }
 
-    /*
-     * Fetch the total instructions executed by this function.
-     */
-    assert(this->isFunctionTotalInstructionsAvailable(F));
-    auto totalInstsOfF = this->getTotalInstructions(&F);
-    auto totalInstsOfFPerInvocation = totalInstsOfF / this->getInvocations(&F);
-    auto totalInstsOfFLeftover = totalInstsOfF;
-
-    /*
-     * Fetch all callers of the function.
-     */
-    Instruction *callerOfF = nullptr;
-    for (auto &useOfF : F.uses()) {
+  /*
+   * Compute the instructions executed by the SCC.
+   * These are the instructions executed by its functions plus the instructions
+   * executed by the callees outside the SCC.
+   *
+   * The invocations of a function of the SCC that are due to other functions
+   * of the same SCC are tracked as well. This allows us to distinguish them
+   * from the invocations that enter the SCC.
+   */
+  double sccTotalInsts = 0;
+  std::unordered_map<Function *, uint64_t> invocationsFromSCC{};
+  for (auto f : executedFunctions) {
+    for (auto &inst : instructions(f)) {
 
       /*
-       * Fetch the next call instruction to F.
+       * Check if the instruction has been executed at all.
        */
-      auto userOfF = useOfF.getUser();
-      if (!isa<Instruction>(userOfF)) {
+      if (!this->hasBeenExecuted(&inst)) {
         continue;
       }
-      callerOfF = cast<Instruction>(userOfF);
 
       /*
-       * The instruction "userOfF" invokes F.
+       * Count the instruction.
        *
-       * Check if the caller has been executed at all.
+       * Notice that this needs to be done even for call instructions.
+       */
+      auto instructionInvocations = this->getInvocations(&inst);
+      sccTotalInsts += instructionInvocations;
+
+      /*
+       * Check if the instruction invokes a function whose body we can
+       * inspect.
        */
-      if (!this->hasBeenExecuted(callerOfF)) {
+      auto callInst = dyn_cast<CallBase>(&inst);
+      if (callInst == nullptr) {
+        continue;
+      }
+      auto callee = callInst->getCalledFunction();
+      if (false || (callee == nullptr) || (callee->empty())) {
         continue;
       }
+      assert(this->hasBeenExecuted(callee));
+      assert(this->getInvocations(callee) >= instructionInvocations);
 
       /*
-       * Compute the fraction of the callee that is associated to the specific
-       * call instruction we are analyzying. To this end, we make the assumption
-       * that the distribution of total instructions of the callee is uniform
-       * among its invocations.
+       * Check if the callee belongs to the SCC.
        *
-       * The total number of instructions executed by this call is the call
-       * itself plus the total instructions executed by the callee divided by
-       * its invocations due to this call.
+       * In this case, its instructions are already counted by the SCC.
+       * Hence, the call instruction only accounts for itself.
        */
-      auto instructionInvocations = this->getInvocations(callerOfF);
-      auto calleeTotalInstsFraction =
-          totalInstsOfFPerInvocation * instructionInvocations;
-      this->instructionTotalInstructions[callerOfF] =
-          calleeTotalInstsFraction + 1;
+      if (executedFunctions.count(callee) > 0) {
+        invocationsFromSCC[callee] += instructionInvocations;
+        this->instructionTotalInstructions[callInst] = 1;
+        continue;
+      }
 
       /*
-       * Remove the current fraction used of the callee.
-       * This is needed to make sure the whole set of instructions of the callee
-       * will be distributed among the callers.
+       * The callee has been evaluated already.
+       *
+       * Compute the fraction of the callee that is associated to the specific
+       * call instruction we are analyzying. To this end, we make the assumption
+       * that the distribution of total instructions per callee invocation is
+       * uniform among its dynamic callers.
        */
-      totalInstsOfFLeftover -= calleeTotalInstsFraction;
-    }
-
-    /*
-     * Check if all the total instructions have been distributed among the
-     * callers.
-     */
-    if (true && (totalInstsOfFLeftover > 0)
-        && (callerOfF != nullptr) /* This handle the case where a function has
-                                     not known callers  */
-    ) {
+      assert(this->isFunctionTotalInstructionsAvailable(*callee));
+      double calleeTotalInstsFraction = 0;
+      auto calleeInvocations = invocationsFromOutsideSCC.lookup(callee);
+      if (calleeInvocations > 0) {
+        auto calleeTotalInstsPerInvocation =
+            ((double)this->getTotalInstructions(callee))
+            / ((double)calleeInvocations);
+        calleeTotalInstsFraction =
+            calleeTotalInstsPerInvocation * ((double)instructionInvocations);
+      }
+      sccTotalInsts += calleeTotalInstsFraction;
 
       /*
-       * There is some leftover to still distribute.
-       * This happen when the total instructions of the callee is not a multiple
-       * of the number of the callers.
-       *
-       * Our heuristic is to give the leftover to the last caller (this is
-       * completely arbitrary).
+       * The total number of instructions executed by this call is the call
+       * itself plus the total instructions executed by the callee due to this
+       * call.
        */
-      this->instructionTotalInstructions[callerOfF] += totalInstsOfFLeftover;
+      this->instructionTotalInstructions[callInst] =
+          ((uint64_t)calleeTotalInstsFraction) + 1;
     }
   }
 
-  return;
-}
-
-void Hot::computeTotalInstructions(
-    Function &F,
-    std::unordered_map<Function *, bool> &evaluationStack) {
-
   /*
-   * Keep track we are evaluating the input function.
-   */
-  evaluationStack[&F] = true;
-
-  /*
-   * Check if the callee has been executed at all.
+   * Compute the invocations of each function that enter the SCC.
+   *
+   * Profiles can be imprecise. If the SCC seems to be never entered, then we
+   * fall back to all the invocations of its functions.
    */
-  if (!this->hasBeenExecuted(&F)) {
-    this->setFunctionTotalInstructions(&F, 0);
-    return;
+  uint64_t sccInvocations = 0;
+  for (auto f : executedFunctions) {
+    auto invocations = this->getInvocations(f);
+    auto internalInvocations = invocationsFromSCC[f];
+    invocationsFromOutsideSCC[f] = (invocations > internalInvocations)
+                                       ? (invocations - internalInvocations)
+                                       : 0;
+    sccInvocations += invocationsFromOutsideSCC[f];
   }
-
-  /*
-   * Iterate over all instructions.
-   */
-  double t = 0;
-  for (auto &inst : instructions(&F)) {
-
-    /*
-     * Check if the instruction has been executed at all.
-     */
-    if (!this->hasBeenExecuted(&inst)) {
-      continue;
-    }
-
-    /*
-     * Fetch the number of invocations of this instruction.
-     */
-    auto instructionInvocations = this->getInvocations(&inst);
-
-    /*
-     * Count the instruction.
-     *
-     * Notice that this needs to be done even for call instructions.
-     */
-    t += instructionInvocations;
-
-    /*
-     * Check if the instruction can invoke another function.
-     */
-    if (!isa<CallBase>(&inst)) {
-      continue;
-    }
-    auto callInst = dyn_cast<CallBase>(&inst);
-
-    /*
-     * The instruction invokes another function.
-     * Hence, we need to count the instructions executed by the callee.
-     *
-     * Fetch the callee.
-     */
-    auto callee = callInst->getCalledFunction();
-
-    /*
-     * Check if the callee is known and we can inspect its body.
-     */
-    if (false || (callee == nullptr) || (callee->empty())) {
-      continue;
-    }
-    assert(this->hasBeenExecuted(callee));
-    assert(this->getInvocations(callee) >= this->getInvocations(callInst));
-
-    /*
-     * The callee is known and we can inspect its body.
-     *
-     * Check if we have already analyzed the callee.
-     */
-    uint64_t calleeTotalInsts = 0;
-    if (!this->isFunctionTotalInstructionsAvailable(*callee)) {
-
-      /*
-       * We have not analyzed the callee.
-       *
-       * Check if we are in the process of evaluating it.
-       */
-      if (evaluationStack[callee]) {
-
-        /*
-         * We are in the middle of evaluating the callee.
-         * We have to break this evaluation cycle to converge.
-         * For now, we consider the cost of the callee to be 1.
-         */
-        calleeTotalInsts = 1;
-
-      } else {
-
-        /*
-         * We are not in the middle of the process of evaluating the callee.
-         *
-         * It is time to evaluate it.
-         */
-        this->computeTotalInstructions(*callee, evaluationStack);
-        assert(this->isFunctionTotalInstructionsAvailable(*callee));
-
-        /*
-         * Now that the callee has been evaluated, we can fetch that
-         * information.
-         */
-        calleeTotalInsts = this->getTotalInstructions(callee);
-      }
-
-    } else {
-
-      /*
-       * The callee has been evalauted already.
-       */
-      calleeTotalInsts = this->getTotalInstructions(callee);
+  if (sccInvocations == 0) {
+    for (auto f : executedFunctions) {
+      invocationsFromOutsideSCC[f] = this->getInvocations(f);
+      sccInvocations += invocationsFromOutsideSCC[f];
     }
-    assert(calleeTotalInsts > 0);
-
-    /*
-     * Compute the fraction of the callee that is associated to the specific
-     * call instruction we are analyzying. To this end, we make the assumption
-     * that the distribution of total instructions per callee invocation is
-     * uniform among its dynamic callers.
-     */
-    auto calleeTotalInstsPerInvocation =
-        ((double)calleeTotalInsts) / ((double)this->getInvocations(callee));
-
-    /*
-     * Add the fraction of the total of the callee associated to the current
-     * instruction.
-     */
-    t += (calleeTotalInstsPerInvocation * ((double)instructionInvocations));
   }
 
   /*
-   * Set the total counter.
+   * Distribute the instructions executed by the SCC among its functions.
+   *
+   * The total instructions of a function are the ones executed by the SCC when
+   * it is entered through that function. Hence, the totals of the functions of
+   * the SCC sum up to the instructions executed by the SCC, and each invocation
+   * that enters the SCC costs the same.
+   * Notice that, for a function that is not recursive, its total instructions
+   * are the ones executed by the SCC.
    */
-  this->setFunctionTotalInstructions(&F, (uint64_t)t);
+  for (auto f : executedFunctions) {
+    auto fraction = ((double)invocationsFromOutsideSCC[f])
+                    / ((double)sccInvocations);
+    this->setFunctionTotalInstructions(f, (uint64_t)(sccTotalInsts * fraction));
+  }
 
   return;
 }
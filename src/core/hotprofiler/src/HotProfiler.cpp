@@ -92,6 +92,199 @@ void HotProfiler::analyzeProfiles(Module &M) {
   return;
 }
 
+void HotProfiler::loadLoopProfiles(std::string const &fileName) {
+
+  /*
+   * Open the file generated by the loop profiler.
+   */
+  auto fileBuf = MemoryBuffer::getFile(fileName);
+  if (auto ec = fileBuf.getError()) {
+    errs() << "HotProfiler: ERROR: Couldn't open the loop profile " << fileName
+           << ": " << ec.message() << "\n";
+    return;
+  }
+  std::stringstream fileStream{ fileBuf.get()->getBuffer().str() };
+
+  /*
+   * Each line describes a loop as
+   * ID INVOCATIONS ITERATIONS COST_MEAN COST_VARIANCE BUCKETS [INV ITERS]*
+   */
+  std::string line;
+  while (std::getline(fileStream, line)) {
+    if ((line.size() == 0) || (line[0] == '#')) {
+      continue;
+    }
+    std::stringstream lineStream{ line };
+    uint64_t loopID, invocations, iterations;
+    double costMean, costVariance;
+    uint32_t buckets;
+    lineStream >> loopID >> invocations >> iterations >> costMean
+        >> costVariance >> buckets;
+    std::vector<uint64_t> invocationsPerBucket(buckets);
+    std::vector<uint64_t> iterationsPerBucket(buckets);
+    for (auto i = 0u; i < buckets; i++) {
+      lineStream >> invocationsPerBucket[i] >> iterationsPerBucket[i];
+    }
+    if (lineStream.fail()) {
+      errs() << "HotProfiler: ERROR: Malformed loop profile " << fileName
+             << "\n";
+      return;
+    }
+
+    /*
+     * Set the distribution of the loop.
+     */
+    LoopIterationsDistribution d{ invocationsPerBucket,
+                                  iterationsPerBucket,
+                                  costMean,
+                                  costVariance };
+    this->hot.setIterationsDistribution(loopID, d);
+  }
+
+  return;
+}
+
+void HotProfiler::loadDependenceProfiles(Module &M,
+                                         std::string const &fileName) {
+
+  /*
+   * Open the file generated by the dependence profiler.
+   */
+  auto fileBuf = MemoryBuffer::getFile(fileName);
+  if (auto ec = fileBuf.getError()) {
+    errs() << "HotProfiler: ERROR: Couldn't open the dependence profile "
+           << fileName << ": " << ec.message() << "\n";
+    return;
+  }
+  std::stringstream fileStream{ fileBuf.get()->getBuffer().str() };
+
+  /*
+   * Profiles generated by older versions of the dependence profiler do not
+   * describe their instructions and therefore they cannot be validated.
+   */
+  std::string line;
+  std::getline(fileStream, line);
+  if (line != "# NOELLE dependence profile 2") {
+    errs() << "HotProfiler: ERROR: Unsupported dependence profile " << fileName
+           << "\n";
+    return;
+  }
+
+  /*
+   * Each line either describes an instruction of the profiled IR as
+   * I INST_ID OPCODE POSITION FUNCTION_NAME
+   * or a loop-carried memory dependence as
+   * D LOOP_ID FROM_INST_ID TO_INST_ID OCCURRENCES MIN_DISTANCE MAX_DISTANCE
+   *
+   * Instructions are mapped to the ones of @M that are at the same position
+   * within the function with the same name and that have the same opcode.
+   */
+  std::unordered_map<std::string, std::vector<Instruction *>>
+      instructionsOfFunctions;
+  std::unordered_map<uint32_t, Instruction *> profiledInstructions;
+  std::map<uint64_t,
+           std::vector<std::tuple<Instruction *,
+                                  Instruction *,
+                                  MemoryDependenceProfile>>>
+      loopProfiles;
+  std::set<uint64_t> mismatchedLoops;
+  while (std::getline(fileStream, line)) {
+    if ((line.size() == 0) || (line[0] == '#')) {
+      continue;
+    }
+    std::stringstream lineStream{ line };
+    std::string kind;
+    lineStream >> kind;
+
+    if (kind == "I") {
+      uint32_t instID, opcode, position;
+      std::string functionName;
+      lineStream >> instID >> opcode >> position >> functionName;
+      if (lineStream.fail()) {
+        errs() << "HotProfiler: ERROR: Malformed dependence profile "
+               << fileName << "\n";
+        return;
+      }
+
+      /*
+       * Fetch the instructions of the function the first time we need them.
+       */
+      auto fIt = instructionsOfFunctions.find(functionName);
+      if (fIt == instructionsOfFunctions.end()) {
+        std::vector<Instruction *> fInsts;
+        if (auto f = M.getFunction(functionName)) {
+          for (auto &inst : instructions(f)) {
+            fInsts.push_back(&inst);
+          }
+        }
+        fIt = instructionsOfFunctions.insert({ functionName, fInsts }).first;
+      }
+
+      /*
+       * Instructions that do not match are left unmapped.
+       */
+      auto &fInsts = fIt->second;
+      if ((position < fInsts.size())
+          && (fInsts[position]->getOpcode() == opcode)) {
+        profiledInstructions[instID] = fInsts[position];
+      }
+      continue;
+    }
+
+    if (kind != "D") {
+      errs() << "HotProfiler: ERROR: Malformed dependence profile " << fileName
+             << "\n";
+      return;
+    }
+    uint64_t loopID, occurrences, minimumDistance, maximumDistance;
+    uint32_t fromInstID, toInstID;
+    lineStream >> loopID >> fromInstID >> toInstID >> occurrences
+        >> minimumDistance >> maximumDistance;
+    if (lineStream.fail() || (minimumDistance > maximumDistance)) {
+      errs() << "HotProfiler: ERROR: Malformed dependence profile " << fileName
+             << "\n";
+      return;
+    }
+
+    /*
+     * A loop with a dependence that does not match @M has been profiled on
+     * different IR. Hence, none of its profiles can be trusted.
+     */
+    auto fromIt = profiledInstructions.find(fromInstID);
+    auto toIt = profiledInstructions.find(toInstID);
+    if ((fromIt == profiledInstructions.end())
+        || (toIt == profiledInstructions.end())) {
+      mismatchedLoops.insert(loopID);
+      continue;
+    }
+    MemoryDependenceProfile p{ occurrences, minimumDistance, maximumDistance };
+    loopProfiles[loopID].push_back(
+        std::make_tuple(fromIt->second, toIt->second, p));
+  }
+
+  /*
+   * Set the profiles of the loops that match @M.
+   */
+  for (auto loopID : mismatchedLoops) {
+    errs() << "HotProfiler: WARNING: The dependence profile of loop " << loopID
+           << " does not match the IR and it will be ignored\n";
+  }
+  for (auto &pair : loopProfiles) {
+    auto loopID = pair.first;
+    if (mismatchedLoops.find(loopID) != mismatchedLoops.end()) {
+      continue;
+    }
+    for (auto &dep : pair.second) {
+      this->hot.setMemoryDependenceProfile(loopID,
+                                           std::get<0>(dep),
+                                           std::get<1>(dep),
+                                           std::get<2>(dep));
+    }
+  }
+
+  return;
+}
+
 Hot &HotProfiler::getHot(void) {
   return this->hot;
 }
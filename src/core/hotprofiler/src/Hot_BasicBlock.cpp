@@ -57,8 +57,14 @@ bool Hot::hasBeenExecuted(BasicBlock *bb) const {
 
 uint64_t Hot::getInvocations(BasicBlock *bb) const {
   assert(bb != nullptr);
+  this->loadProfileOf(bb->getParent());
 
-  auto inv = this->bbInvocations.at(bb);
+  /*
+   * A basic block created after the profiles have been loaded (e.g., by a
+   * transformation) has not been executed, like a basic block without the
+   * profile metadata.
+   */
+  auto inv = this->bbInvocations.lookup(bb);
 
   return inv;
 }
@@ -104,6 +110,7 @@ uint64_t Hot::getStaticInstructions(
 
 double Hot::getBranchFrequency(BasicBlock *sourceBB,
                                BasicBlock *targetBB) const {
+  this->loadProfileOf(sourceBB->getParent());
   auto &branchSuccessors = this->branchProbability.at(sourceBB);
 
   /*
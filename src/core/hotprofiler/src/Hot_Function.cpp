@@ -48,12 +48,14 @@ uint64_t Hot::getStaticInstructions(
 }
 
 uint64_t Hot::getSelfInstructions(Function *f) const {
+  this->loadProfileOf(f);
   auto insts = this->functionSelfInstructions.at(f);
 
   return insts;
 }
 
 uint64_t Hot::getInvocations(Function *f) const {
+  this->loadProfileOf(f);
   auto invs = this->functionInvocations.at(f);
 
   return invs;
@@ -67,8 +69,8 @@ void Hot::setFunctionTotalInstructions(Function *f,
 }
 
 bool Hot::isFunctionTotalInstructionsAvailable(Function &F) const {
-  if (this->functionTotalInstructions.find(&F)
-      == this->functionTotalInstructions.end()) {
+  this->loadProfileOf(&F);
+  if (!this->functionTotalInstructions.contains(&F)) {
     return false;
   }
   return true;
@@ -78,8 +78,8 @@ uint64_t Hot::getInvocations(Instruction *i) const {
 }
 
 uint64_t Hot::getTotalInstructions(Instruction *i) const {
-  if (this->instructionTotalInstructions.find(i)
-      == this->instructionTotalInstructions.end()) {
+  this->loadProfileOf(i->getFunction());
+  if (!this->instructionTotalInstructions.contains(i)) {
 
     /*
      * This is not a call instruction.
@@ -26,7 +26,7 @@ namespace arcana::noelle {
 
 uint64_t Hot::getStaticInstructions(LoopStructure *l) const {
   uint64_t t = 0;
-  for (auto bb : l->getBasicBlocks()) {
+  for (auto bb : l->blocks()) {
     t += this->getStaticInstructions(bb);
   }
 
@@ -37,7 +37,7 @@ uint64_t Hot::getStaticInstructions(
     LoopStructure *l,
     std::function<bool(Instruction *i)> canIConsiderIt) const {
   uint64_t t = 0;
-  for (auto bb : l->getBasicBlocks()) {
+  for (auto bb : l->blocks()) {
     t += this->getStaticInstructions(bb, canIConsiderIt);
   }
 
@@ -70,7 +70,7 @@ uint64_t Hot::getInvocations(LoopStructure *l) const {
 uint64_t Hot::getSelfInstructions(LoopStructure *loop) const {
   uint64_t insts = 0;
 
-  for (auto bb : loop->getBasicBlocks()) {
+  for (auto bb : loop->blocks()) {
     insts += this->getStaticInstructions(bb);
   }
 
@@ -80,7 +80,7 @@ uint64_t Hot::getSelfInstructions(LoopStructure *loop) const {
 uint64_t Hot::getTotalInstructions(LoopStructure *loop) const {
   uint64_t insts = 0;
 
-  for (auto bb : loop->getBasicBlocks()) {
+  for (auto bb : loop->blocks()) {
     insts += this->getTotalInstructions(bb);
   }
 
@@ -196,4 +196,103 @@ uint64_t Hot::getIterations(LoopStructure *l) const {
   return loopIterations;
 }
 
+const LoopIterationsDistribution *Hot::getIterationsDistribution(
+    LoopStructure *loop) const {
+
+  /*
+   * Distributions are identified by the loop ID.
+   */
+  auto loopID = loop->getID();
+  if (!loopID) {
+    return nullptr;
+  }
+  auto it = this->loopIterationsDistributions.find(loopID.value());
+  if (it == this->loopIterationsDistributions.end()) {
+    return nullptr;
+  }
+
+  return &it->second;
+}
+
+double Hot::getMedianLoopIterationsPerInvocation(LoopStructure *loop) const {
+  auto d = this->getIterationsDistribution(loop);
+  if (d == nullptr) {
+    return this->getAverageLoopIterationsPerInvocation(loop);
+  }
+
+  return d->getIterationsPerInvocationPercentile(0.5);
+}
+
+double Hot::getFractionOfIterationsInInvocationsWithAtLeast(
+    LoopStructure *loop,
+    uint64_t minimumIterations) const {
+
+  /*
+   * Check if we know the distribution of the iterations.
+   */
+  auto d = this->getIterationsDistribution(loop);
+  if (d != nullptr) {
+    return d->getFractionOfIterationsInInvocationsWithAtLeast(
+        minimumIterations);
+  }
+
+  /*
+   * We only know the average.
+   */
+  auto averageIterations = this->getAverageLoopIterationsPerInvocation(loop);
+  if (averageIterations < minimumIterations) {
+    return 0;
+  }
+
+  return 1;
+}
+
+void Hot::setIterationsDistribution(uint64_t loopID,
+                                    LoopIterationsDistribution const &d) {
+  this->loopIterationsDistributions.erase(loopID);
+  this->loopIterationsDistributions.insert({ loopID, d });
+
+  return;
+}
+
+const MemoryDependenceProfile *Hot::getMemoryDependenceProfile(
+    LoopStructure *loop,
+    Instruction *fromInst,
+    Instruction *toInst) const {
+
+  /*
+   * Dependences are identified by the loop ID and by the IDs of their
+   * instructions.
+   */
+  auto loopID = loop->getID();
+  if (!loopID) {
+    return nullptr;
+  }
+  auto loopIt = this->memoryDependenceProfiles.find(loopID.value());
+  if (loopIt == this->memoryDependenceProfiles.end()) {
+    return nullptr;
+  }
+  auto key = std::make_pair(this->numbering.getID(fromInst),
+                            this->numbering.getID(toInst));
+  auto it = loopIt->second.find(key);
+  if (it == loopIt->second.end()) {
+    return nullptr;
+  }
+
+  return &it->second;
+}
+
+void Hot::setMemoryDependenceProfile(uint64_t loopID,
+                                     Instruction *fromInst,
+                                     Instruction *toInst,
+                                     MemoryDependenceProfile const &p) {
+  auto &loopProfiles = this->memoryDependenceProfiles[loopID];
+  auto key = std::make_pair(this->numbering.getID(fromInst),
+                            this->numbering.getID(toInst));
+  loopProfiles.erase(key);
+  loopProfiles.insert({ key, p });
+
+  return;
+}
+
 } // namespace arcana::noelle
@@ -0,0 +1,115 @@
+/*
+ * Copyright 2023  Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do
+ so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "noelle/core/SystemHeaders.hpp"
+#include "noelle/core/Hot.hpp"
+
+namespace arcana::noelle {
+
+void Hot::setProfileStore(std::shared_ptr<ProfileStore> store) {
+  assert(store != nullptr);
+  assert(store->isValid());
+  this->profileStore = store;
+
+  /*
+   * The module-wide counters are computed when the store is generated.
+   * The profiles of the functions are loaded on demand.
+   */
+  this->moduleNumberOfInstructionsExecuted =
+      store->getModuleInstructionsExecuted();
+
+  return;
+}
+
+void Hot::loadProfileOf(Function *f) const {
+
+  /*
+   * Check if the profiles come from a store and if they have been loaded
+   * already.
+   */
+  if (this->profileStore == nullptr) {
+    return;
+  }
+  if (f->empty()) {
+    return;
+  }
+  if (this->functionInvocations.contains(f)) {
+    return;
+  }
+
+  /*
+   * Fetch the profile of the function.
+   * Functions without a profile (e.g., because they have been modified after
+   * the generation of the store) are considered not executed.
+   */
+  auto entry = this->profileStore->getFunctionProfile(*f);
+  if (entry == nullptr) {
+    for (auto &bb : *f) {
+      this->bbInvocations[&bb] = 0;
+    }
+    this->functionInvocations[f] = 0;
+    this->functionSelfInstructions[f] = 0;
+    this->functionTotalInstructions[f] = 0;
+    return;
+  }
+
+  /*
+   * Set the function counters.
+   */
+  this->functionInvocations[f] = entry->invocations;
+  this->functionSelfInstructions[f] = entry->selfInstructions;
+  this->functionTotalInstructions[f] = entry->totalInstructions;
+
+  /*
+   * Set the invocations of the basic blocks and the total instructions of the
+   * call instructions.
+   * Both are identified by their position within the function.
+   */
+  std::vector<BasicBlock *> bbs{};
+  auto blockInvocations = this->profileStore->getBlockInvocations(*entry);
+  auto calls = this->profileStore->getCalls(*entry);
+  auto nextCall = calls.begin();
+  uint32_t instIndex = 0;
+  for (auto &bb : *f) {
+    this->bbInvocations[&bb] = blockInvocations[bbs.size()];
+    bbs.push_back(&bb);
+    for (auto &inst : bb) {
+      if ((nextCall != calls.end()) && (nextCall->instruction == instIndex)) {
+        this->instructionTotalInstructions[&inst] = nextCall->totalInstructions;
+        nextCall++;
+      }
+      instIndex++;
+    }
+  }
+
+  /*
+   * Set the frequencies of the edges.
+   */
+  for (auto &edge : this->profileStore->getEdges(*entry)) {
+    auto bb = bbs[edge.block];
+    auto succBB = bb->getTerminator()->getSuccessor(edge.successor);
+    this->branchProbability[bb][succBB] = edge.frequency;
+  }
+
+  return;
+}
+
+} // namespace arcana::noelle
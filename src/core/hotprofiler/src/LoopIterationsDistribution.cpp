@@ -0,0 +1,128 @@
+/*
+ * Copyright 2023  Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do
+ so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "noelle/core/LoopIterationsDistribution.hpp"
+
+namespace arcana::noelle {
+
+LoopIterationsDistribution::LoopIterationsDistribution(
+    std::vector<uint64_t> const &invocationsPerBucket,
+    std::vector<uint64_t> const &iterationsPerBucket,
+    double iterationCostMean,
+    double iterationCostVariance)
+  : invocationsPerBucket{ invocationsPerBucket },
+    iterationsPerBucket{ iterationsPerBucket },
+    iterationCostMean{ iterationCostMean },
+    iterationCostVariance{ iterationCostVariance } {
+  assert(invocationsPerBucket.size() == iterationsPerBucket.size());
+
+  return;
+}
+
+uint64_t LoopIterationsDistribution::getInvocations(void) const {
+  uint64_t invocations = 0;
+  for (auto invs : this->invocationsPerBucket) {
+    invocations += invs;
+  }
+
+  return invocations;
+}
+
+uint64_t LoopIterationsDistribution::getIterations(void) const {
+  uint64_t iterations = 0;
+  for (auto iters : this->iterationsPerBucket) {
+    iterations += iters;
+  }
+
+  return iterations;
+}
+
+uint64_t LoopIterationsDistribution::getIterationsPerInvocationPercentile(
+    double percentile) const {
+
+  /*
+   * Find the first bucket that reaches the percentile.
+   */
+  auto invocations = this->getInvocations();
+  auto target = percentile * ((double)invocations);
+  uint64_t invocationsSoFar = 0;
+  for (auto i = 0u; i < this->invocationsPerBucket.size(); i++) {
+    invocationsSoFar += this->invocationsPerBucket[i];
+    if ((invocationsSoFar > 0) && (((double)invocationsSoFar) >= target)) {
+      return getLastIterationsOfBucket(i);
+    }
+  }
+
+  return 0;
+}
+
+double LoopIterationsDistribution::
+    getFractionOfIterationsInInvocationsWithAtLeast(
+        uint64_t minimumIterations) const {
+  auto iterations = this->getIterations();
+  if (iterations == 0) {
+    return 0;
+  }
+
+  /*
+   * Sum the iterations of the buckets that satisfy the bound.
+   */
+  uint64_t iterationsOfLongInvocations = 0;
+  for (auto i = 0u; i < this->iterationsPerBucket.size(); i++) {
+    if (getFirstIterationsOfBucket(i) < minimumIterations) {
+      continue;
+    }
+    iterationsOfLongInvocations += this->iterationsPerBucket[i];
+  }
+
+  return ((double)iterationsOfLongInvocations) / ((double)iterations);
+}
+
+double LoopIterationsDistribution::getIterationCostMean(void) const {
+  return this->iterationCostMean;
+}
+
+double LoopIterationsDistribution::getIterationCostVariance(void) const {
+  return this->iterationCostVariance;
+}
+
+uint64_t LoopIterationsDistribution::getFirstIterationsOfBucket(
+    uint32_t bucket) {
+  if (bucket == 0) {
+    return 0;
+  }
+
+  return ((uint64_t)1) << (bucket - 1);
+}
+
+uint64_t LoopIterationsDistribution::getLastIterationsOfBucket(
+    uint32_t bucket) {
+  if (bucket == 0) {
+    return 0;
+  }
+  if (bucket >= 64) {
+    return std::numeric_limits<uint64_t>::max();
+  }
+
+  return (((uint64_t)1) << bucket) - 1;
+}
+
+} // namespace arcana::noelle
@@ -0,0 +1,149 @@
+/*
+ * Copyright 2023  Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do
+ so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "noelle/core/SystemHeaders.hpp"
+#include "noelle/core/LoopProfiler.hpp"
+
+namespace arcana::noelle {
+
+LoopProfiler::LoopProfiler()
+  : ModulePass(ID),
+    readCycleCounter{ nullptr } {
+
+  return;
+}
+
+bool LoopProfiler::doInitialization(Module &M) {
+  return false;
+}
+
+bool LoopProfiler::runOnModule(Module &M) {
+
+  /*
+   * Declare the runtime function that records an invocation of a loop.
+   */
+  auto &context = M.getContext();
+  auto int64Type = Type::getInt64Ty(context);
+  auto voidType = Type::getVoidTy(context);
+  this->invocationEnded =
+      M.getOrInsertFunction("NOELLE_loopProfiler_invocationEnded",
+                            voidType,
+                            int64Type,
+                            int64Type,
+                            int64Type);
+  this->readCycleCounter =
+      Intrinsic::getDeclaration(&M, Intrinsic::readcyclecounter);
+
+  /*
+   * Instrument all loops that have an ID.
+   */
+  auto modified = false;
+  for (auto &F : M) {
+    if (F.empty()) {
+      continue;
+    }
+    auto &LI = getAnalysis<LoopInfoWrapperPass>(F).getLoopInfo();
+    for (auto loop : LI.getLoopsInPreorder()) {
+      LoopStructure loopStructure{ loop };
+      auto loopID = loopStructure.getID();
+      if (!loopID) {
+        continue;
+      }
+      modified |= this->instrumentLoop(loop, loopID.value());
+    }
+  }
+
+  return modified;
+}
+
+bool LoopProfiler::instrumentLoop(Loop *loop, uint64_t loopID) {
+
+  /*
+   * We need a pre-header and dedicated exits to know where an invocation
+   * starts and ends.
+   */
+  auto preheader = loop->getLoopPreheader();
+  if ((preheader == nullptr) || (!loop->hasDedicatedExits())) {
+    errs() << "LoopProfiler: WARNING: loop " << loopID
+           << " is not in simplified form and it will not be profiled\n";
+    return false;
+  }
+  SmallVector<BasicBlock *, 4> exitBlocks;
+  loop->getUniqueExitBlocks(exitBlocks);
+
+  /*
+   * Allocate the counters of the loop invocation.
+   */
+  auto F = loop->getHeader()->getParent();
+  auto int64Type = Type::getInt64Ty(F->getContext());
+  IRBuilder<> entryBuilder(&*F->getEntryBlock().getFirstInsertionPt());
+  auto iterations = entryBuilder.CreateAlloca(int64Type);
+  auto startCycle = entryBuilder.CreateAlloca(int64Type);
+
+  /*
+   * Reset the counters when the loop is invoked.
+   */
+  IRBuilder<> preheaderBuilder(preheader->getTerminator());
+  preheaderBuilder.CreateStore(ConstantInt::get(int64Type, 0), iterations);
+  preheaderBuilder.CreateStore(
+      preheaderBuilder.CreateCall(this->readCycleCounter),
+      startCycle);
+
+  /*
+   * Count the iterations.
+   */
+  IRBuilder<> headerBuilder(&*loop->getHeader()->getFirstInsertionPt());
+  auto currentIterations = headerBuilder.CreateLoad(int64Type, iterations);
+  headerBuilder.CreateStore(
+      headerBuilder.CreateAdd(currentIterations,
+                              ConstantInt::get(int64Type, 1)),
+      iterations);
+
+  /*
+   * Record the invocation when the loop exits.
+   */
+  for (auto exitBB : exitBlocks) {
+    IRBuilder<> exitBuilder(&*exitBB->getFirstInsertionPt());
+    auto endCycle = exitBuilder.CreateCall(this->readCycleCounter);
+    auto startCycleValue = exitBuilder.CreateLoad(int64Type, startCycle);
+    auto cycles = exitBuilder.CreateSub(endCycle, startCycleValue);
+    exitBuilder.CreateCall(this->invocationEnded,
+                           { ConstantInt::get(int64Type, loopID),
+                             exitBuilder.CreateLoad(int64Type, iterations),
+                             cycles });
+  }
+
+  return true;
+}
+
+void LoopProfiler::getAnalysisUsage(AnalysisUsage &AU) const {
+  AU.addRequired<LoopInfoWrapperPass>();
+
+  return;
+}
+
+// Next there is code to register your pass to "opt"
+char LoopProfiler::ID = 0;
+static RegisterPass<LoopProfiler> X(
+    "LoopProfiler",
+    "Instrument loops to profile the distribution of their iterations");
+
+} // namespace arcana::noelle
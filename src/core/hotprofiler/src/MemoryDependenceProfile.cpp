@@ -0,0 +1,54 @@
+/*
+ * Copyright 2023  Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do
+ so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "noelle/core/MemoryDependenceProfile.hpp"
+
+namespace arcana::noelle {
+
+MemoryDependenceProfile::MemoryDependenceProfile(
+    uint64_t occurrences,
+    uint64_t minimumIterationDistance,
+    uint64_t maximumIterationDistance)
+  : occurrences{ occurrences },
+    minimumIterationDistance{ minimumIterationDistance },
+    maximumIterationDistance{ maximumIterationDistance } {
+  assert(minimumIterationDistance <= maximumIterationDistance);
+
+  return;
+}
+
+bool MemoryDependenceProfile::hasManifested(void) const {
+  return this->occurrences > 0;
+}
+
+uint64_t MemoryDependenceProfile::getOccurrences(void) const {
+  return this->occurrences;
+}
+
+uint64_t MemoryDependenceProfile::getMinimumIterationDistance(void) const {
+  return this->minimumIterationDistance;
+}
+
+uint64_t MemoryDependenceProfile::getMaximumIterationDistance(void) const {
+  return this->maximumIterationDistance;
+}
+
+} // namespace arcana::noelle
@@ -25,21 +25,89 @@
 using namespace llvm;
 using namespace arcana::noelle;
 
+/*
+ * Pass options.
+ */
+static cl::opt<std::string> ProfileStoreFileName(
+    "noelle-profile-store",
+    cl::ZeroOrMore,
+    cl::Hidden,
+    cl::desc("Load the profiles from the specified profile store"));
+static cl::opt<std::string> ProfileStoreOutputFileName(
+    "noelle-profile-store-output",
+    cl::ZeroOrMore,
+    cl::Hidden,
+    cl::desc("Save the profiles to the specified profile store"));
+static cl::opt<std::string> LoopProfileFileName(
+    "noelle-loop-profile",
+    cl::ZeroOrMore,
+    cl::Hidden,
+    cl::desc("Load the distributions of loop iterations generated by the loop "
+             "profiler"));
+static cl::opt<std::string> DependenceProfileFileName(
+    "noelle-dependence-profile",
+    cl::ZeroOrMore,
+    cl::Hidden,
+    cl::desc("Load the loop-carried memory dependences observed by the "
+             "dependence profiler"));
+
 HotProfiler::HotProfiler() : ModulePass(ID), hot{} {
 
   return;
 }
 
 bool HotProfiler::doInitialization(Module &M) {
+  this->profileStoreFileName = ProfileStoreFileName.getValue();
+  this->profileStoreOutputFileName = ProfileStoreOutputFileName.getValue();
+  this->loopProfileFileName = LoopProfileFileName.getValue();
+  this->dependenceProfileFileName = DependenceProfileFileName.getValue();
+
   return false;
 }
 
 bool HotProfiler::runOnModule(Module &M) {
 
+  /*
+   * Check if the profiles have been saved to a profile store.
+   * In this case, there is no need to analyze the profiles embedded in the IR.
+   */
+  auto profilesLoaded = false;
+  if (this->profileStoreFileName != "") {
+    auto store = std::make_shared<ProfileStore>(this->profileStoreFileName);
+    if (store->isValid()) {
+      this->hot.setProfileStore(store);
+      profilesLoaded = true;
+    }
+  }
+
   /*
    * Compute the profilers.
    */
-  this->analyzeProfiles(M);
+  if (!profilesLoaded) {
+    this->analyzeProfiles(M);
+  }
+
+  /*
+   * Load the distributions of loop iterations if they are available.
+   */
+  if (this->loopProfileFileName != "") {
+    this->loadLoopProfiles(this->loopProfileFileName);
+  }
+
+  /*
+   * Load the profiles of the loop-carried memory dependences if they are
+   * available.
+   */
+  if (this->dependenceProfileFileName != "") {
+    this->loadDependenceProfiles(M, this->dependenceProfileFileName);
+  }
+
+  /*
+   * Save the profiles if we have been asked to.
+   */
+  if (this->profileStoreOutputFileName != "") {
+    ProfileStore::write(this->profileStoreOutputFileName, M, this->hot);
+  }
 
   return false;
 }
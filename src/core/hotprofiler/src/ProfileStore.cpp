@@ -0,0 +1,270 @@
+/*
+ * Copyright 2023  Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do
+ so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "llvm/Support/FileSystem.h"
+#include "noelle/core/SystemHeaders.hpp"
+#include "noelle/core/ProfileStore.hpp"
+#include "noelle/core/Hot.hpp"
+
+namespace arcana::noelle {
+
+static const char profileStoreMagic[8] = { 'N', 'O', 'E', 'L',
+                                           'P', 'R', 'O', 'F' };
+
+ProfileStore::ProfileStore(std::string const &fileName)
+  : buffer{ nullptr },
+    header{ nullptr } {
+
+  /*
+   * Map the file.
+   * Large files are memory-mapped rather than read.
+   */
+  auto fileOrError = MemoryBuffer::getFile(fileName, -1, false);
+  if (auto ec = fileOrError.getError()) {
+    errs() << "ERROR: Couldn't open the profile store " << fileName << ": "
+           << ec.message() << "\n";
+    return;
+  }
+  this->buffer = std::move(fileOrError.get());
+
+  /*
+   * Check the header.
+   */
+  auto size = this->buffer->getBufferSize();
+  if (size < sizeof(Header)) {
+    errs() << "ERROR: The profile store " << fileName << " is truncated\n";
+    return;
+  }
+  auto h = reinterpret_cast<const Header *>(this->buffer->getBufferStart());
+  if (false || (std::memcmp(h->magic, profileStoreMagic, 8) != 0)
+      || (h->version != ProfileStore::version) || (h->fileSize != size)
+      || (h->functionsOffset > size) || (h->blocksOffset > size)
+      || (h->edgesOffset > size) || (h->callsOffset > size)
+      || (h->namesOffset > size)
+      || ((size - h->functionsOffset) / sizeof(FunctionEntry)
+          < h->numberOfFunctions)) {
+    errs() << "ERROR: " << fileName << " is not a valid profile store\n";
+    return;
+  }
+  this->header = h;
+
+  return;
+}
+
+bool ProfileStore::isValid(void) const {
+  return this->header != nullptr;
+}
+
+uint64_t ProfileStore::getModuleInstructionsExecuted(void) const {
+  assert(this->isValid());
+
+  return this->header->moduleInstructionsExecuted;
+}
+
+const ProfileStore::FunctionEntry *ProfileStore::getFunctionProfile(
+    Function &f) const {
+  assert(this->isValid());
+
+  /*
+   * Look up the function.
+   * Functions are sorted by name.
+   */
+  auto functions =
+      this->getArray<FunctionEntry>(this->header->functionsOffset);
+  auto end = functions + this->header->numberOfFunctions;
+  auto name = f.getName();
+  auto entry = std::lower_bound(
+      functions,
+      end,
+      name,
+      [this](const FunctionEntry &e, StringRef n) {
+        return this->getName(e) < n;
+      });
+  if ((entry == end) || (this->getName(*entry) != name)) {
+    return nullptr;
+  }
+
+  /*
+   * Check that the profile belongs to the current body of the function.
+   */
+  if (false || (entry->numberOfBlocks != f.size())
+      || (entry->numberOfInstructions != f.getInstructionCount())) {
+    return nullptr;
+  }
+
+  return entry;
+}
+
+ArrayRef<uint64_t> ProfileStore::getBlockInvocations(
+    const FunctionEntry &f) const {
+  auto blocks = this->getArray<uint64_t>(this->header->blocksOffset);
+
+  return ArrayRef<uint64_t>(blocks + f.firstBlock, f.numberOfBlocks);
+}
+
+ArrayRef<ProfileStore::EdgeEntry> ProfileStore::getEdges(
+    const FunctionEntry &f) const {
+  auto edges = this->getArray<EdgeEntry>(this->header->edgesOffset);
+
+  return ArrayRef<EdgeEntry>(edges + f.firstEdge, f.numberOfEdges);
+}
+
+ArrayRef<ProfileStore::CallEntry> ProfileStore::getCalls(
+    const FunctionEntry &f) const {
+  auto calls = this->getArray<CallEntry>(this->header->callsOffset);
+
+  return ArrayRef<CallEntry>(calls + f.firstCall, f.numberOfCalls);
+}
+
+template <class T>
+const T *ProfileStore::getArray(uint64_t offset) const {
+  return reinterpret_cast<const T *>(this->buffer->getBufferStart() + offset);
+}
+
+StringRef ProfileStore::getName(const FunctionEntry &f) const {
+  auto names = this->getArray<char>(this->header->namesOffset);
+
+  return StringRef(names + f.nameOffset, f.nameLength);
+}
+
+bool ProfileStore::write(std::string const &fileName, Module &M, Hot &hot) {
+
+  /*
+   * Fetch the functions with a body sorted by name.
+   */
+  std::vector<Function *> functions{};
+  for (auto &F : M) {
+    if (F.empty()) {
+      continue;
+    }
+    functions.push_back(&F);
+  }
+  std::sort(functions.begin(),
+            functions.end(),
+            [](Function *f1, Function *f2) {
+              return f1->getName() < f2->getName();
+            });
+
+  /*
+   * Serialize the profiles of the functions.
+   */
+  std::vector<FunctionEntry> functionEntries{};
+  std::vector<uint64_t> blocks{};
+  std::vector<EdgeEntry> edges{};
+  std::vector<CallEntry> calls{};
+  std::string names{};
+  for (auto f : functions) {
+    hot.loadProfileOf(f);
+
+    /*
+     * Describe the function.
+     */
+    FunctionEntry e{};
+    auto name = f->getName();
+    e.nameOffset = names.size();
+    e.nameLength = name.size();
+    names.append(name.begin(), name.end());
+    e.numberOfBlocks = f->size();
+    e.numberOfInstructions = f->getInstructionCount();
+    e.firstBlock = blocks.size();
+    e.firstEdge = edges.size();
+    e.firstCall = calls.size();
+    e.invocations = hot.getInvocations(f);
+    e.selfInstructions = hot.getSelfInstructions(f);
+    e.totalInstructions = hot.getTotalInstructions(f);
+
+    /*
+     * Serialize the basic blocks and their outgoing edges.
+     */
+    uint32_t bbIndex = 0;
+    uint32_t instIndex = 0;
+    for (auto &bb : *f) {
+      blocks.push_back(hot.getInvocations(&bb));
+      auto branchSuccessors = hot.branchProbability.find(&bb);
+      if (branchSuccessors != hot.branchProbability.end()) {
+        uint32_t succIndex = 0;
+        for (auto succBB : successors(&bb)) {
+          auto frequency = branchSuccessors->second.find(succBB);
+          if (frequency != branchSuccessors->second.end()) {
+            edges.push_back({ bbIndex, succIndex, frequency->second });
+          }
+          succIndex++;
+        }
+      }
+
+      /*
+       * Serialize the total instructions of call instructions.
+       */
+      for (auto &inst : bb) {
+        if (hot.instructionTotalInstructions.contains(&inst)) {
+          calls.push_back(
+              { instIndex, 0, hot.instructionTotalInstructions.at(&inst) });
+        }
+        instIndex++;
+      }
+      bbIndex++;
+    }
+    e.numberOfEdges = edges.size() - e.firstEdge;
+    e.numberOfCalls = calls.size() - e.firstCall;
+    functionEntries.push_back(e);
+  }
+
+  /*
+   * Lay out the file.
+   */
+  Header h{};
+  std::memcpy(h.magic, profileStoreMagic, 8);
+  h.version = ProfileStore::version;
+  h.numberOfFunctions = functionEntries.size();
+  h.moduleInstructionsExecuted = hot.getSelfInstructions();
+  h.functionsOffset = sizeof(Header);
+  h.blocksOffset =
+      h.functionsOffset + functionEntries.size() * sizeof(FunctionEntry);
+  h.edgesOffset = h.blocksOffset + blocks.size() * sizeof(uint64_t);
+  h.callsOffset = h.edgesOffset + edges.size() * sizeof(EdgeEntry);
+  h.namesOffset = h.callsOffset + calls.size() * sizeof(CallEntry);
+  h.fileSize = h.namesOffset + names.size();
+
+  /*
+   * Write the file.
+   */
+  std::error_code ec;
+  raw_fd_ostream file(fileName, ec, sys::fs::OF_None);
+  if (ec) {
+    errs() << "ERROR: Couldn't open the profile store " << fileName << ": "
+           << ec.message() << "\n";
+    return false;
+  }
+  auto writeArray = [&file](const void *data, size_t size) {
+    file.write(reinterpret_cast<const char *>(data), size);
+  };
+  writeArray(&h, sizeof(Header));
+  writeArray(functionEntries.data(),
+             functionEntries.size() * sizeof(FunctionEntry));
+  writeArray(blocks.data(), blocks.size() * sizeof(uint64_t));
+  writeArray(edges.data(), edges.size() * sizeof(EdgeEntry));
+  writeArray(calls.data(), calls.size() * sizeof(CallEntry));
+  writeArray(names.data(), names.size());
+
+  return true;
+}
+
+} // namespace arcana::noelle
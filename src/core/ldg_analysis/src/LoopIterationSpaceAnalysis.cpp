@@ -235,7 +235,7 @@ void LoopIterationSpaceAnalysis::computeMemoryAccessSpace(ScalarEvolution &SE) {
   assert(this->loops != nullptr);
   auto targetLoop = this->loops->getLoop();
 
-  for (auto B : targetLoop->getBasicBlocks()) {
+  for (auto B : targetLoop->blocks()) {
     for (auto &I : *B) {
 
       /*
@@ -27,6 +27,26 @@
 
 namespace arcana::noelle {
 
+/*
+ * A parallel version of a loop that has been generated within the function
+ * that includes the original loop.
+ * The ID of a version must be greater than zero (0 is the original loop).
+ * The guard is the condition that must hold to run the version (nullptr if it
+ * can always run).
+ * The fixed cores are the cores the version always uses (0 if the number of
+ * cores can be chosen at runtime).
+ */
+struct TransformedLoopVersion {
+  uint32_t versionID;
+  BasicBlock *startOfParLoopInOriginalFunc;
+  BasicBlock *endOfParLoopInOriginalFunc;
+  Value *envArray;
+  Value *envIndexForExitVariable;
+  uint32_t minIdleCores;
+  uint32_t fixedCores;
+  Value *guard;
+};
+
 class Linker {
 public:
   Linker(Module &m, TypesManager *tm);
@@ -40,6 +60,35 @@ public:
       std::vector<BasicBlock *> &loopExitBlocks,
       uint32_t minIdleCores);
 
+  /*
+   * Link the parallelized loop to the original function.
+   * The parallelized loop runs only if the guard holds and there are enough
+   * idle cores; the original loop runs otherwise.
+   */
+  void linkTransformedLoopToOriginalFunction(
+      BasicBlock *originalPreHeader,
+      BasicBlock *startOfParLoopInOriginalFunc,
+      BasicBlock *endOfParLoopInOriginalFunc,
+      Value *envArray,
+      Value *envIndexForExitVariable,
+      std::vector<BasicBlock *> &loopExitBlocks,
+      uint32_t minIdleCores,
+      Value *guard);
+
+  /*
+   * Link several versions of the same loop to the original function.
+   * The version to run is selected at runtime by invoking
+   * NOELLE_selectLoopVersion.
+   * The original loop is the version executed when no parallel version is
+   * selected or when the guard of the selected version does not hold.
+   */
+  void linkTransformedLoopVersionsToOriginalFunction(
+      BasicBlock *originalPreHeader,
+      uint64_t loopID,
+      uint32_t defaultVersion,
+      std::vector<TransformedLoopVersion> const &versions,
+      std::vector<BasicBlock *> &loopExitBlocks);
+
   void substituteOriginalLoopWithTransformedLoop(
       LoopStructure *originalLoop,
       BasicBlock *startOfParLoopInOriginalFunc,
@@ -52,6 +101,13 @@ public:
 private:
   Module &program;
   TypesManager *tm;
+
+  void linkEndOfTransformedLoopToLoopExits(
+      BasicBlock *originalHeader,
+      BasicBlock *endOfParLoopInOriginalFunc,
+      Value *envArray,
+      Value *envIndexForExitVariable,
+      std::vector<BasicBlock *> &loopExitBlocks);
 };
 
 } // namespace arcana::noelle
@@ -37,6 +37,27 @@ void Linker::linkTransformedLoopToOriginalFunction(
     Value *envIndexForExitVariable,
     std::vector<BasicBlock *> &loopExitBlocks,
     uint32_t minIdleCores) {
+  this->linkTransformedLoopToOriginalFunction(originalPreHeader,
+                                              startOfParLoopInOriginalFunc,
+                                              endOfParLoopInOriginalFunc,
+                                              envArray,
+                                              envIndexForExitVariable,
+                                              loopExitBlocks,
+                                              minIdleCores,
+                                              nullptr);
+
+  return;
+}
+
+void Linker::linkTransformedLoopToOriginalFunction(
+    BasicBlock *originalPreHeader,
+    BasicBlock *startOfParLoopInOriginalFunc,
+    BasicBlock *endOfParLoopInOriginalFunc,
+    Value *envArray,
+    Value *envIndexForExitVariable,
+    std::vector<BasicBlock *> &loopExitBlocks,
+    uint32_t minIdleCores,
+    Value *guard) {
 
   /*
    * Fetch the runtime API to invoke.
@@ -66,17 +87,183 @@ void Linker::linkTransformedLoopToOriginalFunction(
   IRBuilder<> loopSwitchBuilder(originalTerminator);
   auto callToCoreChecker =
       loopSwitchBuilder.CreateCall(coreChecker->getFunctionType(), coreChecker);
-  auto compareInstruction =
+  Value *compareInstruction =
       loopSwitchBuilder.CreateICmpUGE(callToCoreChecker, minIdleCoresValue);
+
+  /*
+   * Check if the guard of the parallelized loop holds.
+   */
+  if (guard != nullptr) {
+    compareInstruction =
+        loopSwitchBuilder.CreateAnd(guard, compareInstruction);
+  }
   loopSwitchBuilder.CreateCondBr(compareInstruction,
                                  startOfParLoopInOriginalFunc,
                                  originalHeader);
   originalTerminator->eraseFromParent();
 
+  /*
+   * Link the end of the parallelized loop to the loop exit blocks.
+   */
+  this->linkEndOfTransformedLoopToLoopExits(originalHeader,
+                                            endOfParLoopInOriginalFunc,
+                                            envArray,
+                                            envIndexForExitVariable,
+                                            loopExitBlocks);
+
+  return;
+}
+
+void Linker::linkTransformedLoopVersionsToOriginalFunction(
+    BasicBlock *originalPreHeader,
+    uint64_t loopID,
+    uint32_t defaultVersion,
+    std::vector<TransformedLoopVersion> const &versions,
+    std::vector<BasicBlock *> &loopExitBlocks) {
+  assert(versions.size() > 0);
+
+  /*
+   * Fetch the runtime APIs to invoke.
+   */
+  auto coreChecker = this->program.getFunction("NOELLE_getAvailableCores");
+  assert(coreChecker != nullptr);
+  auto versionSelector = this->program.getFunction("NOELLE_selectLoopVersion");
+  assert(versionSelector != nullptr);
+
+  /*
+   * Compute the set of versions available.
+   */
+  auto integerType = this->tm->getIntegerType(32);
+  uint32_t availableVersions = 0;
+  uint32_t maxVersionID = 0;
+  for (auto &version : versions) {
+    assert(version.versionID > 0);
+    assert(version.versionID < 32);
+    availableVersions |= (1 << version.versionID);
+    maxVersionID = std::max(maxVersionID, version.versionID);
+  }
+
+  /*
+   * Allocate the constant array that stores the cores every version always
+   * uses.
+   * The runtime uses it to avoid selecting a version that needs more cores
+   * than the ones configured for the loop.
+   */
+  std::vector<uint32_t> fixedCores(maxVersionID + 1, 0);
+  for (auto &version : versions) {
+    fixedCores[version.versionID] = version.fixedCores;
+  }
+  auto fixedCoresInitializer =
+      ConstantDataArray::get(this->program.getContext(), fixedCores);
+  auto fixedCoresArray =
+      new GlobalVariable(this->program,
+                         fixedCoresInitializer->getType(),
+                         true,
+                         GlobalValue::PrivateLinkage,
+                         fixedCoresInitializer,
+                         "NOELLE_fixedCoresOfLoopVersions");
+
+  /*
+   * Fetch the terminator of the preheader.
+   */
+  auto originalTerminator = originalPreHeader->getTerminator();
+
+  /*
+   * Fetch the header of the original loop.
+   */
+  auto originalHeader = originalTerminator->getSuccessor(0);
+
+  /*
+   * Ask the runtime which version to run.
+   */
+  IRBuilder<> loopSwitchBuilder(originalTerminator);
+  auto fixedCoresPtr = loopSwitchBuilder.CreateConstInBoundsGEP2_32(
+      fixedCoresInitializer->getType(),
+      fixedCoresArray,
+      0,
+      0);
+  auto selectedVersion = loopSwitchBuilder.CreateCall(
+      versionSelector,
+      ArrayRef<Value *>(
+          { ConstantInt::get(this->tm->getIntegerType(64), loopID),
+            ConstantInt::get(integerType, defaultVersion),
+            ConstantInt::get(integerType, availableVersions),
+            fixedCoresPtr }));
+
+  /*
+   * Check if there are enough idle cores to run the version selected and if
+   * its guard holds.
+   * If not, then the sequential version runs.
+   */
+  Value *minIdleCores = ConstantInt::get(integerType, 0);
+  Value *guardHolds = loopSwitchBuilder.getTrue();
+  for (auto &version : versions) {
+    auto isSelected = loopSwitchBuilder.CreateICmpEQ(
+        selectedVersion,
+        ConstantInt::get(integerType, version.versionID));
+    minIdleCores = loopSwitchBuilder.CreateSelect(
+        isSelected,
+        ConstantInt::get(integerType, version.minIdleCores),
+        minIdleCores);
+    if (version.guard != nullptr) {
+      guardHolds =
+          loopSwitchBuilder.CreateSelect(isSelected, version.guard, guardHolds);
+    }
+  }
+  auto callToCoreChecker =
+      loopSwitchBuilder.CreateCall(coreChecker->getFunctionType(), coreChecker);
+  auto enoughCores =
+      loopSwitchBuilder.CreateICmpUGE(callToCoreChecker, minIdleCores);
+  auto canRunSelectedVersion =
+      loopSwitchBuilder.CreateAnd(enoughCores, guardHolds);
+  auto versionToRun =
+      loopSwitchBuilder.CreateSelect(canRunSelectedVersion,
+                                     selectedVersion,
+                                     ConstantInt::get(integerType, 0));
+
+  /*
+   * Jump to the version to run.
+   * The sequential version is the original loop.
+   */
+  auto versionSwitch =
+      loopSwitchBuilder.CreateSwitch(versionToRun,
+                                     originalHeader,
+                                     versions.size());
+  for (auto &version : versions) {
+    auto versionIDValue =
+        cast<ConstantInt>(ConstantInt::get(integerType, version.versionID));
+    versionSwitch->addCase(versionIDValue,
+                           version.startOfParLoopInOriginalFunc);
+  }
+  originalTerminator->eraseFromParent();
+
+  /*
+   * Link the end of every version to the loop exit blocks.
+   */
+  for (auto &version : versions) {
+    this->linkEndOfTransformedLoopToLoopExits(
+        originalHeader,
+        version.endOfParLoopInOriginalFunc,
+        version.envArray,
+        version.envIndexForExitVariable,
+        loopExitBlocks);
+  }
+
+  return;
+}
+
+void Linker::linkEndOfTransformedLoopToLoopExits(
+    BasicBlock *originalHeader,
+    BasicBlock *endOfParLoopInOriginalFunc,
+    Value *envArray,
+    Value *envIndexForExitVariable,
+    std::vector<BasicBlock *> &loopExitBlocks) {
+
   /*
    * Load exit block environment variable and branch to the correct loop exit
    * block
    */
+  auto integerType = this->tm->getIntegerType(32);
   IRBuilder<> endBuilder(endOfParLoopInOriginalFunc);
   if (loopExitBlocks.size() == 1) {
     endBuilder.CreateBr(loopExitBlocks[0]);
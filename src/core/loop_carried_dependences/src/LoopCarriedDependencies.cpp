@@ -246,8 +246,7 @@ std::set<DGEdge<Value, Value> *> LoopCarriedDependencies::
 
   std::set<DGEdge<Value, Value> *> LCEdges;
 
-  for (auto sccNode : sccdag.getNodes()) {
-    auto scc = sccNode->getT();
+  for (auto scc : sccdag.sccs()) {
     for (auto edge : scc->getEdges()) {
       if (!edge->isLoopCarriedDependence()) {
         continue;
@@ -0,0 +1,74 @@
+/*
+ * Copyright 2023  Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do
+ so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#pragma once
+
+#include "noelle/core/SystemHeaders.hpp"
+#include "noelle/core/LoopDependenceInfo.hpp"
+
+namespace arcana::noelle {
+
+class LoopCollapser {
+public:
+  /*
+   * Constructor
+   */
+  LoopCollapser();
+
+  /*
+   * Collapse a loop and its only sub-loop into a single loop that iterates over
+   * the linearized iteration space of the nest.
+   *
+   * The nest must be perfect: the outer loop can only compute its own IV and
+   * values that do not depend on memory.
+   * Both loops must be governed by an IV and the number of iterations of the
+   * sub-loop cannot depend on the outer loop.
+   */
+  bool collapseLoopNest(LoopDependenceInfo const &outerLoop,
+                        LoopDependenceInfo const &innerLoop,
+                        LoopInfo &LI,
+                        ScalarEvolution &SE);
+
+private:
+  /*
+   * Fields
+   */
+  std::string outputPrefix;
+
+  /*
+   * Methods
+   */
+  bool isPerfectlyNested(LoopStructure *outerLoop,
+                         LoopStructure *innerLoop,
+                         PHINode *outerIV,
+                         PHINode *innerIV,
+                         std::vector<Instruction *> &instructionsToClone) const;
+
+  bool canBeCloned(Instruction *inst,
+                   LoopStructure *outerLoop,
+                   LoopStructure *innerLoop,
+                   PHINode *outerIV,
+                   PHINode *innerIV,
+                   std::set<Instruction *> &visited,
+                   std::vector<Instruction *> &instructionsToClone) const;
+};
+
+} // namespace arcana::noelle
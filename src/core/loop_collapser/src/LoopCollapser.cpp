@@ -0,0 +1,496 @@
+/*
+ * Copyright 2023  Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do
+ so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "llvm/Analysis/ScalarEvolutionExpander.h"
+#include "llvm/Analysis/ValueTracking.h"
+#include "llvm/Transforms/Utils/Local.h"
+#include "noelle/core/LoopCollapser.hpp"
+
+namespace arcana::noelle {
+
+LoopCollapser::LoopCollapser() : outputPrefix{ "LoopCollapser: " } {
+  return;
+}
+
+bool LoopCollapser::collapseLoopNest(LoopDependenceInfo const &outerLoop,
+                                     LoopDependenceInfo const &innerLoop,
+                                     LoopInfo &LI,
+                                     ScalarEvolution &SE) {
+
+  /*
+   * Fetch the loops.
+   */
+  auto outerLS = outerLoop.getLoopStructure();
+  auto innerLS = innerLoop.getLoopStructure();
+  auto outerHeader = outerLS->getHeader();
+  auto innerHeader = innerLS->getHeader();
+  auto outerPreHeader = outerLS->getPreHeader();
+  if ((!outerLS->isIncluded(innerHeader))
+      || (innerLS->getNestingLevel() != (outerLS->getNestingLevel() + 1))) {
+    return false;
+  }
+
+  /*
+   * Both loops must be governed by an IV.
+   */
+  auto outerIVM = outerLoop.getInductionVariableManager();
+  auto innerIVM = innerLoop.getInductionVariableManager();
+  auto outerGIV = outerIVM->getLoopGoverningInductionVariable();
+  auto innerGIV = innerIVM->getLoopGoverningInductionVariable();
+  if ((outerGIV == nullptr) || (innerGIV == nullptr)) {
+    return false;
+  }
+  auto outerIV = outerGIV->getInductionVariable()->getLoopEntryPHI();
+  auto innerIV = innerGIV->getInductionVariable()->getLoopEntryPHI();
+  if ((!outerIV->getType()->isIntegerTy())
+      || (!innerIV->getType()->isIntegerTy())) {
+    return false;
+  }
+
+  /*
+   * Both loops must have a single latch and they must exit only from their
+   * header.
+   */
+  for (auto ls : { outerLS, innerLS }) {
+    if ((ls->getLatches().size() != 1)
+        || (ls->numberOfExitBasicBlocks() != 1)) {
+      return false;
+    }
+    for (auto exitEdge : ls->getLoopExitEdges()) {
+      if (exitEdge.first != ls->getHeader()) {
+        return false;
+      }
+    }
+  }
+  if ((outerHeader->getTerminator() != outerGIV->getHeaderBrInst())
+      || (innerHeader->getTerminator() != innerGIV->getHeaderBrInst())
+      || (outerPreHeader->getTerminator()->getNumSuccessors() != 1)) {
+    return false;
+  }
+
+  /*
+   * Fetch the successors of the headers.
+   */
+  BasicBlock *outerExit = nullptr;
+  for (auto succ : successors(outerHeader)) {
+    if (!outerLS->isIncluded(succ)) {
+      outerExit = succ;
+    }
+  }
+  BasicBlock *innerBodyEntry = nullptr;
+  for (auto succ : successors(innerHeader)) {
+    if (innerLS->isIncluded(succ)) {
+      if (innerBodyEntry != nullptr) {
+        return false;
+      }
+      innerBodyEntry = succ;
+    }
+  }
+  if ((outerExit == nullptr) || (innerBodyEntry == nullptr)
+      || (innerBodyEntry == innerHeader)) {
+    return false;
+  }
+
+  /*
+   * Fetch the LLVM loops.
+   */
+  auto outerLLVMLoop = LI.getLoopFor(outerHeader);
+  auto innerLLVMLoop = LI.getLoopFor(innerHeader);
+  if ((outerLLVMLoop == nullptr) || (innerLLVMLoop == nullptr)
+      || (innerLLVMLoop->getParentLoop() != outerLLVMLoop)) {
+    return false;
+  }
+
+  /*
+   * The IVs must evolve linearly and the sub-loop must always start from the
+   * same value with the same step.
+   */
+  auto outerIVSCEV = dyn_cast<SCEVAddRecExpr>(SE.getSCEV(outerIV));
+  auto innerIVSCEV = dyn_cast<SCEVAddRecExpr>(SE.getSCEV(innerIV));
+  if ((outerIVSCEV == nullptr) || (innerIVSCEV == nullptr)
+      || (outerIVSCEV->getLoop() != outerLLVMLoop)
+      || (innerIVSCEV->getLoop() != innerLLVMLoop)
+      || (!outerIVSCEV->isAffine()) || (!innerIVSCEV->isAffine())) {
+    return false;
+  }
+  auto outerStartSCEV = outerIVSCEV->getStart();
+  auto outerStepSCEV = outerIVSCEV->getStepRecurrence(SE);
+  auto innerStartSCEV = innerIVSCEV->getStart();
+  auto innerStepSCEV = innerIVSCEV->getStepRecurrence(SE);
+  if ((!SE.isLoopInvariant(innerStartSCEV, outerLLVMLoop))
+      || (!SE.isLoopInvariant(innerStepSCEV, outerLLVMLoop))) {
+    return false;
+  }
+
+  /*
+   * The number of iterations of both loops must be computable before the nest
+   * starts.
+   * Since both loops exit only from their header, the number of iterations of
+   * their body is the number of times their back-edge is taken.
+   */
+  auto outerIterationsSCEV = SE.getBackedgeTakenCount(outerLLVMLoop);
+  auto innerIterationsSCEV = SE.getBackedgeTakenCount(innerLLVMLoop);
+  if (isa<SCEVCouldNotCompute>(outerIterationsSCEV)
+      || isa<SCEVCouldNotCompute>(innerIterationsSCEV)
+      || (!SE.isLoopInvariant(innerIterationsSCEV, outerLLVMLoop))
+      || (SE.getTypeSizeInBits(outerIterationsSCEV->getType()) > 64)
+      || (SE.getTypeSizeInBits(innerIterationsSCEV->getType()) > 64)) {
+    return false;
+  }
+  auto preHeaderTerminator = outerPreHeader->getTerminator();
+  for (auto s : { outerStartSCEV,
+                  outerStepSCEV,
+                  innerStartSCEV,
+                  innerStepSCEV,
+                  outerIterationsSCEV,
+                  innerIterationsSCEV }) {
+    if (!isSafeToExpandAt(s, preHeaderTerminator, SE)) {
+      return false;
+    }
+  }
+
+  /*
+   * The nest must be perfect.
+   */
+  std::vector<Instruction *> instructionsToClone;
+  if (!this->isPerfectlyNested(outerLS,
+                               innerLS,
+                               outerIV,
+                               innerIV,
+                               instructionsToClone)) {
+    return false;
+  }
+  errs() << this->outputPrefix << "Collapse the loop nest with header "
+         << outerHeader->getName() << "\n";
+
+  /*
+   * Compute the number of iterations of the collapsed loop, and the start and
+   * the step of both IVs, in the pre-header of the outer loop.
+   */
+  auto F = outerLS->getFunction();
+  auto &cxt = F->getContext();
+  auto int64 = IntegerType::get(cxt, 64);
+  auto &DL = F->getParent()->getDataLayout();
+  SCEVExpander expander(SE, DL, "collapse");
+  auto outerIterations =
+      expander.expandCodeFor(SE.getNoopOrZeroExtend(outerIterationsSCEV, int64),
+                             int64,
+                             preHeaderTerminator);
+  auto innerIterations =
+      expander.expandCodeFor(SE.getNoopOrZeroExtend(innerIterationsSCEV, int64),
+                             int64,
+                             preHeaderTerminator);
+  auto outerStart = expander.expandCodeFor(outerStartSCEV,
+                                           outerIV->getType(),
+                                           preHeaderTerminator);
+  auto outerStep = expander.expandCodeFor(outerStepSCEV,
+                                          outerIV->getType(),
+                                          preHeaderTerminator);
+  auto innerStart = expander.expandCodeFor(innerStartSCEV,
+                                           innerIV->getType(),
+                                           preHeaderTerminator);
+  auto innerStep = expander.expandCodeFor(innerStepSCEV,
+                                          innerIV->getType(),
+                                          preHeaderTerminator);
+  IRBuilder<> preHeaderBuilder(preHeaderTerminator);
+  auto totalIterations =
+      preHeaderBuilder.CreateMul(outerIterations, innerIterations);
+
+  /*
+   * Fetch the instructions of the header of the sub-loop that will be replaced.
+   */
+  std::vector<Instruction *> oldInnerHeaderInstructions;
+  for (auto &inst : *innerHeader) {
+    if (inst.isTerminator()) {
+      continue;
+    }
+    oldInnerHeaderInstructions.push_back(&inst);
+  }
+  auto innerLatch = *innerLS->getLatches().begin();
+  auto innerIVUpdate = innerIV->getIncomingValueForBlock(innerLatch);
+
+  /*
+   * The header of the sub-loop becomes the header of the collapsed loop.
+   * Add the IV of the collapsed loop.
+   */
+  IRBuilder<> headerBuilder(&*innerHeader->begin());
+  auto iteration = headerBuilder.CreatePHI(int64, 2);
+  iteration->addIncoming(ConstantInt::get(int64, 0), outerPreHeader);
+  IRBuilder<> latchBuilder(innerLatch->getTerminator());
+  auto nextIteration =
+      latchBuilder.CreateAdd(iteration, ConstantInt::get(int64, 1));
+  iteration->addIncoming(nextIteration, innerLatch);
+
+  /*
+   * Compute the values of the original IVs at the beginning of the body of the
+   * collapsed loop.
+   * The values of the outer loop used by the body are computed there as well.
+   */
+  auto collapsedBody = BasicBlock::Create(cxt, "", F, innerBodyEntry);
+  IRBuilder<> bodyBuilder(collapsedBody);
+  auto outerIteration = bodyBuilder.CreateUDiv(iteration, innerIterations);
+  auto innerIteration = bodyBuilder.CreateURem(iteration, innerIterations);
+  auto newOuterIV = bodyBuilder.CreateAdd(
+      outerStart,
+      bodyBuilder.CreateMul(
+          bodyBuilder.CreateZExtOrTrunc(outerIteration, outerIV->getType()),
+          outerStep));
+  auto newInnerIV = bodyBuilder.CreateAdd(
+      innerStart,
+      bodyBuilder.CreateMul(
+          bodyBuilder.CreateZExtOrTrunc(innerIteration, innerIV->getType()),
+          innerStep));
+  std::unordered_map<Value *, Value *> clones;
+  clones[outerIV] = newOuterIV;
+  clones[innerIV] = newInnerIV;
+  for (auto inst : instructionsToClone) {
+    auto clone = inst->clone();
+    bodyBuilder.Insert(clone);
+    for (auto i = 0u; i < clone->getNumOperands(); i++) {
+      auto op = clone->getOperand(i);
+      if (clones.find(op) != clones.end()) {
+        clone->setOperand(i, clones.at(op));
+      }
+    }
+    clones[inst] = clone;
+  }
+  bodyBuilder.CreateBr(innerBodyEntry);
+  for (auto &phi : innerBodyEntry->phis()) {
+    auto index = phi.getBasicBlockIndex(innerHeader);
+    if (index >= 0) {
+      phi.setIncomingBlock(index, collapsedBody);
+    }
+  }
+
+  /*
+   * Redirect the uses within the body to the values just computed.
+   */
+  for (auto pair : clones) {
+    std::vector<Use *> usesToRedirect;
+    for (auto &use : pair.first->uses()) {
+      auto userBB = cast<Instruction>(use.getUser())->getParent();
+      if (innerLS->isIncluded(userBB) && (userBB != innerHeader)) {
+        usesToRedirect.push_back(&use);
+      }
+    }
+    for (auto use : usesToRedirect) {
+      use->set(pair.second);
+    }
+  }
+
+  /*
+   * The collapsed loop exits when all iterations of the nest have been
+   * executed.
+   */
+  auto oldInnerHeaderTerminator = innerHeader->getTerminator();
+  IRBuilder<> exitBuilder(oldInnerHeaderTerminator);
+  auto isInRange = exitBuilder.CreateICmpULT(iteration, totalIterations);
+  exitBuilder.CreateCondBr(isInRange, collapsedBody, outerExit);
+  oldInnerHeaderTerminator->eraseFromParent();
+  for (auto &phi : outerExit->phis()) {
+    auto index = phi.getBasicBlockIndex(outerHeader);
+    if (index >= 0) {
+      phi.setIncomingBlock(index, innerHeader);
+    }
+  }
+  cast<BranchInst>(preHeaderTerminator)->setSuccessor(0, innerHeader);
+
+  /*
+   * Remove the old instructions of the header of the sub-loop.
+   */
+  for (auto it = oldInnerHeaderInstructions.rbegin();
+       it != oldInnerHeaderInstructions.rend();
+       ++it) {
+    auto inst = *it;
+    inst->replaceAllUsesWith(UndefValue::get(inst->getType()));
+    inst->eraseFromParent();
+  }
+  RecursivelyDeleteTriviallyDeadInstructions(innerIVUpdate);
+
+  /*
+   * Remove the basic blocks that only belonged to the outer loop.
+   * They are no longer reachable.
+   */
+  std::vector<BasicBlock *> deadBlocks;
+  for (auto bb : outerLS->getBasicBlocks()) {
+    if (!innerLS->isIncluded(bb)) {
+      deadBlocks.push_back(bb);
+    }
+  }
+  for (auto bb : deadBlocks) {
+    for (auto &inst : *bb) {
+      inst.replaceAllUsesWith(UndefValue::get(inst.getType()));
+    }
+  }
+  for (auto bb : deadBlocks) {
+    bb->dropAllReferences();
+  }
+  for (auto bb : deadBlocks) {
+    bb->eraseFromParent();
+  }
+
+  return true;
+}
+
+bool LoopCollapser::isPerfectlyNested(
+    LoopStructure *outerLoop,
+    LoopStructure *innerLoop,
+    PHINode *outerIV,
+    PHINode *innerIV,
+    std::vector<Instruction *> &instructionsToClone) const {
+  auto innerHeader = innerLoop->getHeader();
+  auto outerHeader = outerLoop->getHeader();
+
+  /*
+   * The body of the nest is the sub-loop without its header.
+   * The code of the nest outside its body controls the iterations of the two
+   * loops and it is going to be removed.
+   */
+  auto isInBody = [innerLoop, innerHeader](BasicBlock *bb) -> bool {
+    return innerLoop->isIncluded(bb) && (bb != innerHeader);
+  };
+
+  std::set<Instruction *> visited;
+  for (auto bb : outerLoop->getBasicBlocks()) {
+    for (auto &inst : *bb) {
+
+      /*
+       * No value of the nest can be used after it.
+       */
+      for (auto user : inst.users()) {
+        auto userInst = dyn_cast<Instruction>(user);
+        if ((userInst == nullptr) || (!outerLoop->isIncluded(userInst))) {
+          return false;
+        }
+      }
+      if (isInBody(bb)) {
+        continue;
+      }
+
+      /*
+       * The control code must branch only to jump to the sub-loop or to exit
+       * the nest.
+       * This guarantees the sub-loop runs at every iteration of the outer loop.
+       */
+      if (inst.isTerminator()) {
+        if (!isa<BranchInst>(&inst)) {
+          return false;
+        }
+        if ((bb != outerHeader) && (bb != innerHeader)
+            && (inst.getNumSuccessors() != 1)) {
+          return false;
+        }
+        continue;
+      }
+
+      /*
+       * The control code cannot have side effects.
+       */
+      if (inst.mayHaveSideEffects()) {
+        return false;
+      }
+
+      /*
+       * The values computed by the control code and used by the body must be
+       * computable from the IVs.
+       */
+      for (auto user : inst.users()) {
+        auto userInst = cast<Instruction>(user);
+        if (!isInBody(userInst->getParent())) {
+          continue;
+        }
+        if (!this->canBeCloned(&inst,
+                               outerLoop,
+                               innerLoop,
+                               outerIV,
+                               innerIV,
+                               visited,
+                               instructionsToClone)) {
+          return false;
+        }
+      }
+    }
+  }
+
+  return true;
+}
+
+bool LoopCollapser::canBeCloned(
+    Instruction *inst,
+    LoopStructure *outerLoop,
+    LoopStructure *innerLoop,
+    PHINode *outerIV,
+    PHINode *innerIV,
+    std::set<Instruction *> &visited,
+    std::vector<Instruction *> &instructionsToClone) const {
+
+  /*
+   * The IVs are computed in the body of the collapsed loop.
+   */
+  if ((inst == outerIV) || (inst == innerIV)) {
+    return true;
+  }
+  if (visited.find(inst) != visited.end()) {
+    return true;
+  }
+
+  /*
+   * Only instructions that do not access memory and that can be executed
+   * speculatively can be cloned.
+   */
+  if (isa<PHINode>(inst) || inst->mayReadOrWriteMemory()
+      || (!isSafeToSpeculativelyExecute(inst))) {
+    return false;
+  }
+  visited.insert(inst);
+
+  /*
+   * Check the operands.
+   */
+  for (auto &op : inst->operands()) {
+    auto opInst = dyn_cast<Instruction>(op.get());
+    if ((opInst == nullptr) || (!outerLoop->isIncluded(opInst))) {
+      continue;
+    }
+    if (innerLoop->isIncluded(opInst)
+        && (opInst->getParent() != innerLoop->getHeader())) {
+      return false;
+    }
+    if (!this->canBeCloned(opInst,
+                           outerLoop,
+                           innerLoop,
+                           outerIV,
+                           innerIV,
+                           visited,
+                           instructionsToClone)) {
+      return false;
+    }
+  }
+
+  /*
+   * The operands are cloned before the instruction.
+   */
+  instructionsToClone.push_back(inst);
+
+  return true;
+}
+
+} // namespace arcana::noelle
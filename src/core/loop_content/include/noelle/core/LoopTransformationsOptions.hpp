@@ -38,6 +38,14 @@ public:
 
   uint32_t getChunkSize(void) const;
 
+  /*
+   * Number of consecutive iterations that a core executes between two
+   * synchronizations of HELIX (0: chosen from the profiles).
+   */
+  uint32_t getIterationBlockSize(void) const;
+
+  void setIterationBlockSize(uint32_t iterationBlockSize);
+
   uint32_t getMaximumNumberOfCores(void) const;
 
   /*
@@ -67,6 +75,7 @@ public:
 
 private:
   uint32_t chunkSize;
+  uint32_t iterationBlockSize;
   uint32_t maxCores;
   std::set<Transformation>
       enabledTransformations; /* Transformations enabled. */
@@ -425,8 +425,8 @@ std::pair<PDG *, SCCDAG *> LoopDependenceInfo::createDGsForLoop(
    * Perform loop-aware memory dependence analysis to refine the loop dependence
    * graph.
    */
-  auto domainSpace = LoopIterationSpaceAnalysis(loopNode, ivManager, SE);
   if (this->loopTransformationsManager->areLoopAwareAnalysesEnabled()) {
+    auto domainSpace = LoopIterationSpaceAnalysis(loopNode, ivManager, SE);
     refinePDGWithLoopAwareMemDepAnalysis(loopDG,
                                          l,
                                          loopStructure,
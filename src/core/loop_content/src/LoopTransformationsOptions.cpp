@@ -29,6 +29,7 @@ LoopTransformationsManager::LoopTransformationsManager(
     std::unordered_set<LoopDependenceInfoOptimization> optimizations,
     bool enableLoopAwareDependenceAnalyses)
   : chunkSize{ chunkSize },
+    iterationBlockSize{ 0 },
     maxCores{ maxNumberOfCores },
     enabledTransformations{},
     enabledOptimizations{ optimizations },
@@ -40,6 +41,7 @@ LoopTransformationsManager::LoopTransformationsManager(
 LoopTransformationsManager::LoopTransformationsManager(
     const LoopTransformationsManager &other) {
   this->chunkSize = other.chunkSize;
+  this->iterationBlockSize = other.iterationBlockSize;
   this->maxCores = other.maxCores;
   this->enabledTransformations = other.enabledTransformations;
   this->_areLoopAwareAnalysesEnabled = other._areLoopAwareAnalysesEnabled;
@@ -55,6 +57,17 @@ uint32_t LoopTransformationsManager::getChunkSize(void) const {
   return this->chunkSize;
 }
 
+uint32_t LoopTransformationsManager::getIterationBlockSize(void) const {
+  return this->iterationBlockSize;
+}
+
+void LoopTransformationsManager::setIterationBlockSize(
+    uint32_t iterationBlockSize) {
+  this->iterationBlockSize = iterationBlockSize;
+
+  return;
+}
+
 bool LoopTransformationsManager::isTransformationEnabled(
     Transformation transformation) {
   auto exist = this->enabledTransformations.find(transformation)
@@ -23,6 +23,9 @@
 
 #include "noelle/core/SystemHeaders.hpp"
 #include "noelle/core/BinaryReductionSCC.hpp"
+#include "noelle/core/MinMaxReductionSCC.hpp"
+#include "noelle/core/ArgMinMaxReductionSCC.hpp"
+#include "noelle/core/AssociativeCallReductionSCC.hpp"
 #include "noelle/core/LoopEnvironment.hpp"
 #include "noelle/core/LoopEnvironmentUser.hpp"
 
@@ -70,13 +73,13 @@ public:
   void generateEnvVariables(IRBuilder<> builder);
 
   /*
-   * Reduce live out variables given binary operators to reduce
-   * with and initial values to start at
+   * Reduce live out variables given the reductions that compute them
+   * and initial values to start at
    */
   BasicBlock *reduceLiveOutVariables(
       BasicBlock *bb,
       IRBuilder<> builder,
-      const std::unordered_map<uint32_t, BinaryReductionSCC *> &reductions,
+      const std::unordered_map<uint32_t, ReductionSCC *> &reductions,
       Value *numberOfThreadsExecuted,
       std::function<Value *(ReductionSCC *scc)> castingInitialValue);
 
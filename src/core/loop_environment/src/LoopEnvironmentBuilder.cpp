@@ -391,7 +391,7 @@ void LoopEnvironmentBuilder::generateEnvVariables(IRBuilder<> builder) {
 BasicBlock *LoopEnvironmentBuilder::reduceLiveOutVariables(
     BasicBlock *bb,
     IRBuilder<> builder,
-    const std::unordered_map<uint32_t, BinaryReductionSCC *> &reductions,
+    const std::unordered_map<uint32_t, ReductionSCC *> &reductions,
     Value *numberOfThreadsExecuted,
     std::function<Value *(ReductionSCC *scc)> castingInitialValue) {
   assert(bb != nullptr);
@@ -444,6 +444,7 @@ BasicBlock *LoopEnvironmentBuilder::reduceLiveOutVariables(
    * Add the PHI nodes about the current accumulated value
    */
   std::vector<PHINode *> phiNodes;
+  std::vector<ReductionSCC *> reductionsOfPHINodes;
   auto count = 0;
   for (auto envIDInitValue : reductions) {
     auto envID = envIDInitValue.first;
@@ -471,6 +472,7 @@ BasicBlock *LoopEnvironmentBuilder::reduceLiveOutVariables(
      * Keep track of the PHI node just created.
      */
     phiNodes.push_back(phiNode);
+    reductionsOfPHINodes.push_back(red);
   }
 
   /*
@@ -535,7 +537,6 @@ BasicBlock *LoopEnvironmentBuilder::reduceLiveOutVariables(
      * values.
      */
     auto red = reductions.at(envID);
-    auto binOp = red->getReductionOperation();
 
     /*
      * Fetch the accumulator, which is the PHI node related to the current
@@ -547,8 +548,51 @@ BasicBlock *LoopEnvironmentBuilder::reduceLiveOutVariables(
      * Accumulate values to the accumulator of the current reduced variable.
      */
     auto privateCurrentCopy = loadedValues[count];
-    auto newAccumulatorValue =
-        loopBodyBuilder.CreateBinOp(binOp, accumVal, privateCurrentCopy);
+    Value *newAccumulatorValue = nullptr;
+    if (auto binRed = dyn_cast<BinaryReductionSCC>(red)) {
+      auto binOp = binRed->getReductionOperation();
+      newAccumulatorValue =
+          loopBodyBuilder.CreateBinOp(binOp, accumVal, privateCurrentCopy);
+
+    } else if (auto minMaxRed = dyn_cast<MinMaxReductionSCC>(red)) {
+      newAccumulatorValue =
+          minMaxRed->generateCodeToCombine(loopBodyBuilder,
+                                           accumVal,
+                                           privateCurrentCopy);
+
+    } else if (auto callRed = dyn_cast<AssociativeCallReductionSCC>(red)) {
+      newAccumulatorValue =
+          callRed->generateCodeToCombine(loopBodyBuilder,
+                                         accumVal,
+                                         privateCurrentCopy);
+
+    } else {
+      auto argRed = cast<ArgMinMaxReductionSCC>(red);
+
+      /*
+       * Fetch the values of the min/max reduction that decides which
+       * iteration to keep.
+       * This min/max reduction is a live-out variable, so it is reduced as
+       * well.
+       */
+      auto minMaxPHI = argRed->getMinMaxAccumulator();
+      auto minMaxIndex = 0u;
+      while ((minMaxIndex < reductionsOfPHINodes.size())
+             && !reductionsOfPHINodes[minMaxIndex]->getSCC()->isInternal(
+                 minMaxPHI)) {
+        minMaxIndex++;
+      }
+      assert(minMaxIndex < reductionsOfPHINodes.size());
+      auto minMaxAccumVal = phiNodes[minMaxIndex];
+      auto minMaxInitialValue = minMaxAccumVal->getIncomingValueForBlock(bb);
+      newAccumulatorValue =
+          argRed->generateCodeToCombine(loopBodyBuilder,
+                                        accumVal,
+                                        privateCurrentCopy,
+                                        minMaxAccumVal,
+                                        loadedValues[minMaxIndex],
+                                        minMaxInitialValue);
+    }
 
     /*
      * Keep track of the new accumulator value.
@@ -31,6 +31,34 @@ class LoopForest;
 
 class LoopTree {
 public:
+  /*
+   * Pre-order iterator over the descendants of a node of the loop forest.
+   * It walks the tree through the parent links, so it does not need any
+   * auxiliary container.
+   */
+  class descendants_iterator
+    : public iterator_facade_base<descendants_iterator,
+                                  std::forward_iterator_tag,
+                                  LoopTree *,
+                                  std::ptrdiff_t,
+                                  LoopTree **,
+                                  LoopTree *> {
+  public:
+    descendants_iterator(const LoopTree *root, LoopTree *current);
+
+    bool operator==(const descendants_iterator &other) const;
+
+    LoopTree *operator*(void) const;
+
+    descendants_iterator &operator++(void);
+
+    using iterator_facade_base::operator++;
+
+  private:
+    const LoopTree *root;
+    LoopTree *current;
+  };
+
   LoopTree(LoopForest *f, LoopStructure *l);
 
   LoopTree(LoopForest *f, LoopStructure *l, LoopTree *parent);
@@ -55,6 +83,12 @@ public:
 
   std::unordered_set<LoopTree *> getDescendants(void);
 
+  /*
+   * Non-allocating view of the nodes that @getDescendants returns.
+   * The view is invalidated when the sub-tree changes.
+   */
+  iterator_range<descendants_iterator> descendants(void) const;
+
   bool isIncludedInItsSubLoops(Instruction *inst) const;
 
   /*
@@ -201,6 +201,67 @@ std::unordered_set<LoopTree *> LoopTree::getDescendants(void) {
   return s;
 }
 
+iterator_range<LoopTree::descendants_iterator> LoopTree::descendants(
+    void) const {
+  LoopTree *first = nullptr;
+  if (this->children.size() > 0) {
+    first = *this->children.begin();
+  }
+  descendants_iterator b(this, first);
+  descendants_iterator e(this, nullptr);
+
+  return make_range(b, e);
+}
+
+LoopTree::descendants_iterator::descendants_iterator(const LoopTree *root,
+                                                     LoopTree *current)
+  : root{ root },
+    current{ current } {
+  return;
+}
+
+bool LoopTree::descendants_iterator::operator==(
+    const descendants_iterator &other) const {
+  return this->current == other.current;
+}
+
+LoopTree *LoopTree::descendants_iterator::operator*(void) const {
+  return this->current;
+}
+
+LoopTree::descendants_iterator &LoopTree::descendants_iterator::operator++(
+    void) {
+
+  /*
+   * Go down to the first child, if any.
+   */
+  if (this->current->children.size() > 0) {
+    this->current = *this->current->children.begin();
+    return *this;
+  }
+
+  /*
+   * Go up until we find a node with a sibling that follows it.
+   * We stop once we go back to the root.
+   */
+  auto n = this->current;
+  while (true) {
+    auto &siblings = n->parent->children;
+    auto nextSibling = std::next(siblings.find(n));
+    if (nextSibling != siblings.end()) {
+      this->current = *nextSibling;
+      break;
+    }
+    if (n->parent == this->root) {
+      this->current = nullptr;
+      break;
+    }
+    n = n->parent;
+  }
+
+  return *this;
+}
+
 std::unordered_set<LoopTree *> LoopTree::getChildren(void) const {
   return this->children;
 }
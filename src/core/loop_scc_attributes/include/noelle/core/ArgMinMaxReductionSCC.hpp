@@ -0,0 +1,79 @@
+/*
+ * Copyright 2023  Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do
+ so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#pragma once
+
+#include "noelle/core/SystemHeaders.hpp"
+#include "noelle/core/ReductionSCC.hpp"
+
+namespace arcana::noelle {
+
+/*
+ * A variable that keeps the iteration where the minimum (or the maximum) of a
+ * min/max reduction has been found first. For example:
+ *    for (...){
+ *      if (a[i] < m) {
+ *        m = a[i];
+ *        index = i;
+ *      }
+ *    }
+ */
+class ArgMinMaxReductionSCC : public ReductionSCC {
+public:
+  ArgMinMaxReductionSCC(
+      SCC *s,
+      LoopStructure *loop,
+      const std::set<DGEdge<Value, Value> *> &loopCarriedDependences,
+      Value *initialValue,
+      PHINode *accumulator,
+      PHINode *minMaxAccumulator,
+      CmpInst::Predicate minMaxPredicate,
+      CmpInst::Predicate iterationOrderPredicate);
+
+  ArgMinMaxReductionSCC() = delete;
+
+  /*
+   * Return the PHI of the min/max reduction that decides the value of this
+   * variable.
+   */
+  PHINode *getMinMaxAccumulator(void) const;
+
+  /*
+   * Combine the private copy of a thread with the value accumulated so far.
+   * The values of the related min/max reduction are needed to pick the
+   * earliest iteration among those that found the same minimum (maximum).
+   */
+  Value *generateCodeToCombine(IRBuilder<> &builder,
+                               Value *accumulatedValue,
+                               Value *privateCopy,
+                               Value *accumulatedMinMax,
+                               Value *privateMinMax,
+                               Value *initialMinMax) const;
+
+  static bool classof(const GenericSCC *s);
+
+protected:
+  PHINode *minMaxAccumulator;
+  CmpInst::Predicate minMaxPredicate;
+  CmpInst::Predicate iterationOrderPredicate;
+};
+
+} // namespace arcana::noelle
@@ -0,0 +1,61 @@
+/*
+ * Copyright 2023  Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do
+ so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#pragma once
+
+#include "noelle/core/SystemHeaders.hpp"
+#include "noelle/core/ReductionSCC.hpp"
+
+namespace arcana::noelle {
+
+/*
+ * A variable updated by calling a pure function that is associative and
+ * commutative. For example:
+ *    for (...){
+ *      m = fmax(m, a[i]);
+ *    }
+ */
+class AssociativeCallReductionSCC : public ReductionSCC {
+public:
+  AssociativeCallReductionSCC(
+      SCC *s,
+      LoopStructure *loop,
+      const std::set<DGEdge<Value, Value> *> &loopCarriedDependences,
+      Value *initialValue,
+      PHINode *accumulator,
+      Function *reductionFunction,
+      Value *identity);
+
+  AssociativeCallReductionSCC() = delete;
+
+  Function *getReductionFunction(void) const;
+
+  Value *generateCodeToCombine(IRBuilder<> &builder,
+                               Value *accumulatedValue,
+                               Value *privateCopy) const;
+
+  static bool classof(const GenericSCC *s);
+
+protected:
+  Function *reductionFunction;
+};
+
+} // namespace arcana::noelle
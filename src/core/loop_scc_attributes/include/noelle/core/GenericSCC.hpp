@@ -42,6 +42,9 @@ public:
 
     REDUCTION,
     BINARY_REDUCTION,
+    MINMAX_REDUCTION,
+    ARGMINMAX_REDUCTION,
+    ASSOCIATIVE_CALL_REDUCTION,
     LAST_REDUCTION,
 
     RECOMPUTABLE,
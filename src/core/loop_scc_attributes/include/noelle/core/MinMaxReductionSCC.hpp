@@ -0,0 +1,84 @@
+/*
+ * Copyright 2023  Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do
+ so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#pragma once
+
+#include "noelle/core/SystemHeaders.hpp"
+#include "noelle/core/ReductionSCC.hpp"
+
+namespace arcana::noelle {
+
+/*
+ * A variable that keeps the minimum (or the maximum) of the values it is
+ * compared with. For example:
+ *    for (...){
+ *      if (a[i] < m) m = a[i];
+ *    }
+ */
+class MinMaxReductionSCC : public ReductionSCC {
+public:
+  MinMaxReductionSCC(
+      SCC *s,
+      LoopStructure *loop,
+      const std::set<DGEdge<Value, Value> *> &loopCarriedDependences,
+      Value *initialValue,
+      PHINode *accumulator,
+      CmpInst *comparison,
+      CmpInst::Predicate predicate);
+
+  MinMaxReductionSCC() = delete;
+
+  /*
+   * Return the comparison that decides whether a new value replaces the one
+   * accumulated so far.
+   */
+  CmpInst *getComparison(void) const;
+
+  /*
+   * Return the predicate P such that a new value v replaces the accumulated
+   * value a when "v P a" holds.
+   */
+  CmpInst::Predicate getPredicate(void) const;
+
+  /*
+   * Return the strict version of the predicate returned by "getPredicate".
+   */
+  CmpInst::Predicate getStrictPredicate(void) const;
+
+  bool isMinimum(void) const;
+
+  /*
+   * Return true if values equal to the accumulated one do not replace it.
+   */
+  bool isStrict(void) const;
+
+  Value *generateCodeToCombine(IRBuilder<> &builder,
+                               Value *accumulatedValue,
+                               Value *privateCopy) const;
+
+  static bool classof(const GenericSCC *s);
+
+protected:
+  CmpInst *comparison;
+  CmpInst::Predicate predicate;
+};
+
+} // namespace arcana::noelle
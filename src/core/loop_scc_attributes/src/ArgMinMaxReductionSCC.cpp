@@ -0,0 +1,113 @@
+/*
+ * Copyright 2023  Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do
+ so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "noelle/core/ArgMinMaxReductionSCC.hpp"
+
+namespace arcana::noelle {
+
+ArgMinMaxReductionSCC::ArgMinMaxReductionSCC(
+    SCC *s,
+    LoopStructure *loop,
+    const std::set<DGEdge<Value, Value> *> &loopCarriedDependences,
+    Value *initialValue,
+    PHINode *accumulator,
+    PHINode *minMaxAccumulator,
+    CmpInst::Predicate minMaxPredicate,
+    CmpInst::Predicate iterationOrderPredicate)
+  : ReductionSCC(SCCKind::ARGMINMAX_REDUCTION,
+                 s,
+                 loop,
+                 loopCarriedDependences,
+                 initialValue,
+                 accumulator,
+                 Constant::getNullValue(accumulator->getType())),
+    minMaxAccumulator{ minMaxAccumulator },
+    minMaxPredicate{ minMaxPredicate },
+    iterationOrderPredicate{ iterationOrderPredicate } {
+  assert(minMaxAccumulator != nullptr);
+
+  /*
+   * The identity value is never selected.
+   * A private copy is selected only if the related min/max reduction has been
+   * updated by the same thread, which also updates the private copy.
+   */
+
+  return;
+}
+
+PHINode *ArgMinMaxReductionSCC::getMinMaxAccumulator(void) const {
+  return this->minMaxAccumulator;
+}
+
+Value *ArgMinMaxReductionSCC::generateCodeToCombine(
+    IRBuilder<> &builder,
+    Value *accumulatedValue,
+    Value *privateCopy,
+    Value *accumulatedMinMax,
+    Value *privateMinMax,
+    Value *initialMinMax) const {
+
+  /*
+   * Define the comparisons between values of the min/max reduction.
+   */
+  auto isInt = CmpInst::isIntPredicate(this->minMaxPredicate);
+  auto compare = [this, &builder, isInt](Value *a, Value *b) -> Value * {
+    if (isInt) {
+      return builder.CreateICmp(this->minMaxPredicate, a, b);
+    }
+    return builder.CreateFCmp(this->minMaxPredicate, a, b);
+  };
+
+  /*
+   * The private copy wins if the thread found a better value.
+   */
+  auto isBetter = compare(privateMinMax, accumulatedMinMax);
+
+  /*
+   * The private copy also wins if the thread found the same value in an
+   * earlier iteration.
+   * The initial value is never replaced by an equal one because the original
+   * loop replaces it only with strictly better values.
+   */
+  auto isSame = isInt ? builder.CreateICmpEQ(privateMinMax, accumulatedMinMax)
+                      : builder.CreateFCmpOEQ(privateMinMax, accumulatedMinMax);
+  auto hasBeenUpdated = compare(privateMinMax, initialMinMax);
+  auto isEarlier = builder.CreateICmp(this->iterationOrderPredicate,
+                                      privateCopy,
+                                      accumulatedValue);
+  auto isEarlierAndSame =
+      builder.CreateAnd(isSame, builder.CreateAnd(hasBeenUpdated, isEarlier));
+
+  /*
+   * Pick the value.
+   */
+  auto pickPrivateCopy = builder.CreateOr(isBetter, isEarlierAndSame);
+  auto newValue =
+      builder.CreateSelect(pickPrivateCopy, privateCopy, accumulatedValue);
+
+  return newValue;
+}
+
+bool ArgMinMaxReductionSCC::classof(const GenericSCC *s) {
+  return (s->getKind() == GenericSCC::SCCKind::ARGMINMAX_REDUCTION);
+}
+
+} // namespace arcana::noelle
@@ -0,0 +1,132 @@
+/*
+ * Copyright 2023  Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do
+ so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "noelle/core/MinMaxReductionSCC.hpp"
+
+namespace arcana::noelle {
+
+MinMaxReductionSCC::MinMaxReductionSCC(
+    SCC *s,
+    LoopStructure *loop,
+    const std::set<DGEdge<Value, Value> *> &loopCarriedDependences,
+    Value *initialValue,
+    PHINode *accumulator,
+    CmpInst *comparison,
+    CmpInst::Predicate predicate)
+  : ReductionSCC(SCCKind::MINMAX_REDUCTION,
+                 s,
+                 loop,
+                 loopCarriedDependences,
+                 initialValue,
+                 accumulator,
+                 nullptr),
+    comparison{ comparison },
+    predicate{ predicate } {
+  assert(comparison != nullptr);
+
+  /*
+   * Set the identity value.
+   * This is the value that is replaced by any other one.
+   */
+  auto varType = accumulator->getType();
+  if (varType->isIntegerTy()) {
+    auto bits = varType->getIntegerBitWidth();
+    APInt identityValue;
+    if (CmpInst::isSigned(this->predicate)) {
+      identityValue = this->isMinimum() ? APInt::getSignedMaxValue(bits)
+                                        : APInt::getSignedMinValue(bits);
+    } else {
+      identityValue = this->isMinimum() ? APInt::getMaxValue(bits)
+                                        : APInt::getMinValue(bits);
+    }
+    this->identity = ConstantInt::get(varType, identityValue);
+
+  } else {
+    assert(varType->isFloatingPointTy());
+    this->identity = ConstantFP::getInfinity(varType, !this->isMinimum());
+  }
+
+  return;
+}
+
+CmpInst *MinMaxReductionSCC::getComparison(void) const {
+  return this->comparison;
+}
+
+CmpInst::Predicate MinMaxReductionSCC::getPredicate(void) const {
+  return this->predicate;
+}
+
+CmpInst::Predicate MinMaxReductionSCC::getStrictPredicate(void) const {
+  switch (this->predicate) {
+    case CmpInst::ICMP_SLE:
+      return CmpInst::ICMP_SLT;
+    case CmpInst::ICMP_SGE:
+      return CmpInst::ICMP_SGT;
+    case CmpInst::ICMP_ULE:
+      return CmpInst::ICMP_ULT;
+    case CmpInst::ICMP_UGE:
+      return CmpInst::ICMP_UGT;
+    case CmpInst::FCMP_OLE:
+      return CmpInst::FCMP_OLT;
+    case CmpInst::FCMP_OGE:
+      return CmpInst::FCMP_OGT;
+    default:
+      return this->predicate;
+  }
+}
+
+bool MinMaxReductionSCC::isMinimum(void) const {
+  switch (this->getStrictPredicate()) {
+    case CmpInst::ICMP_SLT:
+    case CmpInst::ICMP_ULT:
+    case CmpInst::FCMP_OLT:
+      return true;
+    default:
+      return false;
+  }
+}
+
+bool MinMaxReductionSCC::isStrict(void) const {
+  return this->predicate == this->getStrictPredicate();
+}
+
+Value *MinMaxReductionSCC::generateCodeToCombine(IRBuilder<> &builder,
+                                                 Value *accumulatedValue,
+                                                 Value *privateCopy) const {
+
+  /*
+   * Keep the private copy only if it is better than the accumulated value.
+   */
+  auto pred = this->getStrictPredicate();
+  auto isBetter = CmpInst::isIntPredicate(pred)
+                      ? builder.CreateICmp(pred, privateCopy, accumulatedValue)
+                      : builder.CreateFCmp(pred, privateCopy, accumulatedValue);
+  auto newValue = builder.CreateSelect(isBetter, privateCopy, accumulatedValue);
+
+  return newValue;
+}
+
+bool MinMaxReductionSCC::classof(const GenericSCC *s) {
+  return (s->getKind() == GenericSCC::SCCKind::MINMAX_REDUCTION);
+}
+
+} // namespace arcana::noelle
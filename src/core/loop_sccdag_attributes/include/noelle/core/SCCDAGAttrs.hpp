@@ -99,6 +99,28 @@ private:
    */
   LoopCarriedVariable *checkIfReducible(SCC *scc, LoopTree *loop);
 
+  PHINode *getLoopCarriedPHIOfReducibleSCC(SCC *scc, LoopTree *loopNode) const;
+
+  std::tuple<bool, PHINode *, SelectInst *, CmpInst::Predicate>
+  matchMinMaxReduction(SCC *scc, LoopTree *loopNode) const;
+
+  std::tuple<bool, PHINode *, CmpInst *, CmpInst::Predicate>
+  checkIfMinMaxReducible(SCC *scc,
+                         LoopTree *loopNode,
+                         std::set<InductionVariable *> &IVs) const;
+
+  std::tuple<bool,
+             PHINode *,
+             PHINode *,
+             CmpInst::Predicate,
+             CmpInst::Predicate>
+  checkIfArgMinMaxReducible(SCC *scc,
+                            LoopTree *loopNode,
+                            std::set<InductionVariable *> &IVs) const;
+
+  std::tuple<bool, PHINode *, Function *, Value *>
+  checkIfReducibleThroughAssociativeCall(SCC *scc, LoopTree *loopNode) const;
+
   std::tuple<bool, Value *, Value *, Value *> checkIfPeriodic(
       SCC *scc,
       LoopTree *loopNode);
@@ -22,6 +22,9 @@
 #include "noelle/core/SCCDAGAttrs.hpp"
 #include "noelle/core/PDGPrinter.hpp"
 #include "noelle/core/BinaryReductionSCC.hpp"
+#include "noelle/core/MinMaxReductionSCC.hpp"
+#include "noelle/core/ArgMinMaxReductionSCC.hpp"
+#include "noelle/core/AssociativeCallReductionSCC.hpp"
 #include "noelle/core/LoopIterationSCC.hpp"
 #include "noelle/core/LinearInductionVariableSCC.hpp"
 #include "noelle/core/PeriodicVariableSCC.hpp"
@@ -98,6 +101,10 @@ SCCDAGAttrs::SCCDAGAttrs(bool enableFloatAsReal,
                                                        loopGoverningIVs);
     auto lcVar = this->checkIfReducible(scc, loopNode);
     auto isReducable = lcVar != nullptr;
+    auto isMinMax = this->checkIfMinMaxReducible(scc, loopNode, ivs);
+    auto isArgMinMax = this->checkIfArgMinMaxReducible(scc, loopNode, ivs);
+    auto isReducibleThroughCall =
+        this->checkIfReducibleThroughAssociativeCall(scc, loopNode);
     auto stackObjectsThatAreClonable =
         this->checkIfClonableByUsingLocalMemory(scc, loopNode);
     auto valuesToPropagateAcrossIterations =
@@ -156,6 +163,72 @@ SCCDAGAttrs::SCCDAGAttrs(bool enableFloatAsReal,
                                        lcVar,
                                        DS);
 
+    } else if (std::get<0>(isMinMax)) {
+
+      /*
+       * The SCC is a variable that keeps the minimum (maximum) value.
+       */
+      auto loopCarriedDependences = this->sccToLoopCarriedDependencies.at(scc);
+      PHINode *accumulator;
+      CmpInst *comparison;
+      CmpInst::Predicate predicate;
+      std::tie(std::ignore, accumulator, comparison, predicate) = isMinMax;
+      auto initialValue =
+          accumulator->getIncomingValueForBlock(rootLoop->getPreHeader());
+      sccInfo = new MinMaxReductionSCC(scc,
+                                       rootLoop,
+                                       loopCarriedDependences,
+                                       initialValue,
+                                       accumulator,
+                                       comparison,
+                                       predicate);
+
+    } else if (std::get<0>(isArgMinMax)) {
+
+      /*
+       * The SCC is a variable that keeps the iteration of a minimum (maximum)
+       * value.
+       */
+      auto loopCarriedDependences = this->sccToLoopCarriedDependencies.at(scc);
+      PHINode *accumulator, *minMaxAccumulator;
+      CmpInst::Predicate minMaxPredicate, iterationOrderPredicate;
+      std::tie(std::ignore,
+               accumulator,
+               minMaxAccumulator,
+               minMaxPredicate,
+               iterationOrderPredicate) = isArgMinMax;
+      auto initialValue =
+          accumulator->getIncomingValueForBlock(rootLoop->getPreHeader());
+      sccInfo = new ArgMinMaxReductionSCC(scc,
+                                          rootLoop,
+                                          loopCarriedDependences,
+                                          initialValue,
+                                          accumulator,
+                                          minMaxAccumulator,
+                                          minMaxPredicate,
+                                          iterationOrderPredicate);
+
+    } else if (std::get<0>(isReducibleThroughCall)) {
+
+      /*
+       * The SCC is a variable updated by an associative function.
+       */
+      auto loopCarriedDependences = this->sccToLoopCarriedDependencies.at(scc);
+      PHINode *accumulator;
+      Function *reductionFunction;
+      Value *identity;
+      std::tie(std::ignore, accumulator, reductionFunction, identity) =
+          isReducibleThroughCall;
+      auto initialValue =
+          accumulator->getIncomingValueForBlock(rootLoop->getPreHeader());
+      sccInfo = new AssociativeCallReductionSCC(scc,
+                                                rootLoop,
+                                                loopCarriedDependences,
+                                                initialValue,
+                                                accumulator,
+                                                reductionFunction,
+                                                identity);
+
     } else if (valuesToPropagateAcrossIterations.size() > 0) {
 
       /*
@@ -655,86 +728,16 @@ std::tuple<bool, Value *, Value *, Value *> SCCDAGAttrs::checkIfPeriodic(
 LoopCarriedVariable *SCCDAGAttrs::checkIfReducible(SCC *scc,
                                                    LoopTree *loopNode) {
 
-  /*
-   * Check if the SCC has loop-carried dependences.
-   * If not, then this SCC is not reducable because there is nothing to reduce.
-   */
-  if (this->sccToLoopCarriedDependencies.find(scc)
-      == this->sccToLoopCarriedDependencies.end()) {
-    return nullptr;
-  }
-
   /*
    * A reducible variable consists of one loop carried value
    * that tracks the evolution of the reducible value
    */
-  auto rootLoop = loopNode->getLoop();
-  auto rootLoopHeader = rootLoop->getHeader();
-  std::unordered_set<PHINode *> loopCarriedPHIs{};
-  for (auto dependency : this->sccToLoopCarriedDependencies.at(scc)) {
-
-    /*
-     * We do not handle reducibility of memory locations
-     */
-    if (dependency->isMemoryDependence()) {
-      return nullptr;
-    }
-
-    /*
-     * Ignore external control dependencies, do not allow internal ones
-     */
-    auto producer = dependency->getSrc();
-    if (dependency->isControlDependence()) {
-      if (scc->isInternal(producer)) {
-        return nullptr;
-      }
-      continue;
-    }
-
-    /*
-     * Fetch the destination of the dependence.
-     */
-    auto consumer = dependency->getDst();
-    if (!isa<PHINode>(consumer)) {
-
-      /*
-       * We do not handle SCCs with loop-carried data dependences with
-       * instructions that are not PHI.
-       */
-      return nullptr;
-    }
-    assert(isa<PHINode>(consumer)
-           && "All consumers of loop carried data dependencies must be PHIs");
-    auto consumerPHI = cast<PHINode>(consumer);
-
-    /*
-     * Look for an internal consumer of a loop carried dependence
-     *
-     * NOTE: External consumers may be last-live out propagations of a reducible
-     * variable or could disqualify this from reducibility: let the
-     * LoopCarriedVariable analysis determine this
-     */
-    if (!scc->isInternal(consumerPHI)) {
-      continue;
-    }
-
-    /*
-     * Ignore sub-loops as they do not need to be reduced
-     */
-    if (rootLoopHeader != consumerPHI->getParent()) {
-      continue;
-    }
-
-    loopCarriedPHIs.insert(consumerPHI);
-  }
-
-  /*
-   * Check if there are loop carried dependences related to PHI nodes.
-   */
-  if (loopCarriedPHIs.size() != 1) {
+  auto singleLoopCarriedPHI =
+      this->getLoopCarriedPHIOfReducibleSCC(scc, loopNode);
+  if (singleLoopCarriedPHI == nullptr) {
     return nullptr;
   }
-  auto singleLoopCarriedPHI = *loopCarriedPHIs.begin();
+  auto rootLoop = loopNode->getLoop();
 
   /*
    * Analyze the loop-carried variable related to the SCC.
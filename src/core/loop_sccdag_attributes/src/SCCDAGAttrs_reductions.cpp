@@ -0,0 +1,688 @@
+/*
+ * Copyright 2023  Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do
+ so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "noelle/core/SCCDAGAttrs.hpp"
+
+namespace arcana::noelle {
+
+static bool isUsedWithinTheLoopOnlyByTheSCC(Instruction *inst,
+                                            SCC *scc,
+                                            LoopStructure *loop);
+
+static bool isUsedOutsideTheLoop(Instruction *inst, LoopStructure *loop);
+
+static bool isStrictPredicate(CmpInst::Predicate pred);
+
+static Value *getIdentityOfAssociativeFunction(Function *f, Type *t);
+
+PHINode *SCCDAGAttrs::getLoopCarriedPHIOfReducibleSCC(
+    SCC *scc,
+    LoopTree *loopNode) const {
+
+  /*
+   * Check if the SCC has loop-carried dependences.
+   * If not, then this SCC is not reducable because there is nothing to reduce.
+   */
+  if (this->sccToLoopCarriedDependencies.find(scc)
+      == this->sccToLoopCarriedDependencies.end()) {
+    return nullptr;
+  }
+
+  /*
+   * A reducible variable consists of one loop carried value
+   * that tracks the evolution of the reducible value
+   */
+  auto rootLoop = loopNode->getLoop();
+  auto rootLoopHeader = rootLoop->getHeader();
+  std::unordered_set<PHINode *> loopCarriedPHIs{};
+  for (auto dependency : this->sccToLoopCarriedDependencies.at(scc)) {
+
+    /*
+     * We do not handle reducibility of memory locations
+     */
+    if (dependency->isMemoryDependence()) {
+      return nullptr;
+    }
+
+    /*
+     * Ignore external control dependencies, do not allow internal ones
+     */
+    auto producer = dependency->getSrc();
+    if (dependency->isControlDependence()) {
+      if (scc->isInternal(producer)) {
+        return nullptr;
+      }
+      continue;
+    }
+
+    /*
+     * Fetch the destination of the dependence.
+     */
+    auto consumer = dependency->getDst();
+    if (!isa<PHINode>(consumer)) {
+
+      /*
+       * We do not handle SCCs with loop-carried data dependences with
+       * instructions that are not PHI.
+       */
+      return nullptr;
+    }
+    assert(isa<PHINode>(consumer)
+           && "All consumers of loop carried data dependencies must be PHIs");
+    auto consumerPHI = cast<PHINode>(consumer);
+
+    /*
+     * Look for an internal consumer of a loop carried dependence
+     *
+     * NOTE: External consumers may be last-live out propagations of a reducible
+     * variable or could disqualify this from reducibility: let the
+     * LoopCarriedVariable analysis determine this
+     */
+    if (!scc->isInternal(consumerPHI)) {
+      continue;
+    }
+
+    /*
+     * Ignore sub-loops as they do not need to be reduced
+     */
+    if (rootLoopHeader != consumerPHI->getParent()) {
+      continue;
+    }
+
+    loopCarriedPHIs.insert(consumerPHI);
+  }
+
+  /*
+   * Check if there are loop carried dependences related to PHI nodes.
+   */
+  if (loopCarriedPHIs.size() != 1) {
+    return nullptr;
+  }
+  auto singleLoopCarriedPHI = *loopCarriedPHIs.begin();
+
+  return singleLoopCarriedPHI;
+}
+
+std::tuple<bool, PHINode *, SelectInst *, CmpInst::Predicate> SCCDAGAttrs::
+    matchMinMaxReduction(SCC *scc, LoopTree *loopNode) const {
+  auto notMinMax = std::make_tuple(false,
+                                   nullptr,
+                                   nullptr,
+                                   CmpInst::Predicate::BAD_ICMP_PREDICATE);
+
+  /*
+   * The SCC must be composed by the PHI that carries the value between
+   * iterations, the comparison, and the selection of the new value.
+   */
+  auto phi = this->getLoopCarriedPHIOfReducibleSCC(scc, loopNode);
+  if (phi == nullptr) {
+    return notMinMax;
+  }
+  if (scc->numInternalNodes() != 3) {
+    return notMinMax;
+  }
+  SelectInst *selection = nullptr;
+  CmpInst *comparison = nullptr;
+  for (auto nodePair : scc->internalNodePairs()) {
+    auto value = nodePair.first;
+    if (value == phi) {
+      continue;
+    }
+    if (auto selectInst = dyn_cast<SelectInst>(value)) {
+      selection = selectInst;
+    } else if (auto cmpInst = dyn_cast<CmpInst>(value)) {
+      comparison = cmpInst;
+    }
+  }
+  if ((selection == nullptr) || (comparison == nullptr)) {
+    return notMinMax;
+  }
+  if (selection->getCondition() != comparison) {
+    return notMinMax;
+  }
+
+  /*
+   * The selection must not belong to a sub-loop, and it must be the value
+   * that reaches the PHI at every iteration.
+   */
+  auto rootLoop = loopNode->getLoop();
+  if (loopNode->getInnermostLoopThatContains(selection) != rootLoop) {
+    return notMinMax;
+  }
+  for (auto i = 0u; i < phi->getNumIncomingValues(); i++) {
+    if (!rootLoop->isIncluded(phi->getIncomingBlock(i))) {
+      continue;
+    }
+    if (phi->getIncomingValue(i) != selection) {
+      return notMinMax;
+    }
+  }
+
+  /*
+   * Fetch the new value that can replace the accumulated one.
+   */
+  Value *newValue = nullptr;
+  auto isNewValueSelectedWhenTrue = true;
+  if (selection->getFalseValue() == phi) {
+    newValue = selection->getTrueValue();
+  } else if (selection->getTrueValue() == phi) {
+    newValue = selection->getFalseValue();
+    isNewValueSelectedWhenTrue = false;
+  }
+  if ((newValue == nullptr) || (newValue == phi)) {
+    return notMinMax;
+  }
+
+  /*
+   * Compute the predicate P such that the new value v replaces the
+   * accumulated value a when "v P a" holds.
+   */
+  auto pred = comparison->getPredicate();
+  if ((comparison->getOperand(0) == phi)
+      && (comparison->getOperand(1) == newValue)) {
+    pred = CmpInst::getSwappedPredicate(pred);
+  } else if ((comparison->getOperand(0) != newValue)
+             || (comparison->getOperand(1) != phi)) {
+    return notMinMax;
+  }
+  if (!isNewValueSelectedWhenTrue) {
+    pred = CmpInst::getInversePredicate(pred);
+  }
+
+  /*
+   * Check the predicate.
+   *
+   * Floating point variables can be reduced only if they can be considered as
+   * real numbers. In this case, ordered and unordered comparisons are the
+   * same.
+   */
+  if (CmpInst::isFPPredicate(pred)) {
+    if (!this->enableFloatAsReal) {
+      return notMinMax;
+    }
+    switch (pred) {
+      case CmpInst::FCMP_ULT:
+        pred = CmpInst::FCMP_OLT;
+        break;
+      case CmpInst::FCMP_ULE:
+        pred = CmpInst::FCMP_OLE;
+        break;
+      case CmpInst::FCMP_UGT:
+        pred = CmpInst::FCMP_OGT;
+        break;
+      case CmpInst::FCMP_UGE:
+        pred = CmpInst::FCMP_OGE;
+        break;
+      default:
+        break;
+    }
+  }
+  switch (pred) {
+    case CmpInst::ICMP_SLT:
+    case CmpInst::ICMP_SLE:
+    case CmpInst::ICMP_SGT:
+    case CmpInst::ICMP_SGE:
+    case CmpInst::ICMP_ULT:
+    case CmpInst::ICMP_ULE:
+    case CmpInst::ICMP_UGT:
+    case CmpInst::ICMP_UGE:
+    case CmpInst::FCMP_OLT:
+    case CmpInst::FCMP_OLE:
+    case CmpInst::FCMP_OGT:
+    case CmpInst::FCMP_OGE:
+      break;
+    default:
+      return notMinMax;
+  }
+  auto varType = phi->getType();
+  if (!varType->isIntegerTy() && !varType->isFloatingPointTy()) {
+    return notMinMax;
+  }
+
+  /*
+   * Intermediate values of the variable must not be used by other
+   * instructions of the loop.
+   * This is because these values change once the variable is reduced.
+   */
+  if (!isUsedWithinTheLoopOnlyByTheSCC(phi, scc, rootLoop)
+      || !isUsedWithinTheLoopOnlyByTheSCC(selection, scc, rootLoop)) {
+    return notMinMax;
+  }
+
+  return std::make_tuple(true, phi, selection, pred);
+}
+
+std::tuple<bool, PHINode *, CmpInst *, CmpInst::Predicate> SCCDAGAttrs::
+    checkIfMinMaxReducible(SCC *scc,
+                           LoopTree *loopNode,
+                           std::set<InductionVariable *> &IVs) const {
+  auto notMinMax = std::make_tuple(false,
+                                   nullptr,
+                                   nullptr,
+                                   CmpInst::Predicate::BAD_ICMP_PREDICATE);
+
+  /*
+   * Check the SCC.
+   */
+  PHINode *phi = nullptr;
+  SelectInst *selection = nullptr;
+  CmpInst::Predicate pred;
+  bool matched;
+  std::tie(matched, phi, selection, pred) =
+      this->matchMinMaxReduction(scc, loopNode);
+  if (!matched) {
+    return notMinMax;
+  }
+
+  /*
+   * The comparison can be used by other instructions of the loop only to
+   * compute the iteration where the minimum (maximum) has been found.
+   */
+  auto rootLoop = loopNode->getLoop();
+  auto comparison = cast<CmpInst>(selection->getCondition());
+  for (auto user : comparison->users()) {
+    auto userInst = cast<Instruction>(user);
+    if (scc->isInternal(userInst) || !rootLoop->isIncluded(userInst)) {
+      continue;
+    }
+    auto userSCC = this->sccdag->sccOfValue(userInst);
+    if (!std::get<0>(
+            this->checkIfArgMinMaxReducible(userSCC, loopNode, IVs))) {
+      return notMinMax;
+    }
+  }
+
+  return std::make_tuple(true, phi, comparison, pred);
+}
+
+std::tuple<bool,
+           PHINode *,
+           PHINode *,
+           CmpInst::Predicate,
+           CmpInst::Predicate>
+SCCDAGAttrs::checkIfArgMinMaxReducible(
+    SCC *scc,
+    LoopTree *loopNode,
+    std::set<InductionVariable *> &IVs) const {
+  auto notArgMinMax = std::make_tuple(false,
+                                      nullptr,
+                                      nullptr,
+                                      CmpInst::Predicate::BAD_ICMP_PREDICATE,
+                                      CmpInst::Predicate::BAD_ICMP_PREDICATE);
+
+  /*
+   * The SCC must be composed by the PHI that carries the value between
+   * iterations and the selection of the new value.
+   */
+  auto phi = this->getLoopCarriedPHIOfReducibleSCC(scc, loopNode);
+  if (phi == nullptr) {
+    return notArgMinMax;
+  }
+  if (scc->numInternalNodes() != 2) {
+    return notArgMinMax;
+  }
+  SelectInst *selection = nullptr;
+  for (auto nodePair : scc->internalNodePairs()) {
+    auto value = nodePair.first;
+    if (value != phi) {
+      selection = dyn_cast<SelectInst>(value);
+    }
+  }
+  if (selection == nullptr) {
+    return notArgMinMax;
+  }
+  auto rootLoop = loopNode->getLoop();
+  if (loopNode->getInnermostLoopThatContains(selection) != rootLoop) {
+    return notArgMinMax;
+  }
+  for (auto i = 0u; i < phi->getNumIncomingValues(); i++) {
+    if (!rootLoop->isIncluded(phi->getIncomingBlock(i))) {
+      continue;
+    }
+    if (phi->getIncomingValue(i) != selection) {
+      return notArgMinMax;
+    }
+  }
+
+  /*
+   * The selection must be decided by the comparison of a min/max reduction.
+   */
+  auto comparison = dyn_cast<CmpInst>(selection->getCondition());
+  if (comparison == nullptr) {
+    return notArgMinMax;
+  }
+  PHINode *minMaxPHI = nullptr;
+  SelectInst *minMaxSelection = nullptr;
+  CmpInst::Predicate minMaxPred;
+  for (auto user : comparison->users()) {
+    auto userSelection = dyn_cast<SelectInst>(user);
+    if ((userSelection == nullptr) || (userSelection == selection)) {
+      continue;
+    }
+    auto userSCC = this->sccdag->sccOfValue(userSelection);
+    bool matched;
+    SelectInst *s = nullptr;
+    std::tie(matched, minMaxPHI, s, minMaxPred) =
+        this->matchMinMaxReduction(userSCC, loopNode);
+    if (matched && (s == userSelection)) {
+      minMaxSelection = userSelection;
+      break;
+    }
+  }
+  if (minMaxSelection == nullptr) {
+    return notArgMinMax;
+  }
+
+  /*
+   * Only the first iteration that found the minimum (maximum) is tracked.
+   * Hence, equal values must not replace the accumulated one.
+   */
+  if (!isStrictPredicate(minMaxPred)) {
+    return notArgMinMax;
+  }
+
+  /*
+   * The selection must pick a new value exactly when the min/max reduction
+   * does.
+   */
+  Value *newValue = nullptr;
+  if (minMaxSelection->getTrueValue() == minMaxPHI) {
+    if (selection->getTrueValue() != phi) {
+      return notArgMinMax;
+    }
+    newValue = selection->getFalseValue();
+  } else {
+    if (selection->getFalseValue() != phi) {
+      return notArgMinMax;
+    }
+    newValue = selection->getTrueValue();
+  }
+
+  /*
+   * The new value must identify the current iteration.
+   * This is the case for the instructions of an induction variable with a
+   * constant step.
+   */
+  auto isUnsigned = false;
+  if (auto castInst = dyn_cast<ZExtInst>(newValue)) {
+    newValue = castInst->getOperand(0);
+    isUnsigned = true;
+  } else if (auto castInst = dyn_cast<SExtInst>(newValue)) {
+    newValue = castInst->getOperand(0);
+  }
+  auto newValueInst = dyn_cast<Instruction>(newValue);
+  if (newValueInst == nullptr) {
+    return notArgMinMax;
+  }
+  InductionVariable *iv = nullptr;
+  for (auto currentIV : IVs) {
+    if (currentIV->getLoopEntryPHI()->getParent() != rootLoop->getHeader()) {
+      continue;
+    }
+    if (currentIV->isIVInstruction(newValueInst)) {
+      iv = currentIV;
+      break;
+    }
+  }
+  if ((iv == nullptr) || (!iv->getType()->isIntegerTy())
+      || (!iv->isStepValueLoopInvariant())
+      || (!isa<ConstantInt>(iv->getSingleComputedStepValue()))) {
+    return notArgMinMax;
+  }
+  auto iterationOrderPred = iv->isStepValuePositive()
+                                ? (isUnsigned ? CmpInst::ICMP_ULT
+                                              : CmpInst::ICMP_SLT)
+                                : (isUnsigned ? CmpInst::ICMP_UGT
+                                              : CmpInst::ICMP_SGT);
+
+  /*
+   * The values of the min/max reduction of each thread are needed to reduce
+   * this variable.
+   * Hence, the min/max reduction must be a live-out variable.
+   */
+  if (!isUsedOutsideTheLoop(minMaxPHI, rootLoop)
+      && !isUsedOutsideTheLoop(minMaxSelection, rootLoop)) {
+    return notArgMinMax;
+  }
+
+  /*
+   * Intermediate values of the variable must not be used by other
+   * instructions of the loop.
+   */
+  if (!isUsedWithinTheLoopOnlyByTheSCC(phi, scc, rootLoop)
+      || !isUsedWithinTheLoopOnlyByTheSCC(selection, scc, rootLoop)) {
+    return notArgMinMax;
+  }
+
+  return std::make_tuple(true, phi, minMaxPHI, minMaxPred, iterationOrderPred);
+}
+
+std::tuple<bool, PHINode *, Function *, Value *> SCCDAGAttrs::
+    checkIfReducibleThroughAssociativeCall(SCC *scc, LoopTree *loopNode) const {
+  auto notReducible = std::make_tuple(false, nullptr, nullptr, nullptr);
+
+  /*
+   * The SCC must be composed by the PHI that carries the value between
+   * iterations and the call that computes the new value.
+   */
+  auto phi = this->getLoopCarriedPHIOfReducibleSCC(scc, loopNode);
+  if (phi == nullptr) {
+    return notReducible;
+  }
+  if (scc->numInternalNodes() != 2) {
+    return notReducible;
+  }
+  CallInst *call = nullptr;
+  for (auto nodePair : scc->internalNodePairs()) {
+    auto value = nodePair.first;
+    if (value != phi) {
+      call = dyn_cast<CallInst>(value);
+    }
+  }
+  if (call == nullptr) {
+    return notReducible;
+  }
+  auto rootLoop = loopNode->getLoop();
+  if (loopNode->getInnermostLoopThatContains(call) != rootLoop) {
+    return notReducible;
+  }
+  for (auto i = 0u; i < phi->getNumIncomingValues(); i++) {
+    if (!rootLoop->isIncluded(phi->getIncomingBlock(i))) {
+      continue;
+    }
+    if (phi->getIncomingValue(i) != call) {
+      return notReducible;
+    }
+  }
+
+  /*
+   * The call must combine the accumulated value with a new one.
+   */
+  auto callee = call->getCalledFunction();
+  if ((callee == nullptr) || (call->getNumArgOperands() != 2)) {
+    return notReducible;
+  }
+  auto varType = phi->getType();
+  if ((call->getType() != varType)
+      || (call->getArgOperand(0)->getType() != varType)
+      || (call->getArgOperand(1)->getType() != varType)) {
+    return notReducible;
+  }
+  if ((call->getArgOperand(0) == phi) == (call->getArgOperand(1) == phi)) {
+    return notReducible;
+  }
+
+  /*
+   * The callee must be associative and commutative.
+   */
+  auto identity = getIdentityOfAssociativeFunction(callee, varType);
+  if (identity == nullptr) {
+    return notReducible;
+  }
+
+  /*
+   * Intermediate values of the variable must not be used by other
+   * instructions of the loop.
+   */
+  if (!isUsedWithinTheLoopOnlyByTheSCC(phi, scc, rootLoop)
+      || !isUsedWithinTheLoopOnlyByTheSCC(call, scc, rootLoop)) {
+    return notReducible;
+  }
+
+  return std::make_tuple(true, phi, callee, identity);
+}
+
+static bool isUsedWithinTheLoopOnlyByTheSCC(Instruction *inst,
+                                            SCC *scc,
+                                            LoopStructure *loop) {
+  for (auto user : inst->users()) {
+    auto userInst = cast<Instruction>(user);
+    if (scc->isInternal(userInst)) {
+      continue;
+    }
+    if (loop->isIncluded(userInst)) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+static bool isUsedOutsideTheLoop(Instruction *inst, LoopStructure *loop) {
+  for (auto user : inst->users()) {
+    auto userInst = cast<Instruction>(user);
+    if (!loop->isIncluded(userInst)) {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+static bool isStrictPredicate(CmpInst::Predicate pred) {
+  switch (pred) {
+    case CmpInst::ICMP_SLT:
+    case CmpInst::ICMP_SGT:
+    case CmpInst::ICMP_ULT:
+    case CmpInst::ICMP_UGT:
+    case CmpInst::FCMP_OLT:
+    case CmpInst::FCMP_OGT:
+      return true;
+    default:
+      return false;
+  }
+}
+
+static std::set<std::string> getSourceCodeAnnotations(Function *f) {
+  std::set<std::string> annotations;
+
+  /*
+   * Fetch the annotations of the program.
+   */
+  auto globalArray =
+      f->getParent()->getGlobalVariable("llvm.global.annotations");
+  if (globalArray == nullptr) {
+    return annotations;
+  }
+  auto entries = dyn_cast<ConstantArray>(globalArray->getOperand(0));
+  if (entries == nullptr) {
+    return annotations;
+  }
+
+  /*
+   * Collect the annotations of the function.
+   */
+  for (auto &entry : entries->operands()) {
+    auto entryStruct = dyn_cast<ConstantStruct>(entry);
+    if ((entryStruct == nullptr) || (entryStruct->getNumOperands() < 2)) {
+      continue;
+    }
+    if (entryStruct->getOperand(0)->stripPointerCasts() != f) {
+      continue;
+    }
+    auto annotation = entryStruct->getOperand(1)->stripPointerCasts();
+    auto annotationVariable = dyn_cast<GlobalVariable>(annotation);
+    if (annotationVariable == nullptr) {
+      continue;
+    }
+    auto A = dyn_cast<ConstantDataArray>(annotationVariable->getInitializer());
+    if ((A == nullptr) || !A->isString()) {
+      continue;
+    }
+    annotations.insert(A->getAsCString().str());
+  }
+
+  return annotations;
+}
+
+static Value *getIdentityOfAssociativeFunction(Function *f, Type *t) {
+
+  /*
+   * Check known functions.
+   */
+  if (t->isFloatingPointTy()) {
+    auto name = f->getName();
+    if ((f->getIntrinsicID() == Intrinsic::minnum) || (name == "fmin")
+        || (name == "fminf")) {
+      return ConstantFP::getInfinity(t, false);
+    }
+    if ((f->getIntrinsicID() == Intrinsic::maxnum) || (name == "fmax")
+        || (name == "fmaxf")) {
+      return ConstantFP::getInfinity(t, true);
+    }
+  }
+
+  /*
+   * Check user-defined functions.
+   *
+   * The programmer declares a pure function to be associative and commutative
+   * by annotating it with its identity value. For example:
+   *    __attribute__((annotate("noelle.reduction.identity=0")))
+   */
+  if (!f->doesNotAccessMemory()) {
+    return nullptr;
+  }
+  std::string prefix{ "noelle.reduction.identity=" };
+  for (auto &annotation : getSourceCodeAnnotations(f)) {
+    if (annotation.compare(0, prefix.size(), prefix) != 0) {
+      continue;
+    }
+    auto identityString = StringRef(annotation).drop_front(prefix.size());
+    if (t->isIntegerTy()) {
+      int64_t identityValue;
+      if (identityString.getAsInteger(0, identityValue)) {
+        return nullptr;
+      }
+      return ConstantInt::get(t, identityValue, true);
+    }
+    if (t->isFloatingPointTy()) {
+      double identityValue;
+      if (identityString.getAsDouble(identityValue)) {
+        return nullptr;
+      }
+      return ConstantFP::get(t, identityValue);
+    }
+  }
+
+  return nullptr;
+}
+
+} // namespace arcana::noelle
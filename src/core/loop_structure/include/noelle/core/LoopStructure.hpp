@@ -27,6 +27,38 @@ namespace arcana::noelle {
 
 class LoopStructure {
 public:
+  using blocks_iterator = std::unordered_set<BasicBlock *>::const_iterator;
+
+  /*
+   * Iterator over the instructions of the basic blocks of a loop.
+   * It walks the instructions in place without collecting them first.
+   */
+  class instruction_iterator
+    : public iterator_facade_base<instruction_iterator,
+                                  std::forward_iterator_tag,
+                                  Instruction *,
+                                  std::ptrdiff_t,
+                                  Instruction **,
+                                  Instruction *> {
+  public:
+    instruction_iterator(blocks_iterator bb, blocks_iterator bbEnd);
+
+    bool operator==(const instruction_iterator &other) const;
+
+    Instruction *operator*(void) const;
+
+    instruction_iterator &operator++(void);
+
+    using iterator_facade_base::operator++;
+
+  private:
+    blocks_iterator bb;
+    blocks_iterator bbEnd;
+    BasicBlock::iterator inst;
+
+    void skipEmptyBasicBlocks(void);
+  };
+
   LoopStructure(Loop *l);
 
   std::optional<uint64_t> getID(void);
@@ -62,6 +94,17 @@ public:
 
   std::unordered_set<Instruction *> getInstructions(void) const;
 
+  /*
+   * Non-allocating views of the latches, the basic blocks, and the
+   * instructions of the loop.
+   * The views are invalidated when the loop changes.
+   */
+  iterator_range<blocks_iterator> latches(void) const;
+
+  iterator_range<blocks_iterator> blocks(void) const;
+
+  iterator_range<instruction_iterator> instructions(void) const;
+
   uint64_t getNumberOfInstructions(void) const;
 
   std::vector<BasicBlock *> getLoopExitBasicBlocks(void) const;
@@ -138,6 +138,86 @@ std::unordered_set<Instruction *> LoopStructure::getInstructions(void) const {
   return insts;
 }
 
+iterator_range<LoopStructure::blocks_iterator> LoopStructure::latches(
+    void) const {
+  return make_range(this->latchBBs.cbegin(), this->latchBBs.cend());
+}
+
+iterator_range<LoopStructure::blocks_iterator> LoopStructure::blocks(
+    void) const {
+  return make_range(this->bbs.cbegin(), this->bbs.cend());
+}
+
+iterator_range<LoopStructure::instruction_iterator> LoopStructure::
+    instructions(void) const {
+  instruction_iterator b(this->bbs.cbegin(), this->bbs.cend());
+  instruction_iterator e(this->bbs.cend(), this->bbs.cend());
+
+  return make_range(b, e);
+}
+
+LoopStructure::instruction_iterator::instruction_iterator(
+    blocks_iterator bb,
+    blocks_iterator bbEnd)
+  : bb{ bb },
+    bbEnd{ bbEnd } {
+
+  /*
+   * Point to the first instruction of the first non-empty basic block.
+   */
+  this->skipEmptyBasicBlocks();
+
+  return;
+}
+
+void LoopStructure::instruction_iterator::skipEmptyBasicBlocks(void) {
+  while ((this->bb != this->bbEnd) && (*this->bb)->empty()) {
+    this->bb++;
+  }
+  if (this->bb != this->bbEnd) {
+    this->inst = (*this->bb)->begin();
+  }
+
+  return;
+}
+
+bool LoopStructure::instruction_iterator::operator==(
+    const instruction_iterator &other) const {
+  if (this->bb != other.bb) {
+    return false;
+  }
+  if (this->bb == this->bbEnd) {
+    return true;
+  }
+
+  return this->inst == other.inst;
+}
+
+Instruction *LoopStructure::instruction_iterator::operator*(void) const {
+  return &*this->inst;
+}
+
+LoopStructure::instruction_iterator &LoopStructure::instruction_iterator::
+operator++(void) {
+
+  /*
+   * Move to the next instruction of the current basic block.
+   */
+  this->inst++;
+  if (this->inst != (*this->bb)->end()) {
+    return *this;
+  }
+
+  /*
+   * We reached the end of the current basic block.
+   * Move to the next non-empty one.
+   */
+  this->bb++;
+  this->skipEmptyBasicBlocks();
+
+  return *this;
+}
+
 uint64_t LoopStructure::getNumberOfInstructions(void) const {
   uint64_t t = 0;
   for (auto bb : this->bbs) {
@@ -26,6 +26,7 @@
 
 #include "noelle/core/SystemHeaders.hpp"
 #include "noelle/core/LoopDependenceInfo.hpp"
+#include "noelle/core/CodeSizeBudget.hpp"
 
 namespace arcana::noelle {
 
@@ -37,12 +38,20 @@ public:
 
   void setPDG(PDG *programDependenceGraph);
 
+  /*
+   * Set the budget to consult before cloning code (nullptr: no limit).
+   */
+  void setCodeSizeBudget(CodeSizeBudget *budget);
+
   LoopUnrollResult unrollLoop(LoopDependenceInfo *loop, uint32_t unrollFactor);
 
   bool fullyUnrollLoop(LoopDependenceInfo *loop);
 
   bool whilifyLoop(LoopDependenceInfo *loop);
 
+  bool collapseLoopNest(LoopDependenceInfo *outerLoop,
+                        LoopDependenceInfo *innerLoop);
+
   bool splitLoop(LoopDependenceInfo *loop,
                  std::set<SCC *> const &SCCsToPullOut,
                  std::set<Instruction *> &instructionsRemoved,
@@ -58,6 +67,16 @@ public:
 
 private:
   PDG *pdg;
+  CodeSizeBudget *codeSizeBudget;
+
+  bool canCloneCode(LoopDependenceInfo *loop,
+                    std::string const &transformation,
+                    uint64_t codeSize,
+                    double fractionSaved);
+
+  void trackChangesOf(Function &F);
+
+  void updatePDG(Function &F);
 };
 
 } // namespace arcana::noelle
@@ -23,11 +23,15 @@
 #include "noelle/core/Scheduler.hpp"
 #include "noelle/core/LoopWhilify.hpp"
 #include "noelle/core/LoopUnroll.hpp"
+#include "noelle/core/LoopCollapser.hpp"
 #include "noelle/core/LoopDistribution.hpp"
 
 namespace arcana::noelle {
 
-LoopTransformer::LoopTransformer() : ModulePass{ ID } {
+LoopTransformer::LoopTransformer()
+  : ModulePass{ ID },
+    pdg{ nullptr },
+    codeSizeBudget{ nullptr } {
   return;
 }
 
@@ -38,6 +42,43 @@ void LoopTransformer::setPDG(PDG *programDependenceGraph) {
   return;
 }
 
+void LoopTransformer::setCodeSizeBudget(CodeSizeBudget *budget) {
+  this->codeSizeBudget = budget;
+
+  return;
+}
+
+bool LoopTransformer::canCloneCode(LoopDependenceInfo *loop,
+                                   std::string const &transformation,
+                                   uint64_t codeSize,
+                                   double fractionSaved) {
+
+  /*
+   * Check if the code size is limited.
+   */
+  if (this->codeSizeBudget == nullptr) {
+    return true;
+  }
+
+  /*
+   * Ask the budget.
+   */
+  auto ls = loop->getLoopStructure();
+  std::string target{ ls->getFunction()->getName().str() };
+  auto loopID = ls->getID();
+  if (loopID) {
+    target.append(":loop " + std::to_string(loopID.value()));
+  }
+  CodeGrowthRequest request{
+    transformation,
+    target,
+    codeSize,
+    this->codeSizeBudget->getExpectedBenefit(ls, fractionSaved)
+  };
+
+  return this->codeSizeBudget->requestCodeGrowth(request);
+}
+
 LoopUnrollResult LoopTransformer::unrollLoop(LoopDependenceInfo *loop,
                                              uint32_t unrollFactor) {
 
@@ -52,6 +93,20 @@ LoopUnrollResult LoopTransformer::unrollLoop(LoopDependenceInfo *loop,
    */
   auto loopTripCount = (uint32_t)loop->getCompileTimeTripCount();
 
+  /*
+   * Check if we can afford the copies of the body.
+   * Unrolling saves the control instructions of the iterations merged.
+   */
+  auto loopSize = CodeSizeBudget::getCodeSize(*ls);
+  if ((unrollFactor > 1)
+      && !this->canCloneCode(
+          loop,
+          "Unrolling",
+          loopSize * (unrollFactor - 1),
+          (1.0 - (1.0 / unrollFactor)) / std::max<uint64_t>(loopSize, 1))) {
+    return LoopUnrollResult::Unmodified;
+  }
+
   /*
    * Fetch the LLVM loop abstractions.
    */
@@ -83,8 +138,10 @@ LoopUnrollResult LoopTransformer::unrollLoop(LoopDependenceInfo *loop,
   opts.UnrollRemainder = false;
   opts.ForgetAllSCEV = true;
   OptimizationRemarkEmitter ORE(lsFunction);
+  this->trackChangesOf(*lsFunction);
   auto unrolled =
       UnrollLoop(llvmLoop, opts, &LLVMLoops, &SE, &DT, &AC, &ORE, true);
+  this->updatePDG(*lsFunction);
 
   return unrolled;
 }
@@ -101,12 +158,30 @@ bool LoopTransformer::fullyUnrollLoop(LoopDependenceInfo *loop) {
    */
   auto ls = loop->getLoopStructure();
   auto &loopFunction = *ls->getFunction();
+
+  /*
+   * Check if we can afford a copy of the body per iteration.
+   * Fully unrolling saves the control instructions of all iterations.
+   */
+  if (loop->doesHaveCompileTimeKnownTripCount()) {
+    auto tripCount = loop->getCompileTimeTripCount();
+    auto loopSize = CodeSizeBudget::getCodeSize(*ls);
+    if ((tripCount > 1)
+        && !this->canCloneCode(loop,
+                               "Full unrolling",
+                               loopSize * (tripCount - 1),
+                               1.0 / std::max<uint64_t>(loopSize, 1))) {
+      return false;
+    }
+  }
   auto &LS = getAnalysis<LoopInfoWrapperPass>(loopFunction).getLoopInfo();
   auto &DT = getAnalysis<DominatorTreeWrapperPass>(loopFunction).getDomTree();
   auto &SE = getAnalysis<ScalarEvolutionWrapperPass>(loopFunction).getSE();
   auto &AC =
       getAnalysis<AssumptionCacheTracker>().getAssumptionCache(loopFunction);
+  this->trackChangesOf(loopFunction);
   auto modified = loopUnroll.fullyUnrollLoop(*loop, LS, DT, SE, AC);
+  this->updatePDG(loopFunction);
 
   return modified;
 }
@@ -125,6 +200,16 @@ bool LoopTransformer::whilifyLoop(LoopDependenceInfo *loop) {
   auto scheduler = Scheduler();
   auto loopStructure = loop->getLoopStructure();
   auto func = loopStructure->getFunction();
+
+  /*
+   * Whilification clones the body of the loop.
+   * It only enables other transformations of the loop, so the whole loop is
+   * what could benefit from it.
+   */
+  auto loopSize = CodeSizeBudget::getCodeSize(*loopStructure);
+  auto canCloneLoop = [this, loop, loopSize]() -> bool {
+    return this->canCloneCode(loop, "Whilification", loopSize, 1.0);
+  };
   auto &DT = getAnalysis<DominatorTreeWrapperPass>(*func).getDomTree();
   auto &PDT = getAnalysis<PostDominatorTreeWrapperPass>(*func).getPostDomTree();
   auto DS = new DominatorSummary(DT, PDT);
@@ -133,7 +218,37 @@ bool LoopTransformer::whilifyLoop(LoopDependenceInfo *loop) {
   /*
    * Whilify the loop.
    */
-  auto modified = loopWhilify.whilifyLoop(*loop, scheduler, DS, FDG);
+  this->trackChangesOf(*func);
+  auto modified =
+      loopWhilify.whilifyLoop(*loop, scheduler, DS, FDG, canCloneLoop);
+  this->updatePDG(*func);
+
+  return modified;
+}
+
+bool LoopTransformer::collapseLoopNest(LoopDependenceInfo *outerLoop,
+                                       LoopDependenceInfo *innerLoop) {
+
+  /*
+   * Allocate the collapser
+   */
+  auto loopCollapser = LoopCollapser();
+
+  /*
+   * Fetch the LLVM analyses of the function that includes the loops.
+   */
+  auto ls = outerLoop->getLoopStructure();
+  auto &loopFunction = *ls->getFunction();
+  auto &LI = getAnalysis<LoopInfoWrapperPass>(loopFunction).getLoopInfo();
+  auto &SE = getAnalysis<ScalarEvolutionWrapperPass>(loopFunction).getSE();
+
+  /*
+   * Collapse the loops.
+   */
+  this->trackChangesOf(loopFunction);
+  auto modified =
+      loopCollapser.collapseLoopNest(*outerLoop, *innerLoop, LI, SE);
+  this->updatePDG(loopFunction);
 
   return modified;
 }
@@ -158,12 +273,38 @@ bool LoopTransformer::splitLoop(LoopDependenceInfo *loop,
    * Split the loop.
    */
   LoopDistribution ld;
+  auto loopFunction = loop->getLoopStructure()->getFunction();
+  this->trackChangesOf(*loopFunction);
   auto modified = ld.splitLoop(*loop,
                                SCCsToPullOut,
                                instructionsRemoved,
                                instructionsAdded);
+  this->updatePDG(*loopFunction);
 
   return modified;
 }
 
+void LoopTransformer::trackChangesOf(Function &F) {
+  if (this->pdg == nullptr) {
+    return;
+  }
+
+  this->pdg->trackChangesOf(F);
+
+  return;
+}
+
+void LoopTransformer::updatePDG(Function &F) {
+  if (this->pdg == nullptr) {
+    return;
+  }
+
+  /*
+   * Keep the PDG consistent with the code transformed.
+   */
+  this->pdg->updateChangesOf(F);
+
+  return;
+}
+
 } // namespace arcana::noelle
@@ -86,10 +86,17 @@ public:
    */
   LoopWhilifier();
 
-  bool whilifyLoop(LoopDependenceInfo &LDI,
-                   Scheduler &scheduler,
-                   DominatorSummary *DS,
-                   PDG *FDG);
+  /*
+   * Whilify the loop of @LDI.
+   * @canCloneLoop is invoked right before the blocks of the loop get cloned;
+   * when it returns false, the loop is left untouched.
+   */
+  bool whilifyLoop(
+      LoopDependenceInfo &LDI,
+      Scheduler &scheduler,
+      DominatorSummary *DS,
+      PDG *FDG,
+      std::function<bool(void)> canCloneLoop = []() { return true; });
 
 private:
   /*
@@ -103,7 +110,8 @@ private:
   bool whilifyLoopDriver(LoopStructure *const LS,
                          Scheduler &scheduler,
                          DominatorSummary *DS,
-                         PDG *FDG);
+                         PDG *FDG,
+                         std::function<bool(void)> canCloneLoop);
 
   bool containsInOriginalLoop(WhilifierContext const &WC, BasicBlock *const BB);
 
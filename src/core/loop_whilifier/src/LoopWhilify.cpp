@@ -30,7 +30,8 @@ LoopWhilifier::LoopWhilifier() : outputPrefix{ "Whilifier: " } {
 bool LoopWhilifier::whilifyLoop(LoopDependenceInfo &LDI,
                                 Scheduler &scheduler,
                                 DominatorSummary *DS,
-                                PDG *FDG) {
+                                PDG *FDG,
+                                std::function<bool(void)> canCloneLoop) {
 
   /*
    * Execute on target loop from @LDI
@@ -40,7 +41,7 @@ bool LoopWhilifier::whilifyLoop(LoopDependenceInfo &LDI,
   errs() << outputPrefix << " Try to whilify the target loop\n";
 
   auto LS = LDI.getLoopStructure();
-  AnyTransformed |= whilifyLoopDriver(LS, scheduler, DS, FDG);
+  AnyTransformed |= whilifyLoopDriver(LS, scheduler, DS, FDG, canCloneLoop);
 
   errs() << outputPrefix << " Transformed = " << AnyTransformed << "\n";
   errs() << outputPrefix << "Exit\n";
@@ -51,7 +52,8 @@ bool LoopWhilifier::whilifyLoop(LoopDependenceInfo &LDI,
 bool LoopWhilifier::whilifyLoopDriver(LoopStructure *const LS,
                                       Scheduler &scheduler,
                                       DominatorSummary *DS,
-                                      PDG *FDG) {
+                                      PDG *FDG,
+                                      std::function<bool(void)> canCloneLoop) {
   auto Transformed = false;
 
   /*
@@ -91,6 +93,14 @@ bool LoopWhilifier::whilifyLoopDriver(LoopStructure *const LS,
     return Transformed;
   }
 
+  /*
+   * Check if we can afford the copy of the loop blocks.
+   */
+  if (!canCloneLoop()) {
+    errs() << outputPrefix << "       The code size budget is exhausted\n";
+    return Transformed;
+  }
+
   /*
    * If the loop is a single block, perform necessary transforms
    * for whilifying the loop --- use collected data structures
@@ -36,6 +36,11 @@ public:
    */
   bool doesHaveMetadata(const std::string &metadataName) const;
 
+  /*
+   * Fetch the metadata attached to the module.
+   */
+  std::string getMetadata(const std::string &metadataName) const;
+
   /*
    * Add metadata to the module.
    *
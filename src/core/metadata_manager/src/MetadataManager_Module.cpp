@@ -36,6 +36,25 @@ bool MetadataManager::doesHaveMetadata(const std::string &metadataName) const {
   return true;
 }
 
+std::string MetadataManager::getMetadata(
+    const std::string &metadataName) const {
+
+  /*
+   * Fetch the metadata.
+   */
+  auto metaNode = this->program.getNamedMetadata(metadataName);
+  assert(metaNode != nullptr);
+  assert(metaNode->getNumOperands() > 0);
+
+  /*
+   * Fetch the value.
+   */
+  auto v = metaNode->getOperand(0);
+  auto metaString = cast<MDString>(v->getOperand(0))->getString();
+
+  return metaString.str();
+}
+
 void MetadataManager::addMetadata(const std::string &metadataName,
                                   const std::string &metadataValue) {
 
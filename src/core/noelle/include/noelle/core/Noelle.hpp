@@ -30,6 +30,7 @@
 #include "noelle/core/DataFlow.hpp"
 #include "noelle/core/LoopDependenceInfo.hpp"
 #include "noelle/core/HotProfiler.hpp"
+#include "noelle/core/CodeSizeBudget.hpp"
 #include "noelle/core/Scheduler.hpp"
 #include "noelle/core/MetadataManager.hpp"
 #include "noelle/core/LoopTransformer.hpp"
@@ -185,6 +186,13 @@ public:
 
   PDG *getProgramDependenceGraph(void);
 
+  /*
+   * Update the program dependence graph after the code of the functions given
+   * as input has been modified.
+   */
+  void updateProgramDependenceGraph(
+      const std::set<Function *> &modifiedFunctions);
+
   DataFlowAnalysis getDataFlowAnalyses(void) const;
 
   CFGAnalysis getCFGAnalysis(void) const;
@@ -201,10 +209,29 @@ public:
 
   DominatorSummary *getDominators(Function *f);
 
+  /*
+   * Return the scalar evolution of the function given as input.
+   * The result is valid until the next request of an LLVM analysis.
+   */
+  ScalarEvolution *getScalarEvolution(Function *f);
+
   Verbosity getVerbosity(void) const;
 
   double getMinimumHotness(void) const;
 
+  /*
+   * Return the hotness-driven budget of the dependence analyses.
+   * Return nullptr if every part of the program is analyzed with the same
+   * precision.
+   */
+  AnalysisBudget *getAnalysisBudget(void);
+
+  /*
+   * Return the budget of the code that transformations can clone.
+   * Return nullptr if the program can grow without limits.
+   */
+  CodeSizeBudget *getCodeSizeBudget(void);
+
   uint64_t numberOfProgramInstructions(void) const;
 
   /**
@@ -231,6 +258,10 @@ public:
 private:
   Verbosity verbose;
   double minHot;
+  double minHotForPreciseAnalyses;
+  AnalysisBudget *analysisBudget;
+  double maxCodeGrowth;
+  CodeSizeBudget *codeSizeBudget;
   Module *program;
   Hot *profiles;
   PDG *programDependenceGraph;
@@ -243,6 +274,7 @@ private:
   std::map<uint32_t, uint32_t> loopThreads;
   std::map<uint32_t, uint32_t> techniquesToDisable;
   std::map<uint32_t, uint32_t> DOALLChunkSize;
+  std::map<uint32_t, uint32_t> HELIXIterationBlockSize;
   FunctionsManager *fm;
   GlobalsManager *gm;
   TypesManager *tm;
@@ -29,6 +29,10 @@ Noelle::Noelle()
   : ModulePass{ ID },
     verbose{ Verbosity::Disabled },
     minHot{ 0.0 },
+    minHotForPreciseAnalyses{ -1.0 },
+    analysisBudget{ nullptr },
+    maxCodeGrowth{ -1.0 },
+    codeSizeBudget{ nullptr },
     program{ nullptr },
     profiles{ nullptr },
     programDependenceGraph{ nullptr },
@@ -97,6 +101,87 @@ double Noelle::getMinimumHotness(void) const {
   return this->minHot;
 }
 
+AnalysisBudget *Noelle::getAnalysisBudget(void) {
+
+  /*
+   * Check if the hotness-driven budget has been requested.
+   */
+  if (this->minHotForPreciseAnalyses < 0) {
+    return nullptr;
+  }
+
+  /*
+   * Check if we have already created the budget.
+   */
+  if (this->analysisBudget != nullptr) {
+    return this->analysisBudget;
+  }
+
+  /*
+   * Check if the profiles are available.
+   * Without them, all code is considered hot.
+   */
+  auto hot = this->getProfiles();
+  if (!hot->isAvailable()) {
+    return nullptr;
+  }
+
+  /*
+   * Create the budget.
+   */
+  auto functionCoverage = [hot](Function *f) -> double {
+    return hot->getDynamicTotalInstructionCoverage(f);
+  };
+  this->analysisBudget =
+      new AnalysisBudget(this->minHotForPreciseAnalyses, functionCoverage);
+
+  return this->analysisBudget;
+}
+
+CodeSizeBudget *Noelle::getCodeSizeBudget(void) {
+
+  /*
+   * Check if the budget has been requested.
+   */
+  if (this->maxCodeGrowth < 0) {
+    return nullptr;
+  }
+
+  /*
+   * Check if we have already created the budget.
+   */
+  if (this->codeSizeBudget != nullptr) {
+    return this->codeSizeBudget;
+  }
+
+  /*
+   * Fetch the original size of the program.
+   *
+   * The budget spans all the tools that transform the program. So, the
+   * original size is recorded in the program the first time the budget is
+   * used.
+   */
+  auto mm = this->getMetadataManager();
+  auto currentCodeSize = CodeSizeBudget::getCodeSize(*this->program);
+  uint64_t originalCodeSize = currentCodeSize;
+  if (mm->doesHaveMetadata("noelle.codesize.original")) {
+    originalCodeSize = std::stoull(mm->getMetadata("noelle.codesize.original"));
+  } else {
+    mm->addMetadata("noelle.codesize.original",
+                    std::to_string(originalCodeSize));
+  }
+
+  /*
+   * Create the budget.
+   */
+  this->codeSizeBudget = new CodeSizeBudget(this->getProfiles(),
+                                            originalCodeSize,
+                                            currentCodeSize,
+                                            this->maxCodeGrowth);
+
+  return this->codeSizeBudget;
+}
+
 Hot *Noelle::getProfiles(void) {
   if (this->profiles == nullptr) {
     this->profiles = &getAnalysis<HotProfiler>().getHot();
@@ -133,6 +218,7 @@ LoopTransformer &Noelle::getLoopTransformer(void) {
   auto &lt = getAnalysis<LoopTransformer>();
   auto pdg = this->getProgramDependenceGraph();
   lt.setPDG(pdg);
+  lt.setCodeSizeBudget(this->getCodeSizeBudget());
   return lt;
 }
 
@@ -152,6 +238,22 @@ uint64_t Noelle::numberOfProgramInstructions(void) const {
 
 Noelle::~Noelle() {
 
+  /*
+   * Report the time spent analyzing code per hotness.
+   */
+  if (this->analysisBudget != nullptr) {
+    this->analysisBudget->printReport(errs(), "Noelle: ");
+    delete this->analysisBudget;
+  }
+
+  /*
+   * Report the code cloned and the code rejected by the budget.
+   */
+  if (this->codeSizeBudget != nullptr) {
+    this->codeSizeBudget->printReport(errs(), "Noelle: ");
+    delete this->codeSizeBudget;
+  }
+
   return;
 }
 
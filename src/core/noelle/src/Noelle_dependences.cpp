@@ -25,12 +25,40 @@ namespace arcana::noelle {
 
 PDG *Noelle::getProgramDependenceGraph(void) {
   if (this->programDependenceGraph == nullptr) {
+
+    /*
+     * Cold code is analyzed conservatively if requested.
+     */
+    auto budget = this->getAnalysisBudget();
+    if (budget != nullptr) {
+      this->pdgAnalysis->setAnalysisBudget(budget);
+    }
+
     this->programDependenceGraph = this->pdgAnalysis->getPDG();
   }
 
   return this->programDependenceGraph;
 }
 
+void Noelle::updateProgramDependenceGraph(
+    const std::set<Function *> &modifiedFunctions) {
+
+  /*
+   * Check if the PDG has been computed already.
+   * If it hasn't, then it will be computed from the current code when needed.
+   */
+  if (this->programDependenceGraph == nullptr) {
+    return;
+  }
+
+  /*
+   * Recompute the dependences of the modified functions.
+   */
+  this->pdgAnalysis->updatePDG(modifiedFunctions);
+
+  return;
+}
+
 PDG *Noelle::getFunctionDependenceGraph(Function *f) {
 
   /*
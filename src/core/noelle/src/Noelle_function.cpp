@@ -40,6 +40,12 @@ DominatorSummary *Noelle::getDominators(Function *f) {
   return ds;
 }
 
+ScalarEvolution *Noelle::getScalarEvolution(Function *f) {
+  auto &SE = getAnalysis<ScalarEvolutionWrapperPass>(*f).getSE();
+
+  return &SE;
+}
+
 FunctionsManager *Noelle::getFunctionsManager(void) {
   if (!this->fm) {
     this->fm = new FunctionsManager(*this->program,
@@ -20,6 +20,7 @@
  OR OTHER DEALINGS IN THE SOFTWARE.
  */
 #include <algorithm>
+#include <chrono>
 
 #include "noelle/core/SystemHeaders.hpp"
 #include "noelle/core/LoopStructure.hpp"
@@ -997,12 +998,25 @@ bool Noelle::checkToGetLoopFilteringInfo(void) {
                           This is because chunk size must start from 1.
                          */
 
+    /*
+     * HELIX: should we fix the number of consecutive iterations executed by a
+     * core between synchronizations?
+     */
+    auto HELIXFixIterationBlock = this->fetchTheNextValue(indexString);
+
+    /*
+     * HELIX: iteration block factor
+     */
+    auto HELIXIterationBlockFactor = this->fetchTheNextValue(indexString);
+    HELIXIterationBlockFactor++; /*
+                                   The block size is the one defined by
+                                   INDEX_FILE + 1 (it must start from 1).
+                                  */
+
     /*
      * Skip
      */
     this->fetchTheNextValue(indexString);
-    this->fetchTheNextValue(indexString);
-    this->fetchTheNextValue(indexString);
 
     /*
      * If the loop needs to be parallelized, then we enable it.
@@ -1011,6 +1025,8 @@ bool Noelle::checkToGetLoopFilteringInfo(void) {
       this->loopThreads[loopID] = cores;
       this->techniquesToDisable[loopID] = technique;
       this->DOALLChunkSize[loopID] = DOALLChunkFactor;
+      this->HELIXIterationBlockSize[loopID] =
+          HELIXFixIterationBlock ? HELIXIterationBlockFactor : 0;
 
     } else {
       this->loopThreads[loopID] = 1;
@@ -1019,6 +1035,7 @@ bool Noelle::checkToGetLoopFilteringInfo(void) {
                             DOALL chunk size is the one defined by INDEX_FILE
                             + 1. This is because chunk size must start from 1.
                            */
+      this->HELIXIterationBlockSize[loopID] = 0;
     }
   }
 
@@ -1322,9 +1339,24 @@ LoopDependenceInfo *Noelle::getLoopDependenceInfoForLoop(
     std::unordered_set<LoopDependenceInfoOptimization> optimizations,
     bool enableLoopAwareDependenceAnalysis) {
 
+  /*
+   * Check if the loop is cold and therefore it should be analyzed
+   * conservatively.
+   */
+  auto budget = this->getAnalysisBudget();
+  double loopCoverage = 1;
+  if (budget != nullptr) {
+    auto hot = this->getProfiles();
+    loopCoverage = hot->getDynamicTotalInstructionCoverage(loopNode->getLoop());
+    if (budget->shouldBeAnalyzedConservatively(loopCoverage)) {
+      enableLoopAwareDependenceAnalysis = false;
+    }
+  }
+
   /*
    * Allocate the LDI.
    */
+  auto start = std::chrono::steady_clock::now();
   auto ldi = new LoopDependenceInfo(this->getCompilationOptionsManager(),
                                     functionPDG,
                                     loopNode,
@@ -1335,6 +1367,15 @@ LoopDependenceInfo *Noelle::getLoopDependenceInfoForLoop(
                                     optimizations,
                                     enableLoopAwareDependenceAnalysis,
                                     DOALLChunkSizeForLoop);
+  auto end = std::chrono::steady_clock::now();
+
+  /*
+   * Account the time spent analyzing the loop.
+   */
+  if (budget != nullptr) {
+    std::chrono::duration<double> elapsed = end - start;
+    budget->addAnalysisTime(loopCoverage, elapsed.count());
+  }
 
   /*
    * Set the techniques that are enabled.
@@ -1378,6 +1419,15 @@ LoopDependenceInfo *Noelle::getLoopDependenceInfoForLoop(
       abort();
   }
 
+  /*
+   * Set the iteration block size of HELIX if the autotuner fixed it.
+   */
+  auto loopIDOpt = loopNode->getLoop()->getID();
+  if (this->hasReadFilterFile && loopIDOpt) {
+    auto loopID = loopIDOpt.value();
+    ltm->setIterationBlockSize(this->HELIXIterationBlockSize[loopID]);
+  }
+
   return ldi;
 }
 
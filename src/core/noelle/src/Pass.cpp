@@ -36,6 +36,18 @@ static cl::opt<int> MinimumHotness(
     cl::ZeroOrMore,
     cl::Hidden,
     cl::desc("Minimum hotness of code to be parallelized"));
+static cl::opt<int> MinimumHotnessForPreciseAnalyses(
+    "noelle-min-hot-precise-analyses",
+    cl::ZeroOrMore,
+    cl::Hidden,
+    cl::desc(
+        "Minimum hotness of code to be analyzed with the expensive dependence analyses"));
+static cl::opt<int> MaximumCodeGrowth(
+    "noelle-max-code-growth",
+    cl::ZeroOrMore,
+    cl::Hidden,
+    cl::desc(
+        "Maximum size of the program, as a percentage of its original size, that transformations can reach by cloning code"));
 static cl::opt<int> MaximumCores(
     "noelle-max-cores",
     cl::ZeroOrMore,
@@ -76,6 +88,11 @@ static cl::opt<bool> DisableWhilifier("noelle-disable-whilifier",
                                       cl::ZeroOrMore,
                                       cl::Hidden,
                                       cl::desc("Disable the loop whilifier"));
+static cl::opt<bool> DisableLoopCollapsing(
+    "noelle-disable-loop-collapsing",
+    cl::ZeroOrMore,
+    cl::Hidden,
+    cl::desc("Disable the loop collapsing"));
 static cl::opt<bool> DisableSCEVSimplification(
     "noelle-disable-scev-simplification",
     cl::ZeroOrMore,
@@ -115,6 +132,14 @@ bool Noelle::doInitialization(Module &M) {
   this->hasReadFilterFile = false;
   this->verbose = static_cast<Verbosity>(Verbose.getValue());
   this->minHot = ((double)(MinimumHotness.getValue())) / 1000;
+  if (MinimumHotnessForPreciseAnalyses.getNumOccurrences() > 0) {
+    this->minHotForPreciseAnalyses =
+        ((double)(MinimumHotnessForPreciseAnalyses.getValue())) / 1000;
+  }
+  if (MaximumCodeGrowth.getNumOccurrences() > 0) {
+    this->maxCodeGrowth =
+        std::max(((double)(MaximumCodeGrowth.getValue())) / 100, 1.0);
+  }
   auto optMaxCores = MaximumCores.getValue();
   if (optMaxCores == 0) {
     optMaxCores = Architecture::getNumberOfPhysicalCores();
@@ -137,6 +162,9 @@ bool Noelle::doInitialization(Module &M) {
   if (DisableWhilifier.getNumOccurrences() > 0) {
     this->enabledTransformations.erase(LOOP_WHILIFIER_ID);
   }
+  if (DisableLoopCollapsing.getNumOccurrences() > 0) {
+    this->enabledTransformations.erase(LOOP_COLLAPSING_ID);
+  }
   if (DisableSCEVSimplification.getNumOccurrences() > 0) {
     this->enabledTransformations.erase(SCEV_SIMPLIFICATION_ID);
   }
@@ -22,6 +22,7 @@
 #pragma once
 
 #include "noelle/core/SystemHeaders.hpp"
+#include "llvm/Analysis/PostDominators.h"
 #include "noelle/core/DGBase.hpp"
 
 namespace arcana::noelle {
@@ -119,6 +120,85 @@ public:
    */
   DGEdge<Value, Value> *addEdge(Value *from, Value *to);
 
+  /*
+   * Add a node per instruction and argument of the function F.
+   */
+  void addNodesOf(Function &F);
+
+  /*
+   * Remove the nodes of the instructions and arguments of the function F that
+   * have been added to the PDG, together with their dependences.
+   *
+   * The instructions of F do not need to exist anymore (e.g., they have been
+   * erased by a transformation).
+   */
+  void removeNodesOf(Function &F);
+
+  /*
+   * Add the control dependences between the instructions of the function F,
+   * which are computed from its post-dominator tree.
+   */
+  void addControlDependencesOf(Function &F, PostDominatorTree &postDomTree);
+
+  /*
+   * Incremental updates.
+   *
+   * Transformations invoke the next methods to keep the dependences of the PDG
+   * consistent with the code they rewrite. Register dependences are derived
+   * from the current IR. Memory and control dependences of new instructions
+   * are inherited from the instructions they originate from.
+   */
+
+  /*
+   * Add the clones of instructions of the PDG.
+   * The keys of clonesToOriginals are the clones and the values are the
+   * instructions they have been cloned from.
+   */
+  void addClonedInstructions(
+      std::unordered_map<Instruction *, Instruction *> const
+          &clonesToOriginals);
+
+  void addClonedInstruction(Instruction *original, Instruction *clone);
+
+  /*
+   * Add an instruction that has not been cloned from an existing one.
+   * If it accesses memory, then it conservatively depends on all memory
+   * instructions of its function.
+   * If it is a terminator, then the control dependences of its function are
+   * computed again.
+   */
+  void addInstruction(Instruction *newInstruction);
+
+  /*
+   * The uses of oldValue have been replaced with newValue (e.g., by invoking
+   * replaceAllUsesWith).
+   */
+  void replaceValue(Value *oldValue, Value *newValue);
+
+  /*
+   * The instruction i is about to be erased from its function.
+   */
+  void eraseInstruction(Instruction *i);
+
+  /*
+   * The instruction i has been moved to a different basic block.
+   */
+  void moveInstruction(Instruction *i);
+
+  /*
+   * Track the changes applied to F by a transformation that does not expose
+   * them (e.g., LLVM utilities). Once the transformation is done,
+   * updateChangesOf(F) updates the PDG by invoking the methods above.
+   * The register dependences of the instructions whose operands have been
+   * changed are updated as well. If the CFG of F has changed, then the control
+   * dependences of F are computed again.
+   * Functions created by the transformation that include clones of
+   * instructions of F (e.g., tasks) are added to the PDG.
+   */
+  void trackChangesOf(Function &F);
+
+  void updateChangesOf(Function &F);
+
   /*
    * Creating Program Dependence Subgraphs
    */
@@ -142,10 +222,44 @@ public:
   ~PDG();
 
 protected:
-  void addNodesOf(Function &F);
+  std::unordered_map<Function *, std::unordered_set<Value *>> functionValues;
+  std::unordered_map<Function *,
+                     std::vector<std::pair<Instruction *, BasicBlock *>>>
+      trackedInstructions;
+  std::unordered_map<Function *,
+                     std::vector<std::pair<BasicBlock *, BasicBlock *>>>
+      trackedCFGs;
 
   void setEntryPointAt(Function &F);
 
+  void removeNodeOf(Function *F, Value *v);
+
+  DGEdge<Value, Value> *copyEdge(DGEdge<Value, Value> &edgeToCopy,
+                                 Value *from,
+                                 Value *to);
+
+  bool isRegisterDependence(DGEdge<Value, Value> *edge) const;
+
+  void addRegisterDependences(Value *v);
+
+  void updateRegisterDependences(Instruction *i);
+
+  void addInstructionWithoutControlDependences(Instruction *newInstruction);
+
+  void addNewFunction(
+      Function &newF,
+      std::unordered_map<Instruction *, Instruction *> const
+          &clonesToOriginals);
+
+  void recomputeControlDependencesOf(Function &F);
+
+  std::vector<std::pair<BasicBlock *, BasicBlock *>> getCFGEdgesOf(
+      Function &F) const;
+
+  void copyControlDependencesFromBasicBlock(Instruction *i);
+
+  void addMemoryDependencesConservatively(Instruction *i);
+
   void copyEdgesInto(PDG *newPDG, bool linkToExternal);
 
   void copyEdgesInto(
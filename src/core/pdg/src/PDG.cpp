@@ -99,17 +99,51 @@ PDG::PDG(std::vector<Value *> &values) {
 }
 
 void PDG::addNodesOf(Function &F) {
+  auto &values = this->functionValues[&F];
   for (auto &arg : F.args()) {
     addNode(cast<Value>(&arg), /*inclusion=*/true);
+    values.insert(&arg);
   }
 
   for (auto &B : F) {
     for (auto &I : B) {
       addNode(cast<Value>(&I), /*inclusion=*/true);
+      values.insert(&I);
     }
   }
 }
 
+void PDG::removeNodesOf(Function &F) {
+
+  /*
+   * Fetch the values of F that have been added to the PDG.
+   *
+   * Notice that these values might not exist anymore, so we cannot inspect
+   * them.
+   */
+  auto valuesIt = this->functionValues.find(&F);
+  if (valuesIt == this->functionValues.end()) {
+    return;
+  }
+
+  /*
+   * Remove the nodes and their dependences.
+   */
+  for (auto value : valuesIt->second) {
+    if (!this->isInGraph(value)) {
+      continue;
+    }
+    auto node = this->fetchNode(value);
+    if (node == this->entryNode) {
+      this->entryNode = nullptr;
+    }
+    this->removeNode(node);
+  }
+  this->functionValues.erase(valuesIt);
+
+  return;
+}
+
 void PDG::setEntryPointAt(Function &F) {
   auto entryInstr = &*(F.begin()->begin());
   entryNode = internalNodeMap[entryInstr];
@@ -0,0 +1,798 @@
+/*
+ * Copyright 2023  Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do
+ so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "noelle/core/PDG.hpp"
+
+namespace arcana::noelle {
+
+static const char *trackingMetadataName = "noelle.pdg.tracking";
+
+/*
+ * A tracking tag is a pair: the index of the tracked instruction and the
+ * function that is tracked.
+ */
+static Function *getTrackedFunctionOf(MDNode *tag) {
+  return cast<Function>(
+      cast<ConstantAsMetadata>(tag->getOperand(1))->getValue());
+}
+
+static uint64_t getTrackedIndexOf(MDNode *tag) {
+  return cast<ConstantInt>(
+             cast<ConstantAsMetadata>(tag->getOperand(0))->getValue())
+      ->getZExtValue();
+}
+
+static Function *getFunctionOf(Value *v) {
+  if (auto inst = dyn_cast<Instruction>(v)) {
+    return inst->getFunction();
+  }
+  if (auto arg = dyn_cast<Argument>(v)) {
+    return arg->getParent();
+  }
+  return nullptr;
+}
+
+void PDG::addClonedInstruction(Instruction *original, Instruction *clone) {
+  std::unordered_map<Instruction *, Instruction *> clonesToOriginals;
+  clonesToOriginals[clone] = original;
+
+  this->addClonedInstructions(clonesToOriginals);
+
+  return;
+}
+
+void PDG::addClonedInstructions(
+    std::unordered_map<Instruction *, Instruction *> const &clonesToOriginals) {
+
+  /*
+   * Take a snapshot of the memory and control dependences of the original
+   * instructions.
+   *
+   * This needs to be done before adding any node: a clone might reuse the
+   * memory of an instruction that has been erased, and whose node is therefore
+   * stale.
+   */
+  using Dependence = std::tuple<DGEdge<Value, Value>, Value *, Value *>;
+  std::unordered_map<Value *, std::vector<Dependence>> dependencesOfOriginals;
+  std::unordered_map<Value *, std::vector<Instruction *>> originalsToClones;
+  for (auto pair : clonesToOriginals) {
+    auto clone = pair.first;
+    auto original = pair.second;
+    originalsToClones[original].push_back(clone);
+    if (dependencesOfOriginals.find(original)
+        != dependencesOfOriginals.end()) {
+      continue;
+    }
+    auto &dependences = dependencesOfOriginals[original];
+    if (!this->isInGraph(original)) {
+      continue;
+    }
+    auto originalNode = this->fetchNode(original);
+    for (auto edge : originalNode->getOutgoingEdges()) {
+      if (this->isRegisterDependence(edge)) {
+        continue;
+      }
+      dependences.push_back(
+          std::make_tuple(*edge, edge->getSrc(), edge->getDst()));
+    }
+    for (auto edge : originalNode->getIncomingEdges()) {
+      if (this->isRegisterDependence(edge)) {
+        continue;
+      }
+      if (edge->getSrc() == original) {
+
+        /*
+         * Self dependences have been collected already as outgoing ones.
+         */
+        continue;
+      }
+      dependences.push_back(
+          std::make_tuple(*edge, edge->getSrc(), edge->getDst()));
+    }
+  }
+
+  /*
+   * Add the nodes of the clones.
+   */
+  for (auto pair : clonesToOriginals) {
+    auto clone = pair.first;
+    auto F = clone->getFunction();
+    this->removeNodeOf(F, clone);
+    this->addNode(clone, true);
+    this->functionValues[F].insert(clone);
+  }
+
+  /*
+   * Add the memory and control dependences of the clones.
+   *
+   * The dependences of an original instruction are inherited by all its
+   * clones. A dependence between two original instructions is inherited by all
+   * pairs of their clones because we do not know which clones belong to the
+   * same copy of the code.
+   *
+   * Dependences never cross function boundaries, so a clone only inherits the
+   * dependences with instructions of its own function. Clones placed in a
+   * function different from the one of their original do not inherit control
+   * dependences: those depend on the CFG of the new function.
+   */
+  auto fetchCopies = [&originalsToClones](Value *v,
+                                          Function *F) -> std::vector<Value *> {
+    std::vector<Value *> copies;
+    auto it = originalsToClones.find(v);
+    if (it != originalsToClones.end()) {
+      for (auto clone : it->second) {
+        if (clone->getFunction() == F) {
+          copies.push_back(clone);
+        }
+      }
+    }
+    auto functionOfV = getFunctionOf(v);
+    if ((functionOfV == nullptr) || (functionOfV == F)) {
+      copies.push_back(v);
+    }
+    return copies;
+  };
+  for (auto pair : clonesToOriginals) {
+    auto clone = pair.first;
+    auto original = pair.second;
+    auto cloneF = clone->getFunction();
+    auto isClonedInItsFunction = (original->getFunction() == cloneF);
+    for (auto &dependence : dependencesOfOriginals.at(original)) {
+      auto &edge = std::get<0>(dependence);
+      auto src = std::get<1>(dependence);
+      auto dst = std::get<2>(dependence);
+      if (edge.isControlDependence() && !isClonedInItsFunction) {
+        continue;
+      }
+
+      /*
+       * Replace the original instruction with the clone.
+       * The other end of the dependence is either an instruction that has not
+       * been cloned or any of its copies.
+       */
+      if (src == original) {
+        for (auto dstCopy : fetchCopies(dst, cloneF)) {
+          if (this->isInGraph(dstCopy)) {
+            this->copyEdge(edge, clone, dstCopy);
+          }
+        }
+      }
+      if ((dst == original) && isClonedInItsFunction && this->isInGraph(src)) {
+        this->copyEdge(edge, src, clone);
+      }
+    }
+  }
+
+  /*
+   * Add the register dependences of the clones.
+   */
+  for (auto pair : clonesToOriginals) {
+    auto clone = pair.first;
+    this->addRegisterDependences(clone);
+  }
+
+  return;
+}
+
+void PDG::addInstruction(Instruction *newInstruction) {
+
+  /*
+   * Add the node and its data dependences.
+   */
+  this->addInstructionWithoutControlDependences(newInstruction);
+
+  /*
+   * Add the control dependences.
+   *
+   * A new terminator (e.g., a conditional branch) can change the control
+   * dependences of any instruction of its function.
+   */
+  if (newInstruction->isTerminator()) {
+    this->recomputeControlDependencesOf(*newInstruction->getFunction());
+  } else {
+    this->copyControlDependencesFromBasicBlock(newInstruction);
+  }
+
+  return;
+}
+
+void PDG::addInstructionWithoutControlDependences(
+    Instruction *newInstruction) {
+  auto F = newInstruction->getFunction();
+
+  /*
+   * Add the node.
+   */
+  this->removeNodeOf(F, newInstruction);
+  this->addNode(newInstruction, true);
+  this->functionValues[F].insert(newInstruction);
+
+  /*
+   * Add the data dependences.
+   */
+  this->addRegisterDependences(newInstruction);
+  if (newInstruction->mayReadOrWriteMemory()) {
+    this->addMemoryDependencesConservatively(newInstruction);
+  }
+
+  return;
+}
+
+void PDG::replaceValue(Value *oldValue, Value *newValue) {
+  if (!this->isInGraph(oldValue)) {
+    return;
+  }
+
+  /*
+   * Collect the register dependences that now start from newValue.
+   */
+  std::vector<DGEdge<Value, Value> *> dependences;
+  auto oldNode = this->fetchNode(oldValue);
+  for (auto edge : oldNode->getOutgoingEdges()) {
+    if (this->isRegisterDependence(edge)) {
+      dependences.push_back(edge);
+    }
+  }
+
+  /*
+   * Move the register dependences.
+   * Constants are not part of the PDG, so there is no dependence to add for
+   * them.
+   */
+  for (auto edge : dependences) {
+    auto user = edge->getDst();
+    this->removeEdge(edge);
+    if (!this->isInGraph(newValue)) {
+      continue;
+    }
+    if (user == oldValue) {
+      continue;
+    }
+    auto newEdge = this->addEdge(newValue, user);
+    newEdge->setMemMustType(false, true, DG_DATA_RAW);
+  }
+
+  return;
+}
+
+void PDG::eraseInstruction(Instruction *i) {
+  this->removeNodeOf(i->getFunction(), i);
+
+  return;
+}
+
+void PDG::moveInstruction(Instruction *i) {
+  if (!this->isInGraph(i)) {
+    return;
+  }
+
+  /*
+   * Remove the control dependences of the old basic block.
+   */
+  std::vector<DGEdge<Value, Value> *> controlDependences;
+  auto node = this->fetchNode(i);
+  for (auto edge : node->getIncomingEdges()) {
+    if (edge->isControlDependence()) {
+      controlDependences.push_back(edge);
+    }
+  }
+  for (auto edge : controlDependences) {
+    this->removeEdge(edge);
+  }
+
+  /*
+   * Add the control dependences of the new basic block.
+   */
+  this->copyControlDependencesFromBasicBlock(i);
+
+  return;
+}
+
+void PDG::trackChangesOf(Function &F) {
+
+  /*
+   * Tag every instruction of F with F and its index in the list of tracked
+   * instructions. Clones inherit the tag of the instruction they have been
+   * cloned from, even when they are placed in other functions.
+   */
+  auto &cxt = F.getContext();
+  auto int64Type = Type::getInt64Ty(cxt);
+  auto trackedFunction = ConstantAsMetadata::get(&F);
+  auto &tracked = this->trackedInstructions[&F];
+  tracked.clear();
+  for (auto &I : instructions(F)) {
+    auto index = ConstantInt::get(int64Type, tracked.size());
+    auto tag =
+        MDNode::get(cxt, { ConstantAsMetadata::get(index), trackedFunction });
+    I.setMetadata(trackingMetadataName, tag);
+    tracked.push_back(std::make_pair(&I, I.getParent()));
+  }
+
+  /*
+   * Keep track of the CFG of F to know whether its control dependences need to
+   * be computed again.
+   */
+  this->trackedCFGs[&F] = this->getCFGEdgesOf(F);
+
+  return;
+}
+
+void PDG::updateChangesOf(Function &F) {
+  auto trackedIt = this->trackedInstructions.find(&F);
+  assert(trackedIt != this->trackedInstructions.end());
+  auto &tracked = trackedIt->second;
+  auto trackingKind = F.getContext().getMDKindID(trackingMetadataName);
+
+  /*
+   * Classify the instructions of F by looking at their tags.
+   *
+   * Instructions that carry the tag of another function are clones of
+   * instructions of a function that is still tracked: they are new for F, and
+   * their tag is removed when their function gets updated.
+   */
+  std::unordered_map<Instruction *, Instruction *> clonesToOriginals;
+  std::unordered_set<Instruction *> keptInstructions;
+  std::unordered_set<Instruction *> newInstructions;
+  std::vector<Instruction *> movedInstructions;
+  for (auto &I : instructions(F)) {
+    auto tag = I.getMetadata(trackingKind);
+    if ((tag == nullptr) || (getTrackedFunctionOf(tag) != &F)) {
+      newInstructions.insert(&I);
+      continue;
+    }
+    I.setMetadata(trackingKind, nullptr);
+    auto &originalPair = tracked.at(getTrackedIndexOf(tag));
+    auto original = originalPair.first;
+    if (original != &I) {
+      clonesToOriginals[&I] = original;
+      continue;
+    }
+    keptInstructions.insert(&I);
+    if (I.getParent() != originalPair.second) {
+      movedInstructions.push_back(&I);
+    }
+  }
+
+  /*
+   * Remove the tags of F from the other functions of the module.
+   *
+   * Instructions of F might have been cloned into other functions (e.g., the
+   * tasks of a parallelized loop). Their tags must not outlive the tracking of
+   * F, or a later tracking would mistake these clones for instructions it
+   * knows.
+   *
+   * Functions that are not part of the PDG (e.g., tasks created while F was
+   * tracked) are added to it: their clones of instructions of F inherit the
+   * dependences of the original instructions.
+   */
+  std::vector<Function *> newFunctions;
+  for (auto &otherF : *F.getParent()) {
+    if (&otherF == &F) {
+      continue;
+    }
+    auto isInPDG = (this->functionValues.find(&otherF)
+                    != this->functionValues.end());
+    auto includesClones = false;
+    for (auto &I : instructions(otherF)) {
+      auto tag = I.getMetadata(trackingKind);
+      if ((tag == nullptr) || (getTrackedFunctionOf(tag) != &F)) {
+        continue;
+      }
+      I.setMetadata(trackingKind, nullptr);
+      includesClones = true;
+      if (!isInPDG) {
+        clonesToOriginals[&I] = tracked.at(getTrackedIndexOf(tag)).first;
+      }
+    }
+    if (includesClones && !isInPDG) {
+      newFunctions.push_back(&otherF);
+    }
+  }
+
+  /*
+   * Update the PDG.
+   *
+   * Clones are added first because they inherit the dependences of their
+   * original instructions, which might have been erased.
+   */
+  this->addClonedInstructions(clonesToOriginals);
+  for (auto &originalPair : tracked) {
+    auto original = originalPair.first;
+    if ((keptInstructions.find(original) != keptInstructions.end())
+        || (clonesToOriginals.find(original) != clonesToOriginals.end())
+        || (newInstructions.find(original) != newInstructions.end())) {
+      continue;
+    }
+    this->removeNodeOf(&F, original);
+  }
+  for (auto newInstruction : newInstructions) {
+    this->addInstructionWithoutControlDependences(newInstruction);
+  }
+  for (auto keptInstruction : keptInstructions) {
+    this->updateRegisterDependences(keptInstruction);
+  }
+  for (auto newF : newFunctions) {
+    this->addNewFunction(*newF, clonesToOriginals);
+  }
+
+  /*
+   * Update the control dependences.
+   *
+   * They need to be computed again if the CFG of F has changed or if a
+   * terminator has been added (its old version has no dependences anymore).
+   */
+  auto trackedCFGIt = this->trackedCFGs.find(&F);
+  assert(trackedCFGIt != this->trackedCFGs.end());
+  auto recomputeControlDependences =
+      (this->getCFGEdgesOf(F) != trackedCFGIt->second);
+  for (auto newInstruction : newInstructions) {
+    if (newInstruction->isTerminator()) {
+      recomputeControlDependences = true;
+      break;
+    }
+  }
+  if (recomputeControlDependences) {
+    this->recomputeControlDependencesOf(F);
+
+  } else {
+    for (auto newInstruction : newInstructions) {
+      this->copyControlDependencesFromBasicBlock(newInstruction);
+    }
+    for (auto movedInstruction : movedInstructions) {
+      this->moveInstruction(movedInstruction);
+    }
+  }
+
+  /*
+   * Set the entry node in case the old one has been erased.
+   */
+  if (this->entryNode == nullptr) {
+    this->setEntryPointAt(F);
+  }
+  this->trackedInstructions.erase(trackedIt);
+  this->trackedCFGs.erase(trackedCFGIt);
+
+  return;
+}
+
+void PDG::addNewFunction(
+    Function &newF,
+    std::unordered_map<Instruction *, Instruction *> const
+        &clonesToOriginals) {
+
+  /*
+   * Add the arguments.
+   */
+  for (auto &arg : newF.args()) {
+    this->removeNodeOf(&newF, &arg);
+    this->addNode(&arg, true);
+    this->functionValues[&newF].insert(&arg);
+    this->addRegisterDependences(&arg);
+  }
+
+  /*
+   * Add the instructions that are not clones.
+   * Clones have been added already with the dependences they inherit.
+   */
+  for (auto &I : instructions(newF)) {
+    if (clonesToOriginals.find(&I) != clonesToOriginals.end()) {
+      continue;
+    }
+    this->addInstructionWithoutControlDependences(&I);
+  }
+
+  /*
+   * Add the control dependences of the new function.
+   */
+  this->recomputeControlDependencesOf(newF);
+
+  return;
+}
+
+void PDG::removeNodeOf(Function *F, Value *v) {
+  if (!this->isInGraph(v)) {
+    return;
+  }
+
+  /*
+   * Remove the node and its dependences.
+   */
+  auto node = this->fetchNode(v);
+  if (node == this->entryNode) {
+    this->entryNode = nullptr;
+  }
+  this->removeNode(node);
+
+  /*
+   * Remove the value from the index of F.
+   */
+  auto valuesIt = this->functionValues.find(F);
+  if (valuesIt != this->functionValues.end()) {
+    valuesIt->second.erase(v);
+  }
+
+  return;
+}
+
+DGEdge<Value, Value> *PDG::copyEdge(DGEdge<Value, Value> &edgeToCopy,
+                                    Value *from,
+                                    Value *to) {
+  auto edge = new DGEdge<Value, Value>(edgeToCopy);
+  this->allEdges.insert(edge);
+
+  /*
+   * Connect the copy to the new nodes.
+   */
+  auto fromNode = this->fetchNode(from);
+  auto toNode = this->fetchNode(to);
+  edge->setNodePair(fromNode, toNode);
+  fromNode->addOutgoingEdge(edge);
+  toNode->addIncomingEdge(edge);
+
+  return edge;
+}
+
+bool PDG::isRegisterDependence(DGEdge<Value, Value> *edge) const {
+  if (edge->isControlDependence()) {
+    return false;
+  }
+  if (edge->isMemoryDependence()) {
+    return false;
+  }
+
+  return true;
+}
+
+void PDG::addRegisterDependences(Value *v) {
+  auto node = this->fetchNode(v);
+
+  /*
+   * Check if a register dependence already exists.
+   */
+  auto existsRegisterDependence = [this](DGNode<Value> *fromNode,
+                                         DGNode<Value> *toNode) -> bool {
+    for (auto edge : this->fetchEdges(fromNode, toNode)) {
+      if (this->isRegisterDependence(edge)) {
+        return true;
+      }
+    }
+    return false;
+  };
+
+  /*
+   * Add the dependences from the definitions used by v.
+   */
+  if (auto inst = dyn_cast<Instruction>(v)) {
+    for (auto &op : inst->operands()) {
+      auto definition = op.get();
+      if (!isa<Instruction>(definition) && !isa<Argument>(definition)) {
+        continue;
+      }
+      if (!this->isInGraph(definition)) {
+        continue;
+      }
+      auto definitionNode = this->fetchNode(definition);
+      if (existsRegisterDependence(definitionNode, node)) {
+        continue;
+      }
+      auto edge = this->addEdge(definition, v);
+      edge->setMemMustType(false, true, DG_DATA_RAW);
+    }
+  }
+
+  /*
+   * Add the dependences to the users of v.
+   */
+  for (auto user : v->users()) {
+    if (!isa<Instruction>(user)) {
+      continue;
+    }
+    if (!this->isInGraph(user)) {
+      continue;
+    }
+    auto userNode = this->fetchNode(user);
+    if (existsRegisterDependence(node, userNode)) {
+      continue;
+    }
+    auto edge = this->addEdge(v, user);
+    edge->setMemMustType(false, true, DG_DATA_RAW);
+  }
+
+  return;
+}
+
+void PDG::updateRegisterDependences(Instruction *i) {
+  if (!this->isInGraph(i)) {
+    return;
+  }
+
+  /*
+   * Check if the operands of i match its register dependences.
+   */
+  std::unordered_set<Value *> operands;
+  for (auto &op : i->operands()) {
+    operands.insert(op.get());
+  }
+  std::unordered_set<Value *> definitions;
+  std::vector<DGEdge<Value, Value> *> staleDependences;
+  auto node = this->fetchNode(i);
+  for (auto edge : node->getIncomingEdges()) {
+    if (!this->isRegisterDependence(edge)) {
+      continue;
+    }
+    auto definition = edge->getSrc();
+    if (operands.find(definition) == operands.end()) {
+      staleDependences.push_back(edge);
+      continue;
+    }
+    definitions.insert(definition);
+  }
+  auto operandsChanged = (staleDependences.size() > 0);
+  for (auto operand : operands) {
+    if (!isa<Instruction>(operand) && !isa<Argument>(operand)) {
+      continue;
+    }
+    if (this->isInGraph(operand)
+        && (definitions.find(operand) == definitions.end())) {
+      operandsChanged = true;
+      break;
+    }
+  }
+  if (!operandsChanged) {
+    return;
+  }
+
+  /*
+   * Remove the dependences from values that are not used by i anymore and add
+   * the ones from its new operands.
+   */
+  for (auto edge : staleDependences) {
+    this->removeEdge(edge);
+  }
+  this->addRegisterDependences(i);
+
+  return;
+}
+
+void PDG::recomputeControlDependencesOf(Function &F) {
+
+  /*
+   * Remove the control dependences of F.
+   * Control dependences never cross function boundaries.
+   */
+  std::vector<DGEdge<Value, Value> *> controlDependences;
+  for (auto &I : instructions(F)) {
+    if (!this->isInGraph(&I)) {
+      continue;
+    }
+    auto node = this->fetchNode(&I);
+    for (auto edge : node->getIncomingEdges()) {
+      if (edge->isControlDependence()) {
+        controlDependences.push_back(edge);
+      }
+    }
+  }
+  for (auto edge : controlDependences) {
+    this->removeEdge(edge);
+  }
+
+  /*
+   * Add the control dependences of the current CFG of F.
+   */
+  PostDominatorTree postDomTree;
+  postDomTree.recalculate(F);
+  this->addControlDependencesOf(F, postDomTree);
+
+  return;
+}
+
+std::vector<std::pair<BasicBlock *, BasicBlock *>> PDG::getCFGEdgesOf(
+    Function &F) const {
+  std::vector<std::pair<BasicBlock *, BasicBlock *>> edges;
+  for (auto &B : F) {
+    for (auto succBB : successors(&B)) {
+      edges.push_back(std::make_pair(&B, succBB));
+    }
+  }
+
+  return edges;
+}
+
+void PDG::copyControlDependencesFromBasicBlock(Instruction *i) {
+
+  /*
+   * All instructions of a basic block have the same control dependences.
+   * Fetch another instruction of the basic block of i, preferring the
+   * terminator.
+   */
+  auto bb = i->getParent();
+  Instruction *sibling = nullptr;
+  auto terminator = bb->getTerminator();
+  if ((terminator != nullptr) && (terminator != i)
+      && this->isInGraph(terminator)) {
+    sibling = terminator;
+  } else {
+    for (auto &I : *bb) {
+      if ((&I != i) && this->isInGraph(&I)) {
+        sibling = &I;
+        break;
+      }
+    }
+  }
+  if (sibling == nullptr) {
+    return;
+  }
+
+  /*
+   * Copy the control dependences.
+   */
+  std::vector<DGEdge<Value, Value> *> controlDependences;
+  auto siblingNode = this->fetchNode(sibling);
+  for (auto edge : siblingNode->getIncomingEdges()) {
+    if (edge->isControlDependence()) {
+      controlDependences.push_back(edge);
+    }
+  }
+  for (auto edge : controlDependences) {
+    this->copyEdge(*edge, edge->getSrc(), i);
+  }
+
+  return;
+}
+
+void PDG::addMemoryDependencesConservatively(Instruction *i) {
+  auto F = i->getFunction();
+
+  /*
+   * Add a dependence for every pair of accesses where at least one of the two
+   * writes memory.
+   */
+  auto addDependence = [this](Instruction *from, Instruction *to) {
+    if (from->mayWriteToMemory() && to->mayReadFromMemory()) {
+      auto edge = this->addEdge(from, to);
+      edge->setMemMustType(true, false, DG_DATA_RAW);
+    }
+    if (from->mayReadFromMemory() && to->mayWriteToMemory()) {
+      auto edge = this->addEdge(from, to);
+      edge->setMemMustType(true, false, DG_DATA_WAR);
+    }
+    if (from->mayWriteToMemory() && to->mayWriteToMemory()) {
+      auto edge = this->addEdge(from, to);
+      edge->setMemMustType(true, false, DG_DATA_WAW);
+    }
+  };
+  for (auto &I : instructions(*F)) {
+    if (!I.mayReadOrWriteMemory()) {
+      continue;
+    }
+    if (!this->isInGraph(&I)) {
+      continue;
+    }
+    addDependence(i, &I);
+    if (&I != i) {
+      addDependence(&I, i);
+    }
+  }
+
+  return;
+}
+
+} // namespace arcana::noelle
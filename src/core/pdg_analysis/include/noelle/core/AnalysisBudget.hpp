@@ -0,0 +1,70 @@
+/*
+ * Copyright 2023  Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do
+ so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#pragma once
+
+#include "noelle/core/SystemHeaders.hpp"
+
+namespace arcana::noelle {
+
+/*
+ * Hotness-driven budget for the dependence analyses.
+ *
+ * Code whose dynamic coverage is below the minimum hotness is analyzed with
+ * conservative and cheap analyses only (e.g., no reachability analysis, no
+ * SVF, no loop-aware refinement). The time spent analyzing code is tracked
+ * per coverage bucket.
+ */
+class AnalysisBudget {
+public:
+  AnalysisBudget(double minimumHotness,
+                 std::function<double(Function *f)> functionCoverage);
+
+  /*
+   * Return the minimum coverage (between 0 and 1) that code must have to be
+   * analyzed precisely.
+   */
+  double getMinimumHotness(void) const;
+
+  double getCoverage(Function *f) const;
+
+  bool shouldBeAnalyzedConservatively(Function *f) const;
+
+  bool shouldBeAnalyzedConservatively(double coverage) const;
+
+  /*
+   * Account @seconds of analysis time to the bucket of @coverage.
+   */
+  void addAnalysisTime(double coverage, double seconds);
+
+  void printReport(raw_ostream &stream, std::string prefix) const;
+
+private:
+  double minHot;
+  std::function<double(Function *f)> functionCoverage;
+  std::vector<double> bucketUpperBounds;
+  std::vector<double> bucketTimes;
+  std::vector<uint64_t> bucketElements;
+
+  uint32_t getBucket(double coverage) const;
+};
+
+} // namespace arcana::noelle
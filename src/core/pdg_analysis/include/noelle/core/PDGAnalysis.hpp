@@ -30,6 +30,7 @@
 #include "noelle/core/CallGraph.hpp"
 #include "noelle/core/AliasAnalysisEngine.hpp"
 #include "noelle/core/MayPointsToAnalysis.hpp"
+#include "noelle/core/AnalysisBudget.hpp"
 
 namespace arcana::noelle {
 
@@ -55,6 +56,19 @@ public:
 
   noelle::CallGraph *getProgramCallGraph(void);
 
+  /*
+   * Recompute the dependences of the functions given as input, which have been
+   * modified after the PDG was computed. The dependences of the other functions
+   * are kept.
+   */
+  void updatePDG(const std::set<Function *> &modifiedFunctions);
+
+  /*
+   * Analyze cold functions (as defined by @budget) conservatively when the PDG
+   * is computed.
+   */
+  void setAnalysisBudget(AnalysisBudget *budget);
+
   static bool isTheLibraryFunctionPure(Function *libraryFunction);
 
   static bool isTheLibraryFunctionThreadSafe(Function *libraryFunction);
@@ -77,6 +91,9 @@ private:
   bool disableRA;
   PDGPrinter printer;
   noelle::CallGraph *noelleCG;
+  AnalysisBudget *budget;
+  std::unordered_set<Function *> conservativelyAnalyzedFunctions;
+  std::unordered_set<Function *> functionsModifiedAfterSVF;
 
   std::unordered_set<const Function *> internalFuncs;
   std::unordered_set<const Function *> unhandledExternalFuncs;
@@ -91,6 +108,7 @@ private:
   bool isInternalFunctionThatReachUnhandledExternalFunction(const Function *F);
   bool cannotReachUnhandledExternalFunction(CallBase *call);
   bool hasNoMemoryOperations(CallBase *call);
+  bool isSVFEnabledFor(Function *F) const;
 
   bool comparePDGs(PDG *pdg1, PDG *pdg2);
   bool compareNodes(PDG *pdg1, PDG *pdg2);
@@ -132,6 +150,8 @@ private:
 
   PDG *constructPDGFromAnalysis(Module &M);
   void constructEdgesFromUseDefs(PDG *pdg);
+  void constructEdgesFromUseDefs(PDG *pdg, Value *pdgValue);
+  void constructEdgesFromUseDefsForFunction(PDG *pdg, Function &F);
   void constructEdgesFromAliases(PDG *pdg, Module &M);
   void constructEdgesFromControl(PDG *pdg, Module &M);
   void constructEdgesFromAliasesForFunction(PDG *pdg, Function &F);
@@ -179,6 +199,8 @@ private:
                                  bool);
 
   void removeEdgesNotUsedByParSchemes(PDG *pdg);
+  void removeEdgesNotUsedByParSchemes(PDG *pdg, Function &F);
+  bool isEdgeNotUsedByParSchemes(PDG *pdg, DGEdge<Value, Value> *edge);
 
   AliasResult doTheyAlias(PDG *pdg,
                           Function &F,
@@ -0,0 +1,122 @@
+/*
+ * Copyright 2023  Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do
+ so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "noelle/core/AnalysisBudget.hpp"
+
+namespace arcana::noelle {
+
+AnalysisBudget::AnalysisBudget(
+    double minimumHotness,
+    std::function<double(Function *f)> functionCoverage)
+  : minHot{ minimumHotness },
+    functionCoverage{ functionCoverage },
+    bucketUpperBounds{ 0, 0.001, 0.01, 0.1, 1 } {
+
+  /*
+   * Allocate the counters of the buckets.
+   */
+  this->bucketTimes.resize(this->bucketUpperBounds.size(), 0);
+  this->bucketElements.resize(this->bucketUpperBounds.size(), 0);
+
+  return;
+}
+
+double AnalysisBudget::getMinimumHotness(void) const {
+  return this->minHot;
+}
+
+double AnalysisBudget::getCoverage(Function *f) const {
+  assert(f != nullptr);
+
+  return this->functionCoverage(f);
+}
+
+bool AnalysisBudget::shouldBeAnalyzedConservatively(Function *f) const {
+  auto coverage = this->getCoverage(f);
+
+  return this->shouldBeAnalyzedConservatively(coverage);
+}
+
+bool AnalysisBudget::shouldBeAnalyzedConservatively(double coverage) const {
+  return coverage < this->minHot;
+}
+
+void AnalysisBudget::addAnalysisTime(double coverage, double seconds) {
+  auto bucketID = this->getBucket(coverage);
+  this->bucketTimes[bucketID] += seconds;
+  this->bucketElements[bucketID]++;
+
+  return;
+}
+
+uint32_t AnalysisBudget::getBucket(double coverage) const {
+
+  /*
+   * Buckets are sorted by their upper bound.
+   * The first bucket only includes code that never executed.
+   */
+  for (auto i = 0u; i < this->bucketUpperBounds.size(); i++) {
+    if (coverage <= this->bucketUpperBounds[i]) {
+      return i;
+    }
+  }
+
+  return this->bucketUpperBounds.size() - 1;
+}
+
+void AnalysisBudget::printReport(raw_ostream &stream,
+                                 std::string prefix) const {
+
+  /*
+   * Compute the total analysis time.
+   */
+  double totalTime = 0;
+  for (auto t : this->bucketTimes) {
+    totalTime += t;
+  }
+
+  /*
+   * Print the time spent per coverage bucket.
+   */
+  stream << prefix << "Analysis time per coverage bucket\n";
+  stream << prefix << "  Minimum hotness for precise analyses: "
+         << (this->minHot * 100) << "%\n";
+  double lowerBound = 0;
+  for (auto i = 0u; i < this->bucketUpperBounds.size(); i++) {
+    auto upperBound = this->bucketUpperBounds[i];
+    auto t = this->bucketTimes[i];
+    auto percentage = (totalTime > 0) ? ((t / totalTime) * 100) : 0;
+    if (i == 0) {
+      stream << prefix << "  Not executed";
+    } else {
+      stream << prefix << "  (" << (lowerBound * 100) << "%, "
+             << (upperBound * 100) << "%]";
+    }
+    stream << ": " << this->bucketElements[i] << " elements, " << t
+           << " seconds (" << percentage << "%)\n";
+    lowerBound = upperBound;
+  }
+  stream << prefix << "  Total: " << totalTime << " seconds\n";
+
+  return;
+}
+
+} // namespace arcana::noelle
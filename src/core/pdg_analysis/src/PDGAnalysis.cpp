@@ -24,6 +24,7 @@
 #include "noelle/core/PDGPrinter.hpp"
 #include "noelle/core/PDGAnalysis.hpp"
 #include "noelle/core/Utils.hpp"
+#include <chrono>
 
 namespace arcana::noelle {
 
@@ -40,7 +41,8 @@ PDGAnalysis::PDGAnalysis()
     disableAllocAA{ false },
     disableRA{ false },
     printer{},
-    noelleCG{ nullptr } {
+    noelleCG{ nullptr },
+    budget{ nullptr } {
 
   return;
 }
@@ -175,6 +177,72 @@ PDG *PDGAnalysis::constructPDGFromAnalysis(Module &M) {
   return pdg;
 }
 
+void PDGAnalysis::updatePDG(const std::set<Function *> &modifiedFunctions) {
+
+  /*
+   * Check if the PDG has been computed.
+   * If it hasn't, then there is nothing to update as it will be computed from
+   * the current code when needed.
+   */
+  if (this->programDependenceGraph == nullptr) {
+    return;
+  }
+  auto pdg = this->programDependenceGraph;
+
+  /*
+   * Remove the stale dependences of the modified functions.
+   *
+   * This needs to be done for all functions before adding new nodes: the
+   * memory of erased instructions might have been reused by new ones.
+   */
+  for (auto F : modifiedFunctions) {
+    pdg->removeNodesOf(*F);
+
+    /*
+     * The results of SVF have been computed on the original code of F.
+     */
+    this->functionsModifiedAfterSVF.insert(F);
+  }
+
+  /*
+   * Recompute the dependences of the modified functions only.
+   * Dependences never cross function boundaries, so the rest of the PDG is
+   * still valid.
+   */
+  for (auto F : modifiedFunctions) {
+    if (F->empty()) {
+      continue;
+    }
+    if (verbose >= PDGVerbosity::Maximal) {
+      errs() << "PDGAnalysis: Update the PDG of " << F->getName() << "\n";
+    }
+    pdg->addNodesOf(*F);
+    this->constructEdgesFromUseDefsForFunction(pdg, *F);
+    this->constructEdgesFromAliasesForFunction(pdg, *F);
+    this->constructEdgesFromControlForFunction(pdg, *F);
+    if (!this->disableAllocAA) {
+      this->removeEdgesNotUsedByParSchemes(pdg, *F);
+    }
+  }
+
+  /*
+   * Set the entry node of the PDG in case it belonged to a modified function.
+   */
+  auto mainF = this->M->getFunction("main");
+  if ((mainF != nullptr) && (modifiedFunctions.count(mainF) > 0)) {
+    auto entryInst = &*(mainF->begin()->begin());
+    pdg->setEntryNode(pdg->fetchNode(entryInst));
+  }
+
+  return;
+}
+
+void PDGAnalysis::setAnalysisBudget(AnalysisBudget *budget) {
+  this->budget = budget;
+
+  return;
+}
+
 void PDGAnalysis::trimDGUsingCustomAliasAnalysis(PDG *pdg) {
 
   /*
@@ -207,33 +275,54 @@ void PDGAnalysis::constructEdgesFromUseDefs(PDG *pdg) {
    * Add the dependences due to variables.
    */
   for (auto node : make_range(pdg->begin_nodes(), pdg->end_nodes())) {
-
-    /*
-     * Check the current definition has uses.
-     * If it doesn't, then there is no variable dependence.
-     */
     auto pdgValue = node->getT();
-    if (pdgValue->getNumUses() == 0) {
-      continue;
-    }
+    this->constructEdgesFromUseDefs(pdg, pdgValue);
+  }
 
-    /*
-     * The current definition has uses.
-     * Add the uses.
-     */
-    for (auto &U : pdgValue->uses()) {
-      auto user = U.getUser();
+  return;
+}
 
-      if (isa<Instruction>(user) || isa<Argument>(user)) {
-        auto edge = pdg->addEdge(pdgValue, user);
-        edge->setMemMustType(false, true, DG_DATA_RAW);
-      }
+void PDGAnalysis::constructEdgesFromUseDefs(PDG *pdg, Value *pdgValue) {
+
+  /*
+   * Check the current definition has uses.
+   * If it doesn't, then there is no variable dependence.
+   */
+  if (pdgValue->getNumUses() == 0) {
+    return;
+  }
+
+  /*
+   * The current definition has uses.
+   * Add the uses.
+   */
+  for (auto &U : pdgValue->uses()) {
+    auto user = U.getUser();
+
+    if (isa<Instruction>(user) || isa<Argument>(user)) {
+      auto edge = pdg->addEdge(pdgValue, user);
+      edge->setMemMustType(false, true, DG_DATA_RAW);
     }
   }
 
   return;
 }
 
+void PDGAnalysis::constructEdgesFromUseDefsForFunction(PDG *pdg, Function &F) {
+
+  /*
+   * Add the dependences due to the arguments and the instructions of F.
+   */
+  for (auto &arg : F.args()) {
+    this->constructEdgesFromUseDefs(pdg, &arg);
+  }
+  for (auto &inst : instructions(F)) {
+    this->constructEdgesFromUseDefs(pdg, &inst);
+  }
+
+  return;
+}
+
 void PDGAnalysis::constructEdgesFromAliases(PDG *pdg, Module &M) {
 
   /*
@@ -248,10 +337,30 @@ void PDGAnalysis::constructEdgesFromAliases(PDG *pdg, Module &M) {
     if (F.empty())
       continue;
 
+    /*
+     * Check if the function is cold and therefore it should be analyzed
+     * conservatively.
+     */
+    if ((this->budget != nullptr)
+        && this->budget->shouldBeAnalyzedConservatively(&F)) {
+      this->conservativelyAnalyzedFunctions.insert(&F);
+    }
+
     /*
      * Add the edges to the PDG.
      */
+    auto start = std::chrono::steady_clock::now();
     constructEdgesFromAliasesForFunction(pdg, F);
+    auto end = std::chrono::steady_clock::now();
+
+    /*
+     * Account the time spent analyzing the function.
+     */
+    if (this->budget != nullptr) {
+      std::chrono::duration<double> elapsed = end - start;
+      this->budget->addAnalysisTime(this->budget->getCoverage(&F),
+                                    elapsed.count());
+    }
   }
 
   return;
@@ -279,10 +388,21 @@ void PDGAnalysis::constructEdgesFromAliasesForFunction(PDG *pdg, Function &F) {
     }
     return false;
   };
-  auto dfr =
-      this->disableRA
-          ? this->dfa.getFullSets(&F)
-          : this->dfa.runReachableAnalysis(&F, onlyMemoryInstructionFilter);
+  DataFlowResult *dfr = nullptr;
+  if (this->disableRA) {
+    dfr = this->dfa.getFullSets(&F);
+
+  } else if (this->conservativelyAnalyzedFunctions.count(&F) > 0) {
+
+    /*
+     * The function is cold: every memory instruction is assumed to reach every
+     * other one.
+     */
+    dfr = this->dfa.getFullSets(&F, onlyMemoryInstructionFilter);
+
+  } else {
+    dfr = this->dfa.runReachableAnalysis(&F, onlyMemoryInstructionFilter);
+  }
 
   for (auto &B : F) {
     for (auto &I : B) {
@@ -309,31 +429,35 @@ void PDGAnalysis::removeEdgesNotUsedByParSchemes(PDG *pdg) {
    * Collect the edges in the PDG that can be safely removed.
    */
   for (auto edge : pdg->getEdges()) {
-
-    /*
-     * Fetch the source of the dependence.
-     */
-    auto source = edge->getSrc();
-    if (!isa<Instruction>(source)) {
-      continue;
-    }
-
-    /*
-     * Check if the dependence can be removed because the instructions accessing
-     * separate memory regions.
-     */
-    if (edge->isMemoryDependence() && this->canMemoryEdgeBeRemoved(pdg, edge)) {
+    if (this->isEdgeNotUsedByParSchemes(pdg, edge)) {
       removeEdges.insert(edge);
-      continue;
     }
+  }
 
-    /*
-     * Check if the function of the dependence destination cannot be reached
-     * from main.
-     */
-    if (edgeIsNotLoopCarriedMemoryDependency(edge)
-        || edgeIsAlongNonMemoryWritingFunctions(edge)) {
-      removeEdges.insert(edge);
+  /*
+   * Remove the tagged edges.
+   */
+  for (auto edge : removeEdges) {
+    pdg->removeEdge(edge);
+  }
+
+  return;
+}
+
+void PDGAnalysis::removeEdgesNotUsedByParSchemes(PDG *pdg, Function &F) {
+  std::set<DGEdge<Value, Value> *> removeEdges;
+
+  /*
+   * Collect the edges from instructions of F that can be safely removed.
+   * Dependences never cross function boundaries, so we only need to check the
+   * outgoing ones.
+   */
+  for (auto &inst : instructions(F)) {
+    auto node = pdg->fetchNode(&inst);
+    for (auto edge : node->getOutgoingEdges()) {
+      if (this->isEdgeNotUsedByParSchemes(pdg, edge)) {
+        removeEdges.insert(edge);
+      }
     }
   }
 
@@ -347,6 +471,37 @@ void PDGAnalysis::removeEdgesNotUsedByParSchemes(PDG *pdg) {
   return;
 }
 
+bool PDGAnalysis::isEdgeNotUsedByParSchemes(PDG *pdg,
+                                            DGEdge<Value, Value> *edge) {
+
+  /*
+   * Fetch the source of the dependence.
+   */
+  auto source = edge->getSrc();
+  if (!isa<Instruction>(source)) {
+    return false;
+  }
+
+  /*
+   * Check if the dependence can be removed because the instructions accessing
+   * separate memory regions.
+   */
+  if (edge->isMemoryDependence() && this->canMemoryEdgeBeRemoved(pdg, edge)) {
+    return true;
+  }
+
+  /*
+   * Check if the function of the dependence destination cannot be reached
+   * from main.
+   */
+  if (edgeIsNotLoopCarriedMemoryDependency(edge)
+      || edgeIsAlongNonMemoryWritingFunctions(edge)) {
+    return true;
+  }
+
+  return false;
+}
+
 bool PDGAnalysis::canMemoryEdgeBeRemoved(PDG *pdg, DGEdge<Value, Value> *edge) {
   assert(pdg != nullptr);
   assert(edge != nullptr);
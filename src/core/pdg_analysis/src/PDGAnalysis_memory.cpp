@@ -173,7 +173,7 @@ bool PDGAnalysis::hasNoMemoryOperations(CallBase *call) {
   /*
    * Check if SVF is enabled.
    */
-  if (this->disableSVF) {
+  if (!this->isSVFEnabledFor(call->getFunction())) {
     return false;
   }
 
@@ -245,7 +245,7 @@ void PDGAnalysis::addEdgeFromFunctionModRef(PDG *pdg,
    *
    * Check if SVF is enabled.
    */
-  if (this->disableSVF) {
+  if (!this->isSVFEnabledFor(&F)) {
 
     /*
      * SVF is disabled.
@@ -376,7 +376,7 @@ void PDGAnalysis::addEdgeFromFunctionModRef(PDG *pdg,
    *
    * Check if SVF is enabled.
    */
-  if (this->disableSVF) {
+  if (!this->isSVFEnabledFor(&F)) {
 
     /*
      * SVF is disabled.
@@ -596,7 +596,7 @@ void PDGAnalysis::addEdgeFromFunctionModRef(PDG *pdg,
    *
    * Check if SVF is enabled.
    */
-  if (this->disableSVF) {
+  if (!this->isSVFEnabledFor(&F)) {
 
     /*
      * SVF is disabled.
@@ -842,7 +842,7 @@ bool PDGAnalysis::isSafeToQueryModRefOfSVF(CallBase *call, BitVector &bv) {
   /*
    * Check if SVF is enabled.
    */
-  if (this->disableSVF) {
+  if (!this->isSVFEnabledFor(call->getFunction())) {
 
     /*
      * SVF is disabled.
@@ -955,7 +955,7 @@ AliasResult PDGAnalysis::doTheyAlias(PDG *pdg,
    *
    * Check if SVF is enabled.
    */
-  if (this->disableSVF) {
+  if (!this->isSVFEnabledFor(&F)) {
 
     /*
      * SVF is disabled.
@@ -988,4 +988,30 @@ AliasResult PDGAnalysis::doTheyAlias(PDG *pdg,
   return MayAlias;
 }
 
+bool PDGAnalysis::isSVFEnabledFor(Function *F) const {
+
+  /*
+   * Check if SVF has been disabled for the whole program.
+   */
+  if (this->disableSVF) {
+    return false;
+  }
+
+  /*
+   * Check if @F is cold and therefore it is analyzed conservatively.
+   */
+  if (this->conservativelyAnalyzedFunctions.count(F) > 0) {
+    return false;
+  }
+
+  /*
+   * Check if @F has been modified after SVF analyzed the program.
+   */
+  if (this->functionsModifiedAfterSVF.count(F) > 0) {
+    return false;
+  }
+
+  return true;
+}
+
 } // namespace arcana::noelle
@@ -142,7 +142,7 @@ void PDGPrinter::printGraphsForFunction(Function &F, PDG *graph, LoopInfo &LI) {
      * Print each SCC within the loop SCCDAG.
      */
     auto sccCount = 0;
-    for (auto scc : sccSubgraph->getSCCs()) {
+    for (auto scc : sccSubgraph->sccs()) {
       filename.clear();
       ros << "pdg-function-" << F.getName() << "-loop" << loopCount
           << "-SCCDAG-SCC" << sccCount << ".dot";
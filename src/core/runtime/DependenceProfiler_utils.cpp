@@ -0,0 +1,259 @@
+#include <cstdint>
+#include <cstdlib>
+#include <mutex>
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <fstream>
+#include <iostream>
+
+class DependenceProfile {
+public:
+  uint64_t occurrences = 0;
+  uint64_t minimumDistance = 0;
+  uint64_t maximumDistance = 0;
+};
+
+class InstructionDescriptor {
+public:
+  std::string functionName;
+  uint32_t position = 0;
+  uint32_t opcode = 0;
+};
+
+class LoopInvocation {
+public:
+  bool isRunning = false;
+  uint64_t iteration = 0;
+
+  /*
+   * Last iteration of the current invocation in which each instruction
+   * accessed each byte.
+   * Bytes are tracked individually to avoid reporting dependences between
+   * accesses to adjacent memory locations.
+   */
+  std::unordered_map<uint64_t, std::unordered_map<uint32_t, uint64_t>>
+      lastAccesses;
+};
+
+class DependenceProfiler {
+public:
+  ~DependenceProfiler() {
+
+    /*
+     * Fetch the output file.
+     */
+    auto fileName = getenv("NOELLE_DEPENDENCE_PROFILE_FILE");
+    if (fileName == nullptr) {
+      fileName = (char *)"noelle_dependence_profile.txt";
+    }
+    std::ofstream outFile(fileName);
+    if (!outFile.is_open()) {
+      std::cerr << "NOELLE: DependenceProfiler: ERROR: Couldn't open "
+                << fileName << std::endl;
+      return;
+    }
+
+    /*
+     * Describe the instructions profiled as
+     * I INST_ID OPCODE POSITION FUNCTION_NAME
+     * where POSITION is the position of the instruction within its function.
+     */
+    outFile << "# NOELLE dependence profile 2" << std::endl;
+    for (auto &pair : this->instructions) {
+      auto &d = pair.second;
+      outFile << "I " << pair.first << " " << d.opcode << " " << d.position
+              << " " << d.functionName << std::endl;
+    }
+
+    /*
+     * Write the profile of each dependence of the loops that have been invoked
+     * as
+     * D LOOP_ID FROM_INST_ID TO_INST_ID OCCURRENCES MIN_DISTANCE MAX_DISTANCE
+     */
+    for (auto &loopPair : this->dependences) {
+      if (this->invocations.find(loopPair.first) == this->invocations.end()) {
+        continue;
+      }
+      for (auto &pair : loopPair.second) {
+        auto &p = pair.second;
+        outFile << "D " << loopPair.first << " " << pair.first.first << " "
+                << pair.first.second << " " << p.occurrences << " "
+                << p.minimumDistance << " " << p.maximumDistance << std::endl;
+      }
+    }
+
+    return;
+  }
+
+  void addInstruction(uint32_t instID,
+                      const char *functionName,
+                      uint32_t position,
+                      uint32_t opcode) {
+    std::lock_guard<std::mutex> lock(this->m);
+    auto &d = this->instructions[instID];
+    d.functionName = functionName;
+    d.position = position;
+    d.opcode = opcode;
+
+    return;
+  }
+
+  void addDependence(uint64_t loopID, uint32_t fromID, uint32_t toID) {
+    std::lock_guard<std::mutex> lock(this->m);
+    auto key = std::make_pair(fromID, toID);
+    auto &loopDependences = this->dependences[loopID];
+    if (loopDependences.find(key) != loopDependences.end()) {
+      return;
+    }
+    loopDependences[key] = DependenceProfile{};
+    this->sources[loopID][toID].push_back(fromID);
+
+    return;
+  }
+
+  void startInvocation(uint64_t loopID) {
+
+    /*
+     * A recursive invocation of a loop that is running restarts it.
+     */
+    std::lock_guard<std::mutex> lock(this->m);
+    auto &invocation = this->invocations[loopID];
+    invocation.isRunning = true;
+    invocation.iteration = 0;
+    invocation.lastAccesses.clear();
+
+    return;
+  }
+
+  void startIteration(uint64_t loopID) {
+    std::lock_guard<std::mutex> lock(this->m);
+    auto &invocation = this->invocations[loopID];
+    invocation.iteration++;
+
+    return;
+  }
+
+  void endInvocation(uint64_t loopID) {
+    std::lock_guard<std::mutex> lock(this->m);
+    auto &invocation = this->invocations[loopID];
+    invocation.isRunning = false;
+    invocation.lastAccesses.clear();
+
+    return;
+  }
+
+  void addAccess(uint64_t loopID,
+                 uint32_t instID,
+                 uint64_t address,
+                 uint64_t bytes) {
+    std::lock_guard<std::mutex> lock(this->m);
+    auto &invocation = this->invocations[loopID];
+    if ((!invocation.isRunning) || (bytes == 0)) {
+      return;
+    }
+
+    /*
+     * Find the latest previous iteration in which the sources of the
+     * dependences that end in the current instruction accessed the same
+     * memory.
+     */
+    auto &loopSources = this->sources[loopID];
+    auto sourcesIt = loopSources.find(instID);
+    std::map<uint32_t, uint64_t> latestSourceIterations;
+    for (auto byte = address; byte < (address + bytes); byte++) {
+      auto &accesses = invocation.lastAccesses[byte];
+      if (sourcesIt != loopSources.end()) {
+        for (auto fromID : sourcesIt->second) {
+          auto it = accesses.find(fromID);
+          if ((it == accesses.end()) || (it->second >= invocation.iteration)) {
+            continue;
+          }
+          auto &latest = latestSourceIterations[fromID];
+          if (it->second > latest) {
+            latest = it->second;
+          }
+        }
+      }
+      accesses[instID] = invocation.iteration;
+    }
+
+    /*
+     * Record the dependences that manifested.
+     */
+    auto &loopDependences = this->dependences[loopID];
+    for (auto &pair : latestSourceIterations) {
+      auto distance = invocation.iteration - pair.second;
+      auto &p = loopDependences[std::make_pair(pair.first, instID)];
+      if ((p.occurrences == 0) || (distance < p.minimumDistance)) {
+        p.minimumDistance = distance;
+      }
+      if (distance > p.maximumDistance) {
+        p.maximumDistance = distance;
+      }
+      p.occurrences++;
+    }
+
+    return;
+  }
+
+private:
+  std::mutex m;
+  std::map<uint32_t, InstructionDescriptor> instructions;
+  std::map<uint64_t, std::map<std::pair<uint32_t, uint32_t>, DependenceProfile>>
+      dependences;
+  std::unordered_map<uint64_t,
+                     std::unordered_map<uint32_t, std::vector<uint32_t>>>
+      sources;
+  std::map<uint64_t, LoopInvocation> invocations;
+};
+
+static DependenceProfiler profiler{};
+
+extern "C" {
+
+void NOELLE_dependenceProfiler_addInstruction(uint32_t instID,
+                                              const char *functionName,
+                                              uint32_t position,
+                                              uint32_t opcode) {
+  profiler.addInstruction(instID, functionName, position, opcode);
+
+  return;
+}
+
+void NOELLE_dependenceProfiler_addDependence(uint64_t loopID,
+                                             uint32_t fromID,
+                                             uint32_t toID) {
+  profiler.addDependence(loopID, fromID, toID);
+
+  return;
+}
+
+void NOELLE_dependenceProfiler_invocationStarted(uint64_t loopID) {
+  profiler.startInvocation(loopID);
+
+  return;
+}
+
+void NOELLE_dependenceProfiler_iterationStarted(uint64_t loopID) {
+  profiler.startIteration(loopID);
+
+  return;
+}
+
+void NOELLE_dependenceProfiler_invocationEnded(uint64_t loopID) {
+  profiler.endInvocation(loopID);
+
+  return;
+}
+
+void NOELLE_dependenceProfiler_memoryAccessed(uint64_t loopID,
+                                              uint32_t instID,
+                                              uint64_t address,
+                                              uint64_t bytes) {
+  profiler.addAccess(loopID, instID, address, bytes);
+
+  return;
+}
+}
@@ -0,0 +1,139 @@
+#include <cstdint>
+#include <cstdlib>
+#include <cmath>
+#include <mutex>
+#include <map>
+#include <fstream>
+#include <iostream>
+
+/*
+ * Runtime of the loop profiler.
+ *
+ * Loops instrumented by the LoopProfiler pass report each of their invocations
+ * by calling NOELLE_loopProfiler_invocationEnded. At the end of the execution,
+ * the profile of all loops is written to the file specified by the
+ * NOELLE_LOOP_PROFILE_FILE environment variable (noelle_loop_profile.txt by
+ * default). This file can be given to NOELLE via -noelle-loop-profile.
+ */
+
+/*
+ * Invocations are grouped by iterations in buckets of powers of two: bucket 0
+ * includes the invocations with no iterations and bucket i > 0 includes the
+ * ones with [2^(i-1), 2^i) iterations.
+ */
+#define NOELLE_LOOP_PROFILER_BUCKETS 65
+
+class LoopProfile {
+public:
+  uint64_t invocations[NOELLE_LOOP_PROFILER_BUCKETS] = {};
+  uint64_t iterations[NOELLE_LOOP_PROFILER_BUCKETS] = {};
+
+  /*
+   * Per-iteration cost (in cycles) weighted by the number of iterations of
+   * each invocation.
+   */
+  double costWeight = 0;
+  double costSum = 0;
+  double costSquaredSum = 0;
+};
+
+class LoopProfiler {
+public:
+  ~LoopProfiler() {
+
+    /*
+     * Fetch the output file.
+     */
+    auto fileName = getenv("NOELLE_LOOP_PROFILE_FILE");
+    if (fileName == nullptr) {
+      fileName = (char *)"noelle_loop_profile.txt";
+    }
+    std::ofstream outFile(fileName);
+    if (!outFile.is_open()) {
+      std::cerr << "NOELLE: LoopProfiler: ERROR: Couldn't open " << fileName
+                << std::endl;
+      return;
+    }
+
+    /*
+     * Write the profile of each loop as
+     * ID INVOCATIONS ITERATIONS COST_MEAN COST_VARIANCE BUCKETS [INV ITERS]*
+     */
+    outFile << "# NOELLE loop profile 1" << std::endl;
+    for (auto &pair : this->loops) {
+      auto &p = pair.second;
+      uint64_t invs = 0;
+      uint64_t iters = 0;
+      auto buckets = 0;
+      for (auto i = 0; i < NOELLE_LOOP_PROFILER_BUCKETS; i++) {
+        invs += p.invocations[i];
+        iters += p.iterations[i];
+        if (p.invocations[i] > 0) {
+          buckets = i + 1;
+        }
+      }
+      double mean = 0;
+      double variance = 0;
+      if (p.costWeight > 0) {
+        mean = p.costSum / p.costWeight;
+        variance = (p.costSquaredSum / p.costWeight) - (mean * mean);
+        if (variance < 0) {
+          variance = 0;
+        }
+      }
+      outFile << pair.first << " " << invs << " " << iters << " " << mean
+              << " " << variance << " " << buckets;
+      for (auto i = 0; i < buckets; i++) {
+        outFile << " " << p.invocations[i] << " " << p.iterations[i];
+      }
+      outFile << std::endl;
+    }
+
+    return;
+  }
+
+  void addInvocation(uint64_t loopID, uint64_t iterations, uint64_t cycles) {
+
+    /*
+     * Compute the bucket.
+     */
+    auto bucket = 0;
+    for (auto i = iterations; i > 0; i >>= 1) {
+      bucket++;
+    }
+
+    /*
+     * Update the profile.
+     */
+    std::lock_guard<std::mutex> lock(this->m);
+    auto &p = this->loops[loopID];
+    p.invocations[bucket]++;
+    p.iterations[bucket] += iterations;
+    if (iterations > 0) {
+      auto w = (double)iterations;
+      auto c = ((double)cycles) / w;
+      p.costWeight += w;
+      p.costSum += w * c;
+      p.costSquaredSum += w * c * c;
+    }
+
+    return;
+  }
+
+private:
+  std::mutex m;
+  std::map<uint64_t, LoopProfile> loops;
+};
+
+static LoopProfiler profiler{};
+
+extern "C" {
+
+void NOELLE_loopProfiler_invocationEnded(uint64_t loopID,
+                                         uint64_t iterations,
+                                         uint64_t cycles) {
+  profiler.addInvocation(loopID, iterations, cycles);
+
+  return;
+}
+}
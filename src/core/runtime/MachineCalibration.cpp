@@ -0,0 +1,227 @@
+#include <cstdint>
+#include <cstdlib>
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <vector>
+#include <chrono>
+#include <algorithm>
+#include <iostream>
+
+/*
+ * Micro-benchmarks that measure the costs of the machine used by the timing
+ * model of the parallelization planner.
+ *
+ * Costs are printed as the options of NOELLE that set them. They are
+ * expressed in dynamic instructions, the unit of the profiles.
+ */
+
+#define NOELLE_CALIBRATION_REPETITIONS 10000
+#define NOELLE_CALIBRATION_QUEUE_SIZE 1024
+#define NOELLE_CALIBRATION_QUEUE_VALUES 1000000
+
+static int64_t getTime(void) {
+  auto now = std::chrono::steady_clock::now().time_since_epoch();
+
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(now).count();
+}
+
+/*
+ * Return the number of instructions executed per nanosecond by a loop of
+ * simple integer operations.
+ */
+static double measureInstructionsPerNanosecond(void) {
+  uint64_t iterations = 100000000;
+  uint64_t a = 1, b = 2, c = 3, d = 4;
+
+  auto start = getTime();
+  for (uint64_t i = 0; i < iterations; i++) {
+    a += i;
+    b ^= a;
+    c += b;
+    d ^= c;
+    asm volatile("" : "+r"(a), "+r"(b), "+r"(c), "+r"(d));
+  }
+  auto elapsed = getTime() - start;
+
+  /*
+   * Every iteration executes the 4 operations, the increment of the induction
+   * variable, and the compare-and-branch.
+   */
+  if ((a + b + c + d) == 0) {
+    std::cerr << "";
+  }
+  auto instructions = (double)(iterations * 6);
+
+  return instructions / ((double)elapsed);
+}
+
+/*
+ * Return the nanoseconds spent to dispatch empty tasks to @cores cores and to
+ * wait for them, like the dispatchers of the NOELLE runtime do.
+ */
+static double measureDispatchNanoseconds(uint32_t cores) {
+  std::mutex m;
+  std::condition_variable cv;
+  uint64_t generation = 0;
+  bool done = false;
+  std::atomic<uint32_t> completedTasks{ 0 };
+
+  /*
+   * Start the threads that wait for tasks.
+   */
+  std::vector<std::thread> threads;
+  for (auto i = 1u; i < cores; i++) {
+    threads.emplace_back([&]() {
+      uint64_t lastGeneration = 0;
+      while (true) {
+        std::unique_lock<std::mutex> lock(m);
+        cv.wait(lock, [&]() { return done || (generation != lastGeneration); });
+        if (done) {
+          return;
+        }
+        lastGeneration = generation;
+        lock.unlock();
+        completedTasks++;
+      }
+    });
+  }
+
+  /*
+   * Dispatch the tasks.
+   */
+  auto start = getTime();
+  for (auto r = 0; r < NOELLE_CALIBRATION_REPETITIONS; r++) {
+    completedTasks = 0;
+    {
+      std::lock_guard<std::mutex> lock(m);
+      generation++;
+    }
+    cv.notify_all();
+    while (completedTasks.load() < (cores - 1)) {
+      std::this_thread::yield();
+    }
+  }
+  auto elapsed = getTime() - start;
+
+  /*
+   * Stop the threads.
+   */
+  {
+    std::lock_guard<std::mutex> lock(m);
+    done = true;
+  }
+  cv.notify_all();
+  for (auto &t : threads) {
+    t.join();
+  }
+
+  return ((double)elapsed) / NOELLE_CALIBRATION_REPETITIONS;
+}
+
+/*
+ * Return the nanoseconds spent to signal another core through a shared cache
+ * line, like HELIX sequential segments do.
+ */
+static double measureSignalNanoseconds(void) {
+  alignas(64) std::atomic<uint32_t> turn{ 0 };
+
+  std::thread other([&]() {
+    for (auto r = 0; r < NOELLE_CALIBRATION_REPETITIONS; r++) {
+      while (turn.load(std::memory_order_acquire) != 1) {
+        std::this_thread::yield();
+      }
+      turn.store(0, std::memory_order_release);
+    }
+  });
+  auto start = getTime();
+  for (auto r = 0; r < NOELLE_CALIBRATION_REPETITIONS; r++) {
+    turn.store(1, std::memory_order_release);
+    while (turn.load(std::memory_order_acquire) != 0) {
+      std::this_thread::yield();
+    }
+  }
+  auto elapsed = getTime() - start;
+  other.join();
+
+  /*
+   * Every repetition includes two signals.
+   */
+  return ((double)elapsed) / (2 * NOELLE_CALIBRATION_REPETITIONS);
+}
+
+/*
+ * Return the nanoseconds spent to transfer a value between two cores through
+ * a lock-free queue, like DSWP stages do.
+ */
+static double measureQueueTransferNanoseconds(void) {
+  std::vector<int64_t> buffer(NOELLE_CALIBRATION_QUEUE_SIZE);
+  alignas(64) std::atomic<uint64_t> head{ 0 };
+  alignas(64) std::atomic<uint64_t> tail{ 0 };
+
+  std::thread consumer([&]() {
+    int64_t sum = 0;
+    for (uint64_t i = 0; i < NOELLE_CALIBRATION_QUEUE_VALUES; i++) {
+      while (head.load(std::memory_order_acquire) == i) {
+        std::this_thread::yield();
+      }
+      sum += buffer[i % NOELLE_CALIBRATION_QUEUE_SIZE];
+      tail.store(i + 1, std::memory_order_release);
+    }
+    if (sum == 0) {
+      std::cerr << "";
+    }
+  });
+  auto start = getTime();
+  for (uint64_t i = 0; i < NOELLE_CALIBRATION_QUEUE_VALUES; i++) {
+    while ((i - tail.load(std::memory_order_acquire))
+           >= NOELLE_CALIBRATION_QUEUE_SIZE) {
+      std::this_thread::yield();
+    }
+    buffer[i % NOELLE_CALIBRATION_QUEUE_SIZE] = (int64_t)i;
+    head.store(i + 1, std::memory_order_release);
+  }
+  consumer.join();
+  auto elapsed = getTime() - start;
+
+  return ((double)elapsed) / NOELLE_CALIBRATION_QUEUE_VALUES;
+}
+
+int main(int argc, char *argv[]) {
+
+  /*
+   * Fetch the number of cores to dispatch tasks to.
+   */
+  uint32_t cores = std::max(2u, std::thread::hardware_concurrency() / 2);
+  if (argc > 1) {
+    cores = std::max(2, atoi(argv[1]));
+  }
+
+  /*
+   * Measure the costs.
+   */
+  auto instructionsPerNanosecond = measureInstructionsPerNanosecond();
+  auto dispatch = measureDispatchNanoseconds(cores);
+  auto signal = measureSignalNanoseconds();
+  auto queueTransfer = measureQueueTransferNanoseconds();
+  std::cerr << "Instructions per nanosecond: " << instructionsPerNanosecond
+            << std::endl;
+  std::cerr << "Dispatch to " << cores << " cores: " << dispatch << " ns"
+            << std::endl;
+  std::cerr << "Signal: " << signal << " ns" << std::endl;
+  std::cerr << "Queue transfer: " << queueTransfer << " ns" << std::endl;
+
+  /*
+   * Print the costs as options of NOELLE.
+   */
+  auto toInstructions = [instructionsPerNanosecond](double ns) -> uint64_t {
+    return std::max<uint64_t>(1, (uint64_t)(ns * instructionsPerNanosecond));
+  };
+  std::cout << "-noelle-dispatch-cost=" << toInstructions(dispatch)
+            << " -noelle-helix-signal-cost=" << toInstructions(signal)
+            << " -noelle-dswp-queue-cost=" << toInstructions(queueTransfer)
+            << std::endl;
+
+  return 0;
+}
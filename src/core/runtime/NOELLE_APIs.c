@@ -26,7 +26,9 @@ extern DispatcherInfo NOELLE_DSWPDispatcher(void *env,
                                             int64_t *queueSizes,
                                             void *stages,
                                             int64_t numberOfStages,
-                                            int64_t numberOfQueues);
+                                            int64_t numberOfQueues,
+                                            int64_t *queueStages,
+                                            int64_t *stageReplicas);
 
 extern void HELIX_wait(void *);
 extern void HELIX_signal(void *);
@@ -56,8 +58,33 @@ extern DispatcherInfo NOELLE_HELIX_dispatcher_sequentialSegments(
     int64_t numCores,
     int64_t numOfsequentialSegments);
 
+extern DispatcherInfo NOELLE_HELIX_dispatcher_sequentialSegmentsForLoop(
+    int64_t loopID,
+    void (*parallelizedLoop)(void *,
+                             void *,
+                             void *,
+                             void *,
+                             int64_t,
+                             int64_t,
+                             uint64_t *),
+    void *env,
+    void *loopCarriedArray,
+    int64_t numCores,
+    int64_t numOfsequentialSegments);
+
 extern uint32_t NOELLE_getAvailableCores(void);
 
+extern uint32_t NOELLE_selectLoopVersion(int64_t loopID,
+                                         uint32_t defaultVersion,
+                                         uint32_t availableVersions,
+                                         uint32_t const *fixedCoresOfVersions);
+extern DispatcherInfo NOELLE_DOALLDispatcherForLoop(
+    int64_t loopID,
+    void (*parallelizedLoop)(void *, int64_t, int64_t, int64_t),
+    void *env,
+    int64_t maxNumberOfCores,
+    int64_t chunkSize);
+
 void SIMONE_CAMPANONI_IS_GOING_TO_REMOVE_THIS_FUNCTION(void) {
   queuePush8(0, 0);
   queuePush16(0, 0);
@@ -70,10 +97,11 @@ void SIMONE_CAMPANONI_IS_GOING_TO_REMOVE_THIS_FUNCTION(void) {
   queuePop64(0, 0);
 
   stageExecuter(0, 0, 0);
-  NOELLE_DSWPDispatcher(0, 0, 0, 0, 0);
+  NOELLE_DSWPDispatcher(0, 0, 0, 0, 0, 0, 0);
 
   NOELLE_HELIX_dispatcher_criticalSections(0, 0, 0, 0, 0);
   NOELLE_HELIX_dispatcher_sequentialSegments(0, 0, 0, 0, 0);
+  NOELLE_HELIX_dispatcher_sequentialSegmentsForLoop(0, 0, 0, 0, 0, 0);
   HELIX_wait(0);
   HELIX_signal(0);
 
@@ -82,4 +110,7 @@ void SIMONE_CAMPANONI_IS_GOING_TO_REMOVE_THIS_FUNCTION(void) {
   NOELLE_DOALLDispatcher(0, 0, 0, 0);
 
   NOELLE_getAvailableCores();
+
+  NOELLE_selectLoopVersion(0, 0, 0, 0);
+  NOELLE_DOALLDispatcherForLoop(0, 0, 0, 0, 0);
 }
@@ -2,6 +2,7 @@
 #include <algorithm>
 #include <atomic>
 #include <cstdint>
+#include <cstring>
 #include <pthread.h>
 #include <functional>
 #include <memory>
@@ -20,6 +21,9 @@
 #include <queue>
 #include <utility>
 #include <iostream>
+#include <fstream>
+#include <unordered_map>
+#include <chrono>
 
 /*
  * OPTIONS
@@ -32,6 +36,16 @@ using namespace MARC;
 
 #define CACHE_LINE_SIZE 64
 
+/*
+ * Versions of a multi-versioned loop.
+ * The ID of a parallel version is the ID of the transformation used to
+ * generate it (see Transformations.hpp) plus one.
+ */
+#define NOELLE_SEQUENTIAL_VERSION 0
+#define NOELLE_DOALL_VERSION 1
+#define NOELLE_DSWP_VERSION 2
+#define NOELLE_HELIX_VERSION 3
+
 #ifdef DSWP_STATS
 static int64_t numberOfPushes8 = 0;
 static int64_t numberOfPushes16 = 0;
@@ -45,9 +59,78 @@ typedef struct {
   int64_t coreID;
   int64_t numCores;
   int64_t chunkSize;
+  bool measureTime;
+  int64_t endTime;
   pthread_spinlock_t endLock;
 } DOALL_args_t;
 
+typedef struct {
+  int64_t cores;
+  double time;
+  double imbalance;
+} DOALL_measurement_t;
+
+typedef struct {
+  bool parallelize;
+  uint32_t techniquesToDisable;
+  int64_t cores;
+  int64_t chunkSize;
+} LoopConfiguration_t;
+
+/*
+ * Online tuner of the number of cores and the chunk size of a DOALL loop.
+ *
+ * The tuner hill-climbs from the configuration chosen at compile time.
+ * Every configuration is measured over a few invocations of the loop; the
+ * neighbors of the best configuration found so far are explored until none of
+ * them improves it or the invocations available for tuning are over.
+ * From then on, the best configuration is used.
+ */
+class DOALLTuner {
+public:
+  DOALLTuner(int64_t maxCores, int64_t chunkSize, uint32_t invocationsToTune);
+
+  bool isTuned(void) const;
+
+  void getConfiguration(int64_t *cores, int64_t *chunkSize) const;
+
+  void addMeasurement(int64_t cores,
+                      int64_t chunkSize,
+                      DOALL_measurement_t const &measurement);
+
+private:
+  void computeNeighborsOfBestConfiguration(void);
+
+  void moveToNextConfiguration(void);
+
+  mutable pthread_spinlock_t lock;
+  int64_t maxCores;
+  uint32_t invocationsLeft;
+  bool tuned;
+
+  /*
+   * Configuration under measurement.
+   */
+  int64_t cores;
+  int64_t chunkSize;
+  uint32_t samples;
+  double totalTime;
+  double totalImbalance;
+
+  /*
+   * Best configuration found so far.
+   */
+  int64_t bestCores;
+  int64_t bestChunkSize;
+  double bestTime;
+  double bestImbalance;
+
+  /*
+   * Configurations left to try.
+   */
+  std::vector<std::pair<int64_t, int64_t>> neighbors;
+};
+
 class NoelleRuntime {
 public:
   NoelleRuntime();
@@ -62,6 +145,12 @@ public:
 
   void releaseDOALLArgs(uint32_t index);
 
+  LoopConfiguration_t *getLoopConfiguration(int64_t loopID);
+
+  DOALLTuner *getDOALLTuner(int64_t loopID, int64_t maxCores, int64_t chunkSize);
+
+  bool isDOALLTuningEnabled(void) const;
+
   ThreadPoolForCSingleQueue *virgil;
 
   ~NoelleRuntime(void);
@@ -74,6 +163,22 @@ private:
 
   uint32_t getMaximumNumberOfCores(void);
 
+  void readLoopConfigurations(void);
+
+  /*
+   * Configurations of the loops (if any) read at startup.
+   * They are only read after the construction of the runtime.
+   */
+  std::unordered_map<int64_t, LoopConfiguration_t> loopConfigurations;
+
+  /*
+   * Online tuning of DOALL loops (NOELLE_DOALL_TUNING).
+   */
+  bool doallTuning;
+  uint32_t doallTuningInvocations;
+  mutable pthread_spinlock_t doallTunersLock;
+  std::unordered_map<int64_t, DOALLTuner *> doallTuners;
+
   /*
    * Current number of idle cores.
    */
@@ -109,6 +214,16 @@ pthread_spinlock_t printLock;
 
 static NoelleRuntime runtime{};
 
+/*
+ * Runtime APIs invoked from the body of the generated tasks.
+ * The runtime is linked with the parallelized code before it gets optimized,
+ * so these APIs are inlined into the tasks.
+ * This allows the optimizer to work across the boundary between the task and
+ * the runtime (e.g., to hoist invariant pointer arithmetic out of a
+ * synchronization).
+ */
+#define NOELLE_TASK_API __attribute__((always_inline))
+
 extern "C" {
 
 /************************************ NOELLE public APIs **************/
@@ -127,6 +242,19 @@ DispatcherInfo NOELLE_DOALLDispatcher(
     int64_t maxNumberOfCores,
     int64_t chunkSize);
 
+/*
+ * Dispatch tasks to run the DOALL loop with ID "loopID".
+ * The number of cores and the chunk size given are the ones chosen at compile
+ * time; they can be overwritten by the configuration of the loop (INDEX_FILE)
+ * or by tuning them online (NOELLE_DOALL_TUNING).
+ */
+DispatcherInfo NOELLE_DOALLDispatcherForLoop(
+    int64_t loopID,
+    void (*parallelizedLoop)(void *, int64_t, int64_t, int64_t),
+    void *env,
+    int64_t maxNumberOfCores,
+    int64_t chunkSize);
+
 /*
  * Dispatch tasks to run a HELIX loop.
  */
@@ -143,6 +271,25 @@ DispatcherInfo NOELLE_HELIX_dispatcher_sequentialSegments(
     int64_t numCores,
     int64_t numOfsequentialSegments);
 
+/*
+ * Dispatch tasks to run the HELIX loop with ID "loopID".
+ * The number of cores given is the one chosen at compile time; it can be
+ * lowered by the configuration of the loop (INDEX_FILE).
+ */
+DispatcherInfo NOELLE_HELIX_dispatcher_sequentialSegmentsForLoop(
+    int64_t loopID,
+    void (*parallelizedLoop)(void *,
+                             void *,
+                             void *,
+                             void *,
+                             int64_t,
+                             int64_t,
+                             uint64_t *),
+    void *env,
+    void *loopCarriedArray,
+    int64_t numCores,
+    int64_t numOfsequentialSegments);
+
 DispatcherInfo NOELLE_HELIX_dispatcher_criticalSections(
     void (*parallelizedLoop)(void *,
                              void *,
@@ -160,9 +307,17 @@ DispatcherInfo NOELLE_DSWPDispatcher(void *env,
                                      int64_t *queueSizes,
                                      void *stages,
                                      int64_t numberOfStages,
-                                     int64_t numberOfQueues);
+                                     int64_t numberOfQueues,
+                                     int64_t *queueStages,
+                                     int64_t *stageReplicas);
 
 /******************************************* Utils ********************/
+static int64_t NOELLE_getTime(void) {
+  auto now = std::chrono::steady_clock::now().time_since_epoch();
+
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(now).count();
+}
+
 #ifdef RUNTIME_PROFILE
 static __inline__ int64_t rdtsc_s(void) {
   unsigned a, d;
@@ -198,7 +353,7 @@ void printPulledP(int32_t *p) {
   printf("Pulled: %p\n", p);
 }
 
-void queuePush8(ThreadSafeQueue<int8_t> *queue, int8_t *val) {
+NOELLE_TASK_API void queuePush8(ThreadSafeQueue<int8_t> *queue, int8_t *val) {
   queue->push(*val);
 
 #ifdef DSWP_STATS
@@ -208,12 +363,13 @@ void queuePush8(ThreadSafeQueue<int8_t> *queue, int8_t *val) {
   return;
 }
 
-void queuePop8(ThreadSafeQueue<int8_t> *queue, int8_t *val) {
+NOELLE_TASK_API void queuePop8(ThreadSafeQueue<int8_t> *queue, int8_t *val) {
   queue->waitPop(*val);
   return;
 }
 
-void queuePush16(ThreadSafeQueue<int16_t> *queue, int16_t *val) {
+NOELLE_TASK_API void queuePush16(ThreadSafeQueue<int16_t> *queue,
+                                 int16_t *val) {
   queue->push(*val);
 
 #ifdef DSWP_STATS
@@ -223,11 +379,12 @@ void queuePush16(ThreadSafeQueue<int16_t> *queue, int16_t *val) {
   return;
 }
 
-void queuePop16(ThreadSafeQueue<int16_t> *queue, int16_t *val) {
+NOELLE_TASK_API void queuePop16(ThreadSafeQueue<int16_t> *queue, int16_t *val) {
   queue->waitPop(*val);
 }
 
-void queuePush32(ThreadSafeQueue<int32_t> *queue, int32_t *val) {
+NOELLE_TASK_API void queuePush32(ThreadSafeQueue<int32_t> *queue,
+                                 int32_t *val) {
   queue->push(*val);
 
 #ifdef DSWP_STATS
@@ -237,11 +394,12 @@ void queuePush32(ThreadSafeQueue<int32_t> *queue, int32_t *val) {
   return;
 }
 
-void queuePop32(ThreadSafeQueue<int32_t> *queue, int32_t *val) {
+NOELLE_TASK_API void queuePop32(ThreadSafeQueue<int32_t> *queue, int32_t *val) {
   queue->waitPop(*val);
 }
 
-void queuePush64(ThreadSafeQueue<int64_t> *queue, int64_t *val) {
+NOELLE_TASK_API void queuePush64(ThreadSafeQueue<int64_t> *queue,
+                                 int64_t *val) {
   queue->push(*val);
 
 #ifdef DSWP_STATS
@@ -251,7 +409,7 @@ void queuePush64(ThreadSafeQueue<int64_t> *queue, int64_t *val) {
   return;
 }
 
-void queuePop64(ThreadSafeQueue<int64_t> *queue, int64_t *val) {
+NOELLE_TASK_API void queuePop64(ThreadSafeQueue<int64_t> *queue, int64_t *val) {
   queue->waitPop(*val);
 
   return;
@@ -282,19 +440,25 @@ static void NOELLE_DOALLTrampoline(void *args) {
   clocks_starts[DOALLArgs->coreID] = clocks_start;
   clocks_ends[DOALLArgs->coreID] = clocks_end;
 #endif
+  if (DOALLArgs->measureTime) {
+    DOALLArgs->endTime = NOELLE_getTime();
+  }
 
   pthread_spin_unlock(&(DOALLArgs->endLock));
   return;
 }
 
-DispatcherInfo NOELLE_DOALLDispatcher(
+static DispatcherInfo NOELLE_DOALLDispatch(
     void (*parallelizedLoop)(void *, int64_t, int64_t, int64_t),
     void *env,
     int64_t maxNumberOfCores,
-    int64_t chunkSize) {
+    int64_t chunkSize,
+    DOALL_measurement_t *measurement) {
 #ifdef RUNTIME_PROFILE
   auto clocks_start = rdtsc_s();
 #endif
+  auto measureTime = (measurement != nullptr);
+  int64_t startTime = measureTime ? NOELLE_getTime() : 0;
 
   /*
    * Fetch VIRGIL
@@ -331,6 +495,7 @@ DispatcherInfo NOELLE_DOALLDispatcher(
     argsPerCore->env = env;
     argsPerCore->numCores = numCores;
     argsPerCore->chunkSize = chunkSize;
+    argsPerCore->measureTime = measureTime;
 
 #ifdef RUNTIME_PROFILE
     clocks_dispatch_starts[i] = rdtsc_s();
@@ -357,6 +522,7 @@ DispatcherInfo NOELLE_DOALLDispatcher(
    * Run a task.
    */
   parallelizedLoop(env, numCores - 1, numCores, chunkSize);
+  int64_t mainEndTime = measureTime ? NOELLE_getTime() : 0;
 
 /*
  * Wait for the remaining DOALL tasks.
@@ -371,6 +537,27 @@ DispatcherInfo NOELLE_DOALLDispatcher(
   std::cerr << "DOALL: Dispatcher:   All task instances have completed"
             << std::endl;
 #endif
+
+  /*
+   * Measure the time spent and the load imbalance between task instances.
+   * The load imbalance is the time between the first and the last task
+   * instance to complete relative to the time spent by the loop.
+   */
+  if (measureTime) {
+    auto endTime = NOELLE_getTime();
+    auto firstEndTime = mainEndTime;
+    auto lastEndTime = mainEndTime;
+    for (auto i = 0; i < (numCores - 1); ++i) {
+      auto taskEndTime = argsForAllCores[i].endTime;
+      firstEndTime = std::min(firstEndTime, taskEndTime);
+      lastEndTime = std::max(lastEndTime, taskEndTime);
+    }
+    auto elapsed = std::max<int64_t>(endTime - startTime, 1);
+    measurement->cores = numCores;
+    measurement->time = (double)elapsed;
+    measurement->imbalance =
+        ((double)(lastEndTime - firstEndTime)) / ((double)elapsed);
+  }
 #ifdef RUNTIME_PROFILE
   auto clocks_after_join = rdtsc_e();
   auto clocks_before_cleanup = rdtsc_s();
@@ -448,6 +635,83 @@ DispatcherInfo NOELLE_DOALLDispatcher(
   return dispatcherInfo;
 }
 
+DispatcherInfo NOELLE_DOALLDispatcher(
+    void (*parallelizedLoop)(void *, int64_t, int64_t, int64_t),
+    void *env,
+    int64_t maxNumberOfCores,
+    int64_t chunkSize) {
+  return NOELLE_DOALLDispatch(parallelizedLoop,
+                              env,
+                              maxNumberOfCores,
+                              chunkSize,
+                              nullptr);
+}
+
+DispatcherInfo NOELLE_DOALLDispatcherForLoop(
+    int64_t loopID,
+    void (*parallelizedLoop)(void *, int64_t, int64_t, int64_t),
+    void *env,
+    int64_t maxNumberOfCores,
+    int64_t chunkSize) {
+
+  /*
+   * Check if the loop has been configured.
+   * The number of cores cannot exceed the one the environment has been
+   * allocated for.
+   */
+  auto conf = runtime.getLoopConfiguration(loopID);
+  if (conf != nullptr) {
+    auto cores = maxNumberOfCores;
+    if (conf->cores >= 1) {
+      cores = std::min(conf->cores, maxNumberOfCores);
+    }
+    return NOELLE_DOALLDispatch(parallelizedLoop,
+                                env,
+                                cores,
+                                conf->chunkSize,
+                                nullptr);
+  }
+
+  /*
+   * Check if the loop needs to be tuned online.
+   */
+  if (!runtime.isDOALLTuningEnabled()) {
+    return NOELLE_DOALLDispatch(parallelizedLoop,
+                                env,
+                                maxNumberOfCores,
+                                chunkSize,
+                                nullptr);
+  }
+
+  /*
+   * Fetch the configuration to use.
+   */
+  auto tuner = runtime.getDOALLTuner(loopID, maxNumberOfCores, chunkSize);
+  int64_t cores;
+  int64_t tunedChunkSize;
+  tuner->getConfiguration(&cores, &tunedChunkSize);
+  if (tuner->isTuned()) {
+    return NOELLE_DOALLDispatch(parallelizedLoop,
+                                env,
+                                cores,
+                                tunedChunkSize,
+                                nullptr);
+  }
+
+  /*
+   * Run the loop and measure the configuration used.
+   */
+  DOALL_measurement_t measurement;
+  auto dispatcherInfo = NOELLE_DOALLDispatch(parallelizedLoop,
+                                             env,
+                                             cores,
+                                             tunedChunkSize,
+                                             &measurement);
+  tuner->addMeasurement(cores, tunedChunkSize, measurement);
+
+  return dispatcherInfo;
+}
+
 /**********************************************************************
  *                HELIX
  **********************************************************************/
@@ -585,6 +849,15 @@ static DispatcherInfo NOELLE_HELIX_dispatcher(
       abort();
     }
 
+    /*
+     * Clear the sequential segment arrays.
+     *
+     * Each sequential segment entry is a cache line that starts with its lock.
+     * The rest of the line carries the values forwarded from a core to the
+     * next one, and no value has been forwarded yet.
+     */
+    memset(ssArrays, 0, ssArraySize * numOfSSArrays);
+
     /*
      * Initialize the sequential segment arrays.
      */
@@ -785,6 +1058,38 @@ DispatcherInfo NOELLE_HELIX_dispatcher_sequentialSegments(
                                  true);
 }
 
+DispatcherInfo NOELLE_HELIX_dispatcher_sequentialSegmentsForLoop(
+    int64_t loopID,
+    void (*parallelizedLoop)(void *,
+                             void *,
+                             void *,
+                             void *,
+                             int64_t,
+                             int64_t,
+                             uint64_t *),
+    void *env,
+    void *loopCarriedArray,
+    int64_t numCores,
+    int64_t numOfsequentialSegments) {
+
+  /*
+   * Check if the loop has been configured.
+   * The number of cores cannot exceed the one the environment has been
+   * allocated for.
+   */
+  auto conf = runtime.getLoopConfiguration(loopID);
+  if ((conf != nullptr) && (conf->cores >= 1)) {
+    numCores = std::min(conf->cores, numCores);
+  }
+
+  return NOELLE_HELIX_dispatcher(parallelizedLoop,
+                                 env,
+                                 loopCarriedArray,
+                                 numCores,
+                                 numOfsequentialSegments,
+                                 true);
+}
+
 DispatcherInfo NOELLE_HELIX_dispatcher_criticalSections(
     void (*parallelizedLoop)(void *,
                              void *,
@@ -805,7 +1110,7 @@ DispatcherInfo NOELLE_HELIX_dispatcher_criticalSections(
                                  false);
 }
 
-void HELIX_wait(void *sequentialSegment) {
+NOELLE_TASK_API void HELIX_wait(void *sequentialSegment) {
 
   /*
    * Fetch the spinlock
@@ -835,7 +1140,7 @@ void HELIX_wait(void *sequentialSegment) {
   return;
 }
 
-void HELIX_signal(void *sequentialSegment) {
+NOELLE_TASK_API void HELIX_signal(void *sequentialSegment) {
 
   /*
    * Fetch the spinlock
@@ -895,11 +1200,62 @@ static void NOELLE_DSWPTrampoline(void *args) {
   return;
 }
 
+static void *NOELLE_DSWPAllocateQueue(int64_t queueSize) {
+  void *queue = nullptr;
+  switch (queueSize) {
+    case 1:
+      queue = new ThreadSafeLockFreeQueue<int8_t>();
+      break;
+    case 8:
+      queue = new ThreadSafeLockFreeQueue<int8_t>();
+      break;
+    case 16:
+      queue = new ThreadSafeLockFreeQueue<int16_t>();
+      break;
+    case 32:
+      queue = new ThreadSafeLockFreeQueue<int32_t>();
+      break;
+    case 64:
+      queue = new ThreadSafeLockFreeQueue<int64_t>();
+      break;
+    default:
+      std::cerr << "NOELLE: Runtime: QUEUE SIZE INCORRECT" << std::endl;
+      abort();
+      break;
+  }
+
+  return queue;
+}
+
+static void NOELLE_DSWPFreeQueue(void *queue, int64_t queueSize) {
+  switch (queueSize) {
+    case 1:
+      delete (ThreadSafeLockFreeQueue<int8_t> *)(queue);
+      break;
+    case 8:
+      delete (ThreadSafeLockFreeQueue<int8_t> *)(queue);
+      break;
+    case 16:
+      delete (ThreadSafeLockFreeQueue<int16_t> *)(queue);
+      break;
+    case 32:
+      delete (ThreadSafeLockFreeQueue<int32_t> *)(queue);
+      break;
+    case 64:
+      delete (ThreadSafeLockFreeQueue<int64_t> *)(queue);
+      break;
+  }
+
+  return;
+}
+
 DispatcherInfo NOELLE_DSWPDispatcher(void *env,
                                      int64_t *queueSizes,
                                      void *stages,
                                      int64_t numberOfStages,
-                                     int64_t numberOfQueues) {
+                                     int64_t numberOfQueues,
+                                     int64_t *queueStages,
+                                     int64_t *stageReplicas) {
 #ifdef RUNTIME_PRINT
   std::cerr << "Starting dispatcher: num stages " << numberOfStages
             << ", num queues: " << numberOfQueues << std::endl;
@@ -910,38 +1266,55 @@ DispatcherInfo NOELLE_DSWPDispatcher(void *env,
    */
   auto virgil = runtime.virgil;
 
+  /*
+   * Compute the number of instances of each stage.
+   * Stages are replicated only if the compiler asked for it.
+   */
+  int64_t replicasOfStage[numberOfStages];
+  int64_t numberOfStageInstances = 0;
+  for (auto i = 0; i < numberOfStages; ++i) {
+    replicasOfStage[i] = (stageReplicas != nullptr) ? stageReplicas[i] : 1;
+    assert(replicasOfStage[i] >= 1);
+    numberOfStageInstances += replicasOfStage[i];
+  }
+
   /*
    * Reserve the cores.
    */
-  auto numCores = runtime.reserveCores(numberOfStages);
+  auto numCores = runtime.reserveCores(numberOfStageInstances);
   assert(numCores >= 1);
 
   /*
    * Allocate the communication queues.
+   *
+   * A queue that has a replicated stage at one of its ends is allocated once
+   * per replica.
+   * Replicas always use their own queue.
+   * A stage that isn't replicated accesses the array of queues of all
+   * replicas, and it picks the one of the replica that executes the current
+   * iteration.
    */
   void *localQueues[numberOfQueues];
+  int64_t replicasOfQueue[numberOfQueues];
   for (auto i = 0; i < numberOfQueues; ++i) {
-    switch (queueSizes[i]) {
-      case 1:
-        localQueues[i] = new ThreadSafeLockFreeQueue<int8_t>();
-        break;
-      case 8:
-        localQueues[i] = new ThreadSafeLockFreeQueue<int8_t>();
-        break;
-      case 16:
-        localQueues[i] = new ThreadSafeLockFreeQueue<int16_t>();
-        break;
-      case 32:
-        localQueues[i] = new ThreadSafeLockFreeQueue<int32_t>();
-        break;
-      case 64:
-        localQueues[i] = new ThreadSafeLockFreeQueue<int64_t>();
-        break;
-      default:
-        std::cerr << "NOELLE: Runtime: QUEUE SIZE INCORRECT" << std::endl;
-        abort();
-        break;
+    replicasOfQueue[i] = 1;
+    if (queueStages != nullptr) {
+      auto fromReplicas = replicasOfStage[queueStages[i * 2]];
+      auto toReplicas = replicasOfStage[queueStages[i * 2 + 1]];
+      assert((fromReplicas == 1) || (toReplicas == 1)
+             || (fromReplicas == toReplicas));
+      replicasOfQueue[i] = std::max(fromReplicas, toReplicas);
     }
+    if (replicasOfQueue[i] == 1) {
+      localQueues[i] = NOELLE_DSWPAllocateQueue(queueSizes[i]);
+      continue;
+    }
+    auto queuesOfReplicas =
+        (void **)malloc(sizeof(void *) * replicasOfQueue[i]);
+    for (auto r = 0; r < replicasOfQueue[i]; ++r) {
+      queuesOfReplicas[r] = NOELLE_DSWPAllocateQueue(queueSizes[i]);
+    }
+    localQueues[i] = (void *)queuesOfReplicas;
   }
 #ifdef RUNTIME_PRINT
   std::cerr << "Made queues" << std::endl;
@@ -950,33 +1323,54 @@ DispatcherInfo NOELLE_DSWPDispatcher(void *env,
   /*
    * Allocate the memory to store the arguments.
    */
-  auto argsForAllCores =
-      (NOELLE_DSWP_args_t *)malloc(sizeof(NOELLE_DSWP_args_t) * numberOfStages);
+  auto argsForAllCores = (NOELLE_DSWP_args_t *)malloc(
+      sizeof(NOELLE_DSWP_args_t) * numberOfStageInstances);
+  auto queuesForAllReplicas = (void **)malloc(
+      sizeof(void *) * numberOfQueues * numberOfStageInstances);
 
   /*
    * Submit DSWP tasks
    */
   auto allStages = (void **)stages;
+  auto instanceID = 0;
   for (auto i = 0; i < numberOfStages; ++i) {
+    for (auto r = 0; r < replicasOfStage[i]; ++r) {
 
-    /*
-     * Prepare the arguments.
-     */
-    auto argsPerCore = &argsForAllCores[i];
-    argsPerCore->funcToInvoke = reinterpret_cast<stageFunctionPtr_t>(
-        reinterpret_cast<long long>(allStages[i]));
-    argsPerCore->env = env;
-    argsPerCore->localQueues = (void *)localQueues;
-    pthread_mutex_init(&(argsPerCore->endLock), NULL);
-    pthread_mutex_lock(&(argsPerCore->endLock));
+      /*
+       * Prepare the queues of the current instance of the stage.
+       */
+      auto queuesOfInstance = (void *)localQueues;
+      if (replicasOfStage[i] > 1) {
+        auto replicaQueues = &queuesForAllReplicas[instanceID * numberOfQueues];
+        for (auto q = 0; q < numberOfQueues; ++q) {
+          replicaQueues[q] = localQueues[q];
+          if (replicasOfQueue[q] > 1) {
+            replicaQueues[q] = ((void **)localQueues[q])[r];
+          }
+        }
+        queuesOfInstance = (void *)replicaQueues;
+      }
 
-    /*
-     * Submit
-     */
-    virgil->submitAndDetach(NOELLE_DSWPTrampoline, argsPerCore);
+      /*
+       * Prepare the arguments.
+       */
+      auto argsPerCore = &argsForAllCores[instanceID];
+      argsPerCore->funcToInvoke = reinterpret_cast<stageFunctionPtr_t>(
+          reinterpret_cast<long long>(allStages[i]));
+      argsPerCore->env = env;
+      argsPerCore->localQueues = queuesOfInstance;
+      pthread_mutex_init(&(argsPerCore->endLock), NULL);
+      pthread_mutex_lock(&(argsPerCore->endLock));
+
+      /*
+       * Submit
+       */
+      virgil->submitAndDetach(NOELLE_DSWPTrampoline, argsPerCore);
+      instanceID++;
 #ifdef RUNTIME_PRINT
-    std::cerr << "Submitted stage" << std::endl;
+      std::cerr << "Submitted stage" << std::endl;
 #endif
+    }
   }
 #ifdef RUNTIME_PRINT
   std::cerr << "Submitted pool" << std::endl;
@@ -985,7 +1379,7 @@ DispatcherInfo NOELLE_DSWPDispatcher(void *env,
   /*
    * Wait for the tasks to complete.
    */
-  for (auto i = 0; i < numberOfStages; ++i) {
+  for (auto i = 0; i < numberOfStageInstances; ++i) {
     pthread_mutex_lock(&(argsForAllCores[i].endLock));
   }
 #ifdef RUNTIME_PRINT
@@ -997,24 +1391,17 @@ DispatcherInfo NOELLE_DSWPDispatcher(void *env,
    */
   runtime.releaseCores(numCores);
   for (int i = 0; i < numberOfQueues; ++i) {
-    switch (queueSizes[i]) {
-      case 1:
-        delete (ThreadSafeLockFreeQueue<int8_t> *)(localQueues[i]);
-        break;
-      case 8:
-        delete (ThreadSafeLockFreeQueue<int8_t> *)(localQueues[i]);
-        break;
-      case 16:
-        delete (ThreadSafeLockFreeQueue<int16_t> *)(localQueues[i]);
-        break;
-      case 32:
-        delete (ThreadSafeLockFreeQueue<int32_t> *)(localQueues[i]);
-        break;
-      case 64:
-        delete (ThreadSafeLockFreeQueue<int64_t> *)(localQueues[i]);
-        break;
+    if (replicasOfQueue[i] == 1) {
+      NOELLE_DSWPFreeQueue(localQueues[i], queueSizes[i]);
+      continue;
+    }
+    auto queuesOfReplicas = (void **)localQueues[i];
+    for (auto r = 0; r < replicasOfQueue[i]; ++r) {
+      NOELLE_DSWPFreeQueue(queuesOfReplicas[r], queueSizes[i]);
     }
+    free(queuesOfReplicas);
   }
+  free(queuesForAllReplicas);
   free(argsForAllCores);
 
 #ifdef DSWP_STATS
@@ -1025,7 +1412,7 @@ DispatcherInfo NOELLE_DSWPDispatcher(void *env,
 #endif
 
   DispatcherInfo dispatcherInfo;
-  dispatcherInfo.numberOfThreadsUsed = numberOfStages;
+  dispatcherInfo.numberOfThreadsUsed = numberOfStageInstances;
   return dispatcherInfo;
 }
 
@@ -1034,6 +1421,79 @@ uint32_t NOELLE_getAvailableCores(void) {
 
   return idleCores;
 }
+
+/*
+ * Select the version of a multi-versioned loop to run.
+ *
+ * The bit i of "availableVersions" is set if the version i has been generated.
+ * The element i of "fixedCoresOfVersions" is the number of cores the version i
+ * always uses (0 if the version adapts to the number of cores configured for
+ * the loop). A version that needs more cores than the configured ones is not
+ * selected.
+ * If the loop has no configuration, "defaultVersion" is selected.
+ */
+uint32_t NOELLE_selectLoopVersion(int64_t loopID,
+                                  uint32_t defaultVersion,
+                                  uint32_t availableVersions,
+                                  uint32_t const *fixedCoresOfVersions) {
+
+  /*
+   * Fetch the configuration of the loop.
+   */
+  auto conf = runtime.getLoopConfiguration(loopID);
+  if (conf == nullptr) {
+    return defaultVersion;
+  }
+  if (!conf->parallelize) {
+    return NOELLE_SEQUENTIAL_VERSION;
+  }
+
+  /*
+   * Techniques to disable
+   * 0: None
+   * 1: DSWP
+   * 2: HELIX
+   * 3: DOALL
+   * 4: DSWP, HELIX
+   * 5: DSWP, DOALL
+   * 6: HELIX, DOALL
+   */
+  auto t = conf->techniquesToDisable;
+  auto isDOALLDisabled = (t == 3) || (t == 5) || (t == 6);
+  auto isHELIXDisabled = (t == 2) || (t == 4) || (t == 6);
+  auto isDSWPDisabled = (t == 1) || (t == 4) || (t == 5);
+
+  /*
+   * Check which versions can run with the cores configured for the loop.
+   */
+  auto canRun = [availableVersions, fixedCoresOfVersions, conf](
+                    uint32_t version) -> bool {
+    if (!(availableVersions & (1 << version))) {
+      return false;
+    }
+    auto fixedCores = static_cast<int64_t>(fixedCoresOfVersions[version]);
+    if ((conf->cores >= 1) && (fixedCores > conf->cores)) {
+      return false;
+    }
+    return true;
+  };
+
+  /*
+   * Pick the first version available and enabled following the preference
+   * used by the parallelizer.
+   */
+  if ((!isDOALLDisabled) && canRun(NOELLE_DOALL_VERSION)) {
+    return NOELLE_DOALL_VERSION;
+  }
+  if ((!isHELIXDisabled) && canRun(NOELLE_HELIX_VERSION)) {
+    return NOELLE_HELIX_VERSION;
+  }
+  if ((!isDSWPDisabled) && canRun(NOELLE_DSWP_VERSION)) {
+    return NOELLE_DSWP_VERSION;
+  }
+
+  return NOELLE_SEQUENTIAL_VERSION;
+}
 }
 
 NoelleRuntime::NoelleRuntime() {
@@ -1042,6 +1502,7 @@ NoelleRuntime::NoelleRuntime() {
 
   pthread_spin_init(&this->spinLock, 0);
   pthread_spin_init(&this->doallMemoryLock, 0);
+  pthread_spin_init(&this->doallTunersLock, 0);
 #ifdef RUNTIME_PRINT_LOCK
   pthread_spin_init(&printLock, 0);
 #endif
@@ -1051,9 +1512,293 @@ NoelleRuntime::NoelleRuntime() {
    */
   this->virgil = new ThreadPoolForCSingleQueue(false, maxCores);
 
+  /*
+   * Read the configurations of the multi-versioned loops.
+   */
+  this->readLoopConfigurations();
+
+  /*
+   * Check if DOALL loops need to be tuned online.
+   * NOELLE_DOALL_TUNING specifies the number of invocations of each loop that
+   * can be used to tune it.
+   */
+  this->doallTuning = false;
+  this->doallTuningInvocations = 0;
+  auto tuningEnvVar = getenv("NOELLE_DOALL_TUNING");
+  if (tuningEnvVar != nullptr) {
+    auto invocations = atoi(tuningEnvVar);
+    if (invocations > 0) {
+      this->doallTuning = true;
+      this->doallTuningInvocations = invocations;
+    }
+  }
+
+  return;
+}
+
+bool NoelleRuntime::isDOALLTuningEnabled(void) const {
+  return this->doallTuning;
+}
+
+DOALLTuner *NoelleRuntime::getDOALLTuner(int64_t loopID,
+                                         int64_t maxCores,
+                                         int64_t chunkSize) {
+  pthread_spin_lock(&this->doallTunersLock);
+  auto &tuner = this->doallTuners[loopID];
+  if (tuner == nullptr) {
+    tuner = new DOALLTuner(maxCores, chunkSize, this->doallTuningInvocations);
+  }
+  pthread_spin_unlock(&this->doallTunersLock);
+
+  return tuner;
+}
+
+DOALLTuner::DOALLTuner(int64_t maxCores,
+                       int64_t chunkSize,
+                       uint32_t invocationsToTune)
+  : maxCores{ std::max<int64_t>(maxCores, 1) },
+    invocationsLeft{ invocationsToTune },
+    tuned{ false },
+    cores{ std::max<int64_t>(maxCores, 1) },
+    chunkSize{ std::max<int64_t>(chunkSize, 1) },
+    samples{ 0 },
+    totalTime{ 0 },
+    totalImbalance{ 0 },
+    bestCores{ std::max<int64_t>(maxCores, 1) },
+    bestChunkSize{ std::max<int64_t>(chunkSize, 1) },
+    bestTime{ -1 },
+    bestImbalance{ 0 } {
+  pthread_spin_init(&this->lock, 0);
+
+  return;
+}
+
+bool DOALLTuner::isTuned(void) const {
+  pthread_spin_lock(&this->lock);
+  auto t = this->tuned;
+  pthread_spin_unlock(&this->lock);
+
+  return t;
+}
+
+void DOALLTuner::getConfiguration(int64_t *cores, int64_t *chunkSize) const {
+  pthread_spin_lock(&this->lock);
+  if (this->tuned) {
+    (*cores) = this->bestCores;
+    (*chunkSize) = this->bestChunkSize;
+  } else {
+    (*cores) = this->cores;
+    (*chunkSize) = this->chunkSize;
+  }
+  pthread_spin_unlock(&this->lock);
+
   return;
 }
 
+void DOALLTuner::addMeasurement(int64_t cores,
+                                int64_t chunkSize,
+                                DOALL_measurement_t const &measurement) {
+  const uint32_t samplesPerConfiguration = 3;
+
+  pthread_spin_lock(&this->lock);
+
+  /*
+   * Skip measurements of configurations that are no longer under measurement
+   * (e.g., concurrent invocations of the same loop).
+   */
+  if ((this->tuned) || (cores != this->cores)
+      || (chunkSize != this->chunkSize)) {
+    pthread_spin_unlock(&this->lock);
+    return;
+  }
+
+  /*
+   * Check if the loop got fewer cores than the ones requested (e.g., other
+   * parallel loops were running).
+   * In this case, the configuration measured is the one with the cores
+   * granted, so the measurement starts over from it.
+   */
+  if (measurement.cores != this->cores) {
+    this->cores = measurement.cores;
+    this->samples = 0;
+    this->totalTime = 0;
+    this->totalImbalance = 0;
+  }
+
+  /*
+   * Accumulate the measurement.
+   */
+  this->totalTime += measurement.time;
+  this->totalImbalance += measurement.imbalance;
+  this->samples++;
+  if (this->invocationsLeft > 0) {
+    this->invocationsLeft--;
+  }
+  if (this->samples < samplesPerConfiguration) {
+    if (this->invocationsLeft == 0) {
+      this->tuned = true;
+    }
+    pthread_spin_unlock(&this->lock);
+    return;
+  }
+
+  /*
+   * The current configuration has been measured.
+   * Check if it is better than the best one found so far.
+   * A configuration must be at least 3% faster to be considered better.
+   */
+  auto time = this->totalTime / this->samples;
+  auto imbalance = this->totalImbalance / this->samples;
+  this->samples = 0;
+  this->totalTime = 0;
+  this->totalImbalance = 0;
+  if ((this->bestTime < 0) || (time < (this->bestTime * 0.97))) {
+    this->bestCores = this->cores;
+    this->bestChunkSize = this->chunkSize;
+    this->bestTime = time;
+    this->bestImbalance = imbalance;
+    this->computeNeighborsOfBestConfiguration();
+  }
+
+  /*
+   * Move to the next configuration to measure.
+   */
+  this->moveToNextConfiguration();
+  if (this->invocationsLeft == 0) {
+    this->tuned = true;
+  }
+
+  pthread_spin_unlock(&this->lock);
+
+  return;
+}
+
+void DOALLTuner::computeNeighborsOfBestConfiguration(void) {
+  this->neighbors.clear();
+
+  /*
+   * Chunk sizes.
+   * Smaller chunks are tried first if the task instances were not balanced.
+   */
+  auto smallerChunk = this->bestChunkSize / 2;
+  auto largerChunk = this->bestChunkSize * 2;
+  auto isImbalanced = (this->bestImbalance > 0.1);
+  if (isImbalanced && (smallerChunk >= 1)) {
+    this->neighbors.push_back({ this->bestCores, smallerChunk });
+  }
+  this->neighbors.push_back({ this->bestCores, largerChunk });
+  if ((!isImbalanced) && (smallerChunk >= 1)) {
+    this->neighbors.push_back({ this->bestCores, smallerChunk });
+  }
+
+  /*
+   * Number of cores.
+   */
+  auto coresStep = std::max<int64_t>(this->bestCores / 4, 1);
+  if ((this->bestCores - coresStep) >= 1) {
+    this->neighbors.push_back(
+        { this->bestCores - coresStep, this->bestChunkSize });
+  }
+  if ((this->bestCores + coresStep) <= this->maxCores) {
+    this->neighbors.push_back(
+        { this->bestCores + coresStep, this->bestChunkSize });
+  }
+
+  /*
+   * The neighbors are tried in order.
+   */
+  std::reverse(this->neighbors.begin(), this->neighbors.end());
+
+  return;
+}
+
+void DOALLTuner::moveToNextConfiguration(void) {
+
+  /*
+   * Check if there is a neighbor left to try.
+   * If there isn't, the best configuration is a local optimum.
+   */
+  if (this->neighbors.empty()) {
+    this->tuned = true;
+    return;
+  }
+
+  /*
+   * Try the next neighbor.
+   */
+  auto next = this->neighbors.back();
+  this->neighbors.pop_back();
+  this->cores = next.first;
+  this->chunkSize = next.second;
+
+  return;
+}
+
+void NoelleRuntime::readLoopConfigurations(void) {
+
+  /*
+   * Check if there is a file that specifies the loop configurations.
+   * The file has the same format of the one read by NOELLE at compile time
+   * (INDEX_FILE): each loop is described by ten integers.
+   */
+  auto fileName = getenv("INDEX_FILE");
+  if (fileName == nullptr) {
+    return;
+  }
+  std::ifstream confFile(fileName);
+  if (!confFile.is_open()) {
+    std::cerr << "NOELLE: Runtime: WARNING: failed to read INDEX_FILE = \""
+              << fileName << "\". The loop configurations are ignored"
+              << std::endl;
+    return;
+  }
+
+  /*
+   * Parse the file.
+   */
+  int64_t values[10];
+  while (true) {
+    auto i = 0;
+    for (; i < 10; i++) {
+      if (!(confFile >> values[i])) {
+        break;
+      }
+    }
+    if (i < 10) {
+      break;
+    }
+
+    /*
+     * Fields: loop ID, should be parallelized, unroll factor, peel factor,
+     * techniques to disable, cores, DOALL chunk factor, and three unused
+     * fields.
+     */
+    LoopConfiguration_t conf;
+    conf.parallelize = (values[1] == 1) && (values[5] >= 2);
+    conf.techniquesToDisable = values[4];
+    conf.cores = values[5];
+
+    /*
+     * The DOALL chunk size is the one defined by INDEX_FILE + 1.
+     * This is because chunk size must start from 1.
+     */
+    conf.chunkSize = values[6] + 1;
+
+    this->loopConfigurations[values[0]] = conf;
+  }
+
+  return;
+}
+
+LoopConfiguration_t *NoelleRuntime::getLoopConfiguration(int64_t loopID) {
+  auto it = this->loopConfigurations.find(loopID);
+  if (it == this->loopConfigurations.end()) {
+    return nullptr;
+  }
+
+  return &it->second;
+}
+
 DOALL_args_t *NoelleRuntime::getDOALLArgs(uint32_t cores, uint32_t *index) {
   DOALL_args_t *argsForAllCores = nullptr;
 
@@ -1189,4 +1934,7 @@ uint32_t NoelleRuntime::getAvailableCores(void) {
 
 NoelleRuntime::~NoelleRuntime(void) {
   delete this->virgil;
+  for (auto tunerPair : this->doallTuners) {
+    delete tunerPair.second;
+  }
 }
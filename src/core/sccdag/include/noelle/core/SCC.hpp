@@ -64,6 +64,23 @@ public:
    */
   std::set<Instruction *> getInstructions(void);
 
+  /*
+   * Return a non-allocating view of the instructions inside the SCC.
+   * Contrary to @getInstructions, the instructions are not sorted.
+   */
+  auto instructions(void) {
+    auto isInstruction = [](const auto &p) {
+      return isa<Instruction>(p.first);
+    };
+    auto toInstruction = [](const auto &p) {
+      return cast<Instruction>(p.first);
+    };
+    auto internalInstructions =
+        make_filter_range(this->internalNodePairs(), isInstruction);
+
+    return map_range(internalInstructions, toInstruction);
+  }
+
   /*
    * Iterate over all instructions (internal and external) until @funcToInvoke
    * returns true or no other instruction exists. External nodes represent
@@ -59,6 +59,16 @@ public:
    */
   std::unordered_set<SCC *> getSCCs(void);
 
+  /*
+   * Return a non-allocating view of the SCCs of the SCCDAG.
+   * The view is invalidated when nodes are added to or removed from the
+   * SCCDAG.
+   */
+  auto sccs(void) {
+    return map_range(this->getNodes(),
+                     [](DGNode<SCC> *sccNode) { return sccNode->getT(); });
+  }
+
   /*
    * Iterate over instructions inside the SCCDAG until @funcToInvoke returns
    * true or no other instruction exists.
@@ -34,7 +34,14 @@ patchInstallDir "noelle-meta-pdg-embed" ;
 patchInstallDir "noelle-meta-prof-clean" ;
 patchInstallDir "noelle-meta-prof-embed" ;
 patchInstallDir "noelle-prof-coverage" ;
+patchInstallDir "noelle-prof-store" ;
 patchInstallDir "noelle-config" ;
 patchInstallDir "noelle-simplification" ;
 patchInstallDir "noelle-codesize" ;
 patchInstallDir "loopaa" ;
+
+# Install the runtime of the loop and dependence profilers, and the machine calibration
+mkdir -p ${installDir}/lib/runtime ;
+cp runtime/LoopProfiler_utils.cpp ${installDir}/lib/runtime/ ;
+cp runtime/DependenceProfiler_utils.cpp ${installDir}/lib/runtime/ ;
+cp runtime/MachineCalibration.cpp ${installDir}/lib/runtime/ ;
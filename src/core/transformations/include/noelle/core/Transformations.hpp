@@ -37,9 +37,10 @@ enum Transformation {
   LOOP_WHILIFIER_ID,
   SCEV_SIMPLIFICATION_ID,
   DEVIRTUALIZER_ID,
+  LOOP_COLLAPSING_ID,
 
   First = DOALL_ID,
-  Last = DEVIRTUALIZER_ID
+  Last = LOOP_COLLAPSING_ID
 };
 
 enum LoopDependenceInfoOptimization {
@@ -75,12 +75,13 @@ bool AutotunerDoallFilter::runOnModule(Module &M) {
    * DOALL, 1: HELIX, 2: DSWP) which correspond to indexes 4, 5, 6 respectively
    * 4: number of cores to use,
    * 5: chunk factor (only useful if selected technique is DOALL),
-   * 6: unknown (NOT USED right now),
-   * 7: unknown (NOT USED right now),
+   * 6: fix the iteration block size (only useful if selected technique is
+   * HELIX; otherwise it is chosen from the profiles),
+   * 7: iteration block factor (only useful if selected technique is HELIX),
    * 8: unknown (NOT USED right now)
    */
   std::string enabledNotDOALLLoopString =
-      "2 0 0 3 " + std::to_string(maxNumCores) + " 0 0 0 0 \n";
+      "2 0 0 3 " + std::to_string(maxNumCores) + " 0 2 8 0 \n";
   std::string enabledDOALLLoopString = "2 0 0 1 " + std::to_string(maxNumCores)
                                        + " 8 0 0 0\n"; // Enable only DOALL
 
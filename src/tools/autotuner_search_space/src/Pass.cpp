@@ -76,12 +76,13 @@ bool AutotunerSearchSpace::runOnModule(Module &M) {
    * DOALL, 1: HELIX, 2: DSWP) which correspond to indexes 4, 5, 6 respectively
    * 4: number of cores to use,
    * 5: chunk factor (only useful if selected technique is DOALL),
-   * 6: unknown (NOT USED right now),
-   * 7: unknown (NOT USED right now),
+   * 6: fix the iteration block size (only useful if selected technique is
+   * HELIX; otherwise it is chosen from the profiles),
+   * 7: iteration block factor (only useful if selected technique is HELIX),
    * 8: unknown (NOT USED right now)
    */
   std::string enabledLoopString =
-      "2 0 0 3 " + std::to_string(maxNumCores) + " 8 0 0 0\n";
+      "2 0 0 3 " + std::to_string(maxNumCores) + " 8 2 8 0\n";
 
   // Get loop structures with 0.0 min hotness to ensure we get all loops
   std::vector<LoopStructure *> *loopStructures = noelle.getLoopStructures(0.0);
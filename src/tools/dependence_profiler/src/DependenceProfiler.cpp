@@ -0,0 +1,366 @@
+/*
+ * Copyright 2023  Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do
+ so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "llvm/Transforms/Utils/ModuleUtils.h"
+#include "noelle/core/SystemHeaders.hpp"
+#include "DependenceProfiler.hpp"
+
+namespace arcana::noelle {
+
+DependenceProfiler::DependenceProfiler() : ModulePass{ ID } {
+  return;
+}
+
+bool DependenceProfiler::runOnModule(Module &M) {
+
+  /*
+   * Fetch NOELLE.
+   */
+  auto &noelle = getAnalysis<Noelle>();
+
+  /*
+   * Declare the runtime functions of the dependence profiler.
+   */
+  auto &context = M.getContext();
+  auto int32Type = Type::getInt32Ty(context);
+  auto int64Type = Type::getInt64Ty(context);
+  auto voidType = Type::getVoidTy(context);
+  auto int8PtrType = Type::getInt8PtrTy(context);
+  this->addInstruction =
+      M.getOrInsertFunction("NOELLE_dependenceProfiler_addInstruction",
+                            voidType,
+                            int32Type,
+                            int8PtrType,
+                            int32Type,
+                            int32Type);
+  this->addDependence =
+      M.getOrInsertFunction("NOELLE_dependenceProfiler_addDependence",
+                            voidType,
+                            int64Type,
+                            int32Type,
+                            int32Type);
+  this->invocationStarted =
+      M.getOrInsertFunction("NOELLE_dependenceProfiler_invocationStarted",
+                            voidType,
+                            int64Type);
+  this->iterationStarted =
+      M.getOrInsertFunction("NOELLE_dependenceProfiler_iterationStarted",
+                            voidType,
+                            int64Type);
+  this->invocationEnded =
+      M.getOrInsertFunction("NOELLE_dependenceProfiler_invocationEnded",
+                            voidType,
+                            int64Type);
+  this->memoryAccessed =
+      M.getOrInsertFunction("NOELLE_dependenceProfiler_memoryAccessed",
+                            voidType,
+                            int64Type,
+                            int32Type,
+                            int64Type,
+                            int64Type);
+
+  /*
+   * Collect the dependences to profile before modifying the code.
+   * This fixes the IDs of the instructions that already exist.
+   */
+  IRNumbering numbering{ M };
+  auto loops = noelle.getLoops();
+  std::map<uint64_t, std::set<std::pair<uint32_t, uint32_t>>> loopDependences;
+  std::map<uint64_t, LoopStructure *> loopStructures;
+  for (auto LDI : *loops) {
+    auto loopStructure = LDI->getLoopStructure();
+    auto loopID = loopStructure->getID();
+    if (!loopID) {
+      continue;
+    }
+    auto deps = this->getDependencesToProfile(LDI, numbering);
+    if (deps.size() == 0) {
+      continue;
+    }
+    loopDependences[loopID.value()] = deps;
+    loopStructures[loopID.value()] = loopStructure;
+  }
+  auto positions = this->getPositionsOfInstructions(loopDependences, numbering);
+
+  /*
+   * Instrument the loops.
+   */
+  std::map<uint64_t, std::set<std::pair<uint32_t, uint32_t>>>
+      profiledDependences;
+  for (auto &pair : loopDependences) {
+    auto loopID = pair.first;
+    if (this->instrumentLoop(loopStructures[loopID],
+                             loopID,
+                             pair.second,
+                             numbering)) {
+      profiledDependences[loopID] = pair.second;
+    }
+  }
+  if (profiledDependences.size() == 0) {
+    delete loops;
+    return false;
+  }
+
+  /*
+   * Tell the runtime which dependences to profile.
+   */
+  this->registerDependences(M, profiledDependences, positions, numbering);
+
+  /*
+   * Free the memory.
+   */
+  delete loops;
+
+  return true;
+}
+
+std::set<std::pair<uint32_t, uint32_t>> DependenceProfiler::
+    getDependencesToProfile(LoopDependenceInfo *LDI, IRNumbering &numbering) {
+  std::set<std::pair<uint32_t, uint32_t>> deps;
+
+  auto loopStructure = LDI->getLoopStructure();
+  auto loopDG = LDI->getLoopDG();
+  for (auto dep : loopDG->getEdges()) {
+    if ((!dep->isMemoryDependence()) || (!dep->isLoopCarriedDependence())) {
+      continue;
+    }
+
+    /*
+     * Only the memory accesses of loads and stores can be observed.
+     */
+    auto fromInst = dyn_cast<Instruction>(dep->getSrc());
+    auto toInst = dyn_cast<Instruction>(dep->getDst());
+    if ((fromInst == nullptr) || (toInst == nullptr)) {
+      continue;
+    }
+    if ((!isa<LoadInst>(fromInst)) && (!isa<StoreInst>(fromInst))) {
+      continue;
+    }
+    if ((!isa<LoadInst>(toInst)) && (!isa<StoreInst>(toInst))) {
+      continue;
+    }
+    if ((!loopStructure->isIncluded(fromInst))
+        || (!loopStructure->isIncluded(toInst))) {
+      continue;
+    }
+
+    deps.insert(
+        std::make_pair(numbering.getID(fromInst), numbering.getID(toInst)));
+  }
+
+  return deps;
+}
+
+std::map<uint32_t, uint32_t> DependenceProfiler::getPositionsOfInstructions(
+    std::map<uint64_t, std::set<std::pair<uint32_t, uint32_t>>> const
+        &loopDependences,
+    IRNumbering &numbering) {
+  std::map<uint32_t, uint32_t> positions;
+
+  /*
+   * Collect the functions of the instructions to describe.
+   */
+  std::unordered_map<Instruction *, uint32_t> instIDs;
+  std::set<Function *> functions;
+  for (auto &pair : loopDependences) {
+    for (auto &dep : pair.second) {
+      for (auto instID : { dep.first, dep.second }) {
+        auto inst = numbering.getValue<Instruction>(instID);
+        assert(inst != nullptr);
+        instIDs[inst] = instID;
+        functions.insert(inst->getFunction());
+      }
+    }
+  }
+
+  /*
+   * Compute the positions with a single walk of each function.
+   */
+  for (auto f : functions) {
+    uint32_t position = 0;
+    for (auto &inst : instructions(f)) {
+      auto it = instIDs.find(&inst);
+      if (it != instIDs.end()) {
+        positions[it->second] = position;
+      }
+      position++;
+    }
+  }
+
+  return positions;
+}
+
+bool DependenceProfiler::instrumentLoop(
+    LoopStructure *loop,
+    uint64_t loopID,
+    std::set<std::pair<uint32_t, uint32_t>> const &deps,
+    IRNumbering &numbering) {
+
+  /*
+   * We need a pre-header and dedicated exits to know where an invocation
+   * starts and ends.
+   */
+  auto preheader = loop->getPreHeader();
+  auto exitBlocks = loop->getLoopExitBasicBlocks();
+  auto hasDedicatedExits = true;
+  for (auto exitBB : exitBlocks) {
+    for (auto predBB : predecessors(exitBB)) {
+      if (!loop->isIncluded(predBB)) {
+        hasDedicatedExits = false;
+      }
+    }
+  }
+  if ((preheader == nullptr) || (!hasDedicatedExits)) {
+    errs() << "DependenceProfiler: WARNING: loop " << loopID
+           << " is not in simplified form and it will not be profiled\n";
+    return false;
+  }
+
+  /*
+   * Start the invocation of the loop.
+   */
+  auto &context = loop->getHeader()->getContext();
+  auto int32Type = Type::getInt32Ty(context);
+  auto int64Type = Type::getInt64Ty(context);
+  auto loopIDValue = ConstantInt::get(int64Type, loopID);
+  IRBuilder<> preheaderBuilder(preheader->getTerminator());
+  preheaderBuilder.CreateCall(this->invocationStarted, { loopIDValue });
+
+  /*
+   * Count the iterations.
+   */
+  IRBuilder<> headerBuilder(&*loop->getHeader()->getFirstInsertionPt());
+  headerBuilder.CreateCall(this->iterationStarted, { loopIDValue });
+
+  /*
+   * End the invocation when the loop exits.
+   */
+  for (auto exitBB : exitBlocks) {
+    IRBuilder<> exitBuilder(&*exitBB->getFirstInsertionPt());
+    exitBuilder.CreateCall(this->invocationEnded, { loopIDValue });
+  }
+
+  /*
+   * Record the memory accessed by the instructions of the dependences.
+   */
+  std::set<uint32_t> instIDs;
+  for (auto &dep : deps) {
+    instIDs.insert(dep.first);
+    instIDs.insert(dep.second);
+  }
+  for (auto instID : instIDs) {
+    auto inst = numbering.getValue<Instruction>(instID);
+    assert(inst != nullptr);
+
+    /*
+     * Fetch the memory accessed.
+     */
+    Value *pointer = nullptr;
+    Type *accessedType = nullptr;
+    if (auto load = dyn_cast<LoadInst>(inst)) {
+      pointer = load->getPointerOperand();
+      accessedType = load->getType();
+    } else {
+      auto store = cast<StoreInst>(inst);
+      pointer = store->getPointerOperand();
+      accessedType = store->getValueOperand()->getType();
+    }
+    auto &DL = inst->getModule()->getDataLayout();
+    auto accessedBytes = DL.getTypeStoreSize(accessedType);
+
+    /*
+     * Record the access just before it happens.
+     */
+    IRBuilder<> builder(inst);
+    auto address = builder.CreatePtrToInt(pointer, int64Type);
+    builder.CreateCall(this->memoryAccessed,
+                       { loopIDValue,
+                         ConstantInt::get(int32Type, instID),
+                         address,
+                         ConstantInt::get(int64Type, accessedBytes) });
+  }
+
+  return true;
+}
+
+void DependenceProfiler::registerDependences(
+    Module &M,
+    std::map<uint64_t, std::set<std::pair<uint32_t, uint32_t>>> const
+        &loopDependences,
+    std::map<uint32_t, uint32_t> const &positions,
+    IRNumbering &numbering) {
+
+  /*
+   * Create the constructor that registers the dependences to the runtime.
+   */
+  auto &context = M.getContext();
+  auto int32Type = Type::getInt32Ty(context);
+  auto int64Type = Type::getInt64Ty(context);
+  auto ctorType = FunctionType::get(Type::getVoidTy(context), false);
+  auto ctor = Function::Create(ctorType,
+                               GlobalValue::InternalLinkage,
+                               "NOELLE_dependenceProfiler_init",
+                               &M);
+  auto entryBB = BasicBlock::Create(context, "entry", ctor);
+  IRBuilder<> builder(entryBB);
+
+  /*
+   * Describe the instructions of the dependences as they were before the
+   * instrumentation.
+   */
+  std::unordered_map<Function *, Value *> functionNames;
+  for (auto &pair : positions) {
+    auto inst = numbering.getValue<Instruction>(pair.first);
+    assert(inst != nullptr);
+    auto f = inst->getFunction();
+    if (functionNames.find(f) == functionNames.end()) {
+      functionNames[f] = builder.CreateGlobalStringPtr(f->getName());
+    }
+    builder.CreateCall(this->addInstruction,
+                       { ConstantInt::get(int32Type, pair.first),
+                         functionNames[f],
+                         ConstantInt::get(int32Type, pair.second),
+                         ConstantInt::get(int32Type, inst->getOpcode()) });
+  }
+
+  /*
+   * Register the dependences.
+   */
+  for (auto &pair : loopDependences) {
+    auto loopIDValue = ConstantInt::get(int64Type, pair.first);
+    for (auto &dep : pair.second) {
+      builder.CreateCall(this->addDependence,
+                         { loopIDValue,
+                           ConstantInt::get(int32Type, dep.first),
+                           ConstantInt::get(int32Type, dep.second) });
+    }
+  }
+  builder.CreateRetVoid();
+
+  /*
+   * Run the constructor before main.
+   */
+  appendToGlobalCtors(M, ctor, 0);
+
+  return;
+}
+
+} // namespace arcana::noelle
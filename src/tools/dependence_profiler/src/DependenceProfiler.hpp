@@ -0,0 +1,93 @@
+/*
+ * Copyright 2023  Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do
+ so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#pragma once
+
+#include "noelle/core/Noelle.hpp"
+#include "noelle/core/IRNumbering.hpp"
+
+namespace arcana::noelle {
+
+/*
+ * Instrument the loops that have an ID to observe which of their loop-carried
+ * memory dependences manifest at run time.
+ *
+ * The instrumented program has to be linked with the runtime of the
+ * dependence profiler (DependenceProfiler_utils.cpp). The profile it generates
+ * can be given to NOELLE via -noelle-dependence-profile and it is then
+ * available through Hot::getMemoryDependenceProfile.
+ *
+ * Instructions are identified by their IDs given by IRNumbering before the
+ * instrumentation. The profile also describes each of these instructions by
+ * its function, its position within it, and its opcode, so that NOELLE can
+ * discard the profiles that do not match the IR they are loaded for.
+ */
+class DependenceProfiler : public ModulePass {
+public:
+  static char ID;
+
+  DependenceProfiler();
+
+  bool doInitialization(Module &M) override;
+
+  void getAnalysisUsage(AnalysisUsage &AU) const override;
+
+  bool runOnModule(Module &M) override;
+
+private:
+  FunctionCallee addInstruction;
+  FunctionCallee addDependence;
+  FunctionCallee invocationStarted;
+  FunctionCallee iterationStarted;
+  FunctionCallee invocationEnded;
+  FunctionCallee memoryAccessed;
+
+  /*
+   * Return the pairs of IDs of the instructions of the loop-carried memory
+   * dependences of @LDI that can be profiled.
+   */
+  std::set<std::pair<uint32_t, uint32_t>> getDependencesToProfile(
+      LoopDependenceInfo *LDI,
+      IRNumbering &numbering);
+
+  /*
+   * Return the position within its function of each instruction of the
+   * dependences of @loopDependences.
+   */
+  std::map<uint32_t, uint32_t> getPositionsOfInstructions(
+      std::map<uint64_t, std::set<std::pair<uint32_t, uint32_t>>> const
+          &loopDependences,
+      IRNumbering &numbering);
+
+  bool instrumentLoop(LoopStructure *loop,
+                      uint64_t loopID,
+                      std::set<std::pair<uint32_t, uint32_t>> const &deps,
+                      IRNumbering &numbering);
+
+  void registerDependences(
+      Module &M,
+      std::map<uint64_t, std::set<std::pair<uint32_t, uint32_t>>> const
+          &loopDependences,
+      std::map<uint32_t, uint32_t> const &positions,
+      IRNumbering &numbering);
+};
+
+} // namespace arcana::noelle
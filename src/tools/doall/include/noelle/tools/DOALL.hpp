@@ -31,6 +31,7 @@
 #include "noelle/core/IVStepperUtility.hpp"
 #include "noelle/tools/ParallelizationTechnique.hpp"
 #include "noelle/tools/DOALLTask.hpp"
+#include "noelle/tools/RuntimeAliasCheck.hpp"
 #include "HeuristicsPass.hpp"
 
 namespace arcana::noelle {
@@ -42,6 +43,20 @@ public:
    */
   DOALL(Noelle &noelle);
 
+  /*
+   * When speculateMemoryDependences is true, loop-carried memory dependences
+   * that cannot be disproved at compile time are speculated not to happen.
+   * This speculation is checked when the loop starts: if it fails, the
+   * original loop runs.
+   *
+   * When configurableAtRuntime is true, the runtime can change the number of
+   * cores and the chunk size of the parallelized loops that have an ID (e.g.,
+   * from INDEX_FILE or by tuning them online).
+   */
+  DOALL(Noelle &noelle,
+        bool speculateMemoryDependences,
+        bool configurableAtRuntime);
+
   bool apply(LoopDependenceInfo *LDI, Heuristics *h) override;
 
   bool canBeAppliedToLoop(LoopDependenceInfo *LDI,
@@ -60,8 +75,10 @@ public:
 protected:
   bool enabled;
   Function *taskDispatcher;
+  Function *taskDispatcherForLoop;
   Noelle &n;
   std::map<PHINode *, std::set<Instruction *>> IVValueJustBeforeEnteringBody;
+  bool speculateMemoryDependences;
 
   virtual void invokeParallelizedLoop(LoopDependenceInfo *LDI);
 
@@ -70,6 +87,11 @@ protected:
    */
   void rewireLoopToIterateChunks(LoopDependenceInfo *LDI, DOALLTask *task);
 
+  /*
+   * Speculation of loop-carried memory dependences
+   */
+  void speculateMemoryDependencesOfLoop(LoopDependenceInfo *LDI);
+
   /*
    * Interface
    */
@@ -23,11 +23,19 @@
 
 namespace arcana::noelle {
 
-DOALL::DOALL(Noelle &noelle)
+DOALL::DOALL(Noelle &noelle) : DOALL{ noelle, false, false } {
+  return;
+}
+
+DOALL::DOALL(Noelle &noelle,
+             bool speculateMemoryDependences,
+             bool configurableAtRuntime)
   : ParallelizationTechnique{ noelle },
     enabled{ true },
     taskDispatcher{ nullptr },
-    n{ noelle } {
+    taskDispatcherForLoop{ nullptr },
+    n{ noelle },
+    speculateMemoryDependences{ speculateMemoryDependences } {
 
   /*
    * Fetch the dispatcher to use to jump to a parallelized DOALL loop.
@@ -42,6 +50,17 @@ DOALL::DOALL(Noelle &noelle)
     }
   }
 
+  /*
+   * Fetch the dispatcher that can change the configuration of a DOALL loop at
+   * runtime (e.g., its chunk size), if this has been requested.
+   * If it isn't available, the configuration is the one chosen at compile
+   * time.
+   */
+  if (configurableAtRuntime) {
+    this->taskDispatcherForLoop =
+        this->n.getProgram()->getFunction("NOELLE_DOALLDispatcherForLoop");
+  }
+
   return;
 }
 
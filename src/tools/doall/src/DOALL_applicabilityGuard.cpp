@@ -116,6 +116,20 @@ bool DOALL::canBeAppliedToLoop(LoopDependenceInfo *LDI, Heuristics *h) const {
    * SCCs with loop-carried data dependences.
    */
   auto nonDOALLSCCs = DOALL::getSCCsThatBlockDOALLToBeApplicable(LDI, this->n);
+  if ((nonDOALLSCCs.size() > 0) && this->speculateMemoryDependences) {
+
+    /*
+     * Some of the SCCs might not block DOALL if their loop-carried memory
+     * dependences are speculated.
+     */
+    RuntimeAliasCheck aliasCheck{ this->n, LDI };
+    nonDOALLSCCs = aliasCheck.speculateSCCs(nonDOALLSCCs);
+    if ((nonDOALLSCCs.size() == 0) && (this->verbose != Verbosity::Disabled)) {
+      errs() << "DOALL:   The loop requires to speculate "
+             << aliasCheck.getSpeculatedDependences().size()
+             << " loop-carried memory dependences\n";
+    }
+  }
   if (nonDOALLSCCs.size() > 0) {
     if (this->verbose != Verbosity::Disabled) {
       for (auto scc : nonDOALLSCCs) {
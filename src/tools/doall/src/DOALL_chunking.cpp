@@ -131,7 +131,7 @@ void DOALL::rewireLoopToIterateChunks(LoopDependenceInfo *LDI,
    * Generates code for periodic variable SCCs to match the DOALL chunking
    * strategy.
    */
-  for (auto scc : sccdag->getSCCs()) {
+  for (auto scc : sccdag->sccs()) {
     auto sccInfo = sccManager->getSCCAttrs(scc);
     auto periodicVariableSCC = dyn_cast<PeriodicVariableSCC>(sccInfo);
     if (periodicVariableSCC == nullptr)
@@ -584,7 +584,7 @@ void DOALL::rewireLoopToIterateChunks(LoopDependenceInfo *LDI,
   /*
    * In each latch, check whether we passed the last iteration.
    */
-  for (auto latch : loopSummary->getLatches()) {
+  for (auto latch : loopSummary->latches()) {
 
     /*
      * Fetch the latch in the loop within the task.
@@ -54,12 +54,29 @@ void DOALL::invokeParallelizedLoop(LoopDependenceInfo *LDI) {
   /*
    * Call the dispatcher that will dispatch the tasks that execute the
    * parallelized loop.
+   *
+   * If the loop has an ID and its configuration can change at runtime, then
+   * the runtime can change the number of cores (up to the one used to allocate
+   * the environment) and the chunk size of the loop. This happens when the
+   * loop is configured when the program starts or when the runtime tunes them
+   * online.
    */
   IRBuilder<> doallBuilder(this->entryPointOfParallelizedLoop);
-  auto doallCallInst = doallBuilder.CreateCall(
-      this->taskDispatcher,
-      ArrayRef<Value *>(
-          { tasks[0]->getTaskBody(), envPtr, numCores, chunkSize }));
+  auto loopIDOpt = LDI->getLoopStructure()->getID();
+  CallInst *doallCallInst = nullptr;
+  if ((this->taskDispatcherForLoop != nullptr) && loopIDOpt) {
+    auto loopID = cm->getIntegerConstant(loopIDOpt.value(), 64);
+    doallCallInst = doallBuilder.CreateCall(
+        this->taskDispatcherForLoop,
+        ArrayRef<Value *>(
+            { loopID, tasks[0]->getTaskBody(), envPtr, numCores, chunkSize }));
+
+  } else {
+    doallCallInst = doallBuilder.CreateCall(
+        this->taskDispatcher,
+        ArrayRef<Value *>(
+            { tasks[0]->getTaskBody(), envPtr, numCores, chunkSize }));
+  }
 
   /*
    * Get the return value of the dispatcher, which has the information about how
@@ -68,6 +68,11 @@ bool DOALL::apply(LoopDependenceInfo *LDI, Heuristics *h) {
     errs() << "DOALL:   Chunk size = " << ltm->getChunkSize() << "\n";
   }
 
+  /*
+   * Speculate the loop-carried memory dependences that block DOALL, if any.
+   */
+  this->speculateMemoryDependencesOfLoop(LDI);
+
   /*
    * Define the signature of the task, which will be invoked by the DOALL
    * dispatcher.
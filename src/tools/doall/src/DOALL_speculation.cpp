@@ -0,0 +1,66 @@
+/*
+ * Copyright 2023  Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do
+ so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "noelle/tools/DOALL.hpp"
+
+namespace arcana::noelle {
+
+void DOALL::speculateMemoryDependencesOfLoop(LoopDependenceInfo *LDI) {
+  this->guardOfParallelizedLoop = nullptr;
+
+  /*
+   * Check if speculation is enabled.
+   */
+  if (!this->speculateMemoryDependences) {
+    return;
+  }
+
+  /*
+   * Fetch the loop-carried memory dependences to speculate.
+   */
+  auto nonDOALLSCCs = DOALL::getSCCsThatBlockDOALLToBeApplicable(LDI, this->n);
+  RuntimeAliasCheck aliasCheck{ this->n, LDI };
+  auto sccsThatStillBlock = aliasCheck.speculateSCCs(nonDOALLSCCs);
+  assert(sccsThatStillBlock.size() == 0);
+  auto speculatedDependences = aliasCheck.getSpeculatedDependences();
+  if (speculatedDependences.size() == 0) {
+    return;
+  }
+  if (this->verbose != Verbosity::Disabled) {
+    errs() << "DOALL:   Speculate " << speculatedDependences.size()
+           << " loop-carried memory dependences\n";
+  }
+
+  /*
+   * Record the dependences that have been speculated away.
+   */
+  aliasCheck.addRemediesToSpeculatedDependences();
+
+  /*
+   * Check the speculation when the loop starts.
+   * The parallelized loop runs only if the speculation holds.
+   */
+  this->guardOfParallelizedLoop = aliasCheck.generateCheck();
+
+  return;
+}
+
+} // namespace arcana::noelle
@@ -40,7 +40,10 @@ public:
   /*
    * Methods
    */
-  DSWP(Noelle &par, bool forceParallelization, bool enableSCCMerging);
+  DSWP(Noelle &par,
+       bool forceParallelization,
+       bool enableSCCMerging,
+       uint32_t stageReplicas);
 
   bool apply(LoopDependenceInfo *LDI, Heuristics *h) override;
 
@@ -49,6 +52,11 @@ public:
 
   uint32_t getMinimumNumberOfIdleCores(void) const override;
 
+  /*
+   * The stages and their replicas are bound to the generated code.
+   */
+  uint32_t getNumberOfCoresFixedAtCompileTime(void) const override;
+
   std::set<GenericSCC *> getClonableSCCs(SCCDAGAttrs *sccManager,
                                          LoopTree *loopNode) const;
 
@@ -69,12 +77,14 @@ private:
    * CLI Options
    */
   bool enableMergingSCC;
+  uint32_t stageReplicas;
 
   /*
    * Stores new pipeline execution
    */
   std::unordered_map<SCC *, DSWPTask *> sccToStage;
   std::vector<std::unique_ptr<QueueInfo>> queues;
+  std::vector<DSWPTask *> replicatedStages;
 
   /*
    * Types for arrays storing dependencies and stages
@@ -114,6 +124,27 @@ private:
   Value *createQueueSizesArrayFromStages(LoopDependenceInfo *LDI,
                                          IRBuilder<> funcBuilder,
                                          Noelle &par);
+  Value *createQueueStagesArrayFromStages(LoopDependenceInfo *LDI,
+                                          IRBuilder<> funcBuilder,
+                                          Noelle &par);
+  Value *createStageReplicasArrayFromStages(LoopDependenceInfo *LDI,
+                                            IRBuilder<> funcBuilder,
+                                            Noelle &par);
+
+  /*
+   * Replication of stages without loop-carried dependences (PS-DSWP)
+   */
+  void replicateStages(LoopDependenceInfo *LDI);
+  bool canBeReplicated(LoopDependenceInfo *LDI, int taskIndex) const;
+  bool isRoutedQueue(DSWPTask *task, int queueIndex) const;
+  uint32_t getNumberOfQueues(void) const;
+  Value *fetchQueuePointer(Noelle &par,
+                           DSWPTask *task,
+                           int queueIndex,
+                           IRBuilder<> &builder);
+  void generateCodeToRouteIterationsToReplicas(LoopDependenceInfo *LDI,
+                                               Noelle &par,
+                                               int taskIndex);
 
   bool canBeCloned(GenericSCC *scc) const;
 
@@ -70,6 +70,26 @@ public:
    * Stores information on queue/env usage within stage
    */
   unordered_map<int, std::unique_ptr<QueueInstrs>> queueInstrMap;
+
+  /*
+   * Number of instances of the stage that run in parallel.
+   * Each instance (replica) executes the iterations assigned to it in a
+   * round-robin fashion.
+   */
+  uint32_t numberOfReplicas;
+
+  /*
+   * Queue used by the first stage to tell each replica of this stage whether
+   * there is another iteration to execute (-1 if the stage isn't replicated)
+   */
+  int replicaTokenQueue;
+
+  /*
+   * Replica that executes the current iteration.
+   * It is used by a non-replicated stage to route the values exchanged with
+   * replicated stages.
+   */
+  Value *replicaSlot;
 };
 
 struct QueueInfo {
@@ -110,6 +130,7 @@ struct QueueInfo {
 
 struct QueueInstrs {
   Value *queuePtr;
+  Value *queueReplicas;
   Value *queueCall;
   Value *alloca;
   Value *allocaCast;
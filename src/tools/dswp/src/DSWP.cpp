@@ -25,12 +25,17 @@
 
 namespace arcana::noelle {
 
-DSWP::DSWP(Noelle &n, bool forceParallelization, bool enableSCCMerging)
+DSWP::DSWP(Noelle &n,
+           bool forceParallelization,
+           bool enableSCCMerging,
+           uint32_t stageReplicas)
   : ParallelizationTechniqueForLoopsWithLoopCarriedDataDependences{ n,
                                                                     forceParallelization },
     minCores{ 0 },
     enableMergingSCC{ enableSCCMerging },
+    stageReplicas{ stageReplicas },
     queues{},
+    replicatedStages{},
     queueArrayType{ nullptr },
     sccToStage{},
     stageArrayType{ nullptr },
@@ -270,6 +275,11 @@ bool DSWP::apply(LoopDependenceInfo *LDI, Heuristics *h) {
   collectLiveInEnvInfo(LDI);
   collectLiveOutEnvInfo(LDI);
 
+  /*
+   * Replicate the stages whose iterations can run in parallel.
+   */
+  this->replicateStages(LDI);
+
   if (this->verbose >= Verbosity::Minimal) {
     printStageSCCs(LDI);
   }
@@ -286,8 +296,8 @@ bool DSWP::apply(LoopDependenceInfo *LDI, Heuristics *h) {
    */
   this->zeroIndexForBaseArray = cm->getIntegerConstant(0, 64);
   auto int8Type = tm->getIntegerType(8);
-  this->queueArrayType =
-      ArrayType::get(PointerType::getUnqual(int8Type), this->queues.size());
+  this->queueArrayType = ArrayType::get(PointerType::getUnqual(int8Type),
+                                       this->getNumberOfQueues());
   this->stageArrayType =
       ArrayType::get(PointerType::getUnqual(int8Type), this->tasks.size());
 
@@ -368,6 +378,11 @@ bool DSWP::apply(LoopDependenceInfo *LDI, Heuristics *h) {
       errs() << "DSWP:  Stored live out instructions\n";
     }
 
+    /*
+     * Distribute the iterations among the replicas of the replicated stages.
+     */
+    generateCodeToRouteIterationsToReplicas(LDI, this->noelle, i);
+
     /*
      * Inline recursively calls to queues.
      */
@@ -397,6 +412,9 @@ bool DSWP::apply(LoopDependenceInfo *LDI, Heuristics *h) {
    * Set the minimum number of cores.
    */
   this->minCores = this->tasks.size();
+  for (auto replicatedStage : this->replicatedStages) {
+    this->minCores += (replicatedStage->numberOfReplicas - 1);
+  }
 
   /*
    * Exit
@@ -412,6 +430,10 @@ uint32_t DSWP::getMinimumNumberOfIdleCores(void) const {
   return this->minCores;
 }
 
+uint32_t DSWP::getNumberOfCoresFixedAtCompileTime(void) const {
+  return this->minCores;
+}
+
 std::string DSWP::getName(void) const {
   return "DSWP";
 }
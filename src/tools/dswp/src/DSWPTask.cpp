@@ -26,7 +26,10 @@ namespace arcana::noelle {
 DSWPTask::DSWPTask(FunctionType *taskSignature, Module &M)
   : Task{ taskSignature, M },
     stageSCCs{},
-    clonableSCCs{} {
+    clonableSCCs{},
+    numberOfReplicas{ 1 },
+    replicaTokenQueue{ -1 },
+    replicaSlot{ nullptr } {
 
   auto argIter = this->F->arg_begin();
   this->envArg = (Value *)&*(argIter++);
@@ -0,0 +1,387 @@
+/*
+ * Copyright 2023  Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do
+ so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "noelle/tools/DSWP.hpp"
+#include "noelle/core/LoopIterationSCC.hpp"
+
+namespace arcana::noelle {
+
+void DSWP::replicateStages(LoopDependenceInfo *LDI) {
+
+  /*
+   * Check if stages need to be replicated.
+   */
+  if (this->stageReplicas <= 1) {
+    return;
+  }
+
+  /*
+   * Replicas that have no iterations left jump to the exit of the loop.
+   * Hence, the loop must have only one exit.
+   */
+  auto loopStructure = LDI->getLoopStructure();
+  if (loopStructure->getLoopExitBasicBlocks().size() != 1) {
+    return;
+  }
+
+  /*
+   * Replicate the stages whose iterations are independent.
+   * The first stage is never replicated because it is the one that hands the
+   * iterations to the replicas.
+   */
+  for (auto i = 1; i < this->tasks.size(); ++i) {
+    if (!this->canBeReplicated(LDI, i)) {
+      continue;
+    }
+    auto task = (DSWPTask *)this->tasks[i];
+    task->numberOfReplicas = this->stageReplicas;
+    task->replicaTokenQueue =
+        this->queues.size() + this->replicatedStages.size();
+    this->replicatedStages.push_back(task);
+
+    if (this->verbose != Verbosity::Disabled) {
+      errs() << "DSWP:  Stage " << i << " is replicated "
+             << task->numberOfReplicas << " times\n";
+    }
+  }
+
+  return;
+}
+
+bool DSWP::canBeReplicated(LoopDependenceInfo *LDI, int taskIndex) const {
+
+  /*
+   * Fetch the stage.
+   */
+  auto task = (DSWPTask *)this->tasks[taskIndex];
+
+  /*
+   * Live-out values are produced by the last iteration, which is executed by
+   * only one replica.
+   */
+  auto envUser = this->envBuilder->getUser(taskIndex);
+  auto liveOuts = envUser->getEnvIDsOfLiveOutVars();
+  if (liveOuts.begin() != liveOuts.end()) {
+    return false;
+  }
+
+  /*
+   * Fetch the loop.
+   */
+  auto sccManager = LDI->getSCCManager();
+  auto sccdag = sccManager->getSCCDAG();
+  auto loopNode = LDI->getLoopHierarchyStructures();
+  auto topLoop = loopNode->getLoop();
+  auto loopHeader = LDI->getLoopStructure()->getHeader();
+
+  /*
+   * Dependences that are carried by sub-loops are satisfied within the
+   * iteration of the loop that executes them.
+   */
+  auto isCarriedAcrossIterations = [loopNode, topLoop](auto dependence) {
+    if (!dependence->isLoopCarriedDependence()) {
+      return false;
+    }
+    auto src = cast<Instruction>(dependence->getSrc());
+    auto dst = cast<Instruction>(dependence->getDst());
+    return (loopNode->getInnermostLoopThatContains(src) == topLoop)
+           || (loopNode->getInnermostLoopThatContains(dst) == topLoop);
+  };
+
+  /*
+   * Check every SCC executed by the stage.
+   */
+  std::set<SCC *> stageSCCs(task->stageSCCs.begin(), task->stageSCCs.end());
+  stageSCCs.insert(task->clonableSCCs.begin(), task->clonableSCCs.end());
+  for (auto scc : stageSCCs) {
+
+    /*
+     * The SCC must not carry a dependence across iterations.
+     */
+    auto sccInfo = sccManager->getSCCAttrs(scc);
+    if (auto lcSCC = dyn_cast<LoopCarriedSCC>(sccInfo)) {
+      for (auto dependence : lcSCC->getLoopCarriedDependences()) {
+        if (isCarriedAcrossIterations(dependence)) {
+          return false;
+        }
+      }
+    }
+
+    /*
+     * PHIs of the header merge values that come from the previous iteration,
+     * which is executed by another replica.
+     */
+    for (auto nodePair : scc->internalNodePairs()) {
+      auto phi = dyn_cast<PHINode>(nodePair.first);
+      if ((phi != nullptr) && (phi->getParent() == loopHeader)) {
+        return false;
+      }
+    }
+
+    /*
+     * The dependences between SCCs of the stage must not be carried across
+     * iterations.
+     */
+    for (auto sccEdge : sccdag->fetchNode(scc)->getOutgoingEdges()) {
+      if (stageSCCs.find(sccEdge->getDst()) == stageSCCs.end()) {
+        continue;
+      }
+      for (auto subEdge : sccEdge->getSubEdges()) {
+        if (isCarriedAcrossIterations(subEdge)) {
+          return false;
+        }
+      }
+    }
+  }
+
+  return true;
+}
+
+uint32_t DSWP::getNumberOfQueues(void) const {
+
+  /*
+   * There is a queue of tokens after the queues between stages for each
+   * replicated stage.
+   */
+  auto numberOfQueues = this->queues.size() + this->replicatedStages.size();
+
+  return numberOfQueues;
+}
+
+bool DSWP::isRoutedQueue(DSWPTask *task, int queueIndex) const {
+
+  /*
+   * Replicas always use their own queues.
+   */
+  if (task->numberOfReplicas > 1) {
+    return false;
+  }
+
+  /*
+   * Queues of tokens always connect the first stage to a replicated one.
+   */
+  if (queueIndex >= this->queues.size()) {
+    return true;
+  }
+
+  /*
+   * Check whether the other end of the queue is a replicated stage.
+   */
+  auto &queueInfo = this->queues[queueIndex];
+  auto otherStageID = queueInfo->fromStage;
+  if (otherStageID == task->getID()) {
+    otherStageID = queueInfo->toStage;
+  }
+  auto otherStage =
+      (DSWPTask *)this->tasks[this->fromTaskIDToUserID.at(otherStageID)];
+
+  return otherStage->numberOfReplicas > 1;
+}
+
+Value *DSWP::fetchQueuePointer(Noelle &par,
+                               DSWPTask *task,
+                               int queueIndex,
+                               IRBuilder<> &builder) {
+
+  /*
+   * Check if the queue is shared only between two stage instances.
+   */
+  auto queueInstrs = task->queueInstrMap[queueIndex].get();
+  if (queueInstrs->queueReplicas == nullptr) {
+    return queueInstrs->queuePtr;
+  }
+
+  /*
+   * Select the queue of the replica that executes the current iteration.
+   */
+  assert(task->replicaSlot != nullptr);
+  auto slot = builder.CreateLoad(task->replicaSlot);
+  auto queuePtr = builder.CreateInBoundsGEP(queueInstrs->queueReplicas, slot);
+
+  return builder.CreateLoad(queuePtr);
+}
+
+void DSWP::generateCodeToRouteIterationsToReplicas(LoopDependenceInfo *LDI,
+                                                   Noelle &par,
+                                                   int taskIndex) {
+
+  /*
+   * Check if there are replicas.
+   */
+  if (this->replicatedStages.size() == 0) {
+    return;
+  }
+
+  /*
+   * Fetch the managers.
+   */
+  auto cm = par.getConstantsManager();
+
+  /*
+   * Fetch the stage.
+   */
+  auto task = (DSWPTask *)this->tasks[taskIndex];
+  auto loopHeader = LDI->getLoopStructure()->getHeader();
+  auto headerClone = task->getCloneOfOriginalBasicBlock(loopHeader);
+
+  /*
+   * Check if the stage is a replica or if it exchanges values with replicas.
+   */
+  if ((task->numberOfReplicas == 1) && (task->replicaSlot == nullptr)) {
+    return;
+  }
+
+  /*
+   * Fetch the queue APIs used for tokens.
+   */
+  auto tokenQueueIndex = par.queues.queueSizeToIndex[1];
+  auto tokenQueueType = par.queues.queueTypes[tokenQueueIndex];
+  auto tokenType = par.queues.queueElementTypes[tokenQueueIndex];
+  auto tokenPush = par.queues.queuePushes[tokenQueueIndex];
+  auto tokenPop = par.queues.queuePops[tokenQueueIndex];
+
+  /*
+   * Fetch the array of queues at the entry of the stage.
+   */
+  auto entryTerminator = task->getEntry()->getTerminator();
+  IRBuilder<> entryBuilder(entryTerminator);
+  auto queuesArray =
+      entryBuilder.CreateBitCast(task->queueArg,
+                                 PointerType::getUnqual(this->queueArrayType));
+  auto tokenAlloca = entryBuilder.CreateAlloca(tokenType);
+
+  /*
+   * Check if the current stage is replicated.
+   */
+  if (task->numberOfReplicas > 1) {
+
+    /*
+     * Load the queue of tokens of the current replica.
+     */
+    auto queueIndexValue =
+        cm->getIntegerConstant(task->replicaTokenQueue, 64);
+    auto queuePtr = entryBuilder.CreateInBoundsGEP(
+        queuesArray,
+        ArrayRef<Value *>({ this->zeroIndexForBaseArray, queueIndexValue }));
+    auto queueCast =
+        entryBuilder.CreateBitCast(queuePtr,
+                                   PointerType::getUnqual(tokenQueueType));
+    auto tokenQueue = entryBuilder.CreateLoad(queueCast);
+
+    /*
+     * Before starting an iteration, the replica waits for its token.
+     * A zero token means that the other stages have completed the loop.
+     */
+    auto &cxt = task->getTaskBody()->getContext();
+    auto tokenBB = BasicBlock::Create(cxt, "", task->getTaskBody());
+    std::vector<BasicBlock *> headerPredecessors(pred_begin(headerClone),
+                                                 pred_end(headerClone));
+    for (auto predecessor : headerPredecessors) {
+      auto predecessorTerminator = predecessor->getTerminator();
+      predecessorTerminator->replaceUsesOfWith(headerClone, tokenBB);
+    }
+    IRBuilder<> tokenBuilder(tokenBB);
+    tokenBuilder.CreateCall(tokenPop,
+                            ArrayRef<Value *>({ tokenQueue, tokenAlloca }));
+    auto token = tokenBuilder.CreateLoad(tokenAlloca);
+    auto isIterationAssigned =
+        tokenBuilder.CreateICmpNE(token, cm->getIntegerConstant(0, 8));
+    tokenBuilder.CreateCondBr(isIterationAssigned,
+                              headerClone,
+                              task->getLastBlock(0));
+
+    return;
+  }
+
+  /*
+   * The current stage isn't replicated, but it exchanges values with
+   * replicated stages.
+   *
+   * At the beginning of every iteration, move to the replica that executes
+   * it.
+   */
+  IRBuilder<> headerBuilder(headerClone->getFirstNonPHI());
+  auto slot = headerBuilder.CreateLoad(task->replicaSlot);
+  auto nextSlot = headerBuilder.CreateAdd(slot, cm->getIntegerConstant(1, 64));
+  auto isAfterLastReplica = headerBuilder.CreateICmpEQ(
+      nextSlot,
+      cm->getIntegerConstant(this->stageReplicas, 64));
+  auto newSlot = headerBuilder.CreateSelect(isAfterLastReplica,
+                                            cm->getIntegerConstant(0, 64),
+                                            nextSlot);
+  headerBuilder.CreateStore(newSlot, task->replicaSlot);
+
+  /*
+   * The first stage hands every iteration to the replica that executes it.
+   * When the loop is completed, the first stage tells all replicas to stop.
+   */
+  if (taskIndex != 0) {
+    return;
+  }
+  auto tokenQueuesType =
+      PointerType::getUnqual(PointerType::getUnqual(tokenQueueType));
+  for (auto replicatedStage : this->replicatedStages) {
+
+    /*
+     * Load the queues of tokens of all replicas of the stage.
+     */
+    auto queueIndexValue =
+        cm->getIntegerConstant(replicatedStage->replicaTokenQueue, 64);
+    auto queuePtr = entryBuilder.CreateInBoundsGEP(
+        queuesArray,
+        ArrayRef<Value *>({ this->zeroIndexForBaseArray, queueIndexValue }));
+    auto queueCast = entryBuilder.CreateBitCast(queuePtr, tokenQueuesType);
+    auto tokenQueues = entryBuilder.CreateLoad(queueCast);
+
+    /*
+     * Hand the current iteration.
+     */
+    headerBuilder.CreateStore(cm->getIntegerConstant(1, 8), tokenAlloca);
+    auto currentSlot = headerBuilder.CreateLoad(task->replicaSlot);
+    auto tokenQueuePtr =
+        headerBuilder.CreateInBoundsGEP(tokenQueues, currentSlot);
+    auto tokenQueue = headerBuilder.CreateLoad(tokenQueuePtr);
+    headerBuilder.CreateCall(tokenPush,
+                             ArrayRef<Value *>({ tokenQueue, tokenAlloca }));
+
+    /*
+     * Stop all replicas at the end of the loop.
+     */
+    for (auto i = 0; i < task->getNumberOfLastBlocks(); ++i) {
+      auto lastBlock = task->getLastBlock(i);
+      IRBuilder<> exitBuilder(lastBlock->getTerminator());
+      exitBuilder.CreateStore(cm->getIntegerConstant(0, 8), tokenAlloca);
+      for (auto r = 0; r < replicatedStage->numberOfReplicas; ++r) {
+        auto replicaQueuePtr = exitBuilder.CreateInBoundsGEP(
+            tokenQueues,
+            cm->getIntegerConstant(r, 64));
+        auto replicaQueue = exitBuilder.CreateLoad(replicaQueuePtr);
+        exitBuilder.CreateCall(
+            tokenPush,
+            ArrayRef<Value *>({ replicaQueue, tokenAlloca }));
+      }
+    }
+  }
+
+  return;
+}
+
+} // namespace arcana::noelle
@@ -182,20 +182,41 @@ void DSWP::createPipelineFromStages(LoopDependenceInfo *LDI, Noelle &par) {
    */
   auto queueSizesPtr = createQueueSizesArrayFromStages(LDI, builder, par);
 
+  /*
+   * Describe the replicated stages to the runtime.
+   * If there is none, then the runtime runs one instance per stage.
+   */
+  Value *queueStagesPtr = nullptr;
+  Value *stageReplicasPtr = nullptr;
+  if (this->replicatedStages.size() > 0) {
+    queueStagesPtr = createQueueStagesArrayFromStages(LDI, builder, par);
+    stageReplicasPtr = createStageReplicasArrayFromStages(LDI, builder, par);
+  } else {
+    auto tm = par.getTypesManager();
+    auto int64PtrType = PointerType::getUnqual(tm->getIntegerType(64));
+    queueStagesPtr = ConstantPointerNull::get(int64PtrType);
+    stageReplicasPtr = ConstantPointerNull::get(int64PtrType);
+  }
+
   /*
    * Call the stage dispatcher with the environment, queues array, and stages
    * array
    */
-  auto queuesCount = cm->getIntegerConstant(this->queues.size(), 64);
+  auto queuesCount = cm->getIntegerConstant(this->getNumberOfQueues(), 64);
   auto stagesCount = cm->getIntegerConstant(this->numTaskInstances, 64);
 
   /*
    * Add the call to the task dispatcher
    */
-  auto runtimeCall = builder.CreateCall(
-      taskDispatcher,
-      ArrayRef<Value *>(
-          { envPtr, queueSizesPtr, stagesPtr, stagesCount, queuesCount }));
+  auto runtimeCall =
+      builder.CreateCall(taskDispatcher,
+                         ArrayRef<Value *>({ envPtr,
+                                             queueSizesPtr,
+                                             stagesPtr,
+                                             stagesCount,
+                                             queuesCount,
+                                             queueStagesPtr,
+                                             stageReplicasPtr }));
   auto numThreadsUsed = builder.CreateExtractValue(runtimeCall, (uint64_t)0);
 
   /*
@@ -252,18 +273,26 @@ Value *DSWP::createQueueSizesArrayFromStages(LoopDependenceInfo *LDI,
   auto tm = par.getTypesManager();
 
   auto int64Type = tm->getIntegerType(64);
+  auto numberOfQueues = this->getNumberOfQueues();
   auto queuesAlloca = cast<Value>(
-      funcBuilder.CreateAlloca(ArrayType::get(int64Type, this->queues.size())));
-  for (int i = 0; i < this->queues.size(); ++i) {
-    auto &queue = this->queues[i];
+      funcBuilder.CreateAlloca(ArrayType::get(int64Type, numberOfQueues)));
+  for (int i = 0; i < numberOfQueues; ++i) {
+
+    /*
+     * Queues that follow the ones between stages carry the tokens of the
+     * replicated stages, which are single bits.
+     */
+    auto bitLength = 1;
+    if (i < this->queues.size()) {
+      bitLength = this->queues[i]->bitLength;
+    }
     auto queueIndex = cm->getIntegerConstant(i, 64);
     auto queuePtr = funcBuilder.CreateInBoundsGEP(
         queuesAlloca,
         ArrayRef<Value *>({ this->zeroIndexForBaseArray, queueIndex }));
     auto queueCast =
         funcBuilder.CreateBitCast(queuePtr, PointerType::getUnqual(int64Type));
-    funcBuilder.CreateStore(cm->getIntegerConstant(queue->bitLength, 64),
-                            queueCast);
+    funcBuilder.CreateStore(cm->getIntegerConstant(bitLength, 64), queueCast);
   }
 
   return cast<Value>(
@@ -271,4 +300,86 @@ Value *DSWP::createQueueSizesArrayFromStages(LoopDependenceInfo *LDI,
                                 PointerType::getUnqual(int64Type)));
 }
 
+Value *DSWP::createQueueStagesArrayFromStages(LoopDependenceInfo *LDI,
+                                              IRBuilder<> funcBuilder,
+                                              Noelle &par) {
+
+  /*
+   * Fetch the managers.
+   */
+  auto cm = par.getConstantsManager();
+  auto tm = par.getTypesManager();
+
+  /*
+   * Each queue is described by the index of the stage that pushes to it
+   * followed by the index of the stage that pops from it.
+   */
+  auto int64Type = tm->getIntegerType(64);
+  auto numberOfQueues = this->getNumberOfQueues();
+  auto queueStagesAlloca = cast<Value>(
+      funcBuilder.CreateAlloca(ArrayType::get(int64Type, numberOfQueues * 2)));
+  for (int i = 0; i < numberOfQueues; ++i) {
+
+    /*
+     * Fetch the stages connected by the current queue.
+     * Tokens are pushed by the first stage to the replicated ones.
+     */
+    uint64_t fromStage = 0;
+    uint64_t toStage = 0;
+    if (i < this->queues.size()) {
+      auto &queue = this->queues[i];
+      fromStage = this->fromTaskIDToUserID.at(queue->fromStage);
+      toStage = this->fromTaskIDToUserID.at(queue->toStage);
+    } else {
+      auto replicatedStage = this->replicatedStages[i - this->queues.size()];
+      toStage = this->fromTaskIDToUserID.at(replicatedStage->getID());
+    }
+
+    /*
+     * Store the stages.
+     */
+    uint64_t stages[2] = { fromStage, toStage };
+    for (auto j = 0; j < 2; ++j) {
+      auto entryIndex = cm->getIntegerConstant(i * 2 + j, 64);
+      auto entryPtr = funcBuilder.CreateInBoundsGEP(
+          queueStagesAlloca,
+          ArrayRef<Value *>({ this->zeroIndexForBaseArray, entryIndex }));
+      funcBuilder.CreateStore(cm->getIntegerConstant(stages[j], 64), entryPtr);
+    }
+  }
+
+  return cast<Value>(
+      funcBuilder.CreateBitCast(queueStagesAlloca,
+                                PointerType::getUnqual(int64Type)));
+}
+
+Value *DSWP::createStageReplicasArrayFromStages(LoopDependenceInfo *LDI,
+                                                IRBuilder<> funcBuilder,
+                                                Noelle &par) {
+
+  /*
+   * Fetch the managers.
+   */
+  auto cm = par.getConstantsManager();
+  auto tm = par.getTypesManager();
+
+  auto int64Type = tm->getIntegerType(64);
+  auto replicasAlloca = cast<Value>(funcBuilder.CreateAlloca(
+      ArrayType::get(int64Type, this->numTaskInstances)));
+  for (int i = 0; i < this->numTaskInstances; ++i) {
+    auto stage = (DSWPTask *)this->tasks[i];
+    auto stageIndex = cm->getIntegerConstant(i, 64);
+    auto replicasPtr = funcBuilder.CreateInBoundsGEP(
+        replicasAlloca,
+        ArrayRef<Value *>({ this->zeroIndexForBaseArray, stageIndex }));
+    funcBuilder.CreateStore(
+        cm->getIntegerConstant(stage->numberOfReplicas, 64),
+        replicasPtr);
+  }
+
+  return cast<Value>(
+      funcBuilder.CreateBitCast(replicasAlloca,
+                                PointerType::getUnqual(int64Type)));
+}
+
 } // namespace arcana::noelle
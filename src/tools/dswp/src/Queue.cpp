@@ -363,7 +363,19 @@ void DSWP::generateLoadsOfQueuePointers(Noelle &par, int taskIndex) {
         entryBuilder.CreateBitCast(queuePtr, PointerType::getUnqual(queueType));
 
     auto queueInstrs = std::make_unique<QueueInstrs>();
-    queueInstrs->queuePtr = entryBuilder.CreateLoad(queueCast);
+    if (this->isRoutedQueue(task, queueIndex)) {
+
+      /*
+       * The other end of the queue is a replicated stage.
+       * Hence, the entry of the array points to the queues of all replicas.
+       */
+      auto replicasCast = entryBuilder.CreateBitCast(
+          queuePtr,
+          PointerType::getUnqual(PointerType::getUnqual(queueType)));
+      queueInstrs->queueReplicas = entryBuilder.CreateLoad(replicasCast);
+    } else {
+      queueInstrs->queuePtr = entryBuilder.CreateLoad(queueCast);
+    }
     queueInstrs->alloca = entryBuilder.CreateAlloca(queueInfo->dependentType);
     queueInstrs->allocaCast =
         entryBuilder.CreateBitCast(queueInstrs->alloca,
@@ -375,6 +387,35 @@ void DSWP::generateLoadsOfQueuePointers(Noelle &par, int taskIndex) {
     loadQueuePtrFromIndex(queueIndex);
   for (auto queueIndex : task->popValueQueues)
     loadQueuePtrFromIndex(queueIndex);
+
+  /*
+   * Allocate the variable that tracks which replica executes the current
+   * iteration.
+   * This is needed by the stages that exchange values with replicated stages
+   * and by the first stage, which hands the iterations to the replicas.
+   */
+  if (task->numberOfReplicas > 1) {
+    return;
+  }
+  auto needsReplicaSlot =
+      (taskIndex == 0) && (this->replicatedStages.size() > 0);
+  for (auto &queueInstrPair : task->queueInstrMap) {
+    if (queueInstrPair.second->queueReplicas != nullptr) {
+      needsReplicaSlot = true;
+      break;
+    }
+  }
+  if (!needsReplicaSlot) {
+    return;
+  }
+  auto tm = par.getTypesManager();
+  auto int64Type = tm->getIntegerType(64);
+  task->replicaSlot = entryBuilder.CreateAlloca(int64Type);
+  entryBuilder.CreateStore(
+      cm->getIntegerConstant(this->stageReplicas - 1, 64),
+      task->replicaSlot);
+
+  return;
 }
 
 void DSWP::popValueQueues(LoopDependenceInfo *LDI, Noelle &par, int taskIndex) {
@@ -383,8 +424,6 @@ void DSWP::popValueQueues(LoopDependenceInfo *LDI, Noelle &par, int taskIndex) {
   for (auto queueIndex : task->popValueQueues) {
     auto &queueInfo = this->queues[queueIndex];
     auto queueInstrs = task->queueInstrMap[queueIndex].get();
-    auto queueCallArgs =
-        ArrayRef<Value *>({ queueInstrs->queuePtr, queueInstrs->allocaCast });
 
     /*
      * Determine the clone of the basic block of the original producer
@@ -395,10 +434,12 @@ void DSWP::popValueQueues(LoopDependenceInfo *LDI, Noelle &par, int taskIndex) {
     auto clonedB = task->getCloneOfOriginalBasicBlock(originalB);
     Instruction *insertionPoint = clonedB->getFirstNonPHIOrDbgOrLifetime();
     IRBuilder<> builder(insertionPoint);
+    auto queuePtr = this->fetchQueuePointer(par, task, queueIndex, builder);
     auto queuePopFunction =
         par.queues.queuePops[par.queues.queueSizeToIndex[queueInfo->bitLength]];
-    queueInstrs->queueCall =
-        builder.CreateCall(queuePopFunction, queueCallArgs);
+    queueInstrs->queueCall = builder.CreateCall(
+        queuePopFunction,
+        ArrayRef<Value *>({ queuePtr, queueInstrs->allocaCast }));
     queueInstrs->load = builder.CreateLoad(queueInstrs->alloca);
 
     /*
@@ -417,8 +458,6 @@ void DSWP::pushValueQueues(LoopDependenceInfo *LDI,
   for (auto queueIndex : task->pushValueQueues) {
     auto queueInstrs = task->queueInstrMap[queueIndex].get();
     auto queueInfo = this->queues[queueIndex].get();
-    auto queueCallArgs =
-        ArrayRef<Value *>({ queueInstrs->queuePtr, queueInstrs->allocaCast });
     auto queuePushFunction =
         par.queues
             .queuePushes[par.queues.queueSizeToIndex[queueInfo->bitLength]];
@@ -437,7 +476,9 @@ void DSWP::pushValueQueues(LoopDependenceInfo *LDI,
     }
     IRBuilder<> builder(insertPoint);
     builder.CreateStore(producerClone, queueInstrs->alloca);
-    queueInstrs->queueCall =
-        builder.CreateCall(queuePushFunction, queueCallArgs);
+    auto queuePtr = this->fetchQueuePointer(par, task, queueIndex, builder);
+    queueInstrs->queueCall = builder.CreateCall(
+        queuePushFunction,
+        ArrayRef<Value *>({ queuePtr, queueInstrs->allocaCast }));
   }
 }
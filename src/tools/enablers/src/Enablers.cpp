@@ -54,6 +54,18 @@ bool EnablersManager::applyEnablers(
     }
   }
 
+  /*
+   * Collapse loop nests that do not expose enough parallelism at their
+   * outermost level.
+   */
+  if (par.isTransformationEnabled(Transformation::LOOP_COLLAPSING_ID)) {
+    errs() << "EnablersManager:     Try to collapse loop nests\n";
+    if (this->applyLoopCollapsing(LDI, par, LoopTransformer)) {
+      errs() << "EnablersManager:       The loop nest has been collapsed\n";
+      return true;
+    }
+  }
+
   /*
    * Run the whilifier.
    */
@@ -309,4 +321,67 @@ bool EnablersManager::applyDevirtualizer(LoopDependenceInfo *LDI,
   return modified;
 }
 
+bool EnablersManager::applyLoopCollapsing(LoopDependenceInfo *LDI,
+                                          Noelle &par,
+                                          LoopTransformer &loopTransformer) {
+  assert(LDI != nullptr);
+
+  /*
+   * We want to collapse a loop nest when its outermost loop does not have
+   * enough iterations to keep all cores busy. For example:
+   *    for (auto i=0; i < 4; i++){
+   *      for (auto j=0; j < 4096; j++){
+   *        a[i][j] = ...
+   *      }
+   *    }
+   *
+   * Check that the loop has a single sub-loop.
+   */
+  auto loopNode = LDI->getLoopHierarchyStructures();
+  auto children = loopNode->getChildren();
+  if (children.size() != 1) {
+    return false;
+  }
+  auto innerLS = (*children.begin())->getLoop();
+
+  /*
+   * Check that the outermost loop has not enough iterations.
+   */
+  if (!LDI->doesHaveCompileTimeKnownTripCount()) {
+    return false;
+  }
+  auto ltm = LDI->getLoopTransformationsManager();
+  if (LDI->getCompileTimeTripCount() >= ltm->getMaximumNumberOfCores()) {
+    return false;
+  }
+
+  /*
+   * Both loops must be DOALL loops for the collapsed loop to be a DOALL loop.
+   */
+  DOALL doall{ par };
+  if (!doall.canBeAppliedToLoop(LDI, nullptr)) {
+    return false;
+  }
+  auto innerLDI = par.getLoop(innerLS);
+  if (innerLDI == nullptr) {
+    return false;
+  }
+  if (!doall.canBeAppliedToLoop(innerLDI, nullptr)) {
+    delete innerLDI;
+    return false;
+  }
+
+  /*
+   * Collapse the loop nest.
+   */
+  auto modified = loopTransformer.collapseLoopNest(LDI, innerLDI);
+
+  /*
+   * Free the memory.
+   */
+  delete innerLDI;
+
+  return modified;
+}
+
 } // namespace arcana::noelle
@@ -19,6 +19,10 @@
  OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
  OR OTHER DEALINGS IN THE SOFTWARE.
  */
+#include "llvm/IR/LegacyPassManager.h"
+#include "llvm/Transforms/Scalar.h"
+#include "llvm/Transforms/Utils.h"
+#include "llvm/Transforms/Utils/UnifyFunctionExitNodes.h"
 #include "noelle/core/Noelle.hpp"
 #include "EnablersManager.hpp"
 
@@ -51,6 +55,73 @@ bool EnablersManager::runOnModule(Module &M) {
   auto loopInvariantCodeMotion = LoopInvariantCodeMotion(noelle);
   auto scevSimplification = SCEVSimplification(noelle);
 
+  /*
+   * Improve all loops.
+   */
+  auto codeSizeBeforeEnablers = M.getInstructionCount();
+  auto modifiedFunctions = this->improveLoops(noelle,
+                                              loopTransformer,
+                                              loopInvariantCodeMotion,
+                                              scevSimplification,
+                                              nullptr);
+  auto modified = !modifiedFunctions.empty();
+
+  /*
+   * Check if we need to apply the enablers until a fixed point is reached.
+   *
+   * Only the loops of the functions modified by the previous invocation can be
+   * improved further, so they are the only ones we consider. Their code is
+   * normalized and their dependences are recomputed without rebuilding the
+   * rest of the PDG.
+   *
+   * Like noelle-fixedpoint, we stop when the code size does not change.
+   * We also stop after a maximum number of invocations because enablers
+   * might keep changing the code without ever reaching a fixed point.
+   */
+  if (this->runUntilFixedPoint) {
+    auto nextLoopID = this->getNextLoopID(noelle);
+    uint32_t invocation = 1;
+    while (!modifiedFunctions.empty()) {
+      if (M.getInstructionCount() == codeSizeBeforeEnablers) {
+        errs() << "EnablersManager:   The code size did not change\n";
+        break;
+      }
+      if (invocation > this->maxFixedPointInvocations) {
+        errs() << "EnablersManager:   The maximum number of invocations ("
+               << this->maxFixedPointInvocations << ") has been reached\n";
+        break;
+      }
+      errs() << "EnablersManager:   Invocation " << invocation << " on "
+             << modifiedFunctions.size() << " modified functions\n";
+      this->normalizeFunctions(modifiedFunctions);
+      this->embedLoopIDs(noelle, modifiedFunctions, nextLoopID);
+      noelle.updateProgramDependenceGraph(modifiedFunctions);
+      codeSizeBeforeEnablers = M.getInstructionCount();
+      modifiedFunctions = this->improveLoops(noelle,
+                                             loopTransformer,
+                                             loopInvariantCodeMotion,
+                                             scevSimplification,
+                                             &modifiedFunctions);
+      invocation++;
+    }
+
+    /*
+     * Loops created by the last invocation need IDs as well.
+     */
+    this->embedLoopIDs(noelle, modifiedFunctions, nextLoopID);
+  }
+
+  errs() << "EnablersManager: Exit\n";
+  return modified;
+}
+
+std::set<Function *> EnablersManager::improveLoops(
+    Noelle &noelle,
+    LoopTransformer &loopTransformer,
+    LoopInvariantCodeMotion &loopInvariantCodeMotion,
+    SCEVSimplification &scevSimplification,
+    const std::set<Function *> *functionsToImprove) {
+
   /*
    * Fetch all the loops we want to parallelize.
    */
@@ -63,10 +134,19 @@ bool EnablersManager::runOnModule(Module &M) {
    * Remove loops that have not been executed
    */
   auto hot = noelle.getProfiles();
-  auto filter = [hot](LoopStructure *l) -> bool {
+  auto filter = [hot, functionsToImprove](LoopStructure *l) -> bool {
     if (!hot->hasBeenExecuted(l)) {
       return true;
     }
+
+    /*
+     * Remove loops that belong to functions we do not need to improve.
+     */
+    if ((functionsToImprove != nullptr)
+        && (functionsToImprove->count(l->getFunction()) == 0)) {
+      return true;
+    }
+
     return false;
   };
   noelle.filterOutLoops(*loopsToParallelize, filter);
@@ -89,7 +169,6 @@ bool EnablersManager::runOnModule(Module &M) {
   /*
    * Transform the loops selected.
    */
-  auto modified = false;
   std::unordered_map<Function *, bool> modifiedFunctions;
   for (auto tree : sortedTrees) {
 
@@ -101,8 +180,7 @@ bool EnablersManager::runOnModule(Module &M) {
               &scevSimplification,
               &noelle,
               &modifiedFunctions,
-              this,
-              &modified](LoopTree *n, uint32_t l) -> bool {
+              this](LoopTree *n, uint32_t l) -> bool {
       /*
        * Fetch the loop
        */
@@ -142,12 +220,14 @@ bool EnablersManager::runOnModule(Module &M) {
       /*
        * Improve the current loop.
        */
-      modifiedFunctions[f] |= this->applyEnablers(&*loopToImprove,
-                                                  noelle,
-                                                  loopTransformer,
-                                                  loopInvariantCodeMotion,
-                                                  scevSimplification);
-      modified |= modifiedFunctions[f];
+      if (this->applyEnablers(&*loopToImprove,
+                              noelle,
+                              loopTransformer,
+                              loopInvariantCodeMotion,
+                              scevSimplification)) {
+        modifiedFunctions[f] = true;
+        noelle.getProfiles()->invalidateCodeNumbering();
+      }
 
       return false;
     };
@@ -159,8 +239,103 @@ bool EnablersManager::runOnModule(Module &M) {
    */
   delete loopsToParallelize;
 
-  errs() << "EnablersManager: Exit\n";
-  return modified;
+  /*
+   * Collect the functions that have been modified.
+   */
+  std::set<Function *> functionsModified;
+  for (auto pair : modifiedFunctions) {
+    if (pair.second) {
+      functionsModified.insert(pair.first);
+    }
+  }
+
+  return functionsModified;
+}
+
+void EnablersManager::normalizeFunctions(
+    const std::set<Function *> &functions) {
+  if (functions.empty()) {
+    return;
+  }
+
+  /*
+   * Set the normalization passes.
+   *
+   * These are the function passes invoked by noelle-norm.
+   * -break-constgeps is only available when SVF is, and the function attribute
+   * passes work on the whole call graph: they are not invoked. The attributes
+   * of the functions are still valid because enablers neither add calls nor
+   * add accesses to memory locations that were not accessed before.
+   * The loop IDs that noelle-norm embeds are added by embedLoopIDs.
+   */
+  auto M = (*functions.begin())->getParent();
+  legacy::FunctionPassManager normalizer(M);
+  normalizer.add(createPromoteMemoryToRegisterPass());
+  normalizer.add(createCFGSimplificationPass());
+  normalizer.add(createLowerSwitchPass());
+  normalizer.add(createUnifyFunctionExitNodesPass());
+  normalizer.add(createBreakCriticalEdgesPass());
+  normalizer.add(createLoopSimplifyPass());
+  normalizer.add(createLCSSAPass());
+  normalizer.add(createIndVarSimplifyPass());
+
+  /*
+   * Normalize the functions.
+   */
+  normalizer.doInitialization();
+  for (auto F : functions) {
+    normalizer.run(*F);
+  }
+  normalizer.doFinalization();
+
+  return;
+}
+
+uint64_t EnablersManager::getNextLoopID(Noelle &noelle) {
+
+  /*
+   * Fetch the largest loop ID of the program.
+   */
+  uint64_t nextLoopID = 0;
+  auto fm = noelle.getFunctionsManager();
+  for (auto F : fm->getFunctionsWithBody()) {
+    auto loops = noelle.getLoopStructures(F, 0);
+    for (auto loop : *loops) {
+      auto loopIDOpt = loop->getID();
+      if (loopIDOpt) {
+        nextLoopID = std::max(nextLoopID, loopIDOpt.value() + 1);
+      }
+      delete loop;
+    }
+    delete loops;
+  }
+
+  return nextLoopID;
+}
+
+void EnablersManager::embedLoopIDs(Noelle &noelle,
+                                   const std::set<Function *> &functions,
+                                   uint64_t &nextLoopID) {
+
+  /*
+   * Give an ID to the loops that do not have one (e.g., the ones created by
+   * the enablers).
+   * Existing IDs are kept because they might be referenced (e.g., by
+   * INDEX_FILE).
+   */
+  for (auto F : functions) {
+    auto loops = noelle.getLoopStructures(F, 0);
+    for (auto loop : *loops) {
+      if (!loop->doesHaveID()) {
+        loop->setID(nextLoopID);
+        nextLoopID++;
+      }
+      delete loop;
+    }
+    delete loops;
+  }
+
+  return;
 }
 
 } // namespace arcana::noelle
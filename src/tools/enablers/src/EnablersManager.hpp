@@ -47,6 +47,8 @@ private:
    * Fields
    */
   bool enableEnablers;
+  bool runUntilFixedPoint;
+  uint32_t maxFixedPointInvocations;
 
   /*
    * Methods
@@ -54,6 +56,21 @@ private:
   std::vector<LoopDependenceInfo *> getLoopsToParallelize(Module &M,
                                                           Noelle &par);
 
+  std::set<Function *> improveLoops(
+      Noelle &noelle,
+      LoopTransformer &loopTransformer,
+      LoopInvariantCodeMotion &loopInvariantCodeMotion,
+      SCEVSimplification &scevSimplification,
+      const std::set<Function *> *functionsToImprove);
+
+  void normalizeFunctions(const std::set<Function *> &functions);
+
+  uint64_t getNextLoopID(Noelle &noelle);
+
+  void embedLoopIDs(Noelle &noelle,
+                    const std::set<Function *> &functions,
+                    uint64_t &nextLoopID);
+
   bool applyEnablers(LoopDependenceInfo *LDI,
                      Noelle &par,
                      LoopTransformer &LoopTransformer,
@@ -71,6 +88,10 @@ private:
   bool applyDevirtualizer(LoopDependenceInfo *LDI,
                           Noelle &par,
                           LoopTransformer &lt);
+
+  bool applyLoopCollapsing(LoopDependenceInfo *LDI,
+                           Noelle &par,
+                           LoopTransformer &loopTransformer);
 };
 
 } // namespace arcana::noelle
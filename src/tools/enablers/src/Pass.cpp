@@ -28,10 +28,28 @@ static cl::opt<bool> DisableEnablers("noelle-disable-enablers",
                                      cl::ZeroOrMore,
                                      cl::Hidden,
                                      cl::desc("Disable all enablers"));
+static cl::opt<bool> EnablersFixedPoint(
+    "noelle-enablers-fixedpoint",
+    cl::ZeroOrMore,
+    cl::Hidden,
+    cl::desc("Apply the enablers until a fixed point is reached"));
+static cl::opt<uint32_t> EnablersFixedPointMaxInvocations(
+    "noelle-enablers-fixedpoint-max-invocations",
+    cl::ZeroOrMore,
+    cl::Hidden,
+    cl::desc(
+        "Maximum number of invocations of the enablers to reach a fixed point"));
 
 bool EnablersManager::doInitialization(Module &M) {
   this->enableEnablers =
       (DisableEnablers.getNumOccurrences() == 0) ? true : false;
+  this->runUntilFixedPoint =
+      (EnablersFixedPoint.getNumOccurrences() > 0) ? true : false;
+  this->maxFixedPointInvocations = 10;
+  if (EnablersFixedPointMaxInvocations.getNumOccurrences() > 0) {
+    this->maxFixedPointInvocations =
+        EnablersFixedPointMaxInvocations.getValue();
+  }
 
   return false;
 }
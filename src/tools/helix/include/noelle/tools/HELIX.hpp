@@ -34,6 +34,7 @@
 #include "noelle/tools/SequentialSegment.hpp"
 #include "noelle/tools/HELIXTask.hpp"
 #include "noelle/tools/SpilledLoopCarriedDependence.hpp"
+#include "noelle/tools/RuntimeAliasCheck.hpp"
 #include "HeuristicsPass.hpp"
 
 namespace arcana::noelle {
@@ -46,6 +47,25 @@ public:
    */
   HELIX(Noelle &n, bool forceParallelization);
 
+  /*
+   * When speculateMemoryDependences is true, loop-carried memory dependences
+   * that would require sequential segments are speculated not to happen.
+   * This speculation is checked when the loop starts: if it fails, the
+   * original loop runs.
+   */
+  HELIX(Noelle &n,
+        bool forceParallelization,
+        bool speculateMemoryDependences);
+
+  /*
+   * When configurableAtRuntime is true, the runtime can lower the number of
+   * cores of the parallelized loops that have an ID (e.g., from INDEX_FILE).
+   */
+  HELIX(Noelle &n,
+        bool forceParallelization,
+        bool speculateMemoryDependences,
+        bool configurableAtRuntime);
+
   bool apply(LoopDependenceInfo *LDI, Heuristics *h) override;
 
   bool canBeAppliedToLoop(LoopDependenceInfo *LDI,
@@ -131,6 +151,20 @@ protected:
                            std::vector<SequentialSegment *> *sss,
                            HELIXTask *helixTask);
 
+  void forwardSpilledValuesThroughSequentialSegments(
+      LoopDependenceInfo *LDI,
+      std::vector<SequentialSegment *> *sss,
+      HELIXTask *helixTask);
+
+  SequentialSegment *getSequentialSegmentThatAccessesSpill(
+      LoopDependenceInfo *LDI,
+      std::vector<SequentialSegment *> *sss,
+      SpilledLoopCarriedDependence *spill);
+
+  void speculateMemoryDependencesOfLoop(LoopDependenceInfo *LDI);
+
+  void checkSpeculatedMemoryDependencesAtRuntime(LoopDependenceInfo *LDI);
+
   virtual CallInst *injectWaitCall(IRBuilder<> &builder, uint32_t ssID);
 
   virtual CallInst *injectSignalCall(IRBuilder<> &builder, uint32_t ssID);
@@ -153,6 +187,13 @@ protected:
 
   void rewireLoopForPeriodicVariables(LoopDependenceInfo *LDI);
 
+  uint32_t computeIterationBlockSize(LoopDependenceInfo *LDI);
+
+  void batchIterations(HELIXTask *helixTask);
+
+  void guardSignalToExecuteAtTheEndOfIterationBlocks(HELIXTask *helixTask,
+                                                     CallInst *signal);
+
   BasicBlock *getBasicBlockExecutedOnlyByLastIterationBeforeExitingTask(
       LoopDependenceInfo *LDI,
       uint32_t taskIndex,
@@ -170,7 +211,29 @@ protected:
   BasicBlock *lastIterationExecutionBlock;
   bool enableInliner;
   Function *taskDispatcherSS;
+  Function *taskDispatcherSSForLoop;
   Function *taskDispatcherCS;
+
+  /*
+   * Loop-carried memory dependences of the original loop that are speculated
+   * away (nullptr if none).
+   * They are not included in the dependence graph of the task and the SCCs
+   * that only have these loop-carried data dependences do not generate
+   * sequential segments.
+   */
+  bool speculateMemoryDependences;
+  RuntimeAliasCheck *aliasCheck;
+
+  /*
+   * Each core executes blocks of iterationBlockSize consecutive iterations and
+   * it synchronizes once per block for each sequential segment.
+   * The synchronization cost is the estimated number of instructions spent
+   * passing a sequential segment from a core to the next one.
+   */
+  uint32_t iterationBlockSize;
+  double synchronizationCost;
+  PHINode *iterationBlockPHI;
+  std::unordered_map<PHINode *, Value *> iterationBlockJumpSteps;
   void squeezeSequentialSegment(LoopDependenceInfo *LDI,
                                 DataFlowResult *reachabilityDFR,
                                 SequentialSegment *ss);
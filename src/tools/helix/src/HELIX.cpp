@@ -27,11 +27,32 @@
 namespace arcana::noelle {
 
 HELIX::HELIX(Noelle &n, bool forceParallelization)
+  : HELIX{ n, forceParallelization, false } {
+  return;
+}
+
+HELIX::HELIX(Noelle &n,
+             bool forceParallelization,
+             bool speculateMemoryDependences)
+  : HELIX{ n, forceParallelization, speculateMemoryDependences, false } {
+  return;
+}
+
+HELIX::HELIX(Noelle &n,
+             bool forceParallelization,
+             bool speculateMemoryDependences,
+             bool configurableAtRuntime)
   : ParallelizationTechniqueForLoopsWithLoopCarriedDataDependences{ n,
                                                                     forceParallelization },
     loopCarriedLoopEnvironmentBuilder{ nullptr },
     lastIterationExecutionBlock{ nullptr },
     enableInliner{ true },
+    taskDispatcherSSForLoop{ nullptr },
+    speculateMemoryDependences{ speculateMemoryDependences },
+    aliasCheck{ nullptr },
+    iterationBlockSize{ 1 },
+    synchronizationCost{ 200 },
+    iterationBlockPHI{ nullptr },
     prefixString{ "HELIX: " } {
 
   /*
@@ -48,6 +69,15 @@ HELIX::HELIX(Noelle &n, bool forceParallelization)
   this->taskDispatcherCS =
       program->getFunction("NOELLE_HELIX_dispatcher_criticalSections");
   assert(this->taskDispatcherCS != nullptr);
+
+  /*
+   * Fetch the dispatcher to use if the number of cores can be configured at
+   * runtime.
+   */
+  if (configurableAtRuntime) {
+    this->taskDispatcherSSForLoop = program->getFunction(
+        "NOELLE_HELIX_dispatcher_sequentialSegmentsForLoop");
+  }
   this->waitSSCall = program->getFunction("HELIX_wait");
   this->signalSSCall = program->getFunction("HELIX_signal");
 
@@ -78,6 +108,8 @@ Transformation HELIX::getParallelizationID(void) const {
 }
 
 HELIX::~HELIX() {
+  delete this->aliasCheck;
+
   return;
 }
 
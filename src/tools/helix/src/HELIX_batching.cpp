@@ -0,0 +1,181 @@
+/*
+ * Copyright 2023  Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do
+ so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "noelle/tools/HELIX.hpp"
+
+namespace arcana::noelle {
+
+uint32_t HELIX::computeIterationBlockSize(LoopDependenceInfo *LDI) {
+
+  /*
+   * Periodic variables are re-wired assuming iterations are distributed to
+   * cores one at a time.
+   */
+  auto sccManager = LDI->getSCCManager();
+  auto periodicVariables =
+      sccManager->getSCCsOfKind(GenericSCC::SCCKind::PERIODIC_VARIABLE);
+  if (periodicVariables.size() > 0) {
+    return 1;
+  }
+
+  /*
+   * Check if the block size has been fixed (e.g., by the autotuner).
+   */
+  auto ltm = LDI->getLoopTransformationsManager();
+  auto blockSize = ltm->getIterationBlockSize();
+  if (blockSize > 0) {
+    return blockSize;
+  }
+
+  /*
+   * Check if the loop has been profiled.
+   */
+  auto loopStructure = LDI->getLoopStructure();
+  auto profiles = this->noelle.getProfiles();
+  if ((!profiles->isAvailable())
+      || (!profiles->hasBeenExecuted(loopStructure))) {
+    return 1;
+  }
+  auto instructionsPerIteration =
+      profiles->getAverageTotalInstructionsPerIteration(loopStructure);
+  if (instructionsPerIteration < 1) {
+    return 1;
+  }
+
+  /*
+   * Make a block of iterations at least as long as passing a sequential
+   * segment from a core to the next one.
+   */
+  blockSize = static_cast<uint32_t>(
+      std::ceil(this->synchronizationCost / instructionsPerIteration));
+
+  /*
+   * Every core must still get at least one block of iterations per invocation
+   * of the loop.
+   */
+  auto iterationsPerCore =
+      profiles->getAverageLoopIterationsPerInvocation(loopStructure)
+      / ltm->getMaximumNumberOfCores();
+  if (blockSize > iterationsPerCore) {
+    blockSize = static_cast<uint32_t>(iterationsPerCore);
+  }
+  if (blockSize == 0) {
+    blockSize = 1;
+  }
+
+  return blockSize;
+}
+
+void HELIX::batchIterations(HELIXTask *helixTask) {
+  this->iterationBlockPHI = nullptr;
+
+  /*
+   * Check if cores execute blocks of iterations.
+   */
+  if (this->iterationBlockSize <= 1) {
+    return;
+  }
+
+  /*
+   * Fetch the preheader and the header of the loop within the task.
+   */
+  auto loopStructure = this->originalLDI->getLoopStructure();
+  auto preheaderClone =
+      helixTask->getCloneOfOriginalBasicBlock(loopStructure->getPreHeader());
+  auto headerClone =
+      helixTask->getCloneOfOriginalBasicBlock(loopStructure->getHeader());
+
+  /*
+   * Track the position of the current iteration within its block.
+   */
+  auto blockCounterType = helixTask->coreArg->getType();
+  auto blockSize = ConstantInt::get(blockCounterType, this->iterationBlockSize);
+  this->iterationBlockPHI = IVUtility::createChunkPHI(preheaderClone,
+                                                      headerClone,
+                                                      blockCounterType,
+                                                      blockSize);
+
+  /*
+   * Jump the IVs to the next block of the current core at the end of a block.
+   */
+  for (auto ivJump : this->iterationBlockJumpSteps) {
+    auto ivPHI = ivJump.first;
+    auto jumpStepSize = ivJump.second;
+    IVUtility::chunkInductionVariablePHI(preheaderClone,
+                                         ivPHI,
+                                         this->iterationBlockPHI,
+                                         jumpStepSize);
+  }
+
+  return;
+}
+
+void HELIX::guardSignalToExecuteAtTheEndOfIterationBlocks(HELIXTask *helixTask,
+                                                          CallInst *signal) {
+  assert(this->iterationBlockPHI != nullptr);
+
+  /*
+   * Move the code after the signal to a new basic block.
+   */
+  auto block = signal->getParent();
+  auto afterSignalBB = helixTask->newBasicBlock("SS-after-signal");
+  IRBuilder<> afterSignalBuilder(afterSignalBB);
+  auto afterSignal = signal->getNextNode();
+  while (afterSignal) {
+    auto currentInst = afterSignal;
+    afterSignal = afterSignal->getNextNode();
+    currentInst->removeFromParent();
+    afterSignalBuilder.Insert(currentInst);
+  }
+
+  /*
+   * Redirect PHI node incoming blocks in successors to the new basic block.
+   */
+  for (auto succ : successors(afterSignalBB)) {
+    for (auto &phi : succ->phis()) {
+      auto incomingIndex = phi.getBasicBlockIndex(block);
+      phi.setIncomingBlock(incomingIndex, afterSignalBB);
+    }
+  }
+
+  /*
+   * Move the signal to its own basic block.
+   */
+  auto signalBB = helixTask->newBasicBlock("SS-signal-end-of-block");
+  IRBuilder<> signalBuilder(signalBB);
+  signal->removeFromParent();
+  signalBuilder.Insert(signal);
+  signalBuilder.CreateBr(afterSignalBB);
+
+  /*
+   * Signal only if the current iteration is the last one of its block.
+   */
+  IRBuilder<> blockBuilder(block);
+  auto lastPosition = ConstantInt::get(this->iterationBlockPHI->getType(),
+                                       this->iterationBlockSize - 1);
+  auto isLastIterationOfBlock =
+      blockBuilder.CreateICmpEQ(this->iterationBlockPHI, lastPosition);
+  blockBuilder.CreateCondBr(isLastIterationOfBlock, signalBB, afterSignalBB);
+
+  return;
+}
+
+} // namespace arcana::noelle
@@ -108,6 +108,14 @@ PDG *HELIX::constructTaskInternalDependenceGraphFromOriginalLoopDG(
         continue;
       }
 
+      /*
+       * Skip the dependences that have been speculated away.
+       */
+      if ((this->aliasCheck != nullptr)
+          && this->aliasCheck->isSpeculated(edge->getSrc(), edge->getDst())) {
+        continue;
+      }
+
       /*
        * This is a memory dependence.
        *
@@ -0,0 +1,313 @@
+/*
+ * Copyright 2023  Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do
+ so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "noelle/core/Architecture.hpp"
+#include "noelle/tools/HELIX.hpp"
+
+namespace arcana::noelle {
+
+void HELIX::forwardSpilledValuesThroughSequentialSegments(
+    LoopDependenceInfo *LDI,
+    std::vector<SequentialSegment *> *sss,
+    HELIXTask *helixTask) {
+
+  /*
+   * Check if there are sequential segments.
+   */
+  if (sss->size() == 0) {
+    return;
+  }
+
+  /*
+   * Each sequential segment entry is a cache line: the lock is at its
+   * beginning, the flag that tells whether values have been forwarded through
+   * it is at byte 8, and the forwarded values follow it (one 8-byte slot each).
+   */
+  const uint64_t forwardedFlagOffset = 8;
+  const uint64_t firstSlotOffset = 16;
+  const uint64_t slotBytes = 8;
+  uint64_t maxSlots =
+      (Architecture::getCacheLineBytes() - firstSlotOffset) / slotBytes;
+
+  /*
+   * Fetch the types and the constants we need.
+   */
+  auto tm = this->noelle.getTypesManager();
+  auto int64 = tm->getIntegerType(64);
+  auto cm = this->noelle.getConstantsManager();
+  auto const0 = cm->getIntegerConstant(0, int64);
+  auto const1 = cm->getIntegerConstant(1, int64);
+  auto &DL = this->noelle.getProgram()->getDataLayout();
+
+  /*
+   * Select the spilled loop-carried values to forward.
+   *
+   * A value is forwarded through the cache line of a sequential segment only if
+   * all its accesses within the loop are in that sequential segment: only then
+   * the core that accesses it is guaranteed to hold the sequential segment.
+   */
+  auto taskBody = helixTask->getTaskBody();
+  std::unordered_map<SequentialSegment *,
+                     std::vector<SpilledLoopCarriedDependence *>>
+      forwardedSpills;
+  for (auto spill : this->spills) {
+
+    /*
+     * Check the spilled value belongs to the current task.
+     */
+    if (spill->environmentStores.size() == 0) {
+      continue;
+    }
+    auto anyStore = *spill->environmentStores.begin();
+    if (anyStore->getFunction() != taskBody) {
+      continue;
+    }
+
+    /*
+     * Check the spilled value fits in a slot.
+     */
+    auto spillType = anyStore->getValueOperand()->getType();
+    if ((!spillType->isIntegerTy()) && (!spillType->isFloatingPointTy())
+        && (!spillType->isPointerTy())) {
+      continue;
+    }
+    if (DL.getTypeStoreSize(spillType) > slotBytes) {
+      continue;
+    }
+
+    /*
+     * Fetch the sequential segment that includes all accesses to the spilled
+     * value.
+     */
+    auto ss = this->getSequentialSegmentThatAccessesSpill(LDI, sss, spill);
+    if (ss == nullptr) {
+      continue;
+    }
+
+    /*
+     * Check there is a free slot in the cache line of the sequential segment.
+     */
+    auto &spillsOfSS = forwardedSpills[ss];
+    if (spillsOfSS.size() == maxSlots) {
+      continue;
+    }
+    spillsOfSS.push_back(spill);
+  }
+  if (forwardedSpills.size() == 0) {
+    return;
+  }
+
+  /*
+   * Define the code that computes the pointer to a given byte of a sequential
+   * segment entry.
+   */
+  IRBuilder<> entryBuilder{ helixTask->getEntry()->getTerminator() };
+  auto getPointerWithinSequentialSegment =
+      [&](Value *ssPtr, uint64_t offset, Type *elementType) -> Value * {
+    auto ssPtrAsInt = entryBuilder.CreatePtrToInt(ssPtr, int64);
+    auto ptrAsInt =
+        entryBuilder.CreateAdd(ConstantInt::get(int64, offset), ssPtrAsInt);
+    return entryBuilder.CreateIntToPtr(ptrAsInt,
+                                       PointerType::getUnqual(elementType));
+  };
+
+  /*
+   * Each core keeps its own copy of a forwarded value.
+   *
+   * This copy is initialized with the value the loop-carried environment has at
+   * the beginning of the loop.
+   *
+   * The pointers to the flags and to the slots of the past and future entries
+   * of the sequential segment are computed once, at the entry of the task.
+   */
+  std::unordered_map<uint32_t, std::vector<AllocaInst *>> privateCopies;
+  std::unordered_map<uint32_t, Value *> pastFlagPtrs;
+  std::unordered_map<uint32_t, Value *> futureFlagPtrs;
+  std::unordered_map<uint32_t, std::vector<Value *>> pastSlotPtrs;
+  std::unordered_map<uint32_t, std::vector<Value *>> futureSlotPtrs;
+  for (auto ss : *sss) {
+    if (forwardedSpills.find(ss) == forwardedSpills.end()) {
+      continue;
+    }
+    auto ssID = ss->getID();
+    auto ssPastPtr = this->ssPastPtrs.at(ssID);
+    auto ssFuturePtr = this->ssFuturePtrs.at(ssID);
+    pastFlagPtrs[ssID] = getPointerWithinSequentialSegment(ssPastPtr,
+                                                           forwardedFlagOffset,
+                                                           int64);
+    futureFlagPtrs[ssID] =
+        getPointerWithinSequentialSegment(ssFuturePtr,
+                                          forwardedFlagOffset,
+                                          int64);
+    auto slotOffset = firstSlotOffset;
+    for (auto spill : forwardedSpills.at(ss)) {
+      auto anyStore = *spill->environmentStores.begin();
+      auto spillEnvPtr = anyStore->getPointerOperand();
+      auto spillType = anyStore->getValueOperand()->getType();
+
+      /*
+       * Allocate and initialize the private copy.
+       */
+      auto privateCopy = helixTask->newStackVariable(spillType);
+      auto initialValue = entryBuilder.CreateLoad(spillEnvPtr);
+      entryBuilder.CreateStore(initialValue, privateCopy);
+
+      /*
+       * Redirect all other accesses to the private copy.
+       */
+      std::vector<Use *> usesToRedirect;
+      for (auto &use : spillEnvPtr->uses()) {
+        if (use.getUser() == initialValue) {
+          continue;
+        }
+        usesToRedirect.push_back(&use);
+      }
+      for (auto use : usesToRedirect) {
+        use->set(privateCopy);
+      }
+
+      /*
+       * Compute the pointers to the slot of the spilled value.
+       */
+      privateCopies[ssID].push_back(privateCopy);
+      pastSlotPtrs[ssID].push_back(
+          getPointerWithinSequentialSegment(ssPastPtr, slotOffset, spillType));
+      futureSlotPtrs[ssID].push_back(
+          getPointerWithinSequentialSegment(ssFuturePtr,
+                                            slotOffset,
+                                            spillType));
+      slotOffset += slotBytes;
+    }
+
+    if (this->verbose != Verbosity::Disabled) {
+      errs() << "HELIX:  Forward " << forwardedSpills.at(ss).size()
+             << " spilled values through sequential segment " << ssID
+             << "\n";
+    }
+  }
+
+  /*
+   * Fetch the sequential segment a wait or a signal is for.
+   */
+  auto getSequentialSegmentID = [](std::vector<Value *> &ssPtrs,
+                                   CallInst *call) -> int32_t {
+    auto ssPtr = call->getArgOperand(0);
+    for (auto ssID = 0u; ssID < ssPtrs.size(); ssID++) {
+      if (ssPtrs[ssID] == ssPtr) {
+        return ssID;
+      }
+    }
+    return -1;
+  };
+
+  /*
+   * Just after waiting, fetch the values forwarded by the previous core.
+   *
+   * NOTE: the first core to enter a sequential segment finds no forwarded
+   * values, so it keeps the ones loaded from the loop-carried environment.
+   */
+  for (auto wait : helixTask->waits) {
+    auto ssID = getSequentialSegmentID(this->ssPastPtrs, wait);
+    if (privateCopies.find(ssID) == privateCopies.end()) {
+      continue;
+    }
+    IRBuilder<> afterWaitBuilder(wait->getNextNode());
+    auto flag = afterWaitBuilder.CreateLoad(pastFlagPtrs.at(ssID));
+    auto hasBeenForwarded = afterWaitBuilder.CreateICmpNE(flag, const0);
+    auto &copies = privateCopies.at(ssID);
+    for (auto i = 0u; i < copies.size(); i++) {
+      auto forwardedValue =
+          afterWaitBuilder.CreateLoad(pastSlotPtrs.at(ssID).at(i));
+      auto currentValue = afterWaitBuilder.CreateLoad(copies[i]);
+      auto newValue = afterWaitBuilder.CreateSelect(hasBeenForwarded,
+                                                    forwardedValue,
+                                                    currentValue);
+      afterWaitBuilder.CreateStore(newValue, copies[i]);
+    }
+  }
+
+  /*
+   * Just before signaling, forward the values to the next core.
+   * They travel within the same cache line of the lock the next core waits on.
+   */
+  for (auto signal : helixTask->signals) {
+    auto ssID = getSequentialSegmentID(this->ssFuturePtrs, signal);
+    if (privateCopies.find(ssID) == privateCopies.end()) {
+      continue;
+    }
+    IRBuilder<> beforeSignalBuilder(signal);
+    auto &copies = privateCopies.at(ssID);
+    for (auto i = 0u; i < copies.size(); i++) {
+      auto currentValue = beforeSignalBuilder.CreateLoad(copies[i]);
+      beforeSignalBuilder.CreateStore(currentValue,
+                                      futureSlotPtrs.at(ssID).at(i));
+    }
+    beforeSignalBuilder.CreateStore(const1, futureFlagPtrs.at(ssID));
+  }
+
+  return;
+}
+
+SequentialSegment *HELIX::getSequentialSegmentThatAccessesSpill(
+    LoopDependenceInfo *LDI,
+    std::vector<SequentialSegment *> *sss,
+    SpilledLoopCarriedDependence *spill) {
+
+  /*
+   * Collect the accesses to the spilled value within the loop.
+   *
+   * NOTE: accesses outside the loop follow the waits injected at the loop
+   * exits, which are executed for every sequential segment.
+   */
+  auto loopStructure = LDI->getLoopStructure();
+  std::unordered_set<Instruction *> accesses;
+  for (auto load : spill->environmentLoads) {
+    if (loopStructure->isIncluded(load)) {
+      accesses.insert(load);
+    }
+  }
+  for (auto store : spill->environmentStores) {
+    if (loopStructure->isIncluded(store)) {
+      accesses.insert(store);
+    }
+  }
+
+  /*
+   * Find the sequential segment that includes all of them.
+   */
+  for (auto ss : *sss) {
+    auto ssInstructions = ss->getInstructions();
+    auto includesAllAccesses = true;
+    for (auto access : accesses) {
+      if (ssInstructions.find(access) == ssInstructions.end()) {
+        includesAllAccesses = false;
+        break;
+      }
+    }
+    if (includesAllAccesses) {
+      return ss;
+    }
+  }
+
+  return nullptr;
+}
+
+} // namespace arcana::noelle
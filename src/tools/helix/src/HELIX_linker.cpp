@@ -65,15 +65,33 @@ void HELIX::invokeParallelizedLoop(LoopDependenceInfo *LDI,
 
   /*
    * Call the function that incudes the parallelized loop.
+   *
+   * If the loop has an ID and its configuration can change at runtime, then
+   * the runtime can lower the number of cores of the loop.
    */
   IRBuilder<> helixBuilder(this->entryPointOfParallelizedLoop);
-  auto runtimeCall = helixBuilder.CreateCall(
-      this->taskDispatcherSS,
-      ArrayRef<Value *>({ (Value *)tasks[0]->getTaskBody(),
-                          envPtr,
-                          loopCarriedEnvPtr,
-                          numCores,
-                          numOfSS }));
+  auto loopIDOpt = LDI->getLoopStructure()->getID();
+  CallInst *runtimeCall = nullptr;
+  if ((this->taskDispatcherSSForLoop != nullptr) && loopIDOpt) {
+    auto loopID = cm->getIntegerConstant(loopIDOpt.value(), 64);
+    runtimeCall = helixBuilder.CreateCall(
+        this->taskDispatcherSSForLoop,
+        ArrayRef<Value *>({ loopID,
+                            (Value *)tasks[0]->getTaskBody(),
+                            envPtr,
+                            loopCarriedEnvPtr,
+                            numCores,
+                            numOfSS }));
+
+  } else {
+    runtimeCall = helixBuilder.CreateCall(
+        this->taskDispatcherSS,
+        ArrayRef<Value *>({ (Value *)tasks[0]->getTaskBody(),
+                            envPtr,
+                            loopCarriedEnvPtr,
+                            numCores,
+                            numOfSS }));
+  }
   auto numThreadsUsed =
       helixBuilder.CreateExtractValue(runtimeCall, (uint64_t)0);
 
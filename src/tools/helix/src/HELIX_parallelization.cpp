@@ -56,6 +56,12 @@ bool HELIX::apply(LoopDependenceInfo *LDI, Heuristics *h) {
         DOALL::getSCCsThatBlockDOALLToBeApplicable(LDI, this->noelle));
   }
 
+  /*
+   * Speculate the loop-carried memory dependences that can be checked when the
+   * loop starts, if enabled.
+   */
+  this->speculateMemoryDependencesOfLoop(LDI);
+
   /*
    * Create the HELIX task from the original loop without synchronizations
    * between its dynamic instances.
@@ -76,6 +82,13 @@ bool HELIX::apply(LoopDependenceInfo *LDI, Heuristics *h) {
                                      false);
   auto modified = this->synchronizeTask(newLDI, h, helixTask);
 
+  /*
+   * Guard the parallelized loop with the check of the speculated dependences.
+   */
+  if (modified) {
+    this->checkSpeculatedMemoryDependencesAtRuntime(LDI);
+  }
+
   return modified;
 }
 
@@ -297,6 +310,16 @@ HELIXTask *HELIX::createParallelizableTask(LoopDependenceInfo *LDI,
   }
   this->spillLoopCarriedDataDependencies(LDI, reachabilityDFR, helixTask);
 
+  /*
+   * Decide how many consecutive iterations each core executes.
+   */
+  this->iterationBlockSize = this->computeIterationBlockSize(LDI);
+  this->iterationBlockJumpSteps.clear();
+  if (this->verbose != Verbosity::Disabled) {
+    errs() << this->prefixString << "  Each core executes blocks of "
+           << this->iterationBlockSize << " iterations\n";
+  }
+
   /*
    * For IVs that were not spilled, adjust their step size appropriately
    */
@@ -409,6 +432,14 @@ bool HELIX::synchronizeTask(LoopDependenceInfo *LDI,
     }
   }
 
+  /*
+   * Distribute blocks of consecutive iterations to cores.
+   *
+   * NOTE: This must follow the identification of the sequential segments as
+   * the IVs are no longer stepped uniformly once batched.
+   */
+  this->batchIterations(helixTask);
+
   /*
    * Add synchronization instructions.
    */
@@ -417,6 +448,17 @@ bool HELIX::synchronizeTask(LoopDependenceInfo *LDI,
   }
   this->addSynchronizations(LDI, &sequentialSegments, helixTask);
 
+  /*
+   * Forward small spilled loop-carried values through the cache lines of the
+   * sequential segments.
+   *
+   * NOTE: This must follow the synchronization as values are forwarded at every
+   * wait and signal.
+   */
+  this->forwardSpilledValuesThroughSequentialSegments(LDI,
+                                                      &sequentialSegments,
+                                                      helixTask);
+
   /*
    * Store final results of loop live-out variables.
    *
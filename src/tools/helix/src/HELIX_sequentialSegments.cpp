@@ -176,6 +176,15 @@ std::vector<SequentialSegment *> HELIX::identifySequentialSegments(
         sccInfo = originalSCCManager->getSCCAttrs(sccToAnalyze);
       }
 
+      /*
+       * If all loop-carried data dependences of the SCC have been speculated
+       * away, then we can skip it.
+       */
+      if ((this->aliasCheck != nullptr)
+          && this->aliasCheck->isSpeculated(sccToAnalyze)) {
+        continue;
+      }
+
       /*
        * If the SCC is due to a control dependence, but the number of iterations
        * can be computed just before executing the loop, then we can skip it.
@@ -0,0 +1,102 @@
+/*
+ * Copyright 2023  Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do
+ so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "noelle/tools/HELIX.hpp"
+
+namespace arcana::noelle {
+
+void HELIX::speculateMemoryDependencesOfLoop(LoopDependenceInfo *LDI) {
+  delete this->aliasCheck;
+  this->aliasCheck = nullptr;
+  this->guardOfParallelizedLoop = nullptr;
+
+  /*
+   * Check if speculation is enabled.
+   */
+  if (!this->speculateMemoryDependences) {
+    return;
+  }
+
+  /*
+   * Sequential segments are skipped only for SCCs whose loop-carried data
+   * dependences are all speculated away.
+   * Loop-carried control dependences are handled without sequential segments
+   * only if the loop is governed by an IV.
+   */
+  auto ivManager = LDI->getInductionVariableManager();
+  if (ivManager->getLoopGoverningInductionVariable() == nullptr) {
+    return;
+  }
+
+  /*
+   * Fetch the SCCs that would require sequential segments because of their
+   * loop-carried data dependences.
+   */
+  auto sccManager = LDI->getSCCManager();
+  std::set<SCC *> sccs;
+  for (auto sccInfo : sccManager->getSCCsWithLoopCarriedDataDependencies()) {
+    sccs.insert(sccInfo->getSCC());
+  }
+
+  /*
+   * Speculate the loop-carried memory dependences of these SCCs.
+   */
+  auto aliasCheck = new RuntimeAliasCheck(this->noelle, LDI);
+  aliasCheck->speculateSCCs(sccs);
+  auto speculatedDependences = aliasCheck->getSpeculatedDependences();
+  if (speculatedDependences.size() == 0) {
+    delete aliasCheck;
+    return;
+  }
+  if (this->verbose != Verbosity::Disabled) {
+    errs() << this->prefixString << "  Speculate "
+           << speculatedDependences.size()
+           << " loop-carried memory dependences\n";
+  }
+  this->aliasCheck = aliasCheck;
+
+  return;
+}
+
+void HELIX::checkSpeculatedMemoryDependencesAtRuntime(LoopDependenceInfo *LDI) {
+
+  /*
+   * Check if dependences have been speculated.
+   */
+  if (this->aliasCheck == nullptr) {
+    return;
+  }
+
+  /*
+   * Record the dependences that have been speculated away.
+   */
+  this->aliasCheck->addRemediesToSpeculatedDependences();
+
+  /*
+   * Check the speculation when the loop starts.
+   * The parallelized loop runs only if the speculation holds.
+   */
+  this->guardOfParallelizedLoop = this->aliasCheck->generateCheck();
+
+  return;
+}
+
+} // namespace arcana::noelle
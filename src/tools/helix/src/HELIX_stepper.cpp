@@ -88,9 +88,15 @@ void HELIX::rewireLoopForIVsToIterateNthIterations(LoopDependenceInfo *LDI) {
    */
   auto clonedStepSizeMap = cloneIVStepValueComputation(LDI, 0, entryBuilder);
 
+  /*
+   * Fetch the number of consecutive iterations executed by a core.
+   */
+  auto blockSize =
+      ConstantInt::get(task->coreArg->getType(), this->iterationBlockSize);
+
   /*
    * Determine start value of the IV for the task
-   *   core_start: original_start + original_step_size * core_id
+   *   core_start: original_start + original_step_size * core_id * block_size
    */
   for (auto ivInfo : ivInfos) {
     auto startOfIV = this->fetchCloneInTask(task, ivInfo->getStartValue());
@@ -98,19 +104,29 @@ void HELIX::rewireLoopForIVsToIterateNthIterations(LoopDependenceInfo *LDI) {
     auto originalIVPHI = ivInfo->getLoopEntryPHI();
     auto ivPHI = cast<PHINode>(this->fetchCloneInTask(task, originalIVPHI));
 
+    Value *firstIteration = task->coreArg;
+    if (this->iterationBlockSize > 1) {
+      firstIteration = entryBuilder.CreateMul(task->coreArg,
+                                              blockSize,
+                                              "coreIdx_X_blockSize");
+    }
     auto offsetStartValue =
         IVUtility::computeInductionVariableValueForIteration(preheaderClone,
                                                              ivPHI,
                                                              startOfIV,
                                                              stepOfIV,
-                                                             task->coreArg);
+                                                             firstIteration);
     ivPHI->setIncomingValueForBlock(preheaderClone, offsetStartValue);
   }
 
   /*
    * Determine additional step size to account for n cores each executing the
    * task.
-   *   jump_step_size: original_step_size * (num_cores - 1)
+   *   jump_step_size: original_step_size * (num_cores - 1) * block_size
+   *
+   * When a core executes blocks of iterations, the jump only happens at the
+   * end of a block. This is done by batchIterations once the sequential
+   * segments have been identified, so we only compute the jump here.
    */
   for (auto ivInfo : ivInfos) {
     auto stepOfIV = clonedStepSizeMap.at(ivInfo);
@@ -120,6 +136,17 @@ void HELIX::rewireLoopForIVsToIterateNthIterations(LoopDependenceInfo *LDI) {
     auto numCoresMinusOne = entryBuilder.CreateSub(
         task->numCoresArg,
         ConstantInt::get(task->numCoresArg->getType(), 1));
+    if (this->iterationBlockSize > 1) {
+      auto blockJump = entryBuilder.CreateMul(numCoresMinusOne,
+                                              blockSize,
+                                              "numCoresMinus1_X_blockSize");
+      this->iterationBlockJumpSteps[ivPHI] =
+          IVUtility::scaleInductionVariableStep(preheaderClone,
+                                                ivPHI,
+                                                stepOfIV,
+                                                blockJump);
+      continue;
+    }
     auto jumpStepSize = IVUtility::scaleInductionVariableStep(preheaderClone,
                                                               ivPHI,
                                                               stepOfIV,
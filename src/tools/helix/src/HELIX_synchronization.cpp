@@ -166,8 +166,11 @@ void HELIX::addSynchronizations(LoopDependenceInfo *LDI,
   /*
    * Define the code that inject wait instructions.
    */
-  auto injectSignal = [&](SequentialSegment *ss,
-                          Instruction *justBeforeExit) -> void {
+  auto injectSignal =
+      [&](SequentialSegment *ss,
+          Instruction *justBeforeExit) -> std::vector<CallInst *> {
+    std::vector<CallInst *> signals;
+
     /*
      * Inject a call to HELIX_signal just after "justBeforeExit"
      * NOTE: If the exit is not an unconditional branch, inject the signal in
@@ -183,7 +186,8 @@ void HELIX::addSynchronizations(LoopDependenceInfo *LDI,
       IRBuilder<> beforeExitBuilder(insertPoint);
       auto signal = this->injectSignalCall(beforeExitBuilder, ss->getID());
       helixTask->signals.insert(cast<CallInst>(signal));
-      return;
+      signals.push_back(signal);
+      return signals;
     }
 
     for (auto successorBlock : successors(block)) {
@@ -191,7 +195,10 @@ void HELIX::addSynchronizations(LoopDependenceInfo *LDI,
           successorBlock->getFirstNonPHIOrDbgOrLifetime());
       auto signal = this->injectSignalCall(beforeExitBuilder, ss->getID());
       helixTask->signals.insert(cast<CallInst>(signal));
+      signals.push_back(signal);
     }
+
+    return signals;
   };
 
   /*
@@ -283,7 +290,23 @@ void HELIX::addSynchronizations(LoopDependenceInfo *LDI,
      */
     auto firstLoopInst = loopHeader->getFirstNonPHIOrDbgOrLifetime();
     IRBuilder<> headerBuilder(firstLoopInst);
-    headerBuilder.CreateStore(const0, ssStates.at(ss->getID()));
+    auto ssState = ssStates.at(ss->getID());
+    Value *ssStateAtIterationStart = const0;
+    if (this->iterationBlockPHI != nullptr) {
+
+      /*
+       * Cores execute blocks of iterations.
+       * Only the first iteration of a block has to wait.
+       */
+      auto isFirstIterationOfBlock =
+          headerBuilder.CreateICmpEQ(this->iterationBlockPHI, const0);
+      auto ssStateLoad = headerBuilder.CreateLoad(ssState);
+      ssStateAtIterationStart =
+          headerBuilder.CreateSelect(isFirstIterationOfBlock,
+                                     const0,
+                                     ssStateLoad);
+    }
+    headerBuilder.CreateStore(ssStateAtIterationStart, ssState);
 
     /*
      * Inject waits.
@@ -351,9 +374,21 @@ void HELIX::addSynchronizations(LoopDependenceInfo *LDI,
      * signal so that the set instruction is placed before the signal call
      */
     for (auto exit : exits) {
-      injectSignal(ss, exit);
+      auto signals = injectSignal(ss, exit);
       if (preambleSS == ss && !loopStructure->isIncluded(exit)) {
         injectExitFlagSet(exit);
+        continue;
+      }
+
+      /*
+       * When cores execute blocks of iterations, only the last iteration of a
+       * block passes the sequential segment to the next core.
+       */
+      if (this->iterationBlockPHI != nullptr) {
+        for (auto signal : signals) {
+          this->guardSignalToExecuteAtTheEndOfIterationBlocks(helixTask,
+                                                              signal);
+        }
       }
     }
   }
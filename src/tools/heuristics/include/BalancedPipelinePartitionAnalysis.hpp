@@ -0,0 +1,84 @@
+/*
+ * Copyright 2023  Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do
+ so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#pragma once
+
+#include "llvm/IR/Function.h"
+#include "llvm/IR/BasicBlock.h"
+#include "llvm/IR/Instructions.h"
+
+#include "noelle/core/SCC.hpp"
+#include "noelle/core/SCCDAGPartition.hpp"
+#include "noelle/core/SCCDAGAttrs.hpp"
+#include "noelle/core/Noelle.hpp"
+#include "InvocationLatency.hpp"
+
+using namespace std;
+
+namespace arcana::noelle {
+
+/*
+ * Partition an SCCDAG into a pipeline of at most @numCores stages that
+ * minimizes the execution time of the slowest stage.
+ *
+ * The time of a stage is the profiled time spent in its SCCs (including the
+ * cloned ones) plus the time spent transferring values through the queues it
+ * pushes to and pops from.
+ */
+class BalancedPipelinePartitionAnalysis {
+public:
+  BalancedPipelinePartitionAnalysis(
+      InvocationLatency &IL,
+      SCCDAGPartitioner &p,
+      SCCDAGAttrs &attrs,
+      int numCores,
+      std::function<bool(GenericSCC *scc)> canBeRematerialized,
+      Verbosity verbose);
+
+  /*
+   * Return false if the SCCs have not been profiled.
+   */
+  bool computeBalancedPartition(void);
+
+  void mergeSetsOfStages(void);
+
+  const static std::string prefix;
+
+private:
+  InvocationLatency &IL;
+  SCCDAGPartitioner &partitioner;
+  SCCDAGAttrs &dagAttrs;
+  int numCores;
+  std::function<bool(GenericSCC *scc)> canBeRematerialized;
+  Verbosity verbose;
+
+  std::vector<SCCSet *> orderedSets;
+  std::vector<std::set<SCC *>> executedSCCs;
+  std::vector<std::set<std::pair<Value *, uint64_t>>> incomingValues;
+  std::vector<std::vector<uint64_t>> stageCosts;
+  std::vector<uint64_t> stageEnds;
+
+  void collectSetsInformation(void);
+
+  uint64_t computeStageCost(uint64_t first, uint64_t last);
+};
+
+} // namespace arcana::noelle
@@ -43,5 +43,10 @@ public:
   bool runOnModule(Module &M) override;
 
   Heuristics *getHeuristics(Noelle &noelle);
+
+private:
+  uint64_t queueTransferCost;
+  uint64_t dispatchCost;
+  uint64_t signalCost;
 };
 } // namespace arcana::noelle
@@ -32,6 +32,8 @@
 #include "PartitionCostAnalysis.hpp"
 #include "SmallestSizePartitionAnalysis.hpp"
 #include "MinMaxSizePartitionAnalysis.hpp"
+#include "BalancedPipelinePartitionAnalysis.hpp"
+#include "ParallelLoopTimingModel.hpp"
 
 using namespace std;
 
@@ -42,7 +44,10 @@ public:
   /*
    * Methods
    */
-  Heuristics(Noelle &noelle);
+  Heuristics(Noelle &noelle,
+             uint64_t queueTransferCost,
+             uint64_t dispatchCost,
+             uint64_t signalCost);
 
   void adjustParallelizationPartitionForDSWP(
       SCCDAGPartitioner *partitioner,
@@ -51,7 +56,22 @@ public:
       std::function<bool(GenericSCC *scc)> canBeRematerialized,
       Verbosity verbose);
 
+  /*
+   * Return the timing model of @ldi parallelized by any technique.
+   * @sequentialSCCs are the SCCs of @ldi that block DOALL.
+   */
+  ParallelLoopTimingModel getParallelLoopTimingModel(
+      LoopDependenceInfo &ldi,
+      std::set<SCC *> const &sequentialSCCs);
+
 private:
+  bool balancedPipelinePartition(
+      SCCDAGPartitioner &partitioner,
+      SCCDAGAttrs &attrs,
+      uint64_t numThreads,
+      std::function<bool(GenericSCC *scc)> canBeRematerialized,
+      Verbosity verbose);
+
   void minMaxMergePartition(
       SCCDAGPartitioner &partitioner,
       SCCDAGAttrs &attrs,
@@ -66,6 +86,10 @@ private:
       std::function<bool(GenericSCC *scc)> canBeRematerialized,
       Verbosity verbose);
 
+  Hot *profiles;
+  uint64_t queueTransferCost;
+  uint64_t dispatchCost;
+  uint64_t signalCost;
   InvocationLatency invocationLatency;
 };
 
@@ -31,7 +31,7 @@ namespace arcana::noelle {
 
 class InvocationLatency {
 public:
-  InvocationLatency(Hot *hot);
+  InvocationLatency(Hot *hot, uint64_t queueTransferCost);
 
   uint64_t latencyPerInvocation(SCC *scc);
 
@@ -44,6 +44,8 @@ public:
 
   uint64_t queueLatency(Value *queueVal);
 
+  uint64_t queueTransfersLatency(Value *queueVal);
+
   std::set<Value *> &memoizeExternals(
       SCCDAGAttrs *,
       SCC *,
@@ -56,6 +58,7 @@ public:
 
 private:
   Hot *profiles;
+  uint64_t queueTransferCost;
   std::unordered_map<Function *, uint64_t> funcToCost;
   std::unordered_map<Value *, uint64_t> queueValToCost;
   std::unordered_map<SCC *, uint64_t> sccToCost;
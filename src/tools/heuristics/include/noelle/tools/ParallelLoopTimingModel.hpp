@@ -0,0 +1,91 @@
+/*
+ * Copyright 2023  Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do
+ so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#pragma once
+
+#include "noelle/core/SystemHeaders.hpp"
+#include "noelle/core/SCC.hpp"
+#include "noelle/core/Hot.hpp"
+#include "noelle/core/LoopDependenceInfo.hpp"
+#include "noelle/core/Transformations.hpp"
+
+namespace arcana::noelle {
+
+/*
+ * Timing model of a loop parallelized by DOALL, HELIX, or DSWP.
+ *
+ * Times are expressed in dynamic instructions, the unit of the profiles, and
+ * they include all invocations of the loop.
+ * The model accounts for the critical path of the loop (its sequential SCCs)
+ * and for the costs of the machine measured by noelle-calibrate:
+ * - dispatching the tasks of a loop invocation,
+ * - moving a cache line between cores (HELIX signals),
+ * - transferring a value through a queue (DSWP).
+ */
+class ParallelLoopTimingModel {
+public:
+  ParallelLoopTimingModel(Hot *profiles,
+                          LoopDependenceInfo &ldi,
+                          std::set<SCC *> const &sequentialSCCs,
+                          uint64_t dispatchCost,
+                          uint64_t signalCost,
+                          uint64_t queueTransferCost);
+
+  /*
+   * Return the time spent by the loop when it is not parallelized.
+   */
+  double getSequentialTime(void) const;
+
+  /*
+   * Return the time spent by the loop when it is parallelized by @technique
+   * using @cores cores.
+   *
+   * @return the sequential time if @technique cannot parallelize the loop.
+   */
+  double getParallelTime(Transformation technique, uint32_t cores) const;
+
+  double getSpeedup(Transformation technique, uint32_t cores) const;
+
+private:
+  Hot *profiles;
+  LoopStructure *loop;
+  uint64_t dispatchCost;
+  uint64_t signalCost;
+  uint64_t queueTransferCost;
+  double iterations;
+  double invocations;
+  double timePerIteration;
+  double biggestSequentialSCCTimePerIteration;
+  uint64_t numberOfSequentialSCCs;
+  uint64_t valuesTransferredPerIteration;
+
+  /*
+   * Return the time of the iterations that can run in parallel using
+   * @cores cores, given the time spent by an iteration in the critical path
+   * (@criticalPathPerIteration) and the overhead added to each iteration
+   * (@overheadPerIteration).
+   */
+  double getParallelTime(uint32_t cores,
+                         double criticalPathPerIteration,
+                         double overheadPerIteration) const;
+};
+
+} // namespace arcana::noelle
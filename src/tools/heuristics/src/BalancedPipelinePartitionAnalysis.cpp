@@ -0,0 +1,270 @@
+/*
+ * Copyright 2023  Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do
+ so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "noelle/tools/BalancedPipelinePartitionAnalysis.hpp"
+
+using namespace llvm;
+using namespace arcana::noelle;
+
+const std::string BalancedPipelinePartitionAnalysis::prefix =
+    "Heuristic:   Balanced pipeline: ";
+
+BalancedPipelinePartitionAnalysis::BalancedPipelinePartitionAnalysis(
+    InvocationLatency &IL,
+    SCCDAGPartitioner &p,
+    SCCDAGAttrs &attrs,
+    int numCores,
+    std::function<bool(GenericSCC *scc)> canBeRematerialized,
+    Verbosity verbose)
+  : IL{ IL },
+    partitioner{ p },
+    dagAttrs{ attrs },
+    numCores{ numCores },
+    canBeRematerialized{ canBeRematerialized },
+    verbose{ verbose } {
+  return;
+}
+
+bool BalancedPipelinePartitionAnalysis::computeBalancedPartition(void) {
+
+  /*
+   * Fetch the sets in topological order.
+   * Stages are contiguous ranges of this order, so merging the sets of a stage
+   * cannot introduce cycles in the pipeline.
+   */
+  this->orderedSets = this->partitioner.getDepthOrderedSets();
+  auto numberOfSets = this->orderedSets.size();
+  if (numberOfSets == 0) {
+    return false;
+  }
+  this->collectSetsInformation();
+
+  /*
+   * Check that the SCCs have been profiled.
+   */
+  auto totalCost = this->computeStageCost(0, numberOfSets - 1);
+  if (totalCost == 0) {
+    if (this->verbose != Verbosity::Disabled) {
+      errs() << prefix << "No profiled costs available\n";
+    }
+    return false;
+  }
+
+  /*
+   * Compute the cost of every candidate stage.
+   */
+  this->stageCosts.assign(numberOfSets, std::vector<uint64_t>(numberOfSets, 0));
+  for (auto first = 0u; first < numberOfSets; first++) {
+    for (auto last = first; last < numberOfSets; last++) {
+      this->stageCosts[first][last] = this->computeStageCost(first, last);
+    }
+  }
+
+  /*
+   * Find the partition that minimizes the cost of the slowest stage.
+   *
+   * bottleneck[k][j] is the cost of the slowest stage when the first j sets
+   * are split into k stages.
+   */
+  uint64_t maxStages = this->numCores > 1 ? this->numCores : 1;
+  if (maxStages > numberOfSets) {
+    maxStages = numberOfSets;
+  }
+  auto unreachable = std::numeric_limits<uint64_t>::max();
+  std::vector<std::vector<uint64_t>> bottleneck(
+      maxStages + 1,
+      std::vector<uint64_t>(numberOfSets + 1, unreachable));
+  std::vector<std::vector<uint64_t>> split(
+      maxStages + 1,
+      std::vector<uint64_t>(numberOfSets + 1, 0));
+  for (auto j = 1u; j <= numberOfSets; j++) {
+    bottleneck[1][j] = this->stageCosts[0][j - 1];
+  }
+  for (auto k = 2u; k <= maxStages; k++) {
+    for (auto j = k; j <= numberOfSets; j++) {
+      for (auto i = k - 1; i < j; i++) {
+        auto cost =
+            std::max(bottleneck[k - 1][i], this->stageCosts[i][j - 1]);
+        if (cost < bottleneck[k][j]) {
+          bottleneck[k][j] = cost;
+          split[k][j] = i;
+        }
+      }
+    }
+  }
+
+  /*
+   * Pick the smallest number of stages that reaches the minimum bottleneck.
+   */
+  uint64_t stages = 1;
+  for (auto k = 2u; k <= maxStages; k++) {
+    if (bottleneck[k][numberOfSets] < bottleneck[stages][numberOfSets]) {
+      stages = k;
+    }
+  }
+
+  /*
+   * Rebuild the stages.
+   */
+  this->stageEnds.clear();
+  auto end = numberOfSets;
+  for (auto k = stages; k > 0; k--) {
+    this->stageEnds.insert(this->stageEnds.begin(), end - 1);
+    end = split[k][end];
+  }
+
+  if (this->verbose != Verbosity::Disabled) {
+    errs() << prefix << stages << " stages, slowest stage cost "
+           << bottleneck[stages][numberOfSets] << " over a total cost of "
+           << totalCost << "\n";
+    if (this->verbose >= Verbosity::Maximal) {
+      uint64_t first = 0;
+      for (auto last : this->stageEnds) {
+        errs() << prefix << "  Stage with sets " << first << " - " << last
+               << ": cost " << this->stageCosts[first][last] << "\n";
+        first = last + 1;
+      }
+    }
+  }
+
+  return true;
+}
+
+void BalancedPipelinePartitionAnalysis::mergeSetsOfStages(void) {
+  auto partition = this->partitioner.getPartitionGraph();
+
+  uint64_t first = 0;
+  for (auto last : this->stageEnds) {
+    if (last > first) {
+      std::unordered_set<SCCSet *> setsOfStage(
+          this->orderedSets.begin() + first,
+          this->orderedSets.begin() + last + 1);
+      partition->mergeSetsAndCollapseResultingCycles(setsOfStage);
+    }
+    first = last + 1;
+  }
+
+  return;
+}
+
+void BalancedPipelinePartitionAnalysis::collectSetsInformation(void) {
+  auto partition = this->partitioner.getPartitionGraph();
+  auto sccdag = this->dagAttrs.getSCCDAG();
+  auto numberOfSets = this->orderedSets.size();
+
+  std::unordered_map<SCCSet *, uint64_t> setIndex;
+  for (auto i = 0u; i < numberOfSets; i++) {
+    setIndex[this->orderedSets[i]] = i;
+  }
+
+  this->executedSCCs.assign(numberOfSets, std::set<SCC *>());
+  this->incomingValues.assign(numberOfSets,
+                              std::set<std::pair<Value *, uint64_t>>());
+  for (auto i = 0u; i < numberOfSets; i++) {
+
+    /*
+     * The SCCs executed by a set are its own SCCs and their clonable parents.
+     */
+    auto &executed = this->executedSCCs[i];
+    for (auto scc : this->orderedSets[i]->sccs) {
+      executed.insert(scc);
+      auto &parents = this->IL.memoizeParents(&this->dagAttrs,
+                                              scc,
+                                              this->canBeRematerialized);
+      executed.insert(parents.begin(), parents.end());
+    }
+
+    /*
+     * Collect the values that must be received from the other sets.
+     */
+    for (auto scc : executed) {
+      for (auto edge : sccdag->fetchNode(scc)->getIncomingEdges()) {
+        auto fromSCC = edge->getSrc();
+        auto fromSCCInfo = this->dagAttrs.getSCCAttrs(fromSCC);
+        if (this->canBeRematerialized(fromSCCInfo)) {
+          continue;
+        }
+        if (!partition->isIncludedInPartitioning(fromSCC)) {
+          continue;
+        }
+        auto fromSet = setIndex.at(partition->setOfSCC(fromSCC));
+        if (fromSet == i) {
+          continue;
+        }
+
+        for (auto subEdge : edge->getSubEdges()) {
+          if (subEdge->isControlDependence() || subEdge->isMemoryDependence()) {
+            continue;
+          }
+          this->incomingValues[i].insert(
+              std::make_pair(subEdge->getSrc(), fromSet));
+        }
+      }
+    }
+  }
+
+  return;
+}
+
+uint64_t BalancedPipelinePartitionAnalysis::computeStageCost(uint64_t first,
+                                                             uint64_t last) {
+  auto isInStage = [first, last](uint64_t index) -> bool {
+    return (first <= index) && (index <= last);
+  };
+
+  /*
+   * Compute the time spent executing the SCCs of the stage.
+   */
+  std::set<SCC *> sccs;
+  for (auto i = first; i <= last; i++) {
+    sccs.insert(this->executedSCCs[i].begin(), this->executedSCCs[i].end());
+  }
+  uint64_t cost = 0;
+  for (auto scc : sccs) {
+    cost += this->IL.latencyPerInvocation(scc);
+  }
+
+  /*
+   * Add the time spent popping values produced by other stages and pushing
+   * values to the sets of other stages.
+   */
+  std::set<Value *> poppedValues;
+  std::set<std::pair<Value *, uint64_t>> pushedValues;
+  for (auto i = 0u; i < this->incomingValues.size(); i++) {
+    for (auto &incoming : this->incomingValues[i]) {
+      auto value = incoming.first;
+      auto fromSet = incoming.second;
+      if (isInStage(i) && !isInStage(fromSet)) {
+        poppedValues.insert(value);
+      } else if (!isInStage(i) && isInStage(fromSet)) {
+        pushedValues.insert(std::make_pair(value, i));
+      }
+    }
+  }
+  for (auto value : poppedValues) {
+    cost += this->IL.queueTransfersLatency(value);
+  }
+  for (auto &pushed : pushedValues) {
+    cost += this->IL.queueTransfersLatency(pushed.first);
+  }
+
+  return cost;
+}
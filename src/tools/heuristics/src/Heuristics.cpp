@@ -24,18 +24,49 @@
 using namespace llvm;
 using namespace arcana::noelle;
 
-Heuristics::Heuristics(Noelle &noelle)
-  : invocationLatency{ noelle.getProfiles() } {
+Heuristics::Heuristics(Noelle &noelle,
+                       uint64_t queueTransferCost,
+                       uint64_t dispatchCost,
+                       uint64_t signalCost)
+  : profiles{ noelle.getProfiles() },
+    queueTransferCost{ queueTransferCost },
+    dispatchCost{ dispatchCost },
+    signalCost{ signalCost },
+    invocationLatency{ noelle.getProfiles(), queueTransferCost } {
 
   return;
 }
 
+ParallelLoopTimingModel Heuristics::getParallelLoopTimingModel(
+    LoopDependenceInfo &ldi,
+    std::set<SCC *> const &sequentialSCCs) {
+  return ParallelLoopTimingModel(this->profiles,
+                                 ldi,
+                                 sequentialSCCs,
+                                 this->dispatchCost,
+                                 this->signalCost,
+                                 this->queueTransferCost);
+}
+
 void Heuristics::adjustParallelizationPartitionForDSWP(
     SCCDAGPartitioner *partitioner,
     SCCDAGAttrs &attrs,
     uint64_t numThreads,
     std::function<bool(GenericSCC *scc)> canBeRematerialized,
     Verbosity verbose) {
+
+  /*
+   * Balance the pipeline using the profiled costs of the SCCs, if they are
+   * available.
+   */
+  if (balancedPipelinePartition(*partitioner,
+                                attrs,
+                                numThreads,
+                                canBeRematerialized,
+                                verbose)) {
+    return;
+  }
+
   // smallestSizeMergePartition(*partitioner, attrs, idealThreads, verbose);
   minMaxMergePartition(*partitioner,
                        attrs,
@@ -68,6 +99,34 @@ void Heuristics::minMaxMergePartition(
   } while (modified);
 }
 
+bool Heuristics::balancedPipelinePartition(
+    SCCDAGPartitioner &partitioner,
+    SCCDAGAttrs &attrs,
+    uint64_t numThreads,
+    std::function<bool(GenericSCC *scc)> canBeRematerialized,
+    Verbosity verbose) {
+  BalancedPipelinePartitionAnalysis BPA(invocationLatency,
+                                        partitioner,
+                                        attrs,
+                                        numThreads,
+                                        canBeRematerialized,
+                                        verbose);
+
+  /*
+   * Check if the SCCs have been profiled.
+   */
+  if (!BPA.computeBalancedPartition()) {
+    return false;
+  }
+
+  /*
+   * Merge the sets that belong to the same stage.
+   */
+  BPA.mergeSetsOfStages();
+
+  return true;
+}
+
 void Heuristics::smallestSizeMergePartition(
     SCCDAGPartitioner &partitioner,
     SCCDAGAttrs &attrs,
@@ -37,7 +37,39 @@
 using namespace llvm;
 using namespace arcana::noelle;
 
+/*
+ * Options of the Heuristics pass.
+ */
+static cl::opt<uint64_t> QueueTransferCost(
+    "noelle-dswp-queue-cost",
+    cl::ZeroOrMore,
+    cl::Hidden,
+    cl::desc(
+        "Measured cost of transferring a value between DSWP stages (in instructions)"));
+static cl::opt<uint64_t> DispatchCost(
+    "noelle-dispatch-cost",
+    cl::ZeroOrMore,
+    cl::Hidden,
+    cl::desc(
+        "Measured cost of dispatching the tasks of a parallel loop invocation (in instructions)"));
+static cl::opt<uint64_t> SignalCost(
+    "noelle-helix-signal-cost",
+    cl::ZeroOrMore,
+    cl::Hidden,
+    cl::desc(
+        "Measured cost of signaling a HELIX sequential segment to another core (in instructions)"));
+
 bool HeuristicsPass::doInitialization(Module &M) {
+  if (QueueTransferCost.getNumOccurrences() > 0) {
+    this->queueTransferCost = QueueTransferCost.getValue();
+  }
+  if (DispatchCost.getNumOccurrences() > 0) {
+    this->dispatchCost = DispatchCost.getValue();
+  }
+  if (SignalCost.getNumOccurrences() > 0) {
+    this->signalCost = SignalCost.getValue();
+  }
+
   return false;
 }
 
@@ -50,12 +82,19 @@ bool HeuristicsPass::runOnModule(Module &M) {
   return false;
 }
 
-HeuristicsPass::HeuristicsPass() : ModulePass{ ID } {
+HeuristicsPass::HeuristicsPass()
+  : ModulePass{ ID },
+    queueTransferCost{ 20 },
+    dispatchCost{ 10000 },
+    signalCost{ 200 } {
   return;
 }
 
 Heuristics *HeuristicsPass::getHeuristics(Noelle &noelle) {
-  return new Heuristics(noelle);
+  return new Heuristics(noelle,
+                        this->queueTransferCost,
+                        this->dispatchCost,
+                        this->signalCost);
 }
 
 // Next there is code to register your pass to "opt"
@@ -24,7 +24,9 @@
 using namespace llvm;
 using namespace arcana::noelle;
 
-InvocationLatency::InvocationLatency(Hot *hot) : profiles{ hot } {
+InvocationLatency::InvocationLatency(Hot *hot, uint64_t queueTransferCost)
+  : profiles{ hot },
+    queueTransferCost{ queueTransferCost } {
   return;
 }
 
@@ -107,6 +109,20 @@ uint64_t InvocationLatency::queueLatency(Value *queueVal) {
   return 100;
 }
 
+/*
+ * The time spent to transfer a value through a queue during the whole
+ * profiled execution: one transfer per execution of its producer.
+ */
+uint64_t InvocationLatency::queueTransfersLatency(Value *queueVal) {
+  auto producer = dyn_cast<Instruction>(queueVal);
+  if (producer == nullptr) {
+    return 0;
+  }
+  auto transfers = this->profiles->getInvocations(producer);
+
+  return transfers * this->queueTransferCost;
+}
+
 /*
  * Retrieve or memoize all values the SCC is dependent on.
  * This does NOT include values within clonable parents as they will be present
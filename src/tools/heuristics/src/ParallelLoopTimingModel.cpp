@@ -0,0 +1,194 @@
+/*
+ * Copyright 2023  Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do
+ so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "noelle/core/SCCDAGAttrs.hpp"
+#include "noelle/tools/ParallelLoopTimingModel.hpp"
+
+namespace arcana::noelle {
+
+ParallelLoopTimingModel::ParallelLoopTimingModel(
+    Hot *profiles,
+    LoopDependenceInfo &ldi,
+    std::set<SCC *> const &sequentialSCCs,
+    uint64_t dispatchCost,
+    uint64_t signalCost,
+    uint64_t queueTransferCost)
+  : profiles{ profiles },
+    loop{ ldi.getLoopStructure() },
+    dispatchCost{ dispatchCost },
+    signalCost{ signalCost },
+    queueTransferCost{ queueTransferCost },
+    iterations{ 0 },
+    invocations{ 0 },
+    timePerIteration{ 0 },
+    biggestSequentialSCCTimePerIteration{ 0 },
+    numberOfSequentialSCCs{ 0 },
+    valuesTransferredPerIteration{ 0 } {
+
+  /*
+   * Fetch the profiles of the loop.
+   */
+  if ((!profiles->isAvailable()) || (!profiles->hasBeenExecuted(this->loop))) {
+    return;
+  }
+  this->iterations = (double)profiles->getIterations(this->loop);
+  if (this->iterations == 0) {
+    return;
+  }
+  this->invocations = (double)profiles->getInvocations(this->loop);
+  this->timePerIteration =
+      ((double)profiles->getTotalInstructions(this->loop)) / this->iterations;
+
+  /*
+   * Compute the critical path of an iteration: the biggest sequential SCC.
+   */
+  for (auto scc : sequentialSCCs) {
+    auto sccTime =
+        ((double)profiles->getTotalInstructions(scc)) / this->iterations;
+    this->biggestSequentialSCCTimePerIteration =
+        std::max(this->biggestSequentialSCCTimePerIteration, sccTime);
+  }
+  this->numberOfSequentialSCCs = sequentialSCCs.size();
+
+  /*
+   * Count the values that DSWP stages transfer per iteration.
+   * This is an upper bound as it assumes every SCC is in its own stage.
+   */
+  std::set<Value *> transferredValues;
+  auto sccdag = ldi.getSCCManager()->getSCCDAG();
+  for (auto edge : sccdag->getEdges()) {
+    for (auto subEdge : edge->getSubEdges()) {
+      if (subEdge->isControlDependence() || subEdge->isMemoryDependence()) {
+        continue;
+      }
+      transferredValues.insert(subEdge->getSrc());
+    }
+  }
+  this->valuesTransferredPerIteration = transferredValues.size();
+
+  return;
+}
+
+double ParallelLoopTimingModel::getSequentialTime(void) const {
+  return this->iterations * this->timePerIteration;
+}
+
+double ParallelLoopTimingModel::getParallelTime(Transformation technique,
+                                                uint32_t cores) const {
+
+  /*
+   * Check if there is anything to parallelize.
+   */
+  auto sequentialTime = this->getSequentialTime();
+  if ((this->iterations == 0) || (cores < 2)) {
+    return sequentialTime;
+  }
+
+  switch (technique) {
+    case DOALL_ID:
+
+      /*
+       * Iterations are independent.
+       */
+      if (this->numberOfSequentialSCCs > 0) {
+        return sequentialTime;
+      }
+      return this->getParallelTime(cores, 0, 0);
+
+    case HELIX_ID: {
+
+      /*
+       * Each sequential SCC runs in a sequential segment.
+       * Iterations wait for the previous one to signal them before entering a
+       * sequential segment, which moves a cache line between cores.
+       */
+      double criticalPath = 0;
+      if (this->numberOfSequentialSCCs > 0) {
+        criticalPath =
+            this->biggestSequentialSCCTimePerIteration + this->signalCost;
+      }
+      auto overhead = this->numberOfSequentialSCCs * this->signalCost;
+      return this->getParallelTime(cores, criticalPath, overhead);
+    }
+
+    case DSWP_ID: {
+
+      /*
+       * Each SCC runs in a single stage, and stages exchange values through
+       * queues.
+       */
+      auto criticalPath = this->biggestSequentialSCCTimePerIteration
+                          + this->queueTransferCost;
+      auto overhead =
+          this->valuesTransferredPerIteration * this->queueTransferCost;
+      return this->getParallelTime(cores, criticalPath, overhead);
+    }
+
+    default:
+      return sequentialTime;
+  }
+}
+
+double ParallelLoopTimingModel::getSpeedup(Transformation technique,
+                                           uint32_t cores) const {
+  auto parallelTime = this->getParallelTime(technique, cores);
+  if (parallelTime == 0) {
+    return 1;
+  }
+
+  return this->getSequentialTime() / parallelTime;
+}
+
+double ParallelLoopTimingModel::getParallelTime(
+    uint32_t cores,
+    double criticalPathPerIteration,
+    double overheadPerIteration) const {
+
+  /*
+   * Only the invocations with at least @cores iterations keep all cores busy.
+   * The iterations of the other invocations are assumed to run sequentially.
+   */
+  auto parallelIterations =
+      this->iterations
+      * this->profiles->getFractionOfIterationsInInvocationsWithAtLeast(
+          this->loop,
+          cores);
+  auto sequentialIterations = this->iterations - parallelIterations;
+
+  /*
+   * Iterations are spread across cores, but they cannot go faster than their
+   * critical path.
+   */
+  auto timePerParallelIteration =
+      std::max((this->timePerIteration + overheadPerIteration) / cores,
+               criticalPathPerIteration);
+
+  /*
+   * Every invocation pays the dispatch of its tasks.
+   */
+  auto time = (this->invocations * this->dispatchCost)
+              + (parallelIterations * timePerParallelIteration)
+              + (sequentialIterations * this->timePerIteration);
+
+  return time;
+}
+
+} // namespace arcana::noelle
@@ -50,6 +50,7 @@ public:
 private:
   uint32_t maxNumberOfFunctionCallsToInlinePerLoop;
   uint32_t maxProgramInstructions;
+  CodeSizeBudget *codeSizeBudget;
 
   /*
    * Inlining procedure
@@ -27,6 +27,7 @@ Inliner::Inliner()
   : ModulePass{ ID },
     maxNumberOfFunctionCallsToInlinePerLoop{ 10 },
     maxProgramInstructions{ 50000 },
+    codeSizeBudget{ nullptr },
     fnsAffected{},
     parentFns{},
     childrenFns{},
@@ -56,6 +57,11 @@ bool Inliner::runOnModule(Module &M) {
   }
   errs() << "Inliner: Start\n";
 
+  /*
+   * Fetch the budget of the code we can add by inlining.
+   */
+  this->codeSizeBudget = noelle.getCodeSizeBudget();
+
   /*
    * Fetch the entry point of the program.
    */
@@ -436,6 +442,21 @@ bool Inliner::inlineFunctionCall(Hot *p,
     return false;
   }
 
+  /*
+   * Check if we can afford the copy of the callee.
+   * Inlining saves the overhead of the call every time it executes.
+   */
+  if (this->codeSizeBudget != nullptr) {
+    CodeGrowthRequest request{ "Inlining",
+                               "call to " + childF->getName().str() + " in "
+                                   + F->getName().str(),
+                               CodeSizeBudget::getCodeSize(*childF),
+                               (double)p->getInvocations(call) };
+    if (!this->codeSizeBudget->requestCodeGrowth(request)) {
+      return false;
+    }
+  }
+
   /*
    * Try to inline the function.
    */
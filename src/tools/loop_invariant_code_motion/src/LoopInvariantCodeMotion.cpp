@@ -33,24 +33,42 @@ bool LoopInvariantCodeMotion::promoteMemoryLocationsToRegisters(
     LoopDependenceInfo const &LDI) {
   Mem2RegNonAlloca mem2Reg(LDI, this->noelle);
 
+  /*
+   * Keep track of the changes to update the PDG.
+   */
+  auto pdg = this->noelle.getProgramDependenceGraph();
+  auto loopFunction = LDI.getLoopStructure()->getFunction();
+  pdg->trackChangesOf(*loopFunction);
+
   auto result = mem2Reg.promoteMemoryToRegister();
 
+  pdg->updateChangesOf(*loopFunction);
+
   return result;
 }
 
 bool LoopInvariantCodeMotion::extractInvariantsFromLoop(
     LoopDependenceInfo const &LDI) {
 
-  if (this->hoistInvariantValues(LDI)) {
-    return true;
-  }
+  /*
+   * Keep track of the changes to update the PDG.
+   */
+  auto pdg = this->noelle.getProgramDependenceGraph();
+  auto loopFunction = LDI.getLoopStructure()->getFunction();
+  pdg->trackChangesOf(*loopFunction);
 
-  Mem2RegNonAlloca mem2Reg(LDI, noelle);
-  if (mem2Reg.promoteMemoryToRegister()) {
-    return true;
+  /*
+   * Hoist invariants or promote memory locations to registers.
+   */
+  auto modified = this->hoistInvariantValues(LDI);
+  if (!modified) {
+    Mem2RegNonAlloca mem2Reg(LDI, noelle);
+    modified = mem2Reg.promoteMemoryToRegister();
   }
 
-  return false;
+  pdg->updateChangesOf(*loopFunction);
+
+  return modified;
 }
 
 } // namespace arcana::noelle
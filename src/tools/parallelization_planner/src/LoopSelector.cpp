@@ -79,15 +79,19 @@ void Planner::removeLoopsNotWorthParallelizing(Noelle &noelle,
 
       /*
        * Check the number of iterations per invocation.
+       *
+       * We use the median rather than the average when the distribution of
+       * the iterations is known: a few long invocations can hide many short
+       * ones.
        */
-      auto averageIterations =
-          profiles->getAverageLoopIterationsPerInvocation(ls);
-      auto averageIterationThreshold = 12;
-      if (averageIterations < averageIterationThreshold) {
-        errs() << "Planner:    Loop " << loopID << " has " << averageIterations
-               << " number of iterations on average per loop invocation\n";
+      auto medianIterations =
+          profiles->getMedianLoopIterationsPerInvocation(ls);
+      auto medianIterationThreshold = 12;
+      if (medianIterations < medianIterationThreshold) {
+        errs() << "Planner:    Loop " << loopID << " has " << medianIterations
+               << " number of iterations per loop invocation (median)\n";
         errs() << "Planner:      It is too low. The threshold is "
-               << averageIterationThreshold << "\n";
+               << medianIterationThreshold << "\n";
 
         /*
          * Remove the loop.
@@ -197,6 +201,7 @@ void Planner::removeLoopsNotWorthParallelizing(Noelle &noelle,
 std::vector<LoopDependenceInfo *> Planner::selectTheOrderOfLoopsToParallelize(
     Noelle &noelle,
     Hot *profiles,
+    Heuristics *heuristics,
     noelle::LoopTree *tree,
     uint64_t &maxTimeSaved,
     uint64_t &maxTimeSavedWithDOALLOnly) {
@@ -214,10 +219,16 @@ std::vector<LoopDependenceInfo *> Planner::selectTheOrderOfLoopsToParallelize(
   std::map<LoopDependenceInfo *, uint64_t> timeSavedLoops;
   std::map<LoopStructure *, bool> doallLoops;
   std::map<LoopStructure *, uint64_t> timeSavedPerLoop;
+  std::map<LoopDependenceInfo *, std::optional<Transformation>> bestTechniques;
+  std::map<LoopDependenceInfo *, std::vector<double>> predictedSpeedups;
   auto selector = [&noelle,
                    &timeSavedLoops,
                    &timeSavedPerLoop,
+                   &bestTechniques,
+                   &predictedSpeedups,
+                   verbose,
                    profiles,
+                   heuristics,
                    &doallLoops](LoopTree *n, uint32_t treeLevel) -> bool {
     /*
      * Fetch the loop.
@@ -232,7 +243,7 @@ std::vector<LoopDependenceInfo *> Planner::selectTheOrderOfLoopsToParallelize(
     /*
      * Compute the timing model for this loop.
      */
-    auto loopTimeModel = new LoopTimingModel(noelle, *ldi);
+    auto loopTimeModel = new LoopTimingModel(noelle, *ldi, *heuristics);
 
     /*
      * Tag DOALL loops.
@@ -251,6 +262,24 @@ std::vector<LoopDependenceInfo *> Planner::selectTheOrderOfLoopsToParallelize(
     timeSavedLoops[ldi] = (uint64_t)timeSaved;
     timeSavedPerLoop[ls] = (uint64_t)timeSaved;
 
+    /*
+     * Predict the speedup per number of cores.
+     */
+    if (verbose != Verbosity::Disabled) {
+      bestTechniques[ldi] = loopTimeModel->getBestTechnique();
+      auto maxCores = ldi->getLoopTransformationsManager()
+                          ->getMaximumNumberOfCores();
+      auto &speedups = predictedSpeedups[ldi];
+      for (auto cores = 2u; cores <= maxCores; cores++) {
+        speedups.push_back(loopTimeModel->getPredictedSpeedup(cores));
+      }
+    }
+
+    /*
+     * Free the memory.
+     */
+    delete loopTimeModel;
+
     return false;
   };
   tree->visitPreOrder(selector);
@@ -388,6 +417,27 @@ std::vector<LoopDependenceInfo *> Planner::selectTheOrderOfLoopsToParallelize(
       errs()
           << "Planner: LoopSelector:      Loop savings = " << savedTimeRelative
           << "%\n";
+
+      /*
+       * Print the predictions of the timing model.
+       */
+      auto bestTechnique = bestTechniques[l];
+      errs() << "Planner: LoopSelector:      Best technique: ";
+      if (!bestTechnique) {
+        errs() << "none\n";
+      } else if (bestTechnique.value() == DOALL_ID) {
+        errs() << "DOALL\n";
+      } else if (bestTechnique.value() == HELIX_ID) {
+        errs() << "HELIX\n";
+      } else {
+        errs() << "DSWP\n";
+      }
+      auto cores = 2;
+      for (auto speedup : predictedSpeedups[l]) {
+        errs() << "Planner: LoopSelector:      Predicted speedup with " << cores
+               << " cores = " << speedup << "x\n";
+        cores++;
+      }
     }
     errs() << "Planner: LoopSelector: End\n";
   }
@@ -31,8 +31,59 @@ static cl::opt<bool> ForceParallelizationPlanner(
     cl::ZeroOrMore,
     cl::Hidden,
     cl::desc("Force the parallelization"));
+static cl::opt<bool> MultiVersioningPlanner(
+    "noelle-parallelizer-multiversion",
+    cl::ZeroOrMore,
+    cl::Hidden,
+    cl::desc(
+        "Plan loops to be parallelized in multiple versions selected at runtime"));
+static cl::opt<bool> WholeProgramSelectionPlanner(
+    "noelle-parallelizer-whole-program",
+    cl::ZeroOrMore,
+    cl::Hidden,
+    cl::desc(
+        "Select the loops to parallelize across the whole program, including the loops nested through calls"));
+
+/*
+ * Options of the Parallelizer pass that the planner only needs to accept.
+ * They are forwarded to both passes by noelle-parallelizer.
+ */
+static cl::opt<uint32_t> DSWPStageReplicasPlanner(
+    "dswp-stage-replicas",
+    cl::ZeroOrMore,
+    cl::Hidden,
+    cl::desc(
+        "Number of replicas of the DSWP stages whose iterations are independent"));
+static cl::opt<uint32_t> HELIXIterationBlockSizePlanner(
+    "helix-iteration-block-size",
+    cl::ZeroOrMore,
+    cl::Hidden,
+    cl::desc(
+        "Number of consecutive iterations a HELIX core executes between synchronizations (unless INDEX_FILE fixes it)"));
+static cl::opt<bool> DOALLSpeculationPlanner(
+    "noelle-doall-speculate",
+    cl::ZeroOrMore,
+    cl::Hidden,
+    cl::desc(
+        "Speculate loop-carried memory dependences that block DOALL and check them when loops start"));
+static cl::opt<bool> HELIXSpeculationPlanner(
+    "noelle-helix-speculate",
+    cl::ZeroOrMore,
+    cl::Hidden,
+    cl::desc(
+        "Speculate loop-carried memory dependences that require HELIX sequential segments and check them when loops start"));
+static cl::opt<bool> DOALLTuningPlanner(
+    "noelle-doall-tuning",
+    cl::ZeroOrMore,
+    cl::Hidden,
+    cl::desc(
+        "Let the runtime set the chunk size and the cores of DOALL loops from INDEX_FILE or by tuning them online (NOELLE_DOALL_TUNING)"));
 
-Planner::Planner() : ModulePass{ ID }, forceParallelization{ false } {
+Planner::Planner()
+  : ModulePass{ ID },
+    forceParallelization{ false },
+    multiVersioning{ false },
+    wholeProgramSelection{ false } {
 
   return;
 }
@@ -40,6 +91,9 @@ Planner::Planner() : ModulePass{ ID }, forceParallelization{ false } {
 bool Planner::doInitialization(Module &M) {
   this->forceParallelization =
       (ForceParallelizationPlanner.getNumOccurrences() > 0);
+  this->multiVersioning = (MultiVersioningPlanner.getNumOccurrences() > 0);
+  this->wholeProgramSelection =
+      (WholeProgramSelectionPlanner.getNumOccurrences() > 0);
 
   return false;
 }
@@ -81,8 +135,11 @@ bool Planner::runOnModule(Module &M) {
 
   /*
    * Filter out loops that are not worth parallelizing.
+   *
+   * When loops are multi-versioned, whether a loop is worth parallelizing is
+   * decided at runtime.
    */
-  if (!this->forceParallelization) {
+  if ((!this->forceParallelization) && (!this->multiVersioning)) {
     this->removeLoopsNotWorthParallelizing(noelle, profiles, forest);
   }
 
@@ -92,48 +149,79 @@ bool Planner::runOnModule(Module &M) {
    * Parallelize the loops starting from the outermost to the inner ones.
    * This is accomplished by having sorted the loops above.
    */
+  auto heuristics = getAnalysis<HeuristicsPass>().getHeuristics(noelle);
   auto modified = false;
   uint32_t parallelizationOrderIndex = 0;
   auto mm = noelle.getMetadataManager();
   uint64_t programMaxTimeSaved = 0;
   uint64_t programMaxTimeSavedWithDOALLOnly = 0;
-  for (auto tree : forest->getTrees()) {
+  auto addLoopsToThePlan =
+      [&parallelizationOrderIndex, &mm, &modified](
+          std::vector<LoopDependenceInfo *> const &loopsToParallelize) {
+        /*
+         * Attach metadata representing the loop's order in the
+         * parallelization plan to each loop we are considering.
+         */
+        for (auto ldi : loopsToParallelize) {
+          auto ls = ldi->getLoopStructure();
+          auto ldiParallelizationOrderIndex =
+              std::to_string(parallelizationOrderIndex++);
+          mm->addMetadata(ls,
+                          "noelle.parallelizer.looporder",
+                          ldiParallelizationOrderIndex);
+          modified = true;
+        }
 
-    /*
-     * Select the loops to parallelize.
-     */
-    uint64_t maxTimeSaved = 0;
-    uint64_t maxTimeSavedWithDOALLOnly = 0;
-    auto loopsToParallelize =
-        this->selectTheOrderOfLoopsToParallelize(noelle,
-                                                 profiles,
-                                                 tree,
-                                                 maxTimeSaved,
-                                                 maxTimeSavedWithDOALLOnly);
-    programMaxTimeSaved += maxTimeSaved;
-    programMaxTimeSavedWithDOALLOnly += maxTimeSavedWithDOALLOnly;
+        /*
+         * Free the memory.
+         */
+        for (auto loop : loopsToParallelize) {
+          delete loop;
+        }
+      };
 
-    /*
-     * Attach metadata representing the loop's order in the parallelization plan
-     * to each loop we are considering.
-     */
-    for (auto ldi : loopsToParallelize) {
-      auto ls = ldi->getLoopStructure();
-      auto ldiParallelizationOrderIndex =
-          std::to_string(parallelizationOrderIndex++);
-      mm->addMetadata(ls,
-                      "noelle.parallelizer.looporder",
-                      ldiParallelizationOrderIndex);
-      modified = true;
-    }
+  /*
+   * Check if the loops should be selected across the whole program.
+   *
+   * In this case, the choice of the loop to parallelize in each nest considers
+   * the loops nested through calls as well. This requires the entry function
+   * of the program.
+   */
+  auto entryFunction = noelle.getFunctionsManager()->getEntryFunction();
+  if (this->wholeProgramSelection && (entryFunction != nullptr)) {
+    auto loopsToParallelize = this->selectLoopsToParallelizeInProgram(
+        noelle,
+        profiles,
+        heuristics,
+        forest,
+        programMaxTimeSaved,
+        programMaxTimeSavedWithDOALLOnly);
+    addLoopsToThePlan(loopsToParallelize);
+  } else {
+    for (auto tree : forest->getTrees()) {
 
-    /*
-     * Free the memory.
-     */
-    for (auto loop : loopsToParallelize) {
-      delete loop;
+      /*
+       * Select the loops to parallelize.
+       */
+      uint64_t maxTimeSaved = 0;
+      uint64_t maxTimeSavedWithDOALLOnly = 0;
+      auto loopsToParallelize =
+          this->selectTheOrderOfLoopsToParallelize(noelle,
+                                                   profiles,
+                                                   heuristics,
+                                                   tree,
+                                                   maxTimeSaved,
+                                                   maxTimeSavedWithDOALLOnly);
+      programMaxTimeSaved += maxTimeSaved;
+      programMaxTimeSavedWithDOALLOnly += maxTimeSavedWithDOALLOnly;
+
+      /*
+       * Add the loops selected to the plan.
+       */
+      addLoopsToThePlan(loopsToParallelize);
     }
   }
+  delete heuristics;
 
   /*
    * Print statistics.
@@ -167,6 +255,7 @@ void Planner::getAnalysisUsage(AnalysisUsage &AU) const {
    * Noelle.
    */
   AU.addRequired<Noelle>();
+  AU.addRequired<HeuristicsPass>();
 
   return;
 }
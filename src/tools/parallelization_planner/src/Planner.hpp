@@ -29,6 +29,7 @@
 #include "noelle/core/Noelle.hpp"
 #include "noelle/core/MetadataManager.hpp"
 #include "noelle/tools/DOALL.hpp"
+#include "noelle/tools/HeuristicsPass.hpp"
 
 namespace arcana::noelle {
 
@@ -52,6 +53,8 @@ private:
    * Fields
    */
   bool forceParallelization;
+  bool multiVersioning;
+  bool wholeProgramSelection;
 
   /*
    * Methods
@@ -67,10 +70,19 @@ private:
   std::vector<LoopDependenceInfo *> selectTheOrderOfLoopsToParallelize(
       Noelle &noelle,
       Hot *profiles,
+      Heuristics *heuristics,
       noelle::LoopTree *tree,
       uint64_t &maxTimeSaved,
       uint64_t &maxTimeSavedWithDOALLOnly);
 
+  std::vector<LoopDependenceInfo *> selectLoopsToParallelizeInProgram(
+      Noelle &noelle,
+      Hot *profiles,
+      Heuristics *heuristics,
+      LoopForest *forest,
+      uint64_t &maxTimeSaved,
+      uint64_t &maxTimeSavedWithDOALLOnly);
+
   std::pair<uint64_t, uint64_t> evaluateSavings(
       Noelle &noelle,
       noelle::LoopTree *tree,
@@ -24,9 +24,12 @@
 
 namespace arcana::noelle {
 
-LoopTimingModel::LoopTimingModel(Noelle &noelle, LoopDependenceInfo &ldi)
+LoopTimingModel::LoopTimingModel(Noelle &noelle,
+                                 LoopDependenceInfo &ldi,
+                                 Heuristics &heuristics)
   : n{ noelle },
-    loop{ ldi } {
+    loop{ ldi },
+    heuristics{ heuristics } {
   return;
 }
 
@@ -50,23 +53,28 @@ uint64_t LoopTimingModel::getTimeSavedByParallelizingLoop(void) {
   }
 
   /*
-   * Fetch the critical path per iteration
+   * Compute the timing model of the loop.
    */
-  auto seq = this->getTimeSpentInCriticalPathPerIteration();
+  auto sequentialSCCs =
+      DOALL::getSCCsThatBlockDOALLToBeApplicable(&this->loop, this->n);
+  auto model =
+      this->heuristics.getParallelLoopTimingModel(this->loop, sequentialSCCs);
 
   /*
-   * Compute the total time saved.
+   * Find the fastest parallelization of the loop.
    */
-  auto instsPerIteration =
-      profiles->getAverageTotalInstructionsPerIteration(ls);
-  auto instsInBiggestSCCPerIteration =
-      ((double)seq) / ((double)profiles->getIterations(ls));
-  assert(instsInBiggestSCCPerIteration <= instsPerIteration);
-  auto timeSavedPerIteration =
-      (double)(instsPerIteration - instsInBiggestSCCPerIteration);
-  auto timeSaved = timeSavedPerIteration * profiles->getIterations(ls);
-
-  return timeSaved;
+  auto sequentialTime = model.getSequentialTime();
+  auto bestTime = sequentialTime;
+  auto ltm = this->loop.getLoopTransformationsManager();
+  auto maxCores = ltm->getMaximumNumberOfCores();
+  for (auto technique : this->getEnabledTechniques()) {
+    for (auto cores = 2u; cores <= maxCores; cores++) {
+      auto parallelTime = model.getParallelTime(technique, cores);
+      bestTime = std::min(bestTime, parallelTime);
+    }
+  }
+
+  return (uint64_t)(sequentialTime - bestTime);
 }
 
 uint64_t LoopTimingModel::getTimeSpentInCriticalPathPerIteration(void) {
@@ -108,4 +116,68 @@ uint64_t LoopTimingModel::getTimeSpentInCriticalPathPerIteration(void) {
   return biggestSCCTime;
 }
 
+std::optional<Transformation> LoopTimingModel::getBestTechnique(void) {
+
+  /*
+   * Compute the timing model of the loop.
+   */
+  auto sequentialSCCs =
+      DOALL::getSCCsThatBlockDOALLToBeApplicable(&this->loop, this->n);
+  auto model =
+      this->heuristics.getParallelLoopTimingModel(this->loop, sequentialSCCs);
+
+  /*
+   * Find the technique of the fastest parallelization of the loop.
+   */
+  std::optional<Transformation> bestTechnique;
+  auto bestTime = model.getSequentialTime();
+  auto ltm = this->loop.getLoopTransformationsManager();
+  auto maxCores = ltm->getMaximumNumberOfCores();
+  for (auto technique : this->getEnabledTechniques()) {
+    for (auto cores = 2u; cores <= maxCores; cores++) {
+      auto parallelTime = model.getParallelTime(technique, cores);
+      if (parallelTime < bestTime) {
+        bestTime = parallelTime;
+        bestTechnique = technique;
+      }
+    }
+  }
+
+  return bestTechnique;
+}
+
+double LoopTimingModel::getPredictedSpeedup(uint32_t cores) {
+
+  /*
+   * Compute the timing model of the loop.
+   */
+  auto sequentialSCCs =
+      DOALL::getSCCsThatBlockDOALLToBeApplicable(&this->loop, this->n);
+  auto model =
+      this->heuristics.getParallelLoopTimingModel(this->loop, sequentialSCCs);
+
+  /*
+   * Find the best speedup among the enabled techniques.
+   */
+  double bestSpeedup = 1;
+  for (auto technique : this->getEnabledTechniques()) {
+    bestSpeedup = std::max(bestSpeedup, model.getSpeedup(technique, cores));
+  }
+
+  return bestSpeedup;
+}
+
+std::vector<Transformation> LoopTimingModel::getEnabledTechniques(void) {
+  std::vector<Transformation> techniques;
+
+  auto ltm = this->loop.getLoopTransformationsManager();
+  for (auto technique : { DOALL_ID, HELIX_ID, DSWP_ID }) {
+    if (ltm->isTransformationEnabled(technique)) {
+      techniques.push_back(technique);
+    }
+  }
+
+  return techniques;
+}
+
 } // namespace arcana::noelle
@@ -0,0 +1,412 @@
+/*
+ * Copyright 2023  Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do
+ so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "Planner.hpp"
+#include "TimingModel.hpp"
+
+namespace arcana::noelle {
+
+/*
+ * Select the loops of the nesting forest rooted at @roots that maximize the
+ * time saved, knowing that only one loop per path from a root to a leaf can be
+ * parallelized.
+ */
+static uint64_t selectLoopsOfForest(
+    std::vector<LoopNestingGraphLoopNode *> const &roots,
+    std::unordered_map<LoopNestingGraphLoopNode *,
+                       std::vector<LoopNestingGraphLoopNode *>> &children,
+    std::function<uint64_t(LoopNestingGraphLoopNode *)> getTimeSaved,
+    std::vector<LoopNestingGraphLoopNode *> &selectedLoops) {
+
+  /*
+   * Compute the maximum time saved by any combination of loops nested from
+   * each node (including the node), from the leaves up to the roots.
+   */
+  std::unordered_map<LoopNestingGraphLoopNode *, uint64_t> maxTimeSaved;
+  std::unordered_set<LoopNestingGraphLoopNode *> parallelizeNode;
+  std::function<uint64_t(LoopNestingGraphLoopNode *)> computeMaxTimeSaved;
+  computeMaxTimeSaved = [&](LoopNestingGraphLoopNode *n) -> uint64_t {
+    uint64_t childrenSaved = 0;
+    for (auto child : children[n]) {
+      childrenSaved += computeMaxTimeSaved(child);
+    }
+    auto loopSaved = getTimeSaved(n);
+    if ((loopSaved > 0) && (loopSaved >= childrenSaved)) {
+      parallelizeNode.insert(n);
+      maxTimeSaved[n] = loopSaved;
+    } else {
+      maxTimeSaved[n] = childrenSaved;
+    }
+
+    return maxTimeSaved[n];
+  };
+  uint64_t totalTimeSaved = 0;
+  for (auto root : roots) {
+    totalTimeSaved += computeMaxTimeSaved(root);
+  }
+
+  /*
+   * Collect the loops that achieve the maximum time saved, from the roots down
+   * to the leaves.
+   */
+  std::function<void(LoopNestingGraphLoopNode *)> collectLoops;
+  collectLoops = [&](LoopNestingGraphLoopNode *n) {
+    if (parallelizeNode.find(n) != parallelizeNode.end()) {
+      selectedLoops.push_back(n);
+      return;
+    }
+    for (auto child : children[n]) {
+      collectLoops(child);
+    }
+  };
+  for (auto root : roots) {
+    collectLoops(root);
+  }
+
+  return totalTimeSaved;
+}
+
+/*
+ * Remove from @selectedLoops the loops that are reachable from another
+ * selected loop through an edge of the loop nesting graph that is not part of
+ * the forest (e.g., a function called by several loops). The loop that saves
+ * the most time is kept.
+ */
+static uint64_t removeNestedLoops(
+    std::vector<LoopNestingGraphLoopNode *> &selectedLoops,
+    std::function<uint64_t(LoopNestingGraphLoopNode *)> getTimeSaved) {
+
+  /*
+   * Sort the loops by time saved.
+   */
+  std::stable_sort(
+      selectedLoops.begin(),
+      selectedLoops.end(),
+      [&getTimeSaved](LoopNestingGraphLoopNode *n1,
+                      LoopNestingGraphLoopNode *n2) {
+        return getTimeSaved(n1) > getTimeSaved(n2);
+      });
+
+  /*
+   * Keep a loop only if it is not nested within a loop kept and it does not
+   * include one.
+   */
+  std::vector<LoopNestingGraphLoopNode *> keptLoops;
+  std::unordered_set<LoopNestingGraphLoopNode *> nestedInKeptLoops;
+  uint64_t totalTimeSaved = 0;
+  for (auto n : selectedLoops) {
+    if (nestedInKeptLoops.find(n) != nestedInKeptLoops.end()) {
+      continue;
+    }
+
+    /*
+     * Fetch the loops nested within @n.
+     */
+    std::unordered_set<LoopNestingGraphLoopNode *> nestedLoops;
+    std::vector<LoopNestingGraphLoopNode *> toVisit{ n };
+    while (!toVisit.empty()) {
+      auto current = toVisit.back();
+      toVisit.pop_back();
+      for (auto edge : current->getOutgoingEdges()) {
+        auto child = edge->getChild();
+        if (nestedLoops.insert(child).second) {
+          toVisit.push_back(child);
+        }
+      }
+    }
+
+    /*
+     * Check if @n includes a loop kept.
+     */
+    auto includesKeptLoop = false;
+    for (auto keptLoop : keptLoops) {
+      if (nestedLoops.find(keptLoop) != nestedLoops.end()) {
+        includesKeptLoop = true;
+        break;
+      }
+    }
+    if (includesKeptLoop) {
+      continue;
+    }
+
+    /*
+     * Keep @n.
+     */
+    keptLoops.push_back(n);
+    nestedInKeptLoops.insert(nestedLoops.begin(), nestedLoops.end());
+    totalTimeSaved += getTimeSaved(n);
+  }
+  selectedLoops = keptLoops;
+
+  return totalTimeSaved;
+}
+
+std::vector<LoopDependenceInfo *> Planner::selectLoopsToParallelizeInProgram(
+    Noelle &noelle,
+    Hot *profiles,
+    Heuristics *heuristics,
+    LoopForest *forest,
+    uint64_t &maxTimeSaved,
+    uint64_t &maxTimeSavedWithDOALLOnly) {
+
+  /*
+   * Fetch the verbosity.
+   */
+  auto verbose = noelle.getVerbosity();
+
+  /*
+   * Compute the amount of time that can be saved by parallelizing each loop
+   * that is worth considering.
+   */
+  std::unordered_map<uint64_t, LoopDependenceInfo *> candidates;
+  std::unordered_map<uint64_t, uint64_t> timeSavedPerLoop;
+  std::unordered_map<uint64_t, bool> doallLoops;
+  std::unordered_map<uint64_t, std::optional<Transformation>> bestTechniques;
+  std::unordered_map<uint64_t, uint32_t> bestCores;
+  auto evaluateLoop = [this,
+                       &noelle,
+                       profiles,
+                       heuristics,
+                       &candidates,
+                       &timeSavedPerLoop,
+                       &doallLoops,
+                       &bestTechniques,
+                       &bestCores](LoopTree *n, uint32_t treeLevel) -> bool {
+    /*
+     * Fetch the loop.
+     */
+    auto ls = n->getLoop();
+    auto loopIDOpt = ls->getID();
+    assert(loopIDOpt);
+    auto loopID = loopIDOpt.value();
+    auto optimizations = {
+      LoopDependenceInfoOptimization::MEMORY_CLONING_ID,
+      LoopDependenceInfoOptimization::THREAD_SAFE_LIBRARY_ID
+    };
+    auto ldi = noelle.getLoop(ls, optimizations);
+    candidates[loopID] = ldi;
+
+    /*
+     * Compute the timing model for this loop.
+     */
+    auto loopTimeModel = new LoopTimingModel(noelle, *ldi, *heuristics);
+    doallLoops[loopID] =
+        (loopTimeModel->getTimeSpentInCriticalPathPerIteration() == 0);
+
+    /*
+     * Compute the maximum amount of time saved by any parallelization
+     * technique.
+     * Loops that do not save enough time are not worth parallelizing.
+     */
+    auto timeSaved = loopTimeModel->getTimeSavedByParallelizingLoop();
+    auto savedTimeTotal =
+        ((double)timeSaved) / ((double)profiles->getTotalInstructions());
+    savedTimeTotal *= 100;
+    if ((!this->forceParallelization) && (savedTimeTotal < 2)) {
+      timeSaved = 0;
+    }
+    timeSavedPerLoop[loopID] = timeSaved;
+
+    /*
+     * Fetch the best technique and the number of cores to give to it.
+     */
+    bestTechniques[loopID] = loopTimeModel->getBestTechnique();
+    auto maxCores =
+        ldi->getLoopTransformationsManager()->getMaximumNumberOfCores();
+    auto bestSpeedup = 1.0;
+    bestCores[loopID] = 1;
+    for (auto cores = 2u; cores <= maxCores; cores++) {
+      auto speedup = loopTimeModel->getPredictedSpeedup(cores);
+      if (speedup > bestSpeedup) {
+        bestSpeedup = speedup;
+        bestCores[loopID] = cores;
+      }
+    }
+
+    /*
+     * Free the memory.
+     */
+    delete loopTimeModel;
+
+    return false;
+  };
+  for (auto tree : forest->getTrees()) {
+    tree->visitPreOrder(evaluateLoop);
+  }
+
+  /*
+   * Fetch the loop nesting graph of the whole program, which includes the
+   * loops nested through calls.
+   */
+  auto graph = noelle.getLoopNestingGraphForProgram();
+  auto getLoopID = [](LoopNestingGraphLoopNode *n) -> std::optional<uint64_t> {
+    return n->getLoop()->getID();
+  };
+
+  /*
+   * Organize the loops of the graph in a forest.
+   *
+   * The parent of a loop is the loop that includes it within the same
+   * function, or the only loop that calls its function. Loops called from
+   * several loops, and loops that would create a cycle because of recursion,
+   * become roots.
+   */
+  std::vector<LoopNestingGraphLoopNode *> nodes;
+  for (auto n : graph->getLoopNodes()) {
+    nodes.push_back(n);
+  }
+  std::unordered_map<LoopNestingGraphLoopNode *, LoopNestingGraphLoopNode *>
+      parents;
+  for (auto n : nodes) {
+    LoopNestingGraphLoopNode *parent = nullptr;
+    auto incomingEdges = n->getIncomingEdges();
+    for (auto edge : incomingEdges) {
+      auto p = edge->getParent();
+      if ((p != n)
+          && (p->getLoop()->getFunction() == n->getLoop()->getFunction())) {
+        parent = p;
+        break;
+      }
+    }
+    if ((parent == nullptr) && (incomingEdges.size() == 1)) {
+      auto p = (*incomingEdges.begin())->getParent();
+      if (p != n) {
+        parent = p;
+      }
+    }
+    parents[n] = parent;
+  }
+  for (auto n : nodes) {
+    std::unordered_set<LoopNestingGraphLoopNode *> ancestors;
+    auto p = parents[n];
+    while ((p != nullptr) && (ancestors.find(p) == ancestors.end())) {
+      if (p == n) {
+        parents[n] = nullptr;
+        break;
+      }
+      ancestors.insert(p);
+      p = parents[p];
+    }
+  }
+  std::vector<LoopNestingGraphLoopNode *> roots;
+  std::unordered_map<LoopNestingGraphLoopNode *,
+                     std::vector<LoopNestingGraphLoopNode *>>
+      children;
+  for (auto n : nodes) {
+    auto p = parents[n];
+    if (p == nullptr) {
+      roots.push_back(n);
+    } else {
+      children[p].push_back(n);
+    }
+  }
+
+  /*
+   * Select the loops to parallelize.
+   */
+  auto getTimeSaved = [&getLoopID,
+                       &timeSavedPerLoop](LoopNestingGraphLoopNode *n) {
+    auto loopID = getLoopID(n);
+    if (!loopID || (timeSavedPerLoop.find(*loopID) == timeSavedPerLoop.end())) {
+      return (uint64_t)0;
+    }
+    return timeSavedPerLoop.at(*loopID);
+  };
+  std::vector<LoopNestingGraphLoopNode *> selectedNodes;
+  selectLoopsOfForest(roots, children, getTimeSaved, selectedNodes);
+  maxTimeSaved = removeNestedLoops(selectedNodes, getTimeSaved);
+
+  /*
+   * Evaluate the savings when we only have the DOALL technique.
+   */
+  auto getTimeSavedWithDOALLOnly =
+      [&getLoopID, &doallLoops, &getTimeSaved](LoopNestingGraphLoopNode *n) {
+        auto loopID = getLoopID(n);
+        if (!loopID || (doallLoops.find(*loopID) == doallLoops.end())
+            || (!doallLoops.at(*loopID))) {
+          return (uint64_t)0;
+        }
+        return getTimeSaved(n);
+      };
+  std::vector<LoopNestingGraphLoopNode *> selectedDOALLNodes;
+  selectLoopsOfForest(roots,
+                      children,
+                      getTimeSavedWithDOALLOnly,
+                      selectedDOALLNodes);
+  maxTimeSavedWithDOALLOnly =
+      removeNestedLoops(selectedDOALLNodes, getTimeSavedWithDOALLOnly);
+
+  /*
+   * Fetch the loops selected, which are already sorted by time saved.
+   */
+  std::vector<LoopDependenceInfo *> selectedLoops;
+  for (auto n : selectedNodes) {
+    auto loopID = getLoopID(n).value();
+    selectedLoops.push_back(candidates.at(loopID));
+    candidates.erase(loopID);
+  }
+
+  /*
+   * Free the memory.
+   */
+  for (auto pair : candidates) {
+    delete pair.second;
+  }
+  delete graph;
+
+  /*
+   * Print the loops selected.
+   */
+  if (verbose != Verbosity::Disabled) {
+    errs() << "Planner: LoopSelector: Start\n";
+    errs() << "Planner: LoopSelector:   Loops selected in the whole program\n";
+    for (auto ldi : selectedLoops) {
+      auto ls = ldi->getLoopStructure();
+      auto loopID = ls->getID().value();
+      auto savedTimeTotal = ((double)timeSavedPerLoop[loopID])
+                            / ((double)profiles->getTotalInstructions());
+      savedTimeTotal *= 100;
+      errs() << "Planner: LoopSelector:    Loop " << loopID << "\n";
+      errs() << "Planner: LoopSelector:      Function: \""
+             << ls->getFunction()->getName() << "\"\n";
+      errs() << "Planner: LoopSelector:      Whole-program savings = "
+             << savedTimeTotal << "%\n";
+      auto bestTechnique = bestTechniques[loopID];
+      errs() << "Planner: LoopSelector:      Best technique: ";
+      if (!bestTechnique) {
+        errs() << "none\n";
+      } else if (bestTechnique.value() == DOALL_ID) {
+        errs() << "DOALL\n";
+      } else if (bestTechnique.value() == HELIX_ID) {
+        errs() << "HELIX\n";
+      } else {
+        errs() << "DSWP\n";
+      }
+      errs() << "Planner: LoopSelector:      Cores = " << bestCores[loopID]
+             << "\n";
+    }
+    errs() << "Planner: LoopSelector: End\n";
+  }
+
+  return selectedLoops;
+}
+
+} // namespace arcana::noelle
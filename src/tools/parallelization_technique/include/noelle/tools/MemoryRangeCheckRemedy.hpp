@@ -0,0 +1,49 @@
+/*
+ * Copyright 2023  Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do
+ so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#pragma once
+
+#include "noelle/core/SystemHeaders.hpp"
+#include "noelle/core/Assumptions.hpp"
+#include "noelle/core/DGEdge.hpp"
+
+namespace arcana::noelle {
+
+/*
+ * A loop-carried memory dependence that has been speculated away.
+ * The memory ranges accessed by its two instructions over the whole loop are
+ * checked to be disjoint at runtime, just before the loop starts.
+ */
+class MemoryRangeCheckRemedy : public Remedy {
+public:
+  MemoryRangeCheckRemedy(DGEdge<Value, Value> *dependence);
+
+  DGEdge<Value, Value> *getDependence(void) const;
+
+  bool compare(const Remedy_ptr rhs) const override;
+
+  StringRef getRemedyName(void) const override;
+
+private:
+  DGEdge<Value, Value> *dependence;
+};
+
+} // namespace arcana::noelle
@@ -49,6 +49,13 @@ public:
 
   BasicBlock *getParLoopExitPoint(void) const;
 
+  /*
+   * Return the condition, computed just before the loop starts, that must hold
+   * to run the parallelized loop.
+   * Return nullptr if the parallelized loop can always run.
+   */
+  Value *getParLoopGuard(void) const;
+
   /*
    * Apply the parallelization technique to the loop LDI.
    */
@@ -63,6 +70,12 @@ public:
 
   virtual uint32_t getMinimumNumberOfIdleCores(void) const = 0;
 
+  /*
+   * Return the number of cores the parallelized loop always uses.
+   * Return 0 if the number of cores can be chosen at runtime.
+   */
+  virtual uint32_t getNumberOfCoresFixedAtCompileTime(void) const;
+
   virtual std::string getName(void) const = 0;
 
   virtual Transformation getParallelizationID(void) const = 0;
@@ -207,6 +220,7 @@ protected:
    * Parallel task related information.
    */
   BasicBlock *entryPointOfParallelizedLoop, *exitPointOfParallelizedLoop;
+  Value *guardOfParallelizedLoop;
   std::vector<Task *> tasks;
   uint32_t numTaskInstances;
   std::map<uint64_t, uint64_t> fromTaskIDToUserID;
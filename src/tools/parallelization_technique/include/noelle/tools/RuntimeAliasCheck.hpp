@@ -0,0 +1,96 @@
+/*
+ * Copyright 2023  Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do
+ so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#pragma once
+
+#include "noelle/core/SystemHeaders.hpp"
+#include "llvm/Analysis/ScalarEvolution.h"
+#include "noelle/core/Noelle.hpp"
+#include "noelle/core/LoopDependenceInfo.hpp"
+#include "noelle/core/SCC.hpp"
+#include "noelle/tools/MemoryRangeCheckRemedy.hpp"
+
+namespace arcana::noelle {
+
+/*
+ * Loop-carried memory dependences of a loop that are speculated not to happen.
+ *
+ * The speculation is checked just before the loop starts: the memory ranges
+ * accessed over the whole loop by the two instructions of every speculated
+ * dependence must be disjoint. The parallelized loop runs only when the check
+ * succeeds; the original loop runs otherwise.
+ */
+class RuntimeAliasCheck {
+public:
+  RuntimeAliasCheck(Noelle &noelle, LoopDependenceInfo *LDI);
+
+  /*
+   * Speculate the loop-carried memory dependences of the SCCs given as input.
+   * The dependences of an SCC are speculated only if all its loop-carried
+   * dependences are memory dependences that can be checked at runtime and none
+   * of them manifested when the loop has been profiled by the dependence
+   * profiler.
+   *
+   * Return the SCCs that still have loop-carried dependences.
+   */
+  std::set<SCC *> speculateSCCs(std::set<SCC *> const &sccs);
+
+  std::set<DGEdge<Value, Value> *> getSpeculatedDependences(void) const;
+
+  /*
+   * Return true if the memory dependences between the two instructions given
+   * as input (in either direction) have been speculated away.
+   */
+  bool isSpeculated(Value *from, Value *to) const;
+
+  /*
+   * Return true if all loop-carried data dependences of the SCC have been
+   * speculated away.
+   */
+  bool isSpeculated(SCC *scc) const;
+
+  /*
+   * Record the speculated dependences through their remedies.
+   */
+  void addRemediesToSpeculatedDependences(void);
+
+  /*
+   * Generate the check at the end of the pre-header of the loop.
+   * Return the value that is true when the speculation holds.
+   */
+  Value *generateCheck(void);
+
+private:
+  Noelle &noelle;
+  LoopDependenceInfo *LDI;
+  std::set<DGEdge<Value, Value> *> speculatedDependences;
+  std::set<std::pair<Value *, Value *>> speculatedPairs;
+  std::set<SCC *> speculatedSCCs;
+
+  bool canBeChecked(DGEdge<Value, Value> *dependence,
+                    ScalarEvolution &SE) const;
+
+  std::pair<const SCEV *, const SCEV *> getRangeOfAccessedMemory(
+      Instruction *memoryAccess,
+      ScalarEvolution &SE) const;
+};
+
+} // namespace arcana::noelle
@@ -32,6 +32,7 @@ ParallelizationTechnique::ParallelizationTechnique(Noelle &n)
     tasks{},
     entryPointOfParallelizedLoop{ nullptr },
     exitPointOfParallelizedLoop{ nullptr },
+    guardOfParallelizedLoop{ nullptr },
     numTaskInstances{ 0 } {
   this->verbose = n.getVerbosity();
 }
@@ -41,6 +42,11 @@ Value *ParallelizationTechnique::getEnvArray(void) const {
   return this->envBuilder->getEnvironmentArray();
 }
 
+uint32_t ParallelizationTechnique::getNumberOfCoresFixedAtCompileTime(
+    void) const {
+  return 0;
+}
+
 uint32_t ParallelizationTechnique::getIndexOfEnvironmentVariable(
     uint32_t id) const {
   assert(this->envBuilder != nullptr);
@@ -255,7 +261,7 @@ BasicBlock *ParallelizationTechnique::
    * Collect reduction operation information needed to accumulate reducable
    * variables after parallelization execution
    */
-  std::unordered_map<uint32_t, BinaryReductionSCC *> reductions;
+  std::unordered_map<uint32_t, ReductionSCC *> reductions;
   std::map<ReductionSCC *, Value *> fromReductionToProducer;
   for (auto envID : environment->getEnvIDsOfLiveOutVars()) {
 
@@ -275,7 +281,7 @@ BasicBlock *ParallelizationTechnique::
     auto producer = environment->getProducer(envID);
     auto producerSCC = loopSCCDAG->sccOfValue(producer);
     auto producerSCCAttributes =
-        cast<BinaryReductionSCC>(sccManager->getSCCAttrs(producerSCC));
+        cast<ReductionSCC>(sccManager->getSCCAttrs(producerSCC));
     assert(producerSCCAttributes != nullptr);
 
     /*
@@ -1818,6 +1824,10 @@ BasicBlock *ParallelizationTechnique::getParLoopExitPoint(void) const {
   return this->exitPointOfParallelizedLoop;
 }
 
+Value *ParallelizationTechnique::getParLoopGuard(void) const {
+  return this->guardOfParallelizedLoop;
+}
+
 ParallelizationTechnique::~ParallelizationTechnique() {
   return;
 }
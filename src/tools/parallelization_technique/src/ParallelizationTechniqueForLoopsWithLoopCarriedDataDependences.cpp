@@ -52,7 +52,7 @@ bool ParallelizationTechniqueForLoopsWithLoopCarriedDataDependences::
    * have normal basic blocks as predecessors; this breaks assumptions done for
    * the parallelization.
    */
-  for (auto i : ls->getInstructions()) {
+  for (auto i : ls->instructions()) {
     if (isa<InvokeInst>(i)) {
       return false;
     }
@@ -0,0 +1,324 @@
+/*
+ * Copyright 2023  Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do
+ so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "llvm/Analysis/ScalarEvolutionExpander.h"
+#include "noelle/core/LoopCarriedSCC.hpp"
+#include "noelle/tools/RuntimeAliasCheck.hpp"
+
+namespace arcana::noelle {
+
+RuntimeAliasCheck::RuntimeAliasCheck(Noelle &noelle, LoopDependenceInfo *LDI)
+  : noelle{ noelle },
+    LDI{ LDI } {
+
+  return;
+}
+
+std::set<SCC *> RuntimeAliasCheck::speculateSCCs(std::set<SCC *> const &sccs) {
+  std::set<SCC *> sccsThatStillBlock;
+
+  /*
+   * Fetch the analyses of the loop.
+   */
+  auto sccManager = this->LDI->getSCCManager();
+  auto domainSpaceAnalysis = this->LDI->getLoopIterationSpaceAnalysis();
+  auto loopFunction = this->LDI->getLoopStructure()->getFunction();
+  auto SE = this->noelle.getScalarEvolution(loopFunction);
+  auto loopStructure = this->LDI->getLoopStructure();
+  auto profiles = this->noelle.getProfiles();
+
+  /*
+   * The loop-carried dependences of an SCC are speculated only if all of them
+   * are memory dependences that can be checked when the loop starts.
+   */
+  for (auto scc : sccs) {
+    auto sccInfo = sccManager->getSCCAttrs(scc);
+    auto loopCarriedSCC = dyn_cast<LoopCarriedSCC>(sccInfo);
+    if (loopCarriedSCC == nullptr) {
+      sccsThatStillBlock.insert(scc);
+      continue;
+    }
+
+    auto canBeSpeculated = true;
+    std::set<DGEdge<Value, Value> *> dependencesOfSCC;
+    for (auto dep : loopCarriedSCC->getLoopCarriedDependences()) {
+
+      /*
+       * Control and register dependences cannot be checked at runtime: the
+       * cycle they belong to would still be there.
+       */
+      if (!dep->isMemoryDependence()) {
+        canBeSpeculated = false;
+        break;
+      }
+
+      /*
+       * Skip dependences that are already known not to happen.
+       */
+      auto fromInst = dyn_cast<Instruction>(dep->getSrc());
+      auto toInst = dyn_cast<Instruction>(dep->getDst());
+      if (fromInst && toInst
+          && domainSpaceAnalysis
+                 ->areInstructionsAccessingDisjointMemoryLocationsBetweenIterations(
+                     fromInst,
+                     toInst)) {
+        continue;
+      }
+
+      /*
+       * Dependences that manifested while profiling the loop would make the
+       * check fail.
+       */
+      if (fromInst && toInst) {
+        auto profile = profiles->getMemoryDependenceProfile(loopStructure,
+                                                            fromInst,
+                                                            toInst);
+        if ((profile != nullptr) && profile->hasManifested()) {
+          canBeSpeculated = false;
+          break;
+        }
+      }
+
+      /*
+       * Check if the current dependence can be checked at runtime.
+       */
+      if (!this->canBeChecked(dep, *SE)) {
+        canBeSpeculated = false;
+        break;
+      }
+      dependencesOfSCC.insert(dep);
+    }
+    if (!canBeSpeculated) {
+      sccsThatStillBlock.insert(scc);
+      continue;
+    }
+
+    /*
+     * All loop-carried data dependences of the SCC can be speculated.
+     */
+    this->speculatedSCCs.insert(scc);
+    for (auto dep : dependencesOfSCC) {
+      this->speculatedDependences.insert(dep);
+      auto from = dep->getSrc();
+      auto to = dep->getDst();
+      this->speculatedPairs.insert(std::make_pair(std::min(from, to),
+                                                  std::max(from, to)));
+    }
+  }
+
+  return sccsThatStillBlock;
+}
+
+std::set<DGEdge<Value, Value> *> RuntimeAliasCheck::getSpeculatedDependences(
+    void) const {
+  return this->speculatedDependences;
+}
+
+bool RuntimeAliasCheck::isSpeculated(Value *from, Value *to) const {
+
+  /*
+   * The instructions of a speculated dependence access disjoint memory ranges
+   * over the whole loop. Hence, there is no memory dependence between them in
+   * either direction.
+   */
+  auto pair = std::make_pair(std::min(from, to), std::max(from, to));
+
+  return this->speculatedPairs.find(pair) != this->speculatedPairs.end();
+}
+
+bool RuntimeAliasCheck::isSpeculated(SCC *scc) const {
+  return this->speculatedSCCs.find(scc) != this->speculatedSCCs.end();
+}
+
+void RuntimeAliasCheck::addRemediesToSpeculatedDependences(void) {
+  for (auto dep : this->speculatedDependences) {
+    auto remedies = std::make_shared<Remedies>();
+    remedies->insert(std::make_shared<MemoryRangeCheckRemedy>(dep));
+    dep->addRemedies(remedies);
+  }
+
+  return;
+}
+
+bool RuntimeAliasCheck::canBeChecked(DGEdge<Value, Value> *dependence,
+                                     ScalarEvolution &SE) const {
+
+  /*
+   * Only memory dependences can be checked.
+   */
+  if (!dependence->isMemoryDependence()) {
+    return false;
+  }
+
+  /*
+   * The dependence must be between two different instructions.
+   * This is because the check compares the memory ranges accessed by them.
+   */
+  auto fromInst = dyn_cast<Instruction>(dependence->getSrc());
+  auto toInst = dyn_cast<Instruction>(dependence->getDst());
+  if ((fromInst == nullptr) || (toInst == nullptr) || (fromInst == toInst)) {
+    return false;
+  }
+
+  /*
+   * The memory ranges accessed by both instructions must be computable when
+   * the loop starts.
+   */
+  auto fromRange = this->getRangeOfAccessedMemory(fromInst, SE);
+  if (fromRange.first == nullptr) {
+    return false;
+  }
+  auto toRange = this->getRangeOfAccessedMemory(toInst, SE);
+  if (toRange.first == nullptr) {
+    return false;
+  }
+
+  return true;
+}
+
+std::pair<const SCEV *, const SCEV *> RuntimeAliasCheck::
+    getRangeOfAccessedMemory(Instruction *memoryAccess,
+                             ScalarEvolution &SE) const {
+  std::pair<const SCEV *, const SCEV *> unknownRange{ nullptr, nullptr };
+
+  /*
+   * Fetch the pointer and the type of the memory accessed.
+   */
+  Value *pointer = nullptr;
+  Type *accessedType = nullptr;
+  if (auto load = dyn_cast<LoadInst>(memoryAccess)) {
+    pointer = load->getPointerOperand();
+    accessedType = load->getType();
+  } else if (auto store = dyn_cast<StoreInst>(memoryAccess)) {
+    pointer = store->getPointerOperand();
+    accessedType = store->getValueOperand()->getType();
+  } else {
+    return unknownRange;
+  }
+  auto &DL = memoryAccess->getModule()->getDataLayout();
+  auto accessedBytes = DL.getTypeStoreSize(accessedType);
+
+  /*
+   * Compute the first and the last address accessed by the loop.
+   */
+  auto loopStructure = this->LDI->getLoopStructure();
+  auto pointerSCEV = SE.getSCEV(pointer);
+  auto firstAddress = pointerSCEV;
+  auto lastAddress = pointerSCEV;
+  auto addRec = dyn_cast<SCEVAddRecExpr>(pointerSCEV);
+  if ((addRec != nullptr)
+      && (addRec->getLoop()->getHeader() == loopStructure->getHeader())) {
+
+    /*
+     * The address evolves linearly with the loop iterations.
+     */
+    if ((!addRec->isAffine()) || (!addRec->hasNoSelfWrap())) {
+      return unknownRange;
+    }
+    auto backedgeTakenCount = SE.getBackedgeTakenCount(addRec->getLoop());
+    if (isa<SCEVCouldNotCompute>(backedgeTakenCount)) {
+      return unknownRange;
+    }
+    firstAddress = addRec->getStart();
+    lastAddress = addRec->evaluateAtIteration(backedgeTakenCount, SE);
+  }
+
+  /*
+   * Compute the range [low, high) of the addresses accessed.
+   */
+  auto low = SE.getUMinExpr(firstAddress, lastAddress);
+  auto accessedBytesSCEV =
+      SE.getConstant(SE.getEffectiveSCEVType(pointerSCEV->getType()),
+                     accessedBytes);
+  auto high = SE.getAddExpr(SE.getUMaxExpr(firstAddress, lastAddress),
+                            accessedBytesSCEV);
+
+  /*
+   * The range must be computable in the pre-header of the loop.
+   * This also guarantees the addresses of a loop-invariant pointer do not
+   * change across iterations.
+   */
+  auto preHeaderTerminator = loopStructure->getPreHeader()->getTerminator();
+  if ((!isSafeToExpandAt(low, preHeaderTerminator, SE))
+      || (!isSafeToExpandAt(high, preHeaderTerminator, SE))) {
+    return unknownRange;
+  }
+
+  return std::make_pair(low, high);
+}
+
+Value *RuntimeAliasCheck::generateCheck(void) {
+
+  /*
+   * The check is computed in the pre-header of the loop.
+   */
+  auto loopStructure = this->LDI->getLoopStructure();
+  auto loopFunction = loopStructure->getFunction();
+  auto preHeaderTerminator = loopStructure->getPreHeader()->getTerminator();
+  auto &DL = loopFunction->getParent()->getDataLayout();
+  auto SE = this->noelle.getScalarEvolution(loopFunction);
+  SCEVExpander expander(*SE, DL, "alias.check");
+  IRBuilder<> checkBuilder(preHeaderTerminator);
+
+  /*
+   * Fetch the types we need.
+   */
+  auto tm = this->noelle.getTypesManager();
+  auto int64 = tm->getIntegerType(64);
+
+  /*
+   * Define the code that computes the memory range accessed by an instruction.
+   */
+  std::unordered_map<Instruction *, std::pair<Value *, Value *>> ranges;
+  auto computeRange =
+      [&](Instruction *memoryAccess) -> std::pair<Value *, Value *> {
+    if (ranges.find(memoryAccess) != ranges.end()) {
+      return ranges.at(memoryAccess);
+    }
+    auto range = this->getRangeOfAccessedMemory(memoryAccess, *SE);
+    assert(range.first != nullptr);
+    auto low = expander.expandCodeFor(range.first, int64, preHeaderTerminator);
+    auto high =
+        expander.expandCodeFor(range.second, int64, preHeaderTerminator);
+    ranges[memoryAccess] = std::make_pair(low, high);
+    return ranges.at(memoryAccess);
+  };
+
+  /*
+   * The speculation holds if the instructions of every speculated dependence
+   * access disjoint memory ranges.
+   */
+  Value *speculationHolds = checkBuilder.getTrue();
+  for (auto dep : this->speculatedDependences) {
+    auto fromRange = computeRange(cast<Instruction>(dep->getSrc()));
+    auto toRange = computeRange(cast<Instruction>(dep->getDst()));
+    auto fromIsBefore = checkBuilder.CreateICmpULE(fromRange.second,
+                                                   toRange.first);
+    auto toIsBefore = checkBuilder.CreateICmpULE(toRange.second,
+                                                 fromRange.first);
+    auto areDisjoint = checkBuilder.CreateOr(fromIsBefore, toIsBefore);
+    speculationHolds = checkBuilder.CreateAnd(speculationHolds, areDisjoint);
+  }
+
+  return speculationHolds;
+}
+
+} // namespace arcana::noelle
@@ -56,6 +56,12 @@ private:
    */
   bool forceParallelization;
   bool forceNoSCCPartition;
+  uint32_t dswpStageReplicas;
+  uint32_t helixIterationBlockSize;
+  bool doallSpeculation;
+  bool helixSpeculation;
+  bool doallTuning;
+  bool multiVersioning;
   std::vector<int> loopIndexesWhiteList;
   std::vector<int> loopIndexesBlackList;
 
@@ -64,8 +70,30 @@ private:
    */
   bool parallelizeLoop(LoopDependenceInfo *LDI, Noelle &par, Heuristics *h);
 
+  bool parallelizeLoopInMultipleVersions(
+      LoopDependenceInfo *LDI,
+      Noelle &par,
+      Heuristics *h,
+      std::vector<ParallelizationTechnique *> const &parallelizationTechniques);
+
   bool parallelizeLoops(Noelle &noelle, Heuristics *heuristics);
 
+  bool parallelizeLoopsOfFunction(
+      Noelle &noelle,
+      Heuristics *heuristics,
+      std::vector<std::pair<uint32_t, LoopStructure *>> const &loops,
+      std::map<uint32_t, CodeGrowthRequest> const &codeGrowthGrants);
+
+  /*
+   * Return the number of times the body of @loop is cloned by its
+   * parallelization, which depends on the techniques enabled for it.
+   * Without @ltm, only the techniques enabled for the whole program are
+   * considered.
+   */
+  uint64_t getNumberOfCopiesOfLoop(Noelle &noelle,
+                                   LoopStructure *loop,
+                                   LoopTransformationsManager *ltm);
+
   std::vector<LoopDependenceInfo *> getLoopsToParallelize(Module &M,
                                                           Noelle &par);
 
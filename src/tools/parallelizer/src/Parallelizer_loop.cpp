@@ -37,9 +37,17 @@ bool Parallelizer::parallelizeLoop(LoopDependenceInfo *LDI,
   /*
    * Allocate the parallelization techniques.
    */
-  DSWP dswp{ par, this->forceParallelization, !this->forceNoSCCPartition };
-  DOALL doall{ par };
-  HELIX helix{ par, this->forceParallelization };
+  DSWP dswp{ par,
+             this->forceParallelization,
+             !this->forceNoSCCPartition,
+             this->dswpStageReplicas };
+  DOALL doall{ par,
+               this->doallSpeculation,
+               this->multiVersioning || this->doallTuning };
+  HELIX helix{ par,
+               this->forceParallelization,
+               this->helixSpeculation,
+               this->multiVersioning };
   std::vector<ParallelizationTechnique *> parallelizationTechniques{ &doall,
                                                                      &helix,
                                                                      &dswp };
@@ -120,6 +128,27 @@ bool Parallelizer::parallelizeLoop(LoopDependenceInfo *LDI,
     }
   }
 
+  /*
+   * Fix the number of consecutive iterations executed by a HELIX core if it
+   * has been requested and the configuration of the loop did not fix it.
+   */
+  if (this->helixIterationBlockSize > 0) {
+    auto ltm = LDI->getLoopTransformationsManager();
+    if (ltm->getIterationBlockSize() == 0) {
+      ltm->setIterationBlockSize(this->helixIterationBlockSize);
+    }
+  }
+
+  /*
+   * Check if we need to generate all parallel versions of the loop.
+   */
+  if (this->multiVersioning && loopStructure->getID()) {
+    return this->parallelizeLoopInMultipleVersions(LDI,
+                                                   par,
+                                                   h,
+                                                   parallelizationTechniques);
+  }
+
   /*
    * Parallelize the loop.
    */
@@ -198,7 +227,8 @@ bool Parallelizer::parallelizeLoop(LoopDependenceInfo *LDI,
       envArray,
       exitIndex,
       loopExitBlocks,
-      usedTechnique->getMinimumNumberOfIdleCores());
+      usedTechnique->getMinimumNumberOfIdleCores(),
+      usedTechnique->getParLoopGuard());
   assert(par.verifyCode());
 
   // if (verbose >= Verbosity::Maximal) {
@@ -79,9 +79,9 @@ bool Parallelizer::parallelizeLoops(Noelle &noelle, Heuristics *heuristics) {
    * Determine the parallelization order from the metadata.
    */
   auto mm = noelle.getMetadataManager();
-  std::map<uint32_t, LoopDependenceInfo *> loopParallelizationOrder;
+  std::map<uint32_t, LoopStructure *> loopParallelizationOrder;
   for (auto tree : forest->getTrees()) {
-    auto selector = [&noelle, &mm, &loopParallelizationOrder, &isSelected](
+    auto selector = [&mm, &loopParallelizationOrder, &isSelected](
                         LoopTree *n,
                         uint32_t treeLevel) -> bool {
       auto ls = n->getLoop();
@@ -93,12 +93,7 @@ bool Parallelizer::parallelizeLoops(Noelle &noelle, Heuristics *heuristics) {
       if (!isSelected(parallelizationOrderIndex)) {
         return false;
       }
-      auto optimizations = {
-        LoopDependenceInfoOptimization::MEMORY_CLONING_ID,
-        LoopDependenceInfoOptimization::THREAD_SAFE_LIBRARY_ID
-      };
-      auto ldi = noelle.getLoop(ls, optimizations);
-      loopParallelizationOrder[parallelizationOrderIndex] = ldi;
+      loopParallelizationOrder[parallelizationOrderIndex] = ls;
       return false;
     };
     tree->visitPreOrder(selector);
@@ -110,21 +105,159 @@ bool Parallelizer::parallelizeLoops(Noelle &noelle, Heuristics *heuristics) {
   errs() << "\n";
 
   /*
-   * Parallelize the loops in order.
+   * Check if the code added by the parallelizations fits in the code size
+   * budget.
+   *
+   * The body of a loop is cloned into the tasks of its parallelization (once
+   * per technique when loops are multi-versioned). The loops kept are the ones
+   * with the most dynamic instructions per instruction added.
+   *
+   * The techniques enabled for a single loop are known only once its
+   * abstractions are computed. Hence, loops are charged for the techniques
+   * enabled for the program, and what they do not use is given back to the
+   * budget after their parallelization.
+   */
+  auto budget = noelle.getCodeSizeBudget();
+  std::map<uint32_t, CodeGrowthRequest> codeGrowthGrants;
+  if (budget != nullptr) {
+    std::vector<CodeGrowthRequest> requests;
+    std::vector<uint32_t> indexes;
+    for (const auto &[index, ls] : loopParallelizationOrder) {
+      std::string target{ ls->getFunction()->getName().str() };
+      auto loopID = ls->getID();
+      if (loopID) {
+        target.append(":loop " + std::to_string(loopID.value()));
+      }
+      auto copies = this->getNumberOfCopiesOfLoop(noelle, ls, nullptr);
+      requests.push_back(
+          CodeGrowthRequest{ "Parallelization",
+                             target,
+                             CodeSizeBudget::getCodeSize(*ls) * copies,
+                             budget->getExpectedBenefit(ls, 1.0) });
+      indexes.push_back(index);
+    }
+    auto granted = budget->requestCodeGrowth(requests);
+    for (auto i = 0u; i < indexes.size(); i++) {
+      if (granted[i]) {
+        codeGrowthGrants.insert({ indexes[i], requests[i] });
+        continue;
+      }
+      errs() << "Parallelizer:    Loop with index " << indexes[i]
+             << " does not fit in the code size budget\n";
+      loopParallelizationOrder.erase(indexes[i]);
+    }
+  }
+
+  /*
+   * Group the loops by function.
+   *
+   * Loops of different functions cannot interfere with each other, so each
+   * function is handled as an independent unit: its loop abstractions are
+   * computed only when the function is about to be transformed, and they are
+   * freed as soon as the function is done. The relative order of loops within
+   * a function is preserved.
+   *
+   * Functions are processed one at a time rather than concurrently: all
+   * transformations create types, constants, and metadata in the LLVMContext of
+   * the module, which is not thread-safe, and they all update the same PDG.
+   */
+  std::vector<Function *> functionsOrder;
+  std::unordered_map<Function *,
+                     std::vector<std::pair<uint32_t, LoopStructure *>>>
+      loopsByFunction;
+  for (auto indexLoopPair : loopParallelizationOrder) {
+    auto ls = indexLoopPair.second;
+    auto f = ls->getFunction();
+    if (loopsByFunction.find(f) == loopsByFunction.end()) {
+      functionsOrder.push_back(f);
+    }
+    loopsByFunction[f].push_back(indexLoopPair);
+  }
+
+  /*
+   * Parallelize the loops one function at a time.
    */
   auto modified = false;
-  std::unordered_map<BasicBlock *, bool> modifiedBBs{};
   std::unordered_set<Function *> modifiedFunctions;
-  for (auto indexLoopPair : loopParallelizationOrder) {
-    auto ldi = indexLoopPair.second;
+  for (auto f : functionsOrder) {
+    if (this->parallelizeLoopsOfFunction(noelle,
+                                         heuristics,
+                                         loopsByFunction.at(f),
+                                         codeGrowthGrants)) {
+      modified = true;
+      modifiedFunctions.insert(f);
+    }
+  }
+
+  /*
+   * Erase calls to intrinsics in modified functions
+   */
+  std::unordered_set<CallInst *> intrinsicCallsToRemove;
+  for (auto F : modifiedFunctions) {
+    for (auto &I : *F) {
+      if (auto callInst = dyn_cast<CallInst>(&I)) {
+        if (callInst->isLifetimeStartOrEnd()) {
+          intrinsicCallsToRemove.insert(callInst);
+        }
+      }
+    }
+  }
+  for (auto call : intrinsicCallsToRemove) {
+    call->eraseFromParent();
+  }
+
+  errs() << "Parallelizer: Exit\n";
+  return modified;
+}
+
+bool Parallelizer::parallelizeLoopsOfFunction(
+    Noelle &noelle,
+    Heuristics *heuristics,
+    std::vector<std::pair<uint32_t, LoopStructure *>> const &loops,
+    std::map<uint32_t, CodeGrowthRequest> const &codeGrowthGrants) {
+  std::unordered_set<LoopDependenceInfoOptimization> optimizations = {
+    LoopDependenceInfoOptimization::MEMORY_CLONING_ID,
+    LoopDependenceInfoOptimization::THREAD_SAFE_LIBRARY_ID
+  };
+
+  /*
+   * Give back to the code size budget what has been granted to a loop but not
+   * added to the program.
+   */
+  auto budget = noelle.getCodeSizeBudget();
+  auto releaseUnusedCodeGrowth = [budget, &codeGrowthGrants](
+                                     uint32_t index,
+                                     uint64_t codeSizeAdded) {
+    auto it = codeGrowthGrants.find(index);
+    if ((budget == nullptr) || (it == codeGrowthGrants.end())) {
+      return;
+    }
+    auto &request = it->second;
+    if (request.codeSize > codeSizeAdded) {
+      budget->releaseCodeGrowth(request, request.codeSize - codeSizeAdded);
+    }
+  };
+
+  /*
+   * Parallelize the loops in order.
+   *
+   * The PDG is kept up to date while loops get parallelized, so the
+   * abstractions of a loop computed after the parallelization of another one
+   * of the same function reflect the code transformed.
+   */
+  auto pdg = noelle.getProgramDependenceGraph();
+  auto modified = false;
+  std::unordered_set<BasicBlock *> modifiedBBs{};
+  for (auto indexLoopPair : loops) {
+    auto ls = indexLoopPair.second;
+    auto loopFunction = ls->getFunction();
 
     /*
      * Check if we can parallelize this loop.
      */
-    auto ls = ldi->getLoopStructure();
     auto safe = true;
-    for (auto bb : ls->getBasicBlocks()) {
-      if (modifiedBBs[bb]) {
+    for (auto bb : ls->blocks()) {
+      if (modifiedBBs.find(bb) != modifiedBBs.end()) {
         safe = false;
         break;
       }
@@ -146,13 +279,77 @@ bool Parallelizer::parallelizeLoops(Noelle &noelle, Heuristics *heuristics) {
       }
       errs()
           << " cannot be parallelized because one of its parent has been parallelized already\n";
+      releaseUnusedCodeGrowth(indexLoopPair.first, 0);
       continue;
     }
 
+    /*
+     * Check if the function of the loop has been modified by the
+     * parallelization of another loop.
+     * In this case, the loop structure needs to be computed again.
+     */
+    LoopStructure *recomputedLS = nullptr;
+    if (modified) {
+      auto header = ls->getHeader();
+      auto newLS = noelle.getLoopStructures(loopFunction);
+      for (auto candidate : *newLS) {
+        if ((recomputedLS == nullptr) && (candidate->getHeader() == header)) {
+          recomputedLS = candidate;
+          continue;
+        }
+        delete candidate;
+      }
+      delete newLS;
+
+      /*
+       * Check if the loop still exists.
+       * If it does not, its old abstractions refer to code that has been
+       * transformed, so the loop must be skipped.
+       */
+      if (recomputedLS == nullptr) {
+        errs() << "Parallelizer:    Loop ";
+        if (loopIDOpt) {
+          auto loopID = loopIDOpt.value();
+          errs() << loopID;
+        }
+        errs()
+            << " cannot be parallelized because it cannot be found after the parallelization of another loop of its function\n";
+        releaseUnusedCodeGrowth(indexLoopPair.first, 0);
+        continue;
+      }
+      ls = recomputedLS;
+    }
+
+    /*
+     * Compute the abstractions of the loop.
+     */
+    auto ldi = noelle.getLoop(ls, optimizations);
+
     /*
      * Parallelize the current loop.
      */
+    auto loopCodeSize = CodeSizeBudget::getCodeSize(*ls);
+    pdg->trackChangesOf(*loopFunction);
     auto loopIsParallelized = this->parallelizeLoop(ldi, noelle, heuristics);
+    pdg->updateChangesOf(*loopFunction);
+    noelle.getProfiles()->invalidateCodeNumbering();
+
+    /*
+     * Charge the code size budget only for the copies of the loop that have
+     * been added.
+     */
+    uint64_t codeSizeAdded = 0;
+    if (loopIsParallelized) {
+      auto ltm = ldi->getLoopTransformationsManager();
+      codeSizeAdded =
+          loopCodeSize * this->getNumberOfCopiesOfLoop(noelle, ls, ltm);
+    }
+    releaseUnusedCodeGrowth(indexLoopPair.first, codeSizeAdded);
+
+    /*
+     * Free the memory.
+     */
+    delete ldi;
 
     /*
      * Keep track of the parallelization.
@@ -166,39 +363,47 @@ bool Parallelizer::parallelizeLoops(Noelle &noelle, Heuristics *heuristics) {
       errs()
           << "Parallelizer:      Keep track of basic blocks being modified by the parallelization\n";
       modified = true;
-      for (auto bb : ls->getBasicBlocks()) {
-        modifiedBBs[bb] = true;
+      for (auto bb : ls->blocks()) {
+        modifiedBBs.insert(bb);
       }
-      modifiedFunctions.insert(ls->getFunction());
     }
+
+    /*
+     * Free the loop structure computed again.
+     */
+    delete recomputedLS;
   }
 
+  return modified;
+}
+
+uint64_t Parallelizer::getNumberOfCopiesOfLoop(
+    Noelle &noelle,
+    LoopStructure *loop,
+    LoopTransformationsManager *ltm) {
+
   /*
-   * Free the memory.
+   * Count the parallelization techniques enabled for the loop.
    */
-  for (auto indexLoopPair : loopParallelizationOrder) {
-    delete indexLoopPair.second;
+  uint64_t techniques = 0;
+  for (auto parID : { DOALL_ID, HELIX_ID, DSWP_ID }) {
+    if (!noelle.isTransformationEnabled(parID)) {
+      continue;
+    }
+    if ((ltm != nullptr) && (!ltm->isTransformationEnabled(parID))) {
+      continue;
+    }
+    techniques++;
   }
 
   /*
-   * Erase calls to intrinsics in modified functions
+   * Only multi-versioned loops get a copy per technique.
    */
-  std::unordered_set<CallInst *> intrinsicCallsToRemove;
-  for (auto F : modifiedFunctions) {
-    for (auto &I : *F) {
-      if (auto callInst = dyn_cast<CallInst>(&I)) {
-        if (callInst->isLifetimeStartOrEnd()) {
-          intrinsicCallsToRemove.insert(callInst);
-        }
-      }
-    }
-  }
-  for (auto call : intrinsicCallsToRemove) {
-    call->eraseFromParent();
+  if (this->multiVersioning && loop->getID()) {
+    return techniques;
   }
 
-  errs() << "Parallelizer: Exit\n";
-  return modified;
+  return std::min<uint64_t>(techniques, 1);
 }
 
 } // namespace arcana::noelle
@@ -0,0 +1,155 @@
+/*
+ * Copyright 2023  Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do
+ so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "Parallelizer.hpp"
+
+namespace arcana::noelle {
+
+bool Parallelizer::parallelizeLoopInMultipleVersions(
+    LoopDependenceInfo *LDI,
+    Noelle &par,
+    Heuristics *h,
+    std::vector<ParallelizationTechnique *> const &parallelizationTechniques) {
+  auto prefix = "Parallelizer: parallelizerLoop: ";
+
+  /*
+   * Fetch the managers.
+   */
+  auto cm = par.getConstantsManager();
+
+  /*
+   * Fetch the verbosity level.
+   */
+  auto verbose = par.getVerbosity();
+
+  /*
+   * Fetch the loop information.
+   */
+  auto loopStructure = LDI->getLoopStructure();
+  auto loopPreHeader = loopStructure->getPreHeader();
+  auto loopIDOpt = loopStructure->getID();
+  assert(loopIDOpt);
+  auto loopID = loopIDOpt.value();
+
+  /*
+   * Generate a version of the loop for every parallelization technique that
+   * can be applied to it.
+   *
+   * Every technique clones the original loop into its own tasks, so the
+   * original loop is left untouched and it can be parallelized again by the
+   * next technique.
+   */
+  auto ltm = LDI->getLoopTransformationsManager();
+  auto exitBlockID = LDI->getEnvironment()->getExitBlockID();
+  std::vector<TransformedLoopVersion> versions;
+  for (auto parallelizationTechnique : parallelizationTechniques) {
+
+    /*
+     * Check if the current parallelization technique is applicable to the
+     * current loop.
+     */
+    auto parID = parallelizationTechnique->getParallelizationID();
+    if (!par.isTransformationEnabled(parID)
+        || !ltm->isTransformationEnabled(parID)
+        || !parallelizationTechnique->canBeAppliedToLoop(LDI, h)) {
+      continue;
+    }
+
+    /*
+     * Generate the new version.
+     */
+    if (!parallelizationTechnique->apply(LDI, h)) {
+      continue;
+    }
+
+    /*
+     * Keep track of the new version.
+     * The ID of a version is the ID of the parallelization technique plus one
+     * as 0 is the original loop.
+     * This must match the IDs used by the runtime.
+     */
+    TransformedLoopVersion version;
+    version.versionID = static_cast<uint32_t>(parID) + 1;
+    version.startOfParLoopInOriginalFunc =
+        parallelizationTechnique->getParLoopEntryPoint();
+    version.endOfParLoopInOriginalFunc =
+        parallelizationTechnique->getParLoopExitPoint();
+    version.envArray = parallelizationTechnique->getEnvArray();
+    auto constantValue =
+        exitBlockID >= 0
+            ? parallelizationTechnique->getIndexOfEnvironmentVariable(
+                exitBlockID)
+            : -1;
+    version.envIndexForExitVariable = cm->getIntegerConstant(constantValue, 64);
+    version.minIdleCores =
+        parallelizationTechnique->getMinimumNumberOfIdleCores();
+    version.fixedCores =
+        parallelizationTechnique->getNumberOfCoresFixedAtCompileTime();
+    version.guard = parallelizationTechnique->getParLoopGuard();
+    assert(version.startOfParLoopInOriginalFunc != nullptr);
+    assert(version.endOfParLoopInOriginalFunc != nullptr);
+    assert(version.envArray != nullptr);
+    versions.push_back(version);
+
+    if (verbose != Verbosity::Disabled) {
+      errs() << prefix << "  Version " << version.versionID
+             << " has been generated with "
+             << parallelizationTechnique->getName() << "\n";
+    }
+  }
+
+  /*
+   * Check if the loop has been parallelized.
+   */
+  if (versions.size() == 0) {
+    errs() << prefix << "  The loop has not been parallelized\n";
+    errs() << prefix << "Exit\n";
+    return false;
+  }
+
+  /*
+   * Link all versions within the original function.
+   * The version used when the loop is not configured at runtime is the one
+   * that would have been generated without multi-versioning.
+   */
+  if (verbose != Verbosity::Disabled) {
+    errs() << prefix << "  Link the " << versions.size()
+           << " versions of the loop\n";
+  }
+  auto loopExitBlocks = loopStructure->getLoopExitBasicBlocks();
+  auto linker = par.getLinker();
+  linker->linkTransformedLoopVersionsToOriginalFunction(loopPreHeader,
+                                                        loopID,
+                                                        versions[0].versionID,
+                                                        versions,
+                                                        loopExitBlocks);
+  assert(par.verifyCode());
+
+  if (verbose != Verbosity::Disabled) {
+    errs() << prefix << "  The loop has been parallelized in "
+           << versions.size() << " versions\n";
+    errs() << prefix << "Exit\n";
+  }
+
+  return true;
+}
+
+} // namespace arcana::noelle
@@ -36,6 +36,53 @@ static cl::opt<bool> ForceNoSCCPartition(
     cl::ZeroOrMore,
     cl::Hidden,
     cl::desc("Force no SCC merging when parallelizing"));
+static cl::opt<uint32_t> DSWPStageReplicas(
+    "dswp-stage-replicas",
+    cl::ZeroOrMore,
+    cl::Hidden,
+    cl::desc(
+        "Number of replicas of the DSWP stages whose iterations are independent"));
+static cl::opt<uint32_t> HELIXIterationBlockSize(
+    "helix-iteration-block-size",
+    cl::ZeroOrMore,
+    cl::Hidden,
+    cl::desc(
+        "Number of consecutive iterations a HELIX core executes between synchronizations (unless INDEX_FILE fixes it)"));
+static cl::opt<bool> DOALLSpeculation(
+    "noelle-doall-speculate",
+    cl::ZeroOrMore,
+    cl::Hidden,
+    cl::desc(
+        "Speculate loop-carried memory dependences that block DOALL and check them when loops start"));
+static cl::opt<bool> HELIXSpeculation(
+    "noelle-helix-speculate",
+    cl::ZeroOrMore,
+    cl::Hidden,
+    cl::desc(
+        "Speculate loop-carried memory dependences that require HELIX sequential segments and check them when loops start"));
+static cl::opt<bool> DOALLTuning(
+    "noelle-doall-tuning",
+    cl::ZeroOrMore,
+    cl::Hidden,
+    cl::desc(
+        "Let the runtime set the chunk size and the cores of DOALL loops from INDEX_FILE or by tuning them online (NOELLE_DOALL_TUNING)"));
+static cl::opt<bool> MultiVersioning(
+    "noelle-parallelizer-multiversion",
+    cl::ZeroOrMore,
+    cl::Hidden,
+    cl::desc(
+        "Generate a version of each loop per parallelization technique and select the one to run at runtime"));
+
+/*
+ * Options of the Planner pass that the parallelizer only needs to accept.
+ * They are forwarded to both passes by noelle-parallelizer.
+ */
+static cl::opt<bool> WholeProgramSelectionParallelizer(
+    "noelle-parallelizer-whole-program",
+    cl::ZeroOrMore,
+    cl::Hidden,
+    cl::desc(
+        "Select the loops to parallelize across the whole program, including the loops nested through calls"));
 static cl::list<int> LoopIndexesWhiteList(
     "noelle-loops-white-list",
     cl::ZeroOrMore,
@@ -50,7 +97,13 @@ static cl::list<int> LoopIndexesBlackList(
 Parallelizer::Parallelizer()
   : ModulePass{ ID },
     forceParallelization{ false },
-    forceNoSCCPartition{ false } {
+    forceNoSCCPartition{ false },
+    dswpStageReplicas{ 1 },
+    helixIterationBlockSize{ 0 },
+    doallSpeculation{ false },
+    helixSpeculation{ false },
+    doallTuning{ false },
+    multiVersioning{ false } {
 
   return;
 }
@@ -58,6 +111,16 @@ Parallelizer::Parallelizer()
 bool Parallelizer::doInitialization(Module &M) {
   this->forceParallelization = (ForceParallelization.getNumOccurrences() > 0);
   this->forceNoSCCPartition = (ForceNoSCCPartition.getNumOccurrences() > 0);
+  if (DSWPStageReplicas.getNumOccurrences() > 0) {
+    this->dswpStageReplicas = DSWPStageReplicas.getValue();
+  }
+  if (HELIXIterationBlockSize.getNumOccurrences() > 0) {
+    this->helixIterationBlockSize = HELIXIterationBlockSize.getValue();
+  }
+  this->doallSpeculation = (DOALLSpeculation.getNumOccurrences() > 0);
+  this->helixSpeculation = (HELIXSpeculation.getNumOccurrences() > 0);
+  this->doallTuning = (DOALLTuning.getNumOccurrences() > 0);
+  this->multiVersioning = (MultiVersioning.getNumOccurrences() > 0);
   this->loopIndexesWhiteList = LoopIndexesWhiteList;
   this->loopIndexesBlackList = LoopIndexesBlackList;
 
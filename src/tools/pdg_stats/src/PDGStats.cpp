@@ -157,7 +157,7 @@ void PDGStats::collectStatsForPotentialEdges(
                       &totStores,
                       &totCalls](LoopTree *n, uint32_t level) -> bool {
         auto currentLoop = n->getLoop();
-        for (auto inst : currentLoop->getInstructions()) {
+        for (auto inst : currentLoop->instructions()) {
           if (isa<LoadInst>(inst)) {
             totLoads++;
             continue;
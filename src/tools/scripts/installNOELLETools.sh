@@ -37,6 +37,8 @@ patchInstallDir "noelle-io" ;
 patchInstallDir "noelle-fixedpoint" ;
 patchInstallDir "noelle-pdg-stats" ;
 patchInstallDir "noelle-loop-stats" ;
+patchInstallDir "noelle-dep-prof" ;
+patchInstallDir "noelle-calibrate" ;
 patchInstallDir "noelle-parallelization-planner" ;
 patchInstallDir "noelle-parallelizer-loop" ;
 patchInstallDir "noelle-parallelizer-loop-subset" ;
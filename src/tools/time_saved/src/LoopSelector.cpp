@@ -27,6 +27,7 @@ namespace arcana::noelle {
 std::vector<LoopDependenceInfo *> TimeSaved::selectTheOrderOfLoopsToParallelize(
     Noelle &noelle,
     Hot *profiles,
+    Heuristics *heuristics,
     noelle::LoopTree *tree,
     uint64_t &maxTimeSaved,
     uint64_t &maxTimeSavedWithDOALLOnly) {
@@ -48,6 +49,7 @@ std::vector<LoopDependenceInfo *> TimeSaved::selectTheOrderOfLoopsToParallelize(
                    &timeSavedLoops,
                    &timeSavedPerLoop,
                    profiles,
+                   heuristics,
                    &doallLoops](LoopTree *n, uint32_t treeLevel) -> bool {
     /*
      * Fetch the loop.
@@ -62,7 +64,7 @@ std::vector<LoopDependenceInfo *> TimeSaved::selectTheOrderOfLoopsToParallelize(
     /*
      * Compute the timing model for this loop.
      */
-    auto loopTimeModel = new LoopTimingModel(noelle, *ldi);
+    auto loopTimeModel = new LoopTimingModel(noelle, *ldi, *heuristics);
 
     /*
      * Tag DOALL loops.
@@ -84,6 +86,11 @@ std::vector<LoopDependenceInfo *> TimeSaved::selectTheOrderOfLoopsToParallelize(
     timeSavedLoops[ldi] = (uint64_t)timeSaved;
     timeSavedPerLoop[ls] = (uint64_t)timeSaved;
 
+    /*
+     * Free the memory.
+     */
+    delete loopTimeModel;
+
     return false;
   };
   tree->visitPreOrder(selector);
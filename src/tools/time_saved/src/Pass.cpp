@@ -68,6 +68,12 @@ bool TimeSaved::runOnModule(Module &M) {
   errs() << "TimeSaved:    There are " << forest->getNumberOfLoops()
          << " loops in the program we are going to consider\n";
 
+  /*
+   * Fetch the heuristics, which include the costs of the machine used by the
+   * timing model of the loops.
+   */
+  auto heuristics = getAnalysis<HeuristicsPass>().getHeuristics(noelle);
+
   /*
    * Collect metrics for time saved by parallelizing.
    */
@@ -83,6 +89,7 @@ bool TimeSaved::runOnModule(Module &M) {
     auto loopsToParallelize =
         this->selectTheOrderOfLoopsToParallelize(noelle,
                                                  profiles,
+                                                 heuristics,
                                                  tree,
                                                  maxTimeSaved,
                                                  maxTimeSavedWithDOALLOnly);
@@ -96,6 +103,7 @@ bool TimeSaved::runOnModule(Module &M) {
       delete loop;
     }
   }
+  delete heuristics;
 
   /*
    * Print statistics.
@@ -130,6 +138,7 @@ void TimeSaved::getAnalysisUsage(AnalysisUsage &AU) const {
    * Noelle.
    */
   AU.addRequired<Noelle>();
+  AU.addRequired<HeuristicsPass>();
 
   return;
 }
@@ -48,6 +48,7 @@
 #include "noelle/core/Noelle.hpp"
 #include "noelle/core/MetadataManager.hpp"
 #include "noelle/tools/DOALL.hpp"
+#include "noelle/tools/HeuristicsPass.hpp"
 
 namespace arcana::noelle {
 
@@ -79,6 +80,7 @@ private:
   std::vector<LoopDependenceInfo *> selectTheOrderOfLoopsToParallelize(
       Noelle &noelle,
       Hot *profiles,
+      Heuristics *heuristics,
       noelle::LoopTree *tree,
       uint64_t &maxTimeSaved,
       uint64_t &maxTimeSavedWithDOALLOnly);
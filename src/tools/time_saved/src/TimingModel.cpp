@@ -24,18 +24,21 @@
 
 namespace arcana::noelle {
 
-LoopTimingModel::LoopTimingModel(Noelle &noelle, LoopDependenceInfo &ldi)
+LoopTimingModel::LoopTimingModel(Noelle &noelle,
+                                 LoopDependenceInfo &ldi,
+                                 Heuristics &heuristics)
   : n{ noelle },
-    loop{ ldi } {
+    loop{ ldi },
+    heuristics{ heuristics } {
   return;
 }
 
 uint64_t LoopTimingModel::getTimeSavedByParallelizingLoop(void) {
 
   /*
-   * Fetch the critical path per iteration
+   * Fetch the profiles
    */
-  auto seq = this->getTimeSpentInCriticalPathPerIteration();
+  auto profiles = this->n.getProfiles();
 
   /*
    * Fetch the loop structure
@@ -43,23 +46,35 @@ uint64_t LoopTimingModel::getTimeSavedByParallelizingLoop(void) {
   auto ls = this->loop.getLoopStructure();
 
   /*
-   * Fetch the profiles
+   * Check if the loop has been executed.
    */
-  auto profiles = this->n.getProfiles();
+  if (!profiles->hasBeenExecuted(ls)) {
+    return 0;
+  }
 
   /*
-   * Compute the total time saved.
+   * Compute the timing model of the loop.
    */
-  auto instsPerIteration =
-      profiles->getAverageTotalInstructionsPerIteration(ls);
-  auto instsInBiggestSCCPerIteration =
-      ((double)seq) / ((double)profiles->getIterations(ls));
-  assert(instsInBiggestSCCPerIteration <= instsPerIteration);
-  auto timeSavedPerIteration =
-      (double)(instsPerIteration - instsInBiggestSCCPerIteration);
-  auto timeSaved = timeSavedPerIteration * profiles->getIterations(ls);
-
-  return timeSaved;
+  auto sequentialSCCs =
+      DOALL::getSCCsThatBlockDOALLToBeApplicable(&this->loop, this->n);
+  auto model =
+      this->heuristics.getParallelLoopTimingModel(this->loop, sequentialSCCs);
+
+  /*
+   * Find the fastest parallelization of the loop.
+   */
+  auto sequentialTime = model.getSequentialTime();
+  auto bestTime = sequentialTime;
+  auto ltm = this->loop.getLoopTransformationsManager();
+  auto maxCores = ltm->getMaximumNumberOfCores();
+  for (auto technique : this->getEnabledTechniques()) {
+    for (auto cores = 2u; cores <= maxCores; cores++) {
+      auto parallelTime = model.getParallelTime(technique, cores);
+      bestTime = std::min(bestTime, parallelTime);
+    }
+  }
+
+  return (uint64_t)(sequentialTime - bestTime);
 }
 
 uint64_t LoopTimingModel::getTimeSpentInCriticalPathPerIteration(void) {
@@ -101,4 +116,68 @@ uint64_t LoopTimingModel::getTimeSpentInCriticalPathPerIteration(void) {
   return biggestSCCTime;
 }
 
+std::optional<Transformation> LoopTimingModel::getBestTechnique(void) {
+
+  /*
+   * Compute the timing model of the loop.
+   */
+  auto sequentialSCCs =
+      DOALL::getSCCsThatBlockDOALLToBeApplicable(&this->loop, this->n);
+  auto model =
+      this->heuristics.getParallelLoopTimingModel(this->loop, sequentialSCCs);
+
+  /*
+   * Find the technique of the fastest parallelization of the loop.
+   */
+  std::optional<Transformation> bestTechnique;
+  auto bestTime = model.getSequentialTime();
+  auto ltm = this->loop.getLoopTransformationsManager();
+  auto maxCores = ltm->getMaximumNumberOfCores();
+  for (auto technique : this->getEnabledTechniques()) {
+    for (auto cores = 2u; cores <= maxCores; cores++) {
+      auto parallelTime = model.getParallelTime(technique, cores);
+      if (parallelTime < bestTime) {
+        bestTime = parallelTime;
+        bestTechnique = technique;
+      }
+    }
+  }
+
+  return bestTechnique;
+}
+
+double LoopTimingModel::getPredictedSpeedup(uint32_t cores) {
+
+  /*
+   * Compute the timing model of the loop.
+   */
+  auto sequentialSCCs =
+      DOALL::getSCCsThatBlockDOALLToBeApplicable(&this->loop, this->n);
+  auto model =
+      this->heuristics.getParallelLoopTimingModel(this->loop, sequentialSCCs);
+
+  /*
+   * Find the best speedup among the enabled techniques.
+   */
+  double bestSpeedup = 1;
+  for (auto technique : this->getEnabledTechniques()) {
+    bestSpeedup = std::max(bestSpeedup, model.getSpeedup(technique, cores));
+  }
+
+  return bestSpeedup;
+}
+
+std::vector<Transformation> LoopTimingModel::getEnabledTechniques(void) {
+  std::vector<Transformation> techniques;
+
+  auto ltm = this->loop.getLoopTransformationsManager();
+  for (auto technique : { DOALL_ID, HELIX_ID, DSWP_ID }) {
+    if (ltm->isTransformationEnabled(technique)) {
+      techniques.push_back(technique);
+    }
+  }
+
+  return techniques;
+}
+
 } // namespace arcana::noelle
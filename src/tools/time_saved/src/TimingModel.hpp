@@ -22,20 +22,43 @@
 #pragma once
 
 #include "noelle/core/Noelle.hpp"
+#include "noelle/tools/Heuristics.hpp"
 
 namespace arcana::noelle {
 
 class LoopTimingModel {
 public:
-  LoopTimingModel(Noelle &noelle, LoopDependenceInfo &ldi);
+  LoopTimingModel(Noelle &noelle,
+                  LoopDependenceInfo &ldi,
+                  Heuristics &heuristics);
 
+  /*
+   * Return the time saved by the best parallelization of the loop among the
+   * enabled techniques and the numbers of cores allowed.
+   * Parallelizations that slow the loop down save no time.
+   */
   uint64_t getTimeSavedByParallelizingLoop(void);
 
   uint64_t getTimeSpentInCriticalPathPerIteration(void);
 
+  /*
+   * Return the technique of the best parallelization of the loop, if any
+   * parallelization speeds the loop up.
+   */
+  std::optional<Transformation> getBestTechnique(void);
+
+  /*
+   * Return the speedup predicted for the best technique that uses @cores
+   * cores.
+   */
+  double getPredictedSpeedup(uint32_t cores);
+
 protected:
   Noelle &n;
   LoopDependenceInfo &loop;
+  Heuristics &heuristics;
+
+  std::vector<Transformation> getEnabledTechniques(void);
 };
 
 } // namespace arcana::noelle
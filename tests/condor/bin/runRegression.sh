@@ -28,6 +28,11 @@ fi
 # Go to the directory
 cd $testDir ;
 
+# Check if we need to extend the options
+if test -f parallelization_options.txt ; then
+  parallelizationOptions="$parallelizationOptions `cat parallelization_options.txt`" ;
+fi
+
 # Clean
 make clean ;
 
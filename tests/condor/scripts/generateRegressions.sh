@@ -92,7 +92,7 @@ function generateAllCondorJobs {
   noelleOptions="-noelle-inliner-avoid-hoist-to-main -noelle-disable-helix" ;
   generateCondor "$condorFile" "$noelleOptions" "$parOptions" "$feOptions" "$meOptions"
 
-  noelleOptions="-noelle-disable-dswp -noelle-disable-doall -noelle-disable-helix -noelle-disable-inliner -noelle-disable-whilifier -noelle-disable-loop-distribution -noelle-disable-scev-simplification" ;
+  noelleOptions="-noelle-disable-dswp -noelle-disable-doall -noelle-disable-helix -noelle-disable-inliner -noelle-disable-whilifier -noelle-disable-loop-distribution -noelle-disable-loop-collapsing -noelle-disable-scev-simplification" ;
   generateCondor "$condorFile" "$noelleOptions" "$parOptions" "$feOptions" "$meOptions"
 
   return 
@@ -0,0 +1,37 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+
+#define ROWS 3
+
+int main (int argc, char *argv[]){
+
+  /*
+   * Check the inputs.
+   */
+  if (argc < 2){
+    fprintf(stderr, "USAGE: %s COLUMNS\n", argv[0]);
+    return -1;
+  }
+  auto columns = atoll(argv[1]);
+  auto m = (int64_t *)calloc(ROWS * columns, sizeof(int64_t));
+
+  // The outer loop has fewer iterations than the available cores
+  for (auto i = 0; i < ROWS; i++) {
+    for (auto j = 0; j < columns; j++) {
+      auto v = i + j;
+      for (auto r = 0; r < 100; r++){
+        v = (v * 3 + r) % 1000003;
+      }
+      m[i * columns + j] = v;
+    }
+  }
+
+  int64_t digest = 0;
+  for (auto k = 0; k < ROWS * columns; k++){
+    digest = (digest + m[k]) % 2147483647;
+  }
+  printf("%lld\n", (long long)digest);
+
+  return 0;
+}
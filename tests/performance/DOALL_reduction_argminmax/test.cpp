@@ -0,0 +1,32 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+
+int main (int argc, char *argv[]){
+
+  /*
+   * Check the inputs.
+   */
+  if (argc < 2){
+    fprintf(stderr, "USAGE: %s LOOP_ITERATIONS\n", argv[0]);
+    return -1;
+  }
+  auto iterations = atoll(argv[1]);
+
+  int64_t minValue = INT64_MAX;
+  int64_t minIndex = -1;
+  for (int64_t i = 0; i < iterations; i++) {
+    int64_t v = i;
+    for (auto r = 0; r < 100; r++){
+      v = (v * 3 + r) % 1000003;
+    }
+    if (v < minValue){
+      minValue = v;
+      minIndex = i;
+    }
+  }
+
+  printf("%lld %lld\n", (long long)minValue, (long long)minIndex);
+
+  return 0;
+}
@@ -0,0 +1,42 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+
+/*
+ * The identity value of gcd is 0 because gcd(0, x) = x.
+ */
+__attribute__((noinline, annotate("noelle.reduction.identity=0")))
+int64_t gcd (int64_t a, int64_t b){
+  while (b != 0){
+    auto t = a % b;
+    a = b;
+    b = t;
+  }
+
+  return a;
+}
+
+int main (int argc, char *argv[]){
+
+  /*
+   * Check the inputs.
+   */
+  if (argc < 2){
+    fprintf(stderr, "USAGE: %s LOOP_ITERATIONS\n", argv[0]);
+    return -1;
+  }
+  auto iterations = atoll(argv[1]);
+
+  int64_t g = 0;
+  for (auto i = 0; i < iterations; i++) {
+    int64_t v = i;
+    for (auto r = 0; r < 100; r++){
+      v = (v * 3 + r) % 1000003;
+    }
+    g = gcd(g, 6 * (v + 1));
+  }
+
+  printf("%lld\n", (long long)g);
+
+  return 0;
+}
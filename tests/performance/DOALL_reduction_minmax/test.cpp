@@ -0,0 +1,30 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+
+int main (int argc, char *argv[]){
+
+  /*
+   * Check the inputs.
+   */
+  if (argc < 2){
+    fprintf(stderr, "USAGE: %s LOOP_ITERATIONS\n", argv[0]);
+    return -1;
+  }
+  auto iterations = atoll(argv[1]);
+
+  int64_t minValue = INT64_MAX;
+  int64_t maxValue = INT64_MIN;
+  for (auto i = 0; i < iterations; i++) {
+    int64_t v = i;
+    for (auto r = 0; r < 100; r++){
+      v = (v * 3 + r) % 1000003;
+    }
+    minValue = v < minValue ? v : minValue;
+    maxValue = v > maxValue ? v : maxValue;
+  }
+
+  printf("%lld %lld\n", (long long)minValue, (long long)maxValue);
+
+  return 0;
+}
@@ -0,0 +1,61 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+
+/*
+ * The compiler cannot prove that dst and src never overlap.
+ */
+__attribute__((noinline)) void computeValues (double *dst, double *src, long long int elements, long long int rounds){
+  for (auto i=0; i < elements; i++){
+    auto v = src[i];
+    for (auto r=0; r < rounds; r++){
+      v = sqrt(v * v + r + i);
+    }
+    dst[i] = v;
+  }
+
+  return ;
+}
+
+int main (int argc, char *argv[]){
+
+  /*
+   * Check the inputs.
+   */
+  if (argc < 3){
+    fprintf(stderr, "USAGE: %s ELEMENTS ROUNDS\n", argv[0]);
+    return -1;
+  }
+  auto elements = atoll(argv[1]);
+  auto rounds = atoll(argv[2]);
+
+  /*
+   * Allocate the arrays.
+   */
+  auto src = (double *) calloc(elements + 1, sizeof(double));
+  auto dst = (double *) calloc(elements, sizeof(double));
+  for (auto i=0; i < elements + 1; i++){
+    src[i] = (double)(i % 7);
+  }
+
+  /*
+   * The arrays do not overlap: the speculation holds.
+   */
+  computeValues(dst, src, elements, rounds);
+
+  /*
+   * The arrays overlap: the speculation fails and the original loop runs.
+   */
+  computeValues(src + 1, src, elements, rounds);
+
+  double s = 0;
+  for (auto i=0; i < elements; i++){
+    s += dst[i] + src[i];
+  }
+  printf("%lld\n", (long long int)s);
+
+  free(src);
+  free(dst);
+
+  return 0;
+}
@@ -0,0 +1,33 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+
+int main (int argc, char *argv[]){
+
+  /*
+   * Check the inputs.
+   */
+  if (argc < 3){
+    fprintf(stderr, "USAGE: %s LOOP_ITERATIONS ROUNDS_PER_ITERATION\n", argv[0]);
+    return -1;
+  }
+  auto iterations = atoll(argv[1]);
+  auto rounds = atoll(argv[2]);
+
+  int64_t digest = argc;
+  for (auto i = 0; i < iterations; ++i) {
+
+    // Short parallel segment
+    auto v = i;
+    for (auto r = 0; r < rounds; r++){
+      v = (v * 3 + r) % 1000003;
+    }
+
+    // Sequential segment executed by every iteration
+    digest = (digest * 31 + v) % 2147483647;
+  }
+
+  printf("%lld\n", (long long)digest);
+
+  return 0;
+}
@@ -0,0 +1,55 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+
+/*
+ * The program can grow only by 10%, which is not enough to parallelize all
+ * its loops in all versions. Only the loops that fit in the budget are
+ * parallelized, and the output must not change.
+ */
+static int64_t computeChecksum (int64_t *values, int64_t iterations){
+  int64_t checksum = 0;
+  for (auto i = 0; i < iterations; ++i) {
+    checksum += values[i] * (i % 5);
+  }
+
+  return checksum;
+}
+
+int main (int argc, char *argv[]){
+
+  /*
+   * Check the inputs.
+   */
+  if (argc < 3){
+    fprintf(stderr, "USAGE: %s LOOP_ITERATIONS ROUNDS_PER_ITERATION\n", argv[0]);
+    return -1;
+  }
+  auto iterations = atoll(argv[1]) * 100;
+  auto rounds = atoll(argv[2]);
+
+  /*
+   * Allocate the output.
+   */
+  auto values = (int64_t *)malloc(sizeof(int64_t) * iterations);
+
+  int64_t sum = 0;
+  for (auto i = 0; i < iterations; ++i) {
+    auto v = (int64_t)i * argc;
+    for (auto r = 0; r < rounds; r++){
+      v = (v * 3 + r) % 1000003;
+    }
+    values[i] = v;
+    sum += v;
+  }
+
+  /*
+   * Print the output.
+   */
+  auto checksum = computeChecksum(values, iterations);
+  printf("%lld %lld\n", (long long)sum, (long long)checksum);
+
+  free(values);
+
+  return 0;
+}
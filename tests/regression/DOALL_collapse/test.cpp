@@ -0,0 +1,46 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+
+#define ROWS 2
+
+/*
+ * The outer loop of the nest has fewer iterations than the available cores,
+ * so the enablers collapse the nest into a single loop before DOALL runs.
+ * The inner loop does not start from 0 and its step is not 1, so both
+ * induction variables must be rebuilt from the iteration counter of the
+ * collapsed loop.
+ */
+int main (int argc, char *argv[]){
+
+  /*
+   * Check the inputs.
+   */
+  if (argc < 2){
+    fprintf(stderr, "USAGE: %s COLUMNS\n", argv[0]);
+    return -1;
+  }
+  auto columns = atoll(argv[1]) * 100 + 3;
+
+  auto m = (int64_t *)calloc(ROWS * columns, sizeof(int64_t));
+
+  for (auto i = 0; i < ROWS; i++) {
+    for (auto j = 1; j < columns; j += 2) {
+      auto v = (int64_t)(i * 1000 + j);
+      for (auto r = 0; r < 20; r++){
+        v = (v * 3 + r) % 1000003;
+      }
+      m[i * columns + j] = v;
+    }
+  }
+
+  int64_t digest = 0;
+  for (auto k = 0; k < ROWS * columns; k++){
+    digest = (digest * 31 + m[k]) % 2147483647;
+  }
+  printf("%lld\n", (long long)digest);
+
+  free(m);
+
+  return 0;
+}
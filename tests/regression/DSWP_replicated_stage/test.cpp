@@ -0,0 +1,48 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+
+int main (int argc, char *argv[]){
+
+  /*
+   * Check the inputs.
+   */
+  if (argc < 3){
+    fprintf(stderr, "USAGE: %s LOOP_ITERATIONS ROUNDS_PER_ITERATION\n", argv[0]);
+    return -1;
+  }
+  auto iterations = atoll(argv[1]);
+  auto rounds = atoll(argv[2]);
+
+  /*
+   * Allocate the output.
+   */
+  auto values = (int64_t *)malloc(sizeof(int64_t) * iterations);
+
+  int64_t seed = argc;
+  for (auto i = 0; i < iterations; ++i) {
+
+    // Sequential stage: every seed depends on the previous one
+    seed = (seed * 1103515245 + 12345) % 2147483648;
+
+    // Stage without loop-carried dependences: it can be replicated
+    auto v = seed;
+    for (auto r = 0; r < rounds; r++){
+      v = (v * 3 + r) % 1000003;
+    }
+    values[i] = v;
+  }
+
+  /*
+   * Print the output.
+   */
+  int64_t checksum = 0;
+  for (auto i = 0; i < iterations; ++i) {
+    checksum += values[i];
+  }
+  printf("%lld\n", (long long)checksum);
+
+  free(values);
+
+  return 0;
+}
@@ -0,0 +1,47 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+
+/*
+ * The loop-carried values of the loop of main are spilled by HELIX.
+ * The ones accessed by a single sequential segment are forwarded from a core
+ * to the next one through the cache line of that sequential segment.
+ */
+int main (int argc, char *argv[]){
+
+  /*
+   * Check the inputs.
+   */
+  if (argc < 3){
+    fprintf(stderr, "USAGE: %s LOOP_ITERATIONS ROUNDS_PER_ITERATION\n", argv[0]);
+    return -1;
+  }
+  auto iterations = atoll(argv[1]) * 100;
+  auto rounds = atoll(argv[2]);
+
+  int64_t a = argc;
+  int32_t b = argc * 3;
+  double c = 1.0;
+  int64_t d = argc * 5;
+  for (auto i = 0; i < iterations; ++i) {
+
+    // Parallel segment
+    auto v = (int64_t)i;
+    for (auto r = 0; r < rounds; r++){
+      v = (v * 3 + r) % 1000003;
+    }
+
+    // Values of different types updated together
+    a = (a * 7 + v) % 1000003;
+    b = (b * 5 + (int32_t)(v % 100)) % 65521;
+    c = c * 0.5 + (double)(a % 10);
+
+    // Value updated in a different sequential segment
+    if (v % 3 == 0){
+      d = (d * 11 + v) % 999983;
+    }
+  }
+  printf("%lld %d %.6f %lld\n", (long long)a, b, c, (long long)d);
+
+  return 0;
+}
@@ -0,0 +1,41 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+
+/*
+ * Every core executes blocks of consecutive iterations of the loop of main.
+ * The number of iterations is not a multiple of the block size, so the last
+ * block of some cores is partial.
+ */
+int main (int argc, char *argv[]){
+
+  /*
+   * Check the inputs.
+   */
+  if (argc < 3){
+    fprintf(stderr, "USAGE: %s LOOP_ITERATIONS ROUNDS_PER_ITERATION\n", argv[0]);
+    return -1;
+  }
+  auto iterations = atoll(argv[1]) * 100 + 7;
+  auto rounds = atoll(argv[2]);
+
+  int64_t digest = argc;
+  int64_t last = 0;
+  for (auto i = 0; i < iterations; ++i) {
+
+    // Parallel segment
+    auto v = (int64_t)i;
+    for (auto r = 0; r < rounds; r++){
+      v = (v * 3 + r) % 1000003;
+    }
+
+    // Sequential segment executed by every iteration
+    digest = (digest * 31 + v) % 2147483647;
+
+    // Loop-carried value consumed by the next iteration
+    last = (last + v) % 1000;
+  }
+  printf("%lld %lld\n", (long long)digest, (long long)last);
+
+  return 0;
+}
@@ -0,0 +1,66 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+
+/*
+ * The compiler cannot prove that dst and src never overlap.
+ * HELIX speculates that they do not and checks it when the loop starts.
+ */
+__attribute__((noinline)) int64_t computeValues (int64_t *dst, int64_t *src, int64_t elements, int64_t rounds){
+  int64_t digest = 1;
+  for (auto i = 0; i < elements; i++){
+    auto v = src[i];
+    for (auto r = 0; r < rounds; r++){
+      v = (v * 3 + r) % 1000003;
+    }
+    dst[i] = v;
+
+    // Sequential segment
+    digest = (digest * 31 + v) % 2147483647;
+  }
+
+  return digest;
+}
+
+int main (int argc, char *argv[]){
+
+  /*
+   * Check the inputs.
+   */
+  if (argc < 3){
+    fprintf(stderr, "USAGE: %s ELEMENTS ROUNDS\n", argv[0]);
+    return -1;
+  }
+  auto elements = atoll(argv[1]) * 100;
+  auto rounds = atoll(argv[2]);
+
+  /*
+   * Allocate the arrays.
+   */
+  auto src = (int64_t *) calloc(elements + 1, sizeof(int64_t));
+  auto dst = (int64_t *) calloc(elements, sizeof(int64_t));
+  for (auto i = 0; i < elements + 1; i++){
+    src[i] = i % 7;
+  }
+
+  /*
+   * The arrays do not overlap: the speculation holds.
+   */
+  auto d1 = computeValues(dst, src, elements, rounds);
+
+  /*
+   * The arrays overlap: the speculation fails and the original loop runs.
+   */
+  auto d2 = computeValues(src + 1, src, elements, rounds);
+
+  int64_t s = 0;
+  for (auto i = 0; i < elements; i++){
+    s += dst[i] + src[i];
+  }
+  printf("%lld %lld %lld\n", (long long)d1, (long long)d2, (long long)s);
+
+  free(src);
+  free(dst);
+
+  return 0;
+}
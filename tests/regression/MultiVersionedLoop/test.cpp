@@ -0,0 +1,48 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+
+/*
+ * The loop of main can be parallelized by DOALL, HELIX, and DSWP.
+ * All versions are generated and the one to run is selected at runtime.
+ */
+int main (int argc, char *argv[]){
+
+  /*
+   * Check the inputs.
+   */
+  if (argc < 3){
+    fprintf(stderr, "USAGE: %s LOOP_ITERATIONS ROUNDS_PER_ITERATION\n", argv[0]);
+    return -1;
+  }
+  auto iterations = atoll(argv[1]) * 100;
+  auto rounds = atoll(argv[2]);
+
+  /*
+   * Allocate the output.
+   */
+  auto values = (int64_t *)malloc(sizeof(int64_t) * iterations);
+
+  int64_t sum = 0;
+  for (auto i = 0; i < iterations; ++i) {
+    auto v = (int64_t)i * argc;
+    for (auto r = 0; r < rounds; r++){
+      v = (v * 3 + r) % 1000003;
+    }
+    values[i] = v;
+    sum += v;
+  }
+
+  /*
+   * Print the output.
+   */
+  int64_t checksum = 0;
+  for (auto i = 0; i < iterations; ++i) {
+    checksum += values[i] * (i % 5);
+  }
+  printf("%lld %lld\n", (long long)sum, (long long)checksum);
+
+  free(values);
+
+  return 0;
+}
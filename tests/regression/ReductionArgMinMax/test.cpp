@@ -0,0 +1,46 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+int main (int argc, char *argv[]){
+
+  /*
+   * Check the inputs.
+   */
+  if (argc < 2){
+    fprintf(stderr, "USAGE: %s LOOP_ITERATIONS\n", argv[0]);
+    return -1;
+  }
+  auto iterations = atoi(argv[1]);
+  iterations *= 100;
+  if (iterations < 1){
+    iterations = 1;
+  }
+
+  /*
+   * Values repeat, so the first iteration that found the minimum (maximum)
+   * must be kept.
+   */
+  long *values = (long *)malloc(sizeof(long) * iterations);
+  for (auto i = 0; i < iterations; i++){
+    values[i] = (i * 37 + 11) % 101;
+  }
+
+  long minValue = 1000;
+  int minIndex = -1;
+  long maxValue = -1;
+  int maxIndex = -1;
+  for (auto i = 0; i < iterations; i++){
+    if (values[i] < minValue){
+      minValue = values[i];
+      minIndex = i;
+    }
+    if (values[i] > maxValue){
+      maxValue = values[i];
+      maxIndex = i;
+    }
+  }
+
+  printf("%ld %d %ld %d\n", minValue, minIndex, maxValue, maxIndex);
+
+  return 0;
+}
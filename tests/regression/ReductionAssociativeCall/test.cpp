@@ -0,0 +1,51 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+
+/*
+ * The identity value of gcd is 0 because gcd(0, x) = x.
+ */
+__attribute__((noinline, annotate("noelle.reduction.identity=0")))
+long gcd (long a, long b){
+  while (b != 0){
+    auto t = a % b;
+    a = b;
+    b = t;
+  }
+
+  return a;
+}
+
+int main (int argc, char *argv[]){
+
+  /*
+   * Check the inputs.
+   */
+  if (argc < 2){
+    fprintf(stderr, "USAGE: %s LOOP_ITERATIONS\n", argv[0]);
+    return -1;
+  }
+  auto iterations = atoi(argv[1]);
+  iterations *= 100;
+  if (iterations < 1){
+    iterations = 1;
+  }
+
+  long *values = (long *)malloc(sizeof(long) * iterations);
+  double *reals = (double *)malloc(sizeof(double) * iterations);
+  for (auto i = 0; i < iterations; i++){
+    values[i] = 6 * ((i % 17) + 1) * ((i % 5) + 2);
+    reals[i] = sin((double)i);
+  }
+
+  long g = 0;
+  double maxReal = -2.0;
+  for (auto i = 0; i < iterations; i++){
+    g = gcd(g, values[i]);
+    maxReal = fmax(maxReal, reals[i]);
+  }
+
+  printf("%ld %.6f\n", g, maxReal);
+
+  return 0;
+}
@@ -0,0 +1,45 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+int main (int argc, char *argv[]){
+
+  /*
+   * Check the inputs.
+   */
+  if (argc < 2){
+    fprintf(stderr, "USAGE: %s LOOP_ITERATIONS\n", argv[0]);
+    return -1;
+  }
+  auto iterations = atoi(argv[1]);
+  iterations *= 100;
+  if (iterations < 1){
+    iterations = 1;
+  }
+
+  int *values = (int *)malloc(sizeof(int) * iterations);
+  double *reals = (double *)malloc(sizeof(double) * iterations);
+  for (auto i = 0; i < iterations; i++){
+    values[i] = ((i * 7919) % 1013) - 500;
+    reals[i] = values[i] / 3.0;
+  }
+
+  int minValue = 1000;
+  int maxValue = -1000;
+  unsigned int maxUnsigned = 0;
+  double minReal = 1000.0;
+  for (auto i = 0; i < iterations; i++){
+    if (values[i] < minValue){
+      minValue = values[i];
+    }
+    if (values[i] >= maxValue){
+      maxValue = values[i];
+    }
+    unsigned int u = values[i] * values[i];
+    maxUnsigned = u > maxUnsigned ? u : maxUnsigned;
+    minReal = reals[i] < minReal ? reals[i] : minReal;
+  }
+
+  printf("%d %d %u %.3f\n", minValue, maxValue, maxUnsigned, minReal);
+
+  return 0;
+}
@@ -0,0 +1,41 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+/*
+ * The loops of main are parallelized one after the other.
+ * The abstractions of every loop are computed after its siblings have been
+ * parallelized, so they must describe the code as transformed by them.
+ */
+int main (int argc, char *argv[]){
+
+  if (argc < 2){
+    fprintf(stderr, "USAGE: %s ELEMENTS\n", argv[0]);
+    return -1;
+  }
+  auto elements = atoll(argv[1]) * 100;
+
+  auto a = (long long int *) malloc(sizeof(long long int) * elements);
+  auto b = (long long int *) malloc(sizeof(long long int) * elements);
+
+  for (auto i = 0; i < elements; i++){
+    a[i] = i * argc;
+  }
+
+  for (auto i = 0; i < elements; i++){
+    b[i] = a[i] + (i % 7);
+  }
+
+  long long int s = 0;
+  for (auto i = 0; i < elements; i++){
+    for (auto j = 0; j < 10; j++){
+      s += b[i] * j;
+    }
+  }
+
+  printf("%lld\n", s);
+
+  free(a);
+  free(b);
+
+  return 0;
+}
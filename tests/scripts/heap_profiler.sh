@@ -0,0 +1,52 @@
+#!/bin/bash
+
+# Fetch the inputs
+if test $# -lt 3 ; then
+  echo "USAGE: `basename $0` BASELINE_NOELLE_DIR NOELLE_DIR IR_FILE [OPTION]" ;
+  echo "  It compares the heap allocations done by noelle-loop-stats of two built NOELLE repositories when they analyze IR_FILE (e.g., a large benchmark)." ;
+  exit 1;
+fi
+baselineDir=`realpath $1` ;
+newDir=`realpath $2` ;
+irFile=`realpath $3` ;
+shift 3 ;
+
+# Check the dependences
+if ! command -v valgrind &> /dev/null ; then
+  echo "ERROR: valgrind is not available" ;
+  exit 1;
+fi
+
+# Profile a NOELLE build
+function profile {
+  local noelleDir=$1 ;
+  local outFile=$2 ;
+  shift 2 ;
+
+  ( source ${noelleDir}/enable && valgrind --tool=memcheck --leak-check=no --trace-children=yes noelle-loop-stats ${irFile} $@ ) &> ${outFile} ;
+
+  # Sum the allocations of all processes that noelle-loop-stats spawned
+  grep "total heap usage" ${outFile} | sed 's/,//g' | awk '{allocs += $5 ; bytes += $9} END {print allocs " " bytes}' ;
+}
+
+# Run noelle-loop-stats of both installations
+tmpDir=`mktemp -d` ;
+baseline=`profile ${baselineDir} ${tmpDir}/baseline.txt $@` ;
+new=`profile ${newDir} ${tmpDir}/new.txt $@` ;
+
+allocs1=`echo $baseline | awk '{print $1}'` ;
+bytes1=`echo $baseline | awk '{print $2}'` ;
+allocs2=`echo $new | awk '{print $1}'` ;
+bytes2=`echo $new | awk '{print $2}'` ;
+if test "$allocs1" == "" -o "$allocs2" == "" ; then
+  echo "ERROR: valgrind did not report the heap usage. Check ${tmpDir}" ;
+  exit 1;
+fi
+
+# Print the results
+delta=`echo "scale=3; (($allocs2 - $allocs1) / $allocs1) * 100" | bc`;
+echo "Allocations: $allocs1 (baseline) vs. $allocs2 = $delta %" ;
+delta=`echo "scale=3; (($bytes2 - $bytes1) / $bytes1) * 100" | bc`;
+echo "Bytes allocated: $bytes1 (baseline) vs. $bytes2 = $delta %" ;
+
+rm -r ${tmpDir} ;
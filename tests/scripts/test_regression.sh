@@ -42,8 +42,14 @@ function runningTests {
     # Clean
     make clean > /dev/null ; 
 
+    # Check if we need to extend the options
+    local parOptions="$2" ;
+    if test -f parallelization_options.txt ; then
+      parOptions="$2 `cat parallelization_options.txt`" ;
+    fi
+
     # Compile
-    make PARALLELIZATION_OPTIONS="$2" >> compiler_output.txt 2>&1 ;
+    make PARALLELIZATION_OPTIONS="$parOptions" >> compiler_output.txt 2>&1 ;
     
     # Generate the input
     make input.txt &> /dev/null ;
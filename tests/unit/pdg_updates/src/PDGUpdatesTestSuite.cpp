@@ -0,0 +1,267 @@
+/*
+ * Copyright 2023  Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do
+ so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "PDGUpdatesTestSuite.hpp"
+
+namespace arcana::noelle {
+
+// Register pass to "opt"
+char PDGUpdatesTestSuite::ID = 0;
+static RegisterPass<PDGUpdatesTestSuite> X("UnitTester",
+                                           "PDG Updates Unit Tester");
+
+// Register pass to "clang"
+static PDGUpdatesTestSuite *_PassMaker = NULL;
+static RegisterStandardPasses _RegPass1(
+    PassManagerBuilder::EP_OptimizerLast,
+    [](const PassManagerBuilder &, legacy::PassManagerBase &PM) {
+      if (!_PassMaker) {
+        PM.add(_PassMaker = new PDGUpdatesTestSuite());
+      }
+    }); // ** for -Ox
+static RegisterStandardPasses _RegPass2(
+    PassManagerBuilder::EP_EnabledOnOptLevel0,
+    [](const PassManagerBuilder &, legacy::PassManagerBase &PM) {
+      if (!_PassMaker) {
+        PM.add(_PassMaker = new PDGUpdatesTestSuite());
+      }
+    }); // ** for -O0
+
+const char *PDGUpdatesTestSuite::tests[] = {
+  "no tracking tag is left",
+  "task instructions are in the PDG",
+  "task register dependences match its code",
+  "task dependences do not cross its boundary"
+};
+
+TestFunction PDGUpdatesTestSuite::testFns[] = {
+  PDGUpdatesTestSuite::noTrackingTagIsLeft,
+  PDGUpdatesTestSuite::taskInstructionsAreInThePDG,
+  PDGUpdatesTestSuite::taskRegisterDependencesMatchItsCode,
+  PDGUpdatesTestSuite::taskDependencesDoNotCrossItsBoundary
+};
+
+bool PDGUpdatesTestSuite::doInitialization(Module &M) {
+  errs() << "PDGUpdatesTestSuite: Initialize\n";
+  const int numTests = sizeof(tests) / sizeof(tests[0]);
+  this->suite = new TestSuite("PDGUpdatesTestSuite",
+                              tests,
+                              testFns,
+                              numTests,
+                              "test.txt");
+  this->M = &M;
+  this->task = nullptr;
+  return false;
+}
+
+void PDGUpdatesTestSuite::getAnalysisUsage(AnalysisUsage &AU) const {
+  AU.addRequired<Noelle>();
+  AU.addRequired<HeuristicsPass>();
+}
+
+bool PDGUpdatesTestSuite::runOnModule(Module &M) {
+  errs() << "PDGUpdatesTestSuite: Start\n";
+
+  this->mainF = M.getFunction("main");
+  auto &noelle = getAnalysis<Noelle>();
+  auto heuristics = getAnalysis<HeuristicsPass>().getHeuristics(noelle);
+  this->pdg = noelle.getProgramDependenceGraph();
+
+  /*
+   * Fetch the loop to parallelize.
+   */
+  auto loops = noelle.getLoopStructures(mainF, 0);
+  assert(loops->size() > 0);
+  auto ldi = noelle.getLoop(loops->front());
+
+  /*
+   * Keep track of the functions that exist before the parallelization.
+   */
+  std::unordered_set<Function *> functionsBefore;
+  for (auto &F : M) {
+    functionsBefore.insert(&F);
+  }
+
+  /*
+   * Parallelize the loop while the PDG tracks the changes of its function.
+   */
+  errs() << "PDGUpdatesTestSuite: Parallelizing the loop with DOALL\n";
+  DOALL doall{ noelle };
+  this->pdg->trackChangesOf(*mainF);
+  if (doall.canBeAppliedToLoop(ldi, heuristics)) {
+    doall.apply(ldi, heuristics);
+  }
+  this->pdg->updateChangesOf(*mainF);
+
+  /*
+   * Fetch the task.
+   */
+  for (auto &F : M) {
+    if (F.empty()) {
+      continue;
+    }
+    if (functionsBefore.find(&F) == functionsBefore.end()) {
+      this->task = &F;
+      break;
+    }
+  }
+
+  errs() << "PDGUpdatesTestSuite: Running tests\n";
+  suite->runTests((ModulePass &)*this);
+
+  errs() << "PDGUpdatesTestSuite: Freeing memory\n";
+  delete ldi;
+  delete this->suite;
+
+  return false;
+}
+
+Values PDGUpdatesTestSuite::noTrackingTagIsLeft(ModulePass &pass,
+                                                TestSuite &suite) {
+  auto &puPass = static_cast<PDGUpdatesTestSuite &>(pass);
+
+  /*
+   * Collect the instructions of the module that are still tagged.
+   */
+  Values taggedValues;
+  for (auto &F : *puPass.M) {
+    for (auto &I : instructions(F)) {
+      if (I.getMetadata("noelle.pdg.tracking") != nullptr) {
+        taggedValues.insert(suite.valueToString(&I));
+      }
+    }
+  }
+
+  return taggedValues;
+}
+
+Values PDGUpdatesTestSuite::taskInstructionsAreInThePDG(ModulePass &pass,
+                                                        TestSuite &suite) {
+  auto &puPass = static_cast<PDGUpdatesTestSuite &>(pass);
+
+  /*
+   * Check the loop has been parallelized.
+   */
+  Values missingValues;
+  if (puPass.task == nullptr) {
+    missingValues.insert("No task has been generated");
+    return missingValues;
+  }
+
+  /*
+   * Collect the instructions of the task that are not in the PDG.
+   */
+  for (auto &I : instructions(*puPass.task)) {
+    if (!puPass.pdg->isInGraph(&I)) {
+      missingValues.insert(suite.valueToString(&I));
+    }
+  }
+
+  return missingValues;
+}
+
+Values PDGUpdatesTestSuite::taskRegisterDependencesMatchItsCode(
+    ModulePass &pass,
+    TestSuite &suite) {
+  auto &puPass = static_cast<PDGUpdatesTestSuite &>(pass);
+  Values missingDependences;
+  if (puPass.task == nullptr) {
+    return missingDependences;
+  }
+
+  /*
+   * Every operand of an instruction of the task must have a register
+   * dependence to the instruction.
+   */
+  auto pdg = puPass.pdg;
+  for (auto &I : instructions(*puPass.task)) {
+    if (!pdg->isInGraph(&I)) {
+      continue;
+    }
+    auto node = pdg->fetchNode(&I);
+    for (auto &op : I.operands()) {
+      auto definition = op.get();
+      if (!isa<Instruction>(definition) && !isa<Argument>(definition)) {
+        continue;
+      }
+      auto found = false;
+      for (auto edge : node->getIncomingEdges()) {
+        if ((edge->getSrc() == definition) && !edge->isMemoryDependence()
+            && !edge->isControlDependence()) {
+          found = true;
+          break;
+        }
+      }
+      if (!found) {
+        missingDependences.insert(suite.combineOrderedValues(
+            { suite.valueToString(definition), suite.valueToString(&I) }));
+      }
+    }
+  }
+
+  return missingDependences;
+}
+
+Values PDGUpdatesTestSuite::taskDependencesDoNotCrossItsBoundary(
+    ModulePass &pass,
+    TestSuite &suite) {
+  auto &puPass = static_cast<PDGUpdatesTestSuite &>(pass);
+  Values crossingDependences;
+  if (puPass.task == nullptr) {
+    return crossingDependences;
+  }
+
+  /*
+   * Dependences connect values of the same function.
+   */
+  auto pdg = puPass.pdg;
+  auto isOutsideTask = [&puPass](Value *v) -> bool {
+    if (auto inst = dyn_cast<Instruction>(v)) {
+      return inst->getFunction() != puPass.task;
+    }
+    if (auto arg = dyn_cast<Argument>(v)) {
+      return arg->getParent() != puPass.task;
+    }
+    return false;
+  };
+  for (auto &I : instructions(*puPass.task)) {
+    if (!pdg->isInGraph(&I)) {
+      continue;
+    }
+    auto node = pdg->fetchNode(&I);
+    for (auto edge : node->getIncomingEdges()) {
+      if (isOutsideTask(edge->getSrc())) {
+        crossingDependences.insert(suite.combineOrderedValues(
+            { suite.valueToString(edge->getSrc()), suite.valueToString(&I) }));
+      }
+    }
+    for (auto edge : node->getOutgoingEdges()) {
+      if (isOutsideTask(edge->getDst())) {
+        crossingDependences.insert(suite.combineOrderedValues(
+            { suite.valueToString(&I), suite.valueToString(edge->getDst()) }));
+      }
+    }
+  }
+
+  return crossingDependences;
+}
+
+} // namespace arcana::noelle
@@ -0,0 +1,22 @@
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+int main (int argc, char *argv[]){
+
+  if (argc < 2){
+    fprintf(stderr, "USAGE: %s LOOP_ITERATIONS\n", argv[0]);
+    return -1;
+  }
+  auto iterations = atoll(argv[1]);
+  if (iterations == 0) return 0;
+
+  long long int *array = (long long int *) calloc(iterations, sizeof(long long int));
+
+  for (auto i = 0; i < iterations; ++i) {
+    array[i] = (i * argc) + 3;
+  }
+
+  printf("%lld\n", array[iterations - 1]);
+  return 0;
+}